@@ -0,0 +1,159 @@
+#pragma once
+
+#include "colgen/MasterProblem.hpp"
+#include "core/StopToken.hpp"
+#include "core/UnifiedSolution.hpp"
+#include "network/ConnectionNetwork.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace colgen {
+
+/**
+ * Pool of distinct feasible vehicle blocks collected from many schedules
+ *
+ * Every greedy, local search or stored schedule contains good blocks that the final schedule
+ * of its run throws away. The pool keeps each distinct block once, keyed by its (depot, type)
+ * slot and journey sequence, and recombine() solves the set-partitioning master over the
+ * pool to assemble a schedule from the best blocks of all runs. Blocks are re-costed with
+ * the connection network, so stored blocks of another cost model are re-priced and
+ * infeasible or stale ones are rejected.
+ *
+ * The journeys of all blocks live in one flat array and the index maps a 64-bit hash of
+ * the key to a chain of blocks, so a block costs a few words besides its journeys and
+ * deduplicating millions of blocks stays cheap. Not thread safe.
+ */
+class BlockPool {
+  public:
+    struct RecombineConfig {
+        double          timeLimit  = 10.0;   // Master time limit in seconds
+        size_t          maxColumns = 200000; // Pool blocks handed to the master (0 = all)
+        bool            verbose    = false;
+        core::StopToken stop; // Skips the master, the incumbent is returned
+    };
+
+    struct RecombineResult {
+        core::UnifiedSolution solution; // The incumbent unless the master found a cheaper one
+        bool                  improved;
+        size_t                columns; // Columns of the master
+    };
+
+    /**
+     * @param network Connection network of the instance, must outlive the pool
+     */
+    explicit BlockPool(const network::ConnectionNetwork& network);
+
+    /**
+     * Add a block unless it is infeasible or already pooled
+     * @param depotIndex Dense depot index
+     * @param vehicleTypeIndex Dense vehicle type index
+     * @param journeys Journey indices in driving order
+     * @return Pool index of the block, -1 if it is infeasible
+     */
+    int add(int depotIndex, int vehicleTypeIndex, data::JourneySpan journeys);
+
+    /**
+     * Add every block of a schedule (depot and vehicle type IDs, journey indices)
+     * @return Number of new blocks
+     */
+    int addSolution(const core::UnifiedSolution& solution);
+
+    /**
+     * Reserve room for blocks and their journeys, e.g. before streaming stored rows
+     */
+    void reserve(size_t blocks, size_t journeys);
+
+    size_t size() const { return blocks_.size(); }
+
+    /**
+     * Blocks offered to add() that were already pooled
+     */
+    size_t getDuplicates() const { return duplicates_; }
+
+    /**
+     * Blocks offered to add() that were infeasible or out of range
+     */
+    size_t getRejected() const { return rejected_; }
+
+    /**
+     * Solve the set-partitioning master over the pool
+     *
+     * The master gets the blocks of the incumbent, one cheapest single-journey block per
+     * journey (so a partition always exists) and, if the pool is larger than maxColumns,
+     * the blocks with the lowest cost per journey.
+     *
+     * @param master Master backend, re-initialized for this call
+     * @param incumbent Feasible schedule whose objective the result must beat (may be empty)
+     * @param config Limits
+     */
+    RecombineResult recombine(MasterProblem&               master,
+                              const core::UnifiedSolution& incumbent,
+                              const RecombineConfig&       config);
+
+  private:
+    struct Block {
+        size_t journeyOffset; // First journey in journeys_
+        int    journeyCount;
+        int    slot; // depotIndex * numVehicleTypes + vehicleTypeIndex
+        double cost;
+        int    nextSameHash; // Next block of the hash chain, -1 at the end
+    };
+
+    const network::ConnectionNetwork& network_;
+    int                               numVehicleTypes_;
+
+    std::vector<Block>                blocks_;
+    std::vector<int>                  journeys_; // Journeys of all blocks, one range each
+    std::unordered_map<uint64_t, int> firstByHash_;
+    bool                              singlesAdded_;
+    size_t                            duplicates_;
+    size_t                            rejected_;
+    bool                              verbose_;
+
+    static uint64_t hashKey(int slot, data::JourneySpan journeys);
+
+    /**
+     * Pool index of a block, -1 if not pooled
+     */
+    int find(uint64_t hash, int slot, data::JourneySpan journeys) const;
+
+    data::JourneySpan journeysOf(const Block& block) const {
+        return data::JourneySpan(journeys_.data() + block.journeyOffset, block.journeyCount);
+    }
+
+    /**
+     * Add the cheapest single-journey block of every journey
+     */
+    void addSingles();
+
+    /**
+     * Complete a conflict-free partial selection of the master to a partition
+     * @param chosen Indices into columns, extended in place
+     * @return true if every journey is covered
+     */
+    bool completePartition(const std::vector<Column>& columns,
+                           const std::vector<int>&    capacities,
+                           std::vector<int>&          chosen) const;
+
+    /**
+     * Improve a partition by exchanges: a column enters, the blocks it overlaps leave and
+     * their other journeys are covered again by their remainders or by the cheapest pooled
+     * blocks among them
+     * @param columns Master columns, remainders in the improved partition are appended
+     * @param duals Coverage duals ranking the entering columns (empty = cost per journey)
+     * @param partition Indices into columns, a partition of all journeys, improved in place
+     * @return Cost of the partition
+     */
+    double exchangeColumns(std::vector<Column>&       columns,
+                           const std::vector<int>&    capacities,
+                           const std::vector<double>& duals,
+                           const core::StopToken&     stop,
+                           std::vector<int>&          partition) const;
+
+    core::UnifiedSolution buildSolution(const std::vector<int>& blocks, double objective) const;
+
+    void log(const std::string& message) const;
+};
+
+} // namespace colgen
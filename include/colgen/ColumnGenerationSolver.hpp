@@ -0,0 +1,105 @@
+#pragma once
+
+#include "colgen/DagPricing.hpp"
+#include "colgen/MasterProblem.hpp"
+#include "core/ProgressListener.hpp"
+#include "core/StopToken.hpp"
+#include "core/UnifiedSolution.hpp"
+#include "data/DataLoader.hpp"
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace colgen {
+
+/**
+ * Column generation for the set-partitioning MDVSP formulation
+ *
+ * Every column is a complete vehicle block of one (depot, vehicle type) slot. The restricted
+ * master is seeded with the blocks of an initial solution and one single-journey block per
+ * journey, so it is always feasible. Each iteration solves the master relaxation, then prices
+ * all slots in parallel on the journey connection DAG and adds the negative reduced cost
+ * blocks. When pricing finds no more columns (or a limit is hit) the integer master over the
+ * generated columns yields a schedule, which a recombination of the columns with trimmed
+ * remainders (see BlockPool) then improves.
+ */
+class ColumnGenerationSolver {
+  public:
+    struct SolverConfig {
+        double timeLimit            = 60.0; // Total time limit in seconds
+        int    maxIterations        = 100;  // Master/pricing rounds
+        int    maxColumnsPerPricing = 20;   // Columns per slot and round
+        int    threads              = 0;    // Pricing threads (0 = all hardware threads)
+        int    maxWaitSeconds       = 0;    // Network arc filter (0 = keep all arcs)
+        bool   verbose              = false;
+
+        const network::Preprocessor* preprocessor = nullptr; // Safe arc reductions (optional)
+        core::StopToken              stop; // Deadline ends the rounds, requestStop() keeps the seed
+        core::ProgressListener*      progress = nullptr; // Bound per round, final schedule
+    };
+
+    /**
+     * Constructor
+     * @param dataLoader Loaded MDVSP data
+     * @param master Restricted master backend
+     */
+    ColumnGenerationSolver(const data::DataLoader&        dataLoader,
+                           std::unique_ptr<MasterProblem> master);
+
+    /**
+     * Run column generation
+     * @param initial Feasible solution used for seeding (may be empty)
+     * @param config Solver configuration
+     * @return Best solution found, the initial one if no better schedule was found
+     */
+    core::UnifiedSolution solve(const core::UnifiedSolution& initial, const SolverConfig& config);
+
+    /**
+     * Best lower bound proven in the last solve
+     */
+    double getLowerBound() const { return lowerBound_; }
+
+    int getIterations() const { return iterations_; }
+    int getNumColumns() const { return static_cast<int>(columns_.size()); }
+
+  private:
+    const data::DataLoader&        dataLoader_;
+    std::unique_ptr<MasterProblem> master_;
+    bool                           verbose_;
+
+    std::vector<Column>                        columns_;
+    std::set<std::pair<int, std::vector<int>>> columnKeys_; // (slot, journeys)
+    int                                        numVehicleTypes_;
+    std::vector<int>                           slotCapacities_;
+    std::vector<double>                        coverPrice_; // Cheapest single-journey block
+    double                                     lowerBound_;
+    int                                        iterations_;
+
+    /**
+     * Add columns not generated before to the pool and the master
+     * @return Number of new columns
+     */
+    int addColumns(std::vector<Column> candidates);
+
+    /**
+     * Complete a partial schedule by repeatedly pricing blocks over the uncovered journeys
+     * @param blocks Disjoint blocks, extended in place
+     * @return true if every journey is covered
+     */
+    bool completeCover(const DagPricer&     pricer,
+                       const SolverConfig&  config,
+                       std::vector<Column>& blocks) const;
+
+    /**
+     * Convert blocks to a unified solution
+     */
+    core::UnifiedSolution buildSolution(const network::ConnectionNetwork& network,
+                                        const std::vector<Column>&        blocks,
+                                        double                            objective) const;
+
+    void log(const std::string& message) const;
+};
+
+} // namespace colgen
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "colgen/MasterProblem.hpp"
+#include "network/ConnectionNetwork.hpp"
+#include <vector>
+
+namespace colgen {
+
+/**
+ * Pricing subproblem: shortest path on the journey connection DAG
+ *
+ * For one (depot, vehicle type) slot a block is a path depot -> j1 -> ... -> jn -> depot.
+ * Its reduced cost is the block cost minus the coverage duals of its journeys minus the
+ * slot capacity dual. As the network is acyclic and has no resources, a single pass in
+ * departure order finds the cheapest path ending at every journey.
+ *
+ * The pricer is stateless apart from the network reference, so several slots may be priced
+ * concurrently.
+ */
+class DagPricer {
+  public:
+    explicit DagPricer(const network::ConnectionNetwork& network);
+
+    /**
+     * Find columns with negative reduced cost for a slot
+     * @param depotIndex Dense depot index
+     * @param vehicleTypeIndex Dense vehicle type index
+     * @param coverageDuals Duals of the coverage rows per journey index
+     * @param capacityDual Dual of the slot capacity row (<= 0)
+     * @param maxColumns Maximum number of columns, one per distinct last journey
+     * @return Columns sorted by reduced cost, most negative first
+     */
+    std::vector<Column> price(int                        depotIndex,
+                              int                        vehicleTypeIndex,
+                              const std::vector<double>& coverageDuals,
+                              double                     capacityDual,
+                              int                        maxColumns) const;
+
+    /**
+     * Reduced cost of a column for given duals
+     */
+    static double reducedCost(const Column&              column,
+                              const std::vector<double>& coverageDuals,
+                              double                     capacityDual);
+
+  private:
+    const network::ConnectionNetwork& network_;
+};
+
+} // namespace colgen
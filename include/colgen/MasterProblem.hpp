@@ -0,0 +1,91 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace colgen {
+
+/**
+ * Column of the set-partitioning master: one feasible vehicle block
+ */
+struct Column {
+    int              depotIndex;       // Dense depot index
+    int              vehicleTypeIndex; // Dense vehicle type index
+    std::vector<int> journeys;         // Journey indices in driving order
+    double           cost;             // Block cost
+};
+
+/**
+ * Solution of the (restricted) master LP
+ */
+struct MasterSolution {
+    bool                solved;
+    double              objective;     // LP value, or Lagrangian value for dual methods
+    bool                exact;         // true if objective is the exact restricted LP optimum
+    std::vector<double> coverageDuals; // Per journey, free sign
+    std::vector<double> capacityDuals; // Per (depot, type) slot, <= 0
+};
+
+/**
+ * Integer solution of the restricted master
+ *
+ * If not feasible, columns may still hold a conflict-free partial schedule that respects
+ * the slot capacities; the caller may complete it.
+ */
+struct IntegerSolution {
+    bool             feasible;
+    double           objective;
+    std::vector<int> columns; // Indices in order of addColumns
+};
+
+/**
+ * Restricted master problem of the column generation
+ *
+ *   min  sum_k c_k x_k
+ *   s.t. sum_{k covers j} x_k = 1        for every journey j   (duals pi_j)
+ *        sum_{k in slot s} x_k <= cap_s  for every (depot, type) slot s (duals mu_s <= 0)
+ *        0 <= x_k <= 1
+ *
+ * Slots are numbered depotIndex * numVehicleTypes + vehicleTypeIndex.
+ */
+class MasterProblem {
+  public:
+    virtual ~MasterProblem() = default;
+
+    /**
+     * Set up rows
+     * @param numJourneys Number of coverage rows
+     * @param numVehicleTypes Number of vehicle types (slot stride)
+     * @param slotCapacities Capacity per (depot, type) slot
+     */
+    virtual void initialize(int                     numJourneys,
+                            int                     numVehicleTypes,
+                            const std::vector<int>& slotCapacities) = 0;
+
+    /**
+     * Append columns, they are numbered consecutively in call order
+     */
+    virtual void addColumns(const std::vector<Column>& columns) = 0;
+
+    /**
+     * Provide the objective of a known integer solution (used for step sizes and cutoffs)
+     */
+    virtual void setUpperBound(double upperBound) = 0;
+
+    /**
+     * Solve the LP relaxation and return duals for pricing
+     */
+    virtual MasterSolution solveRelaxation(double timeLimit) = 0;
+
+    /**
+     * Find an integer solution over the current columns
+     */
+    virtual IntegerSolution solveInteger(double timeLimit) = 0;
+
+    /**
+     * Human-readable backend name
+     */
+    virtual std::string getName() const = 0;
+};
+
+} // namespace colgen
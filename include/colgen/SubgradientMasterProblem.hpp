@@ -0,0 +1,77 @@
+#pragma once
+
+#include "colgen/MasterProblem.hpp"
+#include <vector>
+
+namespace colgen {
+
+/**
+ * License-free master problem based on Lagrangian relaxation
+ *
+ * The coverage rows are dualized; the remaining problem decomposes per (depot, type) slot
+ * into picking at most cap_s columns with negative reduced cost. Multipliers are updated
+ * with Polyak subgradient steps towards the known upper bound. A volume-style average of
+ * the subproblem solutions serves as primal guidance for the integer heuristic, which
+ * picks disjoint columns in several orders and returns the best partition, or the cheapest
+ * partial schedule per covered journey if none of the orders covers everything.
+ */
+class SubgradientMasterProblem : public MasterProblem {
+  public:
+    struct Parameters {
+        int    maxIterations     = 400;   // Subgradient steps per relaxation solve
+        double initialStepScale  = 1.0;   // Polyak step scale
+        int    stallIterations   = 25;    // Halve the step scale after this many
+        double minStepScale      = 1e-4;  // Stop below this scale
+        double primalAveraging   = 0.1;   // Weight of the newest subproblem solution
+    };
+
+    SubgradientMasterProblem();
+    explicit SubgradientMasterProblem(const Parameters& parameters);
+
+    void initialize(int                     numJourneys,
+                    int                     numVehicleTypes,
+                    const std::vector<int>& slotCapacities) override;
+    void addColumns(const std::vector<Column>& columns) override;
+    void setUpperBound(double upperBound) override { upperBound_ = upperBound; }
+
+    MasterSolution  solveRelaxation(double timeLimit) override;
+    IntegerSolution solveInteger(double timeLimit) override;
+
+    std::string getName() const override { return "subgradient"; }
+
+  private:
+    Parameters parameters_;
+
+    int              numJourneys_;
+    int              numVehicleTypes_;
+    std::vector<int> slotCapacities_;
+    double           upperBound_;
+
+    std::vector<Column> columns_;
+    std::vector<int>    columnSlot_;
+    std::vector<double> primalAverage_;
+
+    // Best multipliers so far (warm start for the next solve)
+    std::vector<double> coverageDuals_;
+    bool                dualsInitialized_;
+
+    /**
+     * Evaluate the Lagrangian function for multipliers
+     * @param duals Coverage multipliers
+     * @param chosen Receives 1 for columns in the subproblem solution
+     * @param capacityDuals Receives slot duals implied by binding capacities
+     * @return Lagrangian value (a lower bound on the restricted master)
+     */
+    double evaluate(const std::vector<double>& duals,
+                    std::vector<char>&         chosen,
+                    std::vector<double>&       capacityDuals) const;
+
+    double reducedCost(int column, const std::vector<double>& duals) const;
+
+    /**
+     * Greedy disjoint selection in the given column order
+     */
+    IntegerSolution selectColumns(const std::vector<int>& ordering) const;
+};
+
+} // namespace colgen
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "core/StopToken.hpp"
+#include "core/UnifiedSolution.hpp"
+#include "core/UnifiedSolutionDatabase.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace core {
+
+/**
+ * One instance of a batch: data directory and method
+ */
+struct BatchJob {
+    std::string dataPath;
+    std::string method;
+    std::string problemName; // Last component of the data path
+    double      timeLimit;   // Seconds
+    int         threads;     // Cores reserved while the job runs
+};
+
+/**
+ * Outcome of a batch job
+ */
+struct BatchResult {
+    BatchJob    job;
+    std::string status       = "PENDING"; // Solution status, "ERROR", or "STOPPED" (not started)
+    std::string algorithm;                // Algorithm that produced the solution
+    std::string error;                    // Message of a failed load or solve
+    double      objective    = 0.0;
+    int         vehicles     = 0;
+    double      wallSeconds  = 0.0; // Load and solve
+    int         solutionId   = -1;  // Database ID, -1 if not saved
+    bool        reused       = false; // Stored result of an identical run, not solved again
+};
+
+/**
+ * Batch solving of many instances on one machine
+ *
+ * Jobs start in manifest order once their thread budget fits into the free cores, so the
+ * machine is never oversubscribed. The first job that does not fit gets a reservation for
+ * the time enough cores will be free, with time limits as runtime bounds; later jobs may
+ * start ahead of it (e.g. greedy runs beside an exact run) only if they end before that
+ * time or use cores it leaves free (EASY backfilling), so the machine does not idle and
+ * large jobs are not starved.
+ *
+ * Each job loads and solves its own instance. Feasible solutions are saved through one
+ * writer thread that owns the database connection, so the jobs never wait for SQLite.
+ * With Config::reuseResults a job whose instance content, method and parameters match a
+ * stored result returns that result instead (see MDVSPSolver::SolverConfig::reuseDatabase).
+ *
+ * Once Config::stop is stopped (e.g. on SIGINT) no further job starts, running jobs return
+ * their best solution, and queued saves still get a few seconds to finish.
+ *
+ * Manifest: one job per line, "<data directory> <method> [time limit] [threads]", blank
+ * lines and lines starting with '#' are skipped.
+ */
+class BatchRunner {
+  public:
+    struct Config {
+        int         cores         = 0;     // Total thread budget (0 = all hardware threads)
+        int         exactThreads  = 4;     // Default budget of every job but greedy
+        double      timeLimit     = 300.0; // Default time limit per job in seconds
+        double      optimalityGap = 0.01;
+        bool        preprocess    = true;
+        std::string databasePath  = "/workspace/database/mdvsp_solutions.db"; // Empty = off
+        bool        warmStart     = false; // Start jobs from the best stored solution
+        bool        reuseResults  = false; // Skip jobs whose run already has a stored result
+        bool        verbose       = false;
+        StopToken   stop;                  // Cancels the batch (never by default)
+    };
+
+    explicit BatchRunner(const Config& config);
+
+    /**
+     * Read a manifest, filling in default time limits and thread budgets
+     * @throws std::runtime_error if the file cannot be read or a line is malformed
+     */
+    std::vector<BatchJob> readManifest(const std::string& manifestPath) const;
+
+    /**
+     * Solve all jobs and wait for the database writes
+     * @return Results in job order
+     */
+    std::vector<BatchResult> run(const std::vector<BatchJob>& jobs);
+
+    /**
+     * Completed instances per hour of wall time of the last run
+     */
+    double getThroughput() const { return throughput_; }
+
+  private:
+    struct PendingWrite {
+        int             resultIndex;
+        UnifiedSolution solution;
+        JourneyIdMap    journeyIds; // Of the job's data, the solver is gone when it is written
+    };
+
+    Config config_;
+    int    cores_;
+    double throughput_;
+
+    // Database writer queue
+    std::mutex               writeMutex_;
+    std::condition_variable  writeReady_;
+    std::deque<PendingWrite> writes_;
+    bool                     writesClosed_;
+    StopToken                writeStop_; // Bounds the saves left after a stop
+
+    void runJob(const BatchJob& job, int resultIndex, BatchResult& result);
+    void writerLoop(std::vector<BatchResult>& results);
+    // Shadow time and spare cores of a reservation for a job that does not fit yet
+    void reserve(const std::vector<BatchResult>& results,
+                 const std::vector<int>&         state,
+                 const std::vector<double>&      expectedEnd,
+                 int                             freeCores,
+                 size_t                          job,
+                 double&                         shadowTime,
+                 int&                            spareCores) const;
+    void printSummary(const std::vector<BatchResult>& results, double wallSeconds) const;
+
+    int defaultThreads(const std::string& method) const;
+
+    void log(const std::string& message) const;
+};
+
+} // namespace core
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "data/DataStructures.hpp"
+
+namespace core {
+
+/**
+ * Unit conversions of the MDVSP cost model
+ *
+ * Vehicle types price distance per 100 distance units (kmCost) and time per hour (hourCost),
+ * while distances and times in the data are given in raw units and seconds.
+ */
+struct StandardCostUnits {
+    static constexpr double kDistanceDivisor = 100.0;
+    static constexpr double kTimeDivisor     = 3600.0;
+};
+
+/**
+ * Operating cost rates of one vehicle type
+ */
+struct CostRates {
+    double vehicleCost;
+    double kmCost;
+    double hourCost;
+
+    CostRates() : vehicleCost(0.0), kmCost(0.0), hourCost(0.0) {}
+    explicit CostRates(const data::VehicleType& vehicleType)
+      : vehicleCost(vehicleType.vehicleCost),
+        kmCost(vehicleType.kmCost),
+        hourCost(vehicleType.hourCost) {}
+};
+
+/**
+ * Compile-time cost policy shared by all algorithms
+ *
+ * Single definition of the cost formula `kmCost * dist / 100 + hourCost * time / 3600`.
+ * The unit divisors are template constants, so every call site compiles down to a few
+ * multiply-adds without runtime unit handling.
+ */
+template <typename Units = StandardCostUnits>
+struct CostPolicy {
+    /**
+     * Cost of driving a distance over a duration
+     */
+    static constexpr double legCost(const CostRates& rates, double distance, int time) {
+        return rates.kmCost * distance / Units::kDistanceDivisor +
+               rates.hourCost * time / Units::kTimeDivisor;
+    }
+
+    /**
+     * Cost of a dead run; missing (negative) or zero-length dead runs are free
+     */
+    static constexpr double deadRunCost(const CostRates& rates, double distance, int time) {
+        return (distance > 0 && time > 0) ? legCost(rates, distance, time) : 0.0;
+    }
+
+    /**
+     * Cost of operating a service journey
+     */
+    static constexpr double serviceCost(const CostRates&            rates,
+                                        const data::ServiceJourney& journey) {
+        return legCost(rates, journey.distance, journey.arrTime - journey.depTime);
+    }
+};
+
+using DefaultCostPolicy = CostPolicy<StandardCostUnits>;
+
+} // namespace core
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "core/ProgressListener.hpp"
+#include <string>
+#include <vector>
+
+namespace core {
+
+/**
+ * Stores the events of a run in the solution database (unified_progress_events)
+ *
+ * Events are buffered and written in one transaction when the run finishes, so the solver
+ * never waits for SQLite and a run is stored completely or not at all.
+ */
+class DatabaseProgressSink : public ProgressSink {
+  public:
+    /**
+     * @param dbPath Path to the SQLite database file
+     * @param problemInstance Instance of the run
+     * @param method Solving method of the run
+     */
+    DatabaseProgressSink(const std::string& dbPath,
+                         const std::string& problemInstance,
+                         const std::string& method);
+
+    void onEvent(const ProgressEvent& event) override;
+    void finish() override;
+
+  private:
+    std::string                dbPath_;
+    std::string                problemInstance_;
+    std::string                method_;
+    std::vector<ProgressEvent> events_;
+};
+
+} // namespace core
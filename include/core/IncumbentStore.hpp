@@ -0,0 +1,58 @@
+#pragma once
+
+#include "core/UnifiedSolution.hpp"
+#include <atomic>
+#include <cstdint>
+
+namespace core {
+
+/**
+ * Best known solution shared by concurrently running engines, lock-free
+ *
+ * Published solutions are immutable snapshots. offer() links a snapshot into an ownership
+ * list and swings the incumbent pointer with compare-and-swap while the snapshot is better,
+ * so readers never wait and never see a partially written solution. Snapshots are only
+ * freed with the store; improvements are rare, so the memory is bounded in practice.
+ */
+class IncumbentStore {
+  public:
+    IncumbentStore() = default;
+    ~IncumbentStore();
+
+    IncumbentStore(const IncumbentStore&)            = delete;
+    IncumbentStore& operator=(const IncumbentStore&) = delete;
+
+    /**
+     * Publish a solution if it improves on the incumbent
+     * @param solution Feasible solution with its objective value
+     * @return true if it became the incumbent
+     */
+    bool offer(const UnifiedSolution& solution);
+
+    /**
+     * Objective of the incumbent, +infinity if there is none
+     */
+    double getObjective() const;
+
+    /**
+     * Incumbent snapshot, valid while the store lives, nullptr if there is none
+     */
+    const UnifiedSolution* get() const;
+
+    /**
+     * Number of improvements so far, to detect new incumbents cheaply
+     */
+    uint64_t getVersion() const { return version_.load(std::memory_order_acquire); }
+
+  private:
+    struct Snapshot {
+        UnifiedSolution solution;
+        Snapshot*       next; // Ownership list
+    };
+
+    std::atomic<Snapshot*> best_{nullptr};
+    std::atomic<Snapshot*> all_{nullptr};
+    std::atomic<uint64_t>  version_{0};
+};
+
+} // namespace core
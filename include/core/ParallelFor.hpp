@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+/**
+ * Resolve a thread count setting (0 = all hardware threads)
+ */
+inline int resolveThreadCount(int numThreads) {
+    if (numThreads > 0)
+        return numThreads;
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+/**
+ * Run body(i) for every i in [0, count) on up to numThreads threads
+ *
+ * Work is handed out one index at a time, so uneven tasks balance themselves. The calling
+ * thread takes part in the work. The body must not throw.
+ * @param count Number of tasks
+ * @param numThreads Maximum number of threads (0 = all hardware threads)
+ * @param body Callable taking the task index
+ */
+template <typename Body>
+void parallelFor(int count, int numThreads, Body&& body) {
+    int threads = std::min(resolveThreadCount(numThreads), count);
+    if (threads <= 1) {
+        for (int i = 0; i < count; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    std::atomic<int> next{0};
+    auto             worker = [&]() {
+        for (int i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            body(i);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (int t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+} // namespace core
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+/**
+ * One step of an anytime run
+ */
+struct ProgressEvent {
+    enum class Kind {
+        Phase,     // Engine started
+        Incumbent, // New best objective of the run
+        Bound      // New best lower bound of the run
+    };
+
+    Kind        kind;
+    double      seconds; // Since the listener was created
+    const char* engine;  // Static name, e.g. "greedy", "local_search", "lns", "exact"
+    double      value;   // Objective or bound, 0 for phases
+
+    static const char* kindName(Kind kind);
+};
+
+/**
+ * Consumer of progress events, called on the listener's dispatch thread only
+ */
+class ProgressSink {
+  public:
+    virtual ~ProgressSink() = default;
+
+    virtual void onEvent(const ProgressEvent& event) = 0;
+
+    /**
+     * After the last event of the run
+     */
+    virtual void finish() {}
+};
+
+/**
+ * Prints one line per event, e.g. "[Progress] 1.234s lns incumbent 8460213.17"
+ */
+class ConsoleProgressSink : public ProgressSink {
+  public:
+    void onEvent(const ProgressEvent& event) override;
+};
+
+/**
+ * Appends "run,seconds,kind,engine,value" rows to a CSV file, so the runs of several
+ * methods and instances in one file give time-to-target curves
+ */
+class CsvProgressSink : public ProgressSink {
+  public:
+    /**
+     * @param path CSV file, the header is written if the file is new
+     * @param run Label of the run, e.g. "<instance>/<method>"
+     */
+    CsvProgressSink(const std::string& path, const std::string& run);
+
+    void onEvent(const ProgressEvent& event) override;
+    void finish() override;
+
+  private:
+    std::ofstream csv_;
+    std::string   run_;
+};
+
+/**
+ * Solver-independent progress of one run
+ *
+ * Engines report phase starts, incumbents and bounds from any thread. A report only reads
+ * the clock and appends to a queue under a short lock, and only incumbents better (bounds
+ * higher) than the best so far become events, so the history is the anytime curve of the
+ * run. A dispatch thread hands the events to the sinks, so console, file and database
+ * output never run on a solver thread.
+ */
+class ProgressListener {
+  public:
+    /**
+     * Start the clock and the dispatch thread
+     */
+    ProgressListener();
+
+    /**
+     * Dispatch the remaining events and finish the sinks
+     */
+    ~ProgressListener();
+
+    ProgressListener(const ProgressListener&)            = delete;
+    ProgressListener& operator=(const ProgressListener&) = delete;
+
+    /**
+     * Add a sink; it receives the events reported from now on
+     */
+    void addSink(std::unique_ptr<ProgressSink> sink);
+
+    void phase(const char* engine);
+    void incumbent(const char* engine, double objective);
+    void bound(const char* engine, double bound);
+
+    /**
+     * Dispatch the remaining events, finish the sinks and stop the thread, idempotent.
+     * Reports after close() are kept in the history but reach no sink.
+     */
+    void close();
+
+    /**
+     * Events so far in report order
+     */
+    std::vector<ProgressEvent> getEvents() const;
+
+    /**
+     * Seconds until the first incumbent at or below the target, -1 if never reached
+     */
+    double timeToTarget(double target) const;
+
+  private:
+    std::chrono::steady_clock::time_point start_;
+
+    mutable std::mutex         mutex_;
+    std::condition_variable    ready_;
+    std::vector<ProgressEvent> pending_;
+    std::vector<ProgressEvent> history_;
+    double                     bestIncumbent_;
+    double                     bestBound_;
+    bool                       closing_;
+
+    std::mutex                                 sinkMutex_; // Sinks, held while dispatching
+    std::vector<std::unique_ptr<ProgressSink>> sinks_;
+    std::thread                                dispatcher_;
+
+    void report(ProgressEvent::Kind kind, const char* engine, double value);
+    void run();
+    void dispatch(const std::vector<ProgressEvent>& events);
+};
+
+} // namespace core
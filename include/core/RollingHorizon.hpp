@@ -0,0 +1,89 @@
+#pragma once
+
+#include "core/UnifiedSolution.hpp"
+#include "data/DataLoader.hpp"
+#include <memory>
+#include <vector>
+
+namespace core {
+
+/**
+ * Time window of the rolling horizon
+ */
+struct HorizonWindow {
+    int beginTime;    // First departure time of the window's new journeys
+    int endTime;      // Departure times before this belong to the window
+    int commitTime;   // Journeys departing before this are fixed after the window
+    int firstJourney; // Range of the window's journeys in departure order
+    int lastJourney;  // One past the last journey
+};
+
+/**
+ * Rolling-horizon decomposition of the day by departure time
+ *
+ * The day is cut into windows of windowSeconds that overlap by overlapSeconds. After a
+ * window is solved, the journeys departing before its commit time (the start of the overlap)
+ * are fixed; the rest are solved again in the next window.
+ *
+ * Fixed blocks are open at the boundary, as waiting is free and a vehicle can continue
+ * later. Every fixed block enters the next window as a start state: one journey covering the
+ * block from its first departure to its last arrival, pinned to the block's vehicle type.
+ * The window solver may extend it, chain two start states or pick another depot for it, and
+ * each window sees every vehicle of the day so far, so depot capacities stay exact.
+ *
+ * Usage: prepareWindow (thread safe, may run while the previous window solves), then
+ * addStartStates, solve, and commit with the solution in the window's journey indices.
+ */
+class RollingHorizon {
+  public:
+    /**
+     * Plan the windows
+     * @param dataLoader Loaded MDVSP data
+     * @param windowSeconds Window length
+     * @param overlapSeconds Overlap of consecutive windows, less than the window length
+     */
+    RollingHorizon(const data::DataLoader& dataLoader, int windowSeconds, int overlapSeconds);
+
+    const std::vector<HorizonWindow>& getWindows() const { return windows_; }
+    int getNumWindows() const { return static_cast<int>(windows_.size()); }
+
+    /**
+     * Data of a window with its new journeys only, in departure order
+     */
+    std::unique_ptr<data::DataLoader> prepareWindow(int window) const;
+
+    /**
+     * Append the fixed blocks as start states to prepared window data
+     */
+    void addStartStates(data::DataLoader& windowData) const;
+
+    /**
+     * Fix the blocks of a window solution up to the window's commit time
+     * @param window Window index, windows are committed in order
+     * @param solution Solution of the window data (after addStartStates)
+     */
+    void commit(int window, const UnifiedSolution& solution);
+
+    /**
+     * Append the stitched blocks with costs over the full data (journey indices)
+     */
+    void addBlocks(UnifiedSolution& solution) const;
+
+  private:
+    struct FixedBlock {
+        int              depotId;
+        int              vehicleTypeId;
+        std::vector<int> journeys; // Journey indices of the full data, in driving order
+    };
+
+    const data::DataLoader& dataLoader_;
+
+    std::vector<int>           order_;      // Journey indices by departure time
+    std::vector<HorizonWindow> windows_;
+    std::vector<FixedBlock>    fixed_;
+    int                        nextJourneyId_; // IDs of start state journeys start here
+
+    void evaluateBlock(VehicleBlock& block, data::JourneySpan blockJourneys) const;
+};
+
+} // namespace core
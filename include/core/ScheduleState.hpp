@@ -0,0 +1,138 @@
+#pragma once
+
+#include "data/DataLoader.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core {
+
+/**
+ * Mutable bookkeeping of a schedule under construction or repair
+ *
+ * Tracks which journeys are assigned (a bitset) and how many vehicles each (depot, vehicle
+ * type) slot uses against its capacity (a flat depot-major ledger). Journeys are whatever
+ * dense index the caller uses, e.g. journey indices or JourneyTable positions.
+ *
+ * Changes made while a checkpoint is open go to an undo log, so a tentative move is applied
+ * with the normal calls and rejected with rollback() at the cost of the entries it wrote.
+ * reset() clears everything in O(1): bitset words and slot counts carry the epoch they were
+ * last written in and read as empty in any other epoch, so restarts of a multi-start
+ * heuristic never clear or reallocate the arrays.
+ */
+class ScheduleState {
+  public:
+    using Checkpoint = size_t;
+
+    /**
+     * @param numJourneys Number of journey indices
+     * @param capacities Capacity per slot depot * numVehicleTypes + type
+     * @param numVehicleTypes Vehicle types per depot in the slot layout
+     */
+    ScheduleState(int numJourneys, std::vector<int> capacities, int numVehicleTypes);
+
+    /**
+     * State over the service journeys and depot capacities of the data
+     */
+    explicit ScheduleState(const data::DataLoader& dataLoader);
+
+    int getNumJourneys() const { return numJourneys_; }
+
+    // Assignment bitset
+    bool isAssigned(int journey) const {
+        return (word(journey >> 6) >> (journey & 63)) & 1;
+    }
+    int  getNumAssigned() const { return numAssigned_; }
+    bool allAssigned() const { return numAssigned_ == numJourneys_; }
+
+    /**
+     * Mark a journey assigned (no-op if it already is)
+     */
+    void assign(int journey);
+
+    /**
+     * Mark a journey unassigned (no-op if it is not)
+     */
+    void unassign(int journey);
+
+    // Slot capacity ledger
+    bool hasCapacity(int depotIndex, int vehicleTypeIndex) const {
+        int slot = depotIndex * numVehicleTypes_ + vehicleTypeIndex;
+        return used(slot) < capacity_[slot];
+    }
+    int getUsed(int depotIndex, int vehicleTypeIndex) const {
+        return used(depotIndex * numVehicleTypes_ + vehicleTypeIndex);
+    }
+    int getCapacity(int depotIndex, int vehicleTypeIndex) const {
+        return capacity_[depotIndex * numVehicleTypes_ + vehicleTypeIndex];
+    }
+
+    /**
+     * Book one vehicle of this type at the depot
+     */
+    void acquire(int depotIndex, int vehicleTypeIndex);
+
+    /**
+     * Release one vehicle of this type at the depot
+     */
+    void release(int depotIndex, int vehicleTypeIndex);
+
+    /**
+     * Open a checkpoint; changes are logged until it is rolled back or committed.
+     * Checkpoints nest, the log is dropped when the outermost one is committed.
+     */
+    Checkpoint checkpoint() {
+        ++openCheckpoints_;
+        return undoLog_.size();
+    }
+
+    /**
+     * Undo every change since the checkpoint and close it
+     */
+    void rollback(Checkpoint checkpoint);
+
+    /**
+     * Keep the changes since the checkpoint and close it
+     */
+    void commit(Checkpoint checkpoint);
+
+    /**
+     * Unassign all journeys and free all slots in O(1)
+     */
+    void reset();
+
+  private:
+    enum class Change : uint8_t { Assign, Unassign, Acquire, Release };
+
+    struct UndoEntry {
+        Change change;
+        int    index; // Journey or slot
+    };
+
+    int numJourneys_;
+    int numVehicleTypes_;
+    int numAssigned_;
+
+    // Epoch-stamped storage, an entry from an older epoch reads as zero
+    uint32_t              epoch_;
+    std::vector<uint64_t> words_;
+    std::vector<uint32_t> wordEpoch_;
+    std::vector<int>      capacity_;
+    std::vector<int>      used_;
+    std::vector<uint32_t> usedEpoch_;
+
+    std::vector<UndoEntry> undoLog_;
+    int                    openCheckpoints_;
+
+    uint64_t word(int w) const { return wordEpoch_[w] == epoch_ ? words_[w] : 0; }
+    int      used(int slot) const { return usedEpoch_[slot] == epoch_ ? used_[slot] : 0; }
+
+    uint64_t& touchWord(int w);
+    int&      touchUsed(int slot);
+
+    void setBit(int journey, bool value);
+    void addUsed(int slot, int delta);
+    void record(Change change, int index);
+};
+
+} // namespace core
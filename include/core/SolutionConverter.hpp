@@ -13,14 +13,14 @@ namespace core {
 class SolutionConverter {
   public:
     /**
-     * Convert greedy solution to unified format
+     * Convert greedy solution to unified format (an rvalue moves its journey array)
      */
-    static UnifiedSolution fromGreedySolution(const data::MDVSPGreedySolution& greedySolution);
+    static UnifiedSolution fromGreedySolution(data::MDVSPGreedySolution greedySolution);
 
     /**
-     * Convert unified solution back to greedy format
+     * Convert unified solution back to greedy format (an rvalue moves its journey array)
      */
-    static data::MDVSPGreedySolution toGreedySolution(const UnifiedSolution& unified);
+    static data::MDVSPGreedySolution toGreedySolution(UnifiedSolution unified);
 
     /**
      * Generate solver variables from unified solution for warm start
@@ -41,7 +41,7 @@ class SolutionConverter {
     /**
      * Format journey IDs to string representation
      */
-    static std::string formatJourneyIds(const std::vector<int>& journeyIds);
+    static std::string formatJourneyIds(data::JourneySpan journeyIds);
 };
 
 } // namespace core
@@ -15,14 +15,15 @@ class SolutionTransformer {
   public:
     /**
      * Transform greedy solution to unified format
-     * @param greedySolution The greedy solution to transform
+     * @param greedySolution The greedy solution to transform; pass an rvalue to move its
+     *                       journey array into the unified solution instead of copying it
      * @param dataLoader Data loader for context information
      * @param problemInstance Name of the problem instance
      * @return Unified solution
      */
-    static UnifiedSolution transform(const data::MDVSPGreedySolution& greedySolution,
-                                     const data::DataLoader&          dataLoader,
-                                     const std::string&               problemInstance = "unknown");
+    static UnifiedSolution transform(data::MDVSPGreedySolution greedySolution,
+                                     const data::DataLoader&   dataLoader,
+                                     const std::string&        problemInstance = "unknown");
 
     /**
      * Transform exact solution to unified format (for future use)
@@ -42,7 +43,8 @@ class SolutionTransformer {
     /**
      * Convert greedy blocks to unified vehicle blocks
      */
-    static std::vector<VehicleBlock> convertBlocks(const std::vector<data::VehicleBlock>& greedyBlocks);
+    static std::vector<VehicleBlock>
+    convertBlocks(const std::vector<data::VehicleBlock>& greedyBlocks);
 };
 
 } // namespace core
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "core/StopToken.hpp"
+#include "core/UnifiedSolution.hpp"
+#include "network/ConnectionNetwork.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace core {
+
+/**
+ * One broken rule of a solution
+ */
+struct Violation {
+    enum class Kind {
+        UnknownJourney,     // Journey index out of range
+        JourneyRange,       // Block's journey range lies outside the solution's journey array
+        DuplicateJourney,   // Journey served by more than one block (or twice in one)
+        UncoveredJourney,   // Journey served by no block
+        EmptyBlock,         // Block without journeys
+        UnknownDepot,       // Depot ID is no depot of the data
+        UnknownVehicleType, // Vehicle type ID is unknown
+        Incompatible,       // Vehicle type may not serve the journey
+        NoPullOut,          // No dead run from the depot to the first journey
+        Connection,         // Journey cannot be reached in time from its predecessor
+        Capacity,           // More blocks in a depot slot than its capacity
+        BlockCost,          // Block cost differs from the cost model
+        Objective           // Objective differs from the sum of block costs
+    };
+
+    Kind   kind;
+    int    block         = -1;  // Block position in the solution, -1 for solution-wide rules
+    int    position      = -1;  // Position of the journey in the block
+    int    journey       = -1;  // Journey index
+    int    depotId       = -1;  // Depot stop ID of depot and capacity rules
+    int    vehicleTypeId = -1;  // Vehicle type ID of vehicle type and capacity rules
+    double expected      = 0.0; // Recomputed value (costs, capacity)
+    double actual        = 0.0; // Value found in the solution
+
+    /**
+     * One-line description, e.g. "Connection: block 3, position 2, journey 41"
+     */
+    std::string describe() const;
+};
+
+/**
+ * Structured result of a validation
+ */
+struct ValidationReport {
+    std::vector<Violation> violations; // Block rules in block order, then solution-wide rules
+    double                 recomputedObjective = 0.0;
+    bool                   truncated           = false; // Stopped at Options::maxViolations
+    bool                   stopped             = false; // Options::stop ended the checks early
+
+    bool isValid() const { return violations.empty() && !stopped; }
+
+    /**
+     * Number of violations of one kind
+     */
+    int count(Violation::Kind kind) const;
+
+    /**
+     * Counts per kind, e.g. "2 Connection, 1 Capacity", or "valid" ("incomplete" if stopped)
+     */
+    std::string summary() const;
+};
+
+/**
+ * Full feasibility check of any UnifiedSolution (journey indices) against the instance
+ *
+ * Checks that every block's journey range lies in the solution's journey array, coverage
+ * (every journey exactly once), depot and vehicle type IDs, vehicle type compatibility, the
+ * pull-out dead run, the connection rule between consecutive journeys, depot slot
+ * capacities, and that block costs and the objective match the shared cost model of
+ * network::ConnectionNetwork.
+ *
+ * Blocks are checked in parallel. Coverage uses two atomic bitsets (seen, seen twice) and
+ * the per-block checks only read index arrays of the network, so a validation is a single
+ * pass over the journeys and cheap enough to run after every incumbent or local search
+ * pass in debug builds. The validator keeps no state between calls and is thread safe.
+ */
+class SolutionValidator {
+  public:
+    struct Options {
+        bool      checkCosts    = true; // Compare block costs and the objective
+        double    costTolerance = 1e-6; // Relative, at least this much absolute
+        int       threads       = 0;    // Threads over blocks (0 = all hardware threads)
+        size_t    maxViolations = 1000; // Stop collecting after this many (0 = all)
+        StopToken stop;                 // Skip the remaining blocks and rules once stopped
+    };
+
+    /**
+     * @param network Connection network of the instance the solution belongs to
+     */
+    explicit SolutionValidator(const network::ConnectionNetwork& network);
+
+    ValidationReport validate(const UnifiedSolution& solution) const;
+    ValidationReport validate(const UnifiedSolution& solution, const Options& options) const;
+
+    static const char* kindName(Violation::Kind kind);
+
+  private:
+    const network::ConnectionNetwork& network_;
+    std::vector<int>                  slotCapacity_; // Per slot depot * types + type
+
+    // Rules of one block; returns its slot (-1 if depot or type is unknown) and cost
+    int checkBlock(const VehicleBlock&     block,
+                   data::JourneySpan       journeys,
+                   int                     blockIdx,
+                   const Options&          options,
+                   std::vector<Violation>& out,
+                   double&                 cost) const;
+
+    static bool hasJourneyRange(const UnifiedSolution& solution, const VehicleBlock& block);
+    static bool costsDiffer(double expected, double actual, double tolerance);
+};
+
+} // namespace core
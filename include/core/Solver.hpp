@@ -1,7 +1,12 @@
 #pragma once
 
+#include "core/ProgressListener.hpp"
+#include "core/SolutionValidator.hpp"
+#include "core/StopToken.hpp"
 #include "core/UnifiedSolution.hpp"
 #include "data/DataLoader.hpp"
+#include "lagrange/LagrangianBound.hpp"
+#include "network/Preprocessor.hpp"
 #include <memory>
 #include <string>
 
@@ -15,6 +20,8 @@ namespace data {
 class DataLoader;
 }
 
+class GRBEnv;
+
 /**
  * MDVSP Solver with algorithm interoperability
  *
@@ -22,6 +29,9 @@ class DataLoader;
  * - Greedy heuristic (fast, good quality)
  * - Exact optimization (optimal, slower)
  * - Meta-heuristics (balanced)
+ * - Column generation (set partitioning, LP-guided)
+ * - Portfolio (greedy variants, local search and exact racing on shared incumbents)
+ * - Block pool (blocks of many greedy and local search runs recombined by set partitioning)
  *
  * Uses UnifiedSolution format for seamless algorithm integration
  * and warm start capabilities between different solving methods.
@@ -32,14 +42,48 @@ class MDVSPSolver {
      * Configuration for solver behavior
      */
     struct SolverConfig {
-        std::string method      = "greedy"; // "greedy", "exact", "meta"
-        double      timeLimit   = 60.0;     // Time limit in seconds
+        std::string method      = "greedy"; // "greedy", "exact", "meta", "colgen", "portfolio",
+                                            // "pool"
+        double      timeLimit   = 60.0;     // Wall-clock budget of the whole solve in seconds
         bool        verbose     = false;    // Enable detailed logging
         std::string problemName = "mdvsp";  // Problem instance name
 
         // Algorithm-specific parameters
         int    maxIterations = 1000; // For meta-heuristics
         double optimalityGap = 0.01; // For exact solver (1% gap)
+        int    threads       = 0;    // Worker threads (0 = all hardware threads)
+
+        // Exact solver extras
+        int         nodeHeuristicInterval = 0;  // Round node relaxations every N nodes (0 = off)
+        std::string telemetryFile         = ""; // Append progress samples as CSV (empty = off)
+
+        bool decompose = false; // Solve independent components concurrently and merge
+
+        // Block pool: stored blocks of this instance are pooled too (empty = off)
+        std::string poolDatabase = "";
+
+        // Start of meta, colgen, pool, portfolio and the exact warm start (journey indices of
+        // the loaded data, optional). Otherwise the best stored solution of problemName in
+        // warmStartDatabase is loaded, see loadStoredSolution() (empty = off).
+        const core::UnifiedSolution* initial           = nullptr;
+        std::string                  warmStartDatabase = "";
+
+        // The best stored result of a run on the same instance content with the same method,
+        // parameters and stored start is returned without solving, see getRunParameters()
+        // (empty = off; a start passed in initial is never matched)
+        std::string reuseDatabase = "";
+
+        // Rolling horizon by departure time (see core::RollingHorizon)
+        int rollingWindowSeconds  = 0;    // Window length (0 = solve the whole day at once)
+        int rollingOverlapSeconds = 3600; // Overlap, re-solved in the next window
+
+        // Cancellation (e.g. SIGINT): the solve returns its best solution once stopped. The
+        // time limit is applied as a child deadline, so the token may carry a longer one.
+        core::StopToken stop;
+
+        // Phase starts, incumbents and bounds of every engine, e.g. for time-to-target
+        // curves (optional, must outlive the solve)
+        core::ProgressListener* progress = nullptr;
     };
 
     MDVSPSolver();
@@ -48,9 +92,21 @@ class MDVSPSolver {
     /**
      * Load MDVSP problem from CSV data directory
      * @param dataPath Path to directory containing CSV files
+     * @param preprocess Apply the safe reductions of network::Preprocessor
+     * @param stop Abandon loading once stopped
+     * @return true if successful, false otherwise (also if stopped)
+     */
+    bool loadProblem(const std::string&     dataPath,
+                     bool                   preprocess = true,
+                     const core::StopToken& stop       = core::StopToken());
+
+    /**
+     * Use data that is already loaded (e.g. a subproblem of another instance)
+     * @param dataLoader Loaded MDVSP data
+     * @param preprocess Apply the safe reductions of network::Preprocessor
      * @return true if successful, false otherwise
      */
-    bool loadProblem(const std::string& dataPath);
+    bool loadProblem(std::unique_ptr<data::DataLoader> dataLoader, bool preprocess = true);
 
     /**
      * Solve the loaded problem with configuration
@@ -74,14 +130,90 @@ class MDVSPSolver {
     core::UnifiedSolution solveWithWarmStart(const core::UnifiedSolution& warmStart,
                                              const std::string&           targetMethod = "exact");
 
+    /**
+     * Best stored solution of the loaded data, or else the newest one stored under the
+     * instance name for other data, checked against the loaded data. A solution that no
+     * longer fits the data (changed journeys, depots, capacities or costs) is repaired with
+     * meta::LocalSearch::repair().
+     * @param databasePath Solution database
+     * @param problemInstance Instance name the solutions were saved with
+     * @param stop Skip the check once stopped (the solution is then not used)
+     * @return Re-costed feasible solution keeping the storedId of its row, empty if none is
+     *         stored or it cannot be repaired
+     */
+    core::UnifiedSolution loadStoredSolution(const std::string&     databasePath,
+                                             const std::string&     problemInstance,
+                                             const core::StopToken& stop = core::StopToken());
+
+    /**
+     * Compute a Lagrangian lower bound and the optimality gap of a solution
+     * @param solution Solution to rate (its objective is the upper bound)
+     * @param timeLimit Time limit in seconds
+     * @param verbose Log every multiplier update
+     * @return Bound result, lowerBound is -infinity if no problem is loaded
+     */
+    lagrange::BoundResult computeLowerBound(const core::UnifiedSolution& solution,
+                                            double                       timeLimit = 10.0,
+                                            bool                         verbose   = false);
+
+    /**
+     * Check feasibility and cost consistency of a solution with core::SolutionValidator
+     * @param solution Solution of the loaded problem (journey indices)
+     * @param stop Skip the remaining checks once stopped (the report is then incomplete)
+     * @return Violations, empty if the solution is valid
+     * @throws std::runtime_error if no problem is loaded
+     */
+    core::ValidationReport validateSolution(const core::UnifiedSolution& solution,
+                                            const core::StopToken& stop = core::StopToken()) const;
+
+    /**
+     * Share a started Gurobi environment with the exact solver instead of starting one per
+     * solve (e.g. a daemon keeps one per worker). Null starts a new one each time.
+     */
+    void setGurobiEnvironment(std::shared_ptr<GRBEnv> env) { gurobiEnv_ = std::move(env); }
+
+    /**
+     * Loaded (and preprocessed) data, nullptr before loadProblem()
+     */
+    const data::DataLoader* getDataLoader() const { return dataLoader_.get(); }
+
+    /**
+     * Content fingerprint of the loaded data before preprocessing (16 hex digits, see
+     * data::DataLoader::computeFingerprint()), stored with every solution of solve()
+     */
+    const std::string& getFingerprint() const { return fingerprint_; }
+
+    /**
+     * Method and every parameter of a configuration that changes the result, e.g.
+     * "method=meta time=60 gap=0.01 ... warmStart=12/9164287.560000", stored with every
+     * solution of solve(). The start solution is named by its database ID and objective.
+     */
+    std::string getRunParameters(const SolverConfig& config) const;
+
   private:
-    std::unique_ptr<data::DataLoader> dataLoader_;
-    bool                              problemLoaded_;
+    std::unique_ptr<data::DataLoader>      dataLoader_;
+    std::unique_ptr<network::Preprocessor> preprocessor_; // Null if preprocessing is off
+    bool                                   problemLoaded_;
+    std::string                            fingerprint_;
+    std::shared_ptr<GRBEnv>                gurobiEnv_; // Shared environment (optional)
 
     // Solving methods
+    core::UnifiedSolution solveWithMethod(const SolverConfig& config);
+    core::UnifiedSolution solveDecomposed(const SolverConfig& config);
+    core::UnifiedSolution solveRollingHorizon(const SolverConfig& config);
     core::UnifiedSolution solveGreedy(const SolverConfig& config);
     core::UnifiedSolution solveExact(const SolverConfig& config);
     core::UnifiedSolution solveMeta(const SolverConfig& config);
+    core::UnifiedSolution solveColumnGeneration(const SolverConfig& config);
+    core::UnifiedSolution solvePortfolio(const SolverConfig& config);
+    core::UnifiedSolution solveBlockPool(const SolverConfig& config);
+
+    // The configured start solution if feasible, otherwise a greedy one
+    core::UnifiedSolution startSolution(const SolverConfig& config);
+
+    // Stored result of an identical run, empty if none
+    core::UnifiedSolution loadStoredResult(const SolverConfig& config,
+                                           const std::string&  parameters);
 
     // Utility
     void logMessage(const std::string& message, bool verbose = false) const;
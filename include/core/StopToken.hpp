@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace core {
+
+/**
+ * Cooperative cancellation with a wall-clock deadline
+ *
+ * A token is stopped once its deadline passes, requestStop() was called on it, or any of
+ * its parents is stopped. Engines poll stopRequested() at controlled points (between files,
+ * every few journeys, between passes) and return the best result they have. child()
+ * derives a token for one phase: its deadline is capped by the parent's, and stopping it
+ * does not stop the parent, so a phase can be cut short without ending the whole solve.
+ *
+ * Tokens are cheap shared handles; copies observe and stop the same state. A default
+ * token never stops. All members are thread safe.
+ */
+class StopToken {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Token without deadline that only stops on request
+     */
+    StopToken();
+
+    /**
+     * Root token stopping after a time limit
+     * @param seconds Time limit from now
+     */
+    static StopToken withTimeLimit(double seconds);
+
+    /**
+     * Token of a phase, stopped by this token and after the given seconds
+     */
+    StopToken child(double seconds) const;
+
+    /**
+     * Token of a phase taking a share of the remaining time (e.g. 0.2 for a fifth)
+     */
+    StopToken share(double fraction) const;
+
+    /**
+     * Stop this token and every token derived from it
+     */
+    void requestStop() const;
+
+    bool stopRequested() const;
+
+    /**
+     * True if requestStop() was called on this token or a parent (e.g. on SIGINT), false if
+     * at most a deadline has passed
+     */
+    bool interrupted() const;
+
+    /**
+     * Seconds until the deadline, 0 once stopped, infinity without deadline
+     */
+    double remaining() const;
+
+    /**
+     * Stop the token on SIGINT (async-signal-safe). A second SIGINT terminates as usual.
+     */
+    static void stopOnInterrupt(const StopToken& token);
+
+  private:
+    struct State {
+        std::atomic<bool>      stopped{false};
+        Clock::time_point      deadline;
+        std::shared_ptr<State> parent;
+    };
+
+    std::shared_ptr<State> state_;
+
+    explicit StopToken(std::shared_ptr<State> state) : state_(std::move(state)) {}
+};
+
+} // namespace core
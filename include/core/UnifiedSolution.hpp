@@ -1,5 +1,6 @@
 #pragma once
 
+#include "data/JourneySpan.hpp"
 #include <string>
 #include <vector>
 
@@ -7,15 +8,19 @@ namespace core {
 
 /**
  * Unified vehicle block representation for all algorithms
+ *
+ * The service journeys are not stored in the block but as a range of the owning
+ * solution's flat journey array, see UnifiedSolution::journeysOf().
  */
 struct VehicleBlock {
-    int              blockNumber;   // Unique block ID within solution
-    int              depotId;       // Depot where vehicle starts/ends
-    int              vehicleTypeId; // Type of vehicle used
-    std::vector<int> journeyIds;    // Service journeys in order
-    double           totalCost;     // Total cost of this block
-    double           totalDistance; // Total distance (optional)
-    int              totalTime;     // Total time in seconds (optional)
+    int    blockNumber;   // Unique block ID within solution
+    int    depotId;       // Depot where vehicle starts/ends
+    int    vehicleTypeId; // Type of vehicle used
+    int    journeyOffset; // First journey in UnifiedSolution::journeys
+    int    journeyCount;  // Number of service journeys
+    double totalCost;     // Total cost of this block
+    double totalDistance; // Total distance (optional)
+    int    totalTime;     // Total time in seconds (optional)
 };
 
 /**
@@ -30,9 +35,13 @@ class UnifiedSolution {
     std::string status;              // "FEASIBLE", "OPTIMAL", "INFEASIBLE"
     std::string problemInstance;     // Problem instance name
     std::string timestamp;           // When solution was found
+    std::string instanceHash;        // Content fingerprint of the instance (empty = unknown)
+    std::string runParameters;       // Method and parameters of the run that found it
+    int         storedId;            // Database ID if loaded from a database, -1 otherwise
 
     // Solution data
-    std::vector<VehicleBlock> blocks; // Vehicle blocks (core logic)
+    std::vector<VehicleBlock> blocks;   // Vehicle blocks (core logic)
+    std::vector<int>          journeys; // Service journeys of all blocks, one range per block
 
     // Constructors
     UnifiedSolution();
@@ -41,6 +50,25 @@ class UnifiedSolution {
                     double             solutionTime,
                     const std::string& solutionStatus);
 
+    /**
+     * Service journeys of a block of this solution, in driving order
+     */
+    data::JourneySpan journeysOf(const VehicleBlock& block) const {
+        return data::JourneySpan(journeys.data() + block.journeyOffset, block.journeyCount);
+    }
+
+    /**
+     * Append a block; its journeys are copied to the end of the journey array
+     * @param blockJourneys Journeys of the block, not a span of this solution
+     * @return The stored block
+     */
+    VehicleBlock& addBlock(const VehicleBlock& block, data::JourneySpan blockJourneys);
+
+    /**
+     * Remove all blocks and their journeys
+     */
+    void clearBlocks();
+
     // Utility methods
     int  getNumVehicles() const { return static_cast<int>(blocks.size()); }
     int  getNumJourneys() const;
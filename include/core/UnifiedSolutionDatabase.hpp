@@ -1,12 +1,42 @@
 #pragma once
 
+#include "core/ProgressListener.hpp"
+#include "core/StopToken.hpp"
 #include "core/UnifiedSolution.hpp"
+#include "data/DataStructures.hpp"
 #include <SQLiteCpp/SQLiteCpp.h>
+#include <functional>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace core {
 
+/**
+ * Service journey IDs of the data a solution is built on, by journey index and back
+ *
+ * Stored blocks list journey IDs rather than indices: indices shift when journeys are added,
+ * removed or reordered, IDs keep naming the same journey.
+ */
+class JourneyIdMap {
+  public:
+    JourneyIdMap() = default;
+    explicit JourneyIdMap(const std::vector<data::ServiceJourney>& journeys);
+
+    int getId(int journeyIdx) const { return ids_[journeyIdx]; }
+
+    /**
+     * Journey index of a journey ID, -1 if the data has no such journey
+     */
+    int getIndex(int journeyId) const;
+
+    int size() const { return static_cast<int>(ids_.size()); }
+
+  private:
+    std::vector<int>             ids_;     // journey index -> journey ID
+    std::unordered_map<int, int> indices_; // journey ID -> journey index
+};
+
 /**
  * Modern database manager for unified solution format
  */
@@ -32,16 +62,76 @@ class UnifiedSolutionDatabase {
     /**
      * Save unified solution to database
      * @param solution The solution to save
-     * @return Solution ID if successful, -1 if failed
+     * @param journeyIds Journey IDs of the data the solution is built on; blocks are stored
+     *        with them
+     * @param stop Polled between blocks; once stopped the transaction is rolled back
+     * @return Solution ID if successful, -1 if failed or stopped
      */
-    int saveSolution(const UnifiedSolution& solution);
+    int saveSolution(const UnifiedSolution& solution,
+                     const JourneyIdMap&    journeyIds,
+                     const StopToken&       stop = StopToken());
+
+    /**
+     * Save the progress events of one run under a new run ID
+     * @param problemInstance Instance of the run
+     * @param method Solving method of the run
+     * @param events Events in report order
+     * @return Run ID if successful, -1 if failed
+     */
+    int saveProgress(const std::string&                problemInstance,
+                     const std::string&                method,
+                     const std::vector<ProgressEvent>& events);
+
+    /**
+     * Stream the blocks of every feasible stored solution of an instance, row by row, so
+     * millions of stored blocks never reside in memory at once
+     * @param instanceHash Content fingerprint of the instance; only solutions saved with it
+     *        are visited, as their blocks are used unchecked
+     * @param journeyIds Journey IDs of the loaded data, the journeys are passed as indices
+     * @param visit Called per block; the journeys are only valid during the call
+     * @return Number of blocks visited, -1 if failed
+     */
+    long forEachStoredBlock(
+        const std::string&                                                instanceHash,
+        const JourneyIdMap&                                               journeyIds,
+        const std::function<void(const VehicleBlock&, data::JourneySpan)>& visit);
 
     /**
      * Load solution by ID
+     *
+     * Stored journeys the data no longer has are dropped, blocks left without journeys too.
+     * Solutions saved before journey IDs were stored keep their journey indices.
      * @param solutionId Database ID of solution
+     * @param journeyIds Journey IDs of the loaded data
      * @return Unified solution or empty solution if not found
      */
-    UnifiedSolution loadSolution(int solutionId);
+    UnifiedSolution loadSolution(int solutionId, const JourneyIdMap& journeyIds);
+
+    /**
+     * Load the stored feasible solution of an instance with the lowest objective, or else the
+     * newest one saved under its name for other data (drifted or without fingerprint)
+     *
+     * A solution of other data keeps its instanceHash and must be validated before use.
+     * @param problemInstance Instance name the solutions were saved with
+     * @param instanceHash Content fingerprint of the instance (empty = by name only)
+     * @param journeyIds Journey IDs of the loaded data, see loadSolution()
+     * @return Solution with its blocks, or an empty solution if none is stored
+     */
+    UnifiedSolution loadBestSolution(const std::string&  problemInstance,
+                                     const std::string&  instanceHash,
+                                     const JourneyIdMap& journeyIds);
+
+    /**
+     * Load the best stored feasible result of a run on the same instance content with the
+     * same method and parameters
+     * @param instanceHash Content fingerprint of the instance
+     * @param runParameters Method and parameters of the run
+     * @param journeyIds Journey IDs of the loaded data, see loadSolution()
+     * @return Solution with its blocks, or an empty solution if none is stored
+     */
+    UnifiedSolution loadStoredResult(const std::string&  instanceHash,
+                                     const std::string&  runParameters,
+                                     const JourneyIdMap& journeyIds);
 
     /**
      * Load all solutions for specific algorithm
@@ -100,14 +190,28 @@ class UnifiedSolutionDatabase {
     void createTables();
 
     /**
-     * Save vehicle blocks for a solution
+     * Add a column to a table of an older database that lacks it
+     */
+    void addColumnIfMissing(const std::string& table,
+                            const std::string& column,
+                            const std::string& type);
+
+    /**
+     * Save vehicle blocks for a solution, with journey IDs
      */
-    bool saveVehicleBlocks(int solutionId, const std::vector<VehicleBlock>& blocks);
+    bool saveVehicleBlocks(int                    solutionId,
+                           const UnifiedSolution& solution,
+                           const JourneyIdMap&    journeyIds,
+                           const StopToken&       stop);
 
     /**
-     * Load vehicle blocks for a solution
+     * Append the vehicle blocks of a stored solution to a solution, in block order
+     * @param storedById Whether the blocks list journey IDs (otherwise journey indices)
      */
-    std::vector<VehicleBlock> loadVehicleBlocks(int solutionId);
+    bool loadVehicleBlocks(int                 solutionId,
+                           bool                storedById,
+                           const JourneyIdMap& journeyIds,
+                           UnifiedSolution&    solution);
 
     /**
      * Log helper methods
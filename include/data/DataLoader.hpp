@@ -1,9 +1,12 @@
 #pragma once
 
 #include "data/DataStructures.hpp"
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace data {
@@ -21,10 +24,16 @@ class DataLoader {
 
     /**
      * Load all data from CSV files
-     * @return true if successful, false otherwise
+     * @return true if successful, false otherwise (also if stopped)
      */
     bool loadAll();
 
+    /**
+     * Abandon loadAll() once the condition holds, polled between files and every few
+     * thousand lines of the large ones (e.g. a deadline or an interrupt)
+     */
+    void setStopCondition(std::function<bool()> stopped) { stopCondition_ = std::move(stopped); }
+
     /**
      * Get all service journeys
      */
@@ -33,12 +42,12 @@ class DataLoader {
     /**
      * Get all vehicle types
      */
-    const std::vector<VehicleType>& getVehicleTypes() const { return vehicleTypes_; }
+    const std::vector<VehicleType>& getVehicleTypes() const { return tables_->vehicleTypes; }
 
     /**
      * Get all stop points
      */
-    const std::vector<StopPoint>& getStopPoints() const { return stopPoints_; }
+    const std::vector<StopPoint>& getStopPoints() const { return tables_->stopPoints; }
 
     /**
      * Get all vehicle type groups
@@ -58,11 +67,58 @@ class DataLoader {
      */
     double getDeadRunDistance(int fromStop, int toStop) const;
 
+    /**
+     * Get dead run time between two dense stop indices (-1 if not found)
+     */
+    int getDeadRunTimeByIndex(int fromStopIndex, int toStopIndex) const {
+        size_t cell = static_cast<size_t>(fromStopIndex) * tables_->stopIds.size() + toStopIndex;
+        return tables_->deadRunTimeMatrix[cell];
+    }
+
+    /**
+     * Get dead run distance between two dense stop indices (-1 if not found)
+     */
+    double getDeadRunDistanceByIndex(int fromStopIndex, int toStopIndex) const {
+        size_t cell = static_cast<size_t>(fromStopIndex) * tables_->stopIds.size() + toStopIndex;
+        return tables_->deadRunDistanceMatrix[cell];
+    }
+
+    /**
+     * Row-major stop x stop dead run time matrix (getNumStopIndices() squared entries)
+     */
+    const int* getDeadRunTimeMatrix() const { return tables_->deadRunTimeMatrix.data(); }
+
+    /**
+     * Row-major stop x stop dead run distance matrix (getNumStopIndices() squared entries)
+     */
+    const double* getDeadRunDistanceMatrix() const { return tables_->deadRunDistanceMatrix.data(); }
+
     /**
      * Check if vehicle type is compatible with vehicle type group
      */
     bool isVehicleTypeCompatible(int vehicleTypeId, int vehicleTypeGroupId) const;
 
+    /**
+     * Check compatibility by dense vehicle type and vehicle type group index (bit test)
+     */
+    bool isVehicleTypeIndexCompatible(int vehicleTypeIndex, int vehicleTypeGroupIndex) const {
+        return (compatibilityBits_[static_cast<size_t>(vehicleTypeGroupIndex) * compatibilityWords_ +
+                                   (vehicleTypeIndex >> 6)] >>
+                (vehicleTypeIndex & 63)) &
+               1u;
+    }
+
+    /**
+     * Get dense index of a vehicle type group, -1 if unknown
+     */
+    int getVehicleTypeGroupIndex(int vehicleTypeGroupId) const;
+
+    /**
+     * Number of dense vehicle type group indices (rows of the compatibility matrix), including
+     * groups referenced only by journeys or mappings and groups added later
+     */
+    int getNumVehicleTypeGroupIndices() const { return static_cast<int>(groupIndexMap_.size()); }
+
     /**
      * Get vehicle types compatible with a vehicle type group
      */
@@ -71,13 +127,43 @@ class DataLoader {
     /**
      * Get depot stop points (stops with vehicle capacity > 0)
      */
-    std::vector<int> getDepotStops() const;
+    const std::vector<int>& getDepotStops() const { return depotStops_; }
+
+    /**
+     * Get dense index of a depot in getDepotStops(), -1 if the stop is no depot
+     */
+    int getDepotIndex(int stopId) const;
+
+    /**
+     * Get dense index of a stop (0..getNumStopIndices()-1), -1 if no journey or depot uses it
+     */
+    int getStopIndex(int stopId) const;
+
+    /**
+     * Number of dense stop indices (stops of service journeys and depots)
+     */
+    int getNumStopIndices() const { return static_cast<int>(tables_->stopIds.size()); }
+
+    /**
+     * Get stop ID for a dense stop index
+     */
+    int getStopIdByIndex(int stopIndex) const { return tables_->stopIds[stopIndex]; }
+
+    /**
+     * Get dense index of a vehicle type in getVehicleTypes(), -1 if unknown
+     */
+    int getVehicleTypeIndex(int vehicleTypeId) const;
 
     /**
      * Get vehicle capacity at a specific stop
      */
     int getVehicleCapacityAtStop(int vehicleTypeId, int stopId) const;
 
+    /**
+     * Override the vehicle capacity at a stop (used to apply preprocessing reductions)
+     */
+    void setVehicleCapacityAtStop(int vehicleTypeId, int stopId, int capacity);
+
     /**
      * Get stop point by ID
      */
@@ -88,30 +174,106 @@ class DataLoader {
      */
     const VehicleType* getVehicleType(int id) const;
 
+    /**
+     * Copy restricted to some service journeys and (depot, vehicle type) slots
+     *
+     * Stop, vehicle type, group and depot indices stay the same; slots not listed get
+     * capacity 0. Journey indices of the copy follow the order of journeyIndices. Stop, dead
+     * run and vehicle type tables are shared with this loader, not copied.
+     * @param journeyIndices Journey indices to keep
+     * @param slots (depot index, vehicle type index) pairs to keep
+     */
+    std::unique_ptr<DataLoader>
+    createSubproblem(const std::vector<int>&                 journeyIndices,
+                     const std::vector<std::pair<int, int>>& slots) const;
+
+    /**
+     * Add a vehicle type group (e.g. to pin journeys of a subproblem to one vehicle type)
+     * @param vehicleTypeIds Vehicle types serving the group
+     * @param code Code and name of the group
+     * @return ID of the new group
+     */
+    int addVehicleTypeGroup(const std::vector<int>& vehicleTypeIds, const std::string& code);
+
+    /**
+     * Append a service journey whose stops have an index and whose vehicle type group is known
+     */
+    void addServiceJourney(const ServiceJourney& journey);
+
     /**
      * Check if data is loaded successfully
      */
     bool isLoaded() const { return loaded_; }
 
+    /**
+     * Approximate heap memory of the loaded data and indices in bytes
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * Canonical 64-bit hash of the loaded content, one pass over all tables
+     *
+     * Hashes the parsed values, so number formatting, quoting and line endings of the CSV
+     * files do not change it. Every table is hashed with its rows in file order: the order
+     * defines the journey, depot and vehicle type indices of solutions, and the last of
+     * duplicate dead run or capacity rows wins.
+     */
+    uint64_t computeFingerprint() const;
+
+    /**
+     * computeFingerprint() as 16 hex digits, the instance hash stored with solutions
+     */
+    std::string computeFingerprintText() const;
+
   private:
-    std::string dataDirectory_;
-    bool        loaded_;
+    std::string           dataDirectory_;
+    bool                  loaded_;
+    std::function<bool()> stopCondition_;
+
+    /**
+     * Stop, dead run and vehicle type tables: fixed once loaded and shared by the copies of
+     * createSubproblem(), which only hold their own journeys, groups and capacities
+     */
+    struct SharedTables {
+        std::vector<VehicleType>             vehicleTypes;
+        std::vector<StopPoint>               stopPoints;
+        std::vector<DeadRunTime>             deadRuns;
+        std::unordered_map<int, StopPoint>   stopPointMap;
+        std::unordered_map<int, VehicleType> vehicleTypeMap;
+        std::vector<int>                     stopIds;             // stop index -> stop ID
+        std::unordered_map<int, int>         stopIndexMap;        // stop ID -> stop index
+        std::unordered_map<int, int>         vehicleTypeIndexMap; // vehicle type ID -> index
+
+        // Dense stop x stop dead run matrices over the indexed stops, -1 where no dead run
+        std::vector<int>    deadRunTimeMatrix;
+        std::vector<double> deadRunDistanceMatrix;
+    };
+
+    std::shared_ptr<SharedTables> tables_;
 
     // Data containers
     std::vector<ServiceJourney>        serviceJourneys_;
-    std::vector<VehicleType>           vehicleTypes_;
-    std::vector<StopPoint>             stopPoints_;
     std::vector<VehicleTypeGroup>      vehicleTypeGroups_;
     std::vector<VehicleCapacityAtStop> vehicleCapacities_;
     std::vector<VehicleTypeToGroup>    vehicleTypeToGroups_;
 
     // Fast lookup maps
-    std::unordered_map<std::string, int>      deadRunTimes_;     // "fromStop_toStop" -> time
-    std::unordered_map<std::string, double>   deadRunDistances_; // "fromStop_toStop" -> distance
     std::unordered_map<int, std::vector<int>> vehicleTypeToGroupMap_; // vehTypeGroup -> [vehTypes]
     std::unordered_map<std::string, int>      vehicleCapacityMap_;    // "vehType_stop" -> capacity
-    std::unordered_map<int, StopPoint>        stopPointMap_;
-    std::unordered_map<int, VehicleType>      vehicleTypeMap_;
+
+    // Dense indices for array-based lookups in the solvers
+    std::vector<int>             depotStops_;    // depot index -> stop ID
+    std::unordered_map<int, int> depotIndexMap_; // stop ID -> depot index
+    std::unordered_map<int, int> groupIndexMap_; // vehicle type group ID -> index
+
+    // Compatibility bitmatrix: one row of vehicle type bits per vehicle type group
+    std::vector<uint64_t> compatibilityBits_;
+    size_t                compatibilityWords_ = 0;
+
+    /**
+     * Copy sharing the tables of source, with only the given journeys
+     */
+    DataLoader(const DataLoader& source, const std::vector<int>& journeyIndices);
 
     // Loading methods
     bool loadServiceJourneys();
@@ -123,11 +285,16 @@ class DataLoader {
     bool loadVehicleTypeToGroups();
 
     // Helper methods
+    bool stopRequested() const { return stopCondition_ && stopCondition_(); }
+
     std::vector<std::string> parseCsvLine(const std::string& line);
     int                      timeStringToSeconds(const std::string& timeStr);
-    std::string              makeKey(int from, int to) const;
 
     void buildLookupMaps();
+    void buildDenseIndices();
+    void buildDeadRunMatrix();
+    void buildCompatibilityMatrix();
+    void addStopIndex(int stopId);
 };
 
 } // namespace data
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "data/JourneySpan.hpp"
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -126,17 +127,26 @@ struct VehicleTypeToGroup {
 
 /**
  * Represents a vehicle block/tour
+ *
+ * The journeys are a range of the owning solution's flat journey array.
  */
 struct VehicleBlock {
-    int              vehicleTypeId;
-    int              depotStopId;
-    std::vector<int> serviceJourneyIds;
-    double           totalCost;
-    double           totalDistance;
-    int              totalTime;
+    int    vehicleTypeId;
+    int    depotStopId;
+    int    journeyOffset; // First journey in MDVSPGreedySolution::journeys
+    int    journeyCount;
+    double totalCost;
+    double totalDistance;
+    int    totalTime;
 
     VehicleBlock()
-      : vehicleTypeId(-1), depotStopId(-1), totalCost(0.0), totalDistance(0.0), totalTime(0) {}
+      : vehicleTypeId(-1),
+        depotStopId(-1),
+        journeyOffset(0),
+        journeyCount(0),
+        totalCost(0.0),
+        totalDistance(0.0),
+        totalTime(0) {}
 };
 
 /**
@@ -144,6 +154,7 @@ struct VehicleBlock {
  */
 struct MDVSPGreedySolution {
     std::vector<VehicleBlock> blocks;
+    std::vector<int>          journeys; // Journey indices of all blocks, one range per block
     double                    totalObjectiveCost;
     int                       totalVehiclesUsed;
     bool                      isFeasible;
@@ -151,6 +162,13 @@ struct MDVSPGreedySolution {
 
     MDVSPGreedySolution()
       : totalObjectiveCost(0.0), totalVehiclesUsed(0), isFeasible(false), solutionTime(0.0) {}
+
+    /**
+     * Journeys of a block of this solution, in driving order
+     */
+    JourneySpan journeysOf(const VehicleBlock& block) const {
+        return JourneySpan(journeys.data() + block.journeyOffset, block.journeyCount);
+    }
 };
 
 } // namespace data
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace data {
+
+/**
+ * Read-only view of the journeys of one block inside a solution's flat journey array
+ *
+ * Solutions keep the journeys of all blocks in one contiguous vector, allocated once per
+ * solve, and every block only stores its offset and count into it. A span is the cheap way
+ * to hand one block's journeys to code that used to take a std::vector<int>. It is valid
+ * until the owning solution's journey vector is modified or destroyed.
+ */
+class JourneySpan {
+  public:
+    JourneySpan() : first_(nullptr), size_(0) {}
+    JourneySpan(const int* first, size_t size) : first_(first), size_(size) {}
+    JourneySpan(const std::vector<int>& journeys)
+      : first_(journeys.data()), size_(journeys.size()) {}
+
+    const int* begin() const { return first_; }
+    const int* end() const { return first_ + size_; }
+    const int* data() const { return first_; }
+
+    size_t size() const { return size_; }
+    bool   empty() const { return size_ == 0; }
+
+    int operator[](size_t k) const { return first_[k]; }
+    int front() const { return first_[0]; }
+    int back() const { return first_[size_ - 1]; }
+
+    std::vector<int> toVector() const { return std::vector<int>(begin(), end()); }
+
+  private:
+    const int* first_;
+    size_t     size_;
+};
+
+} // namespace data
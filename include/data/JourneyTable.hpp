@@ -0,0 +1,89 @@
+#pragma once
+
+#include "data/DataLoader.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace data {
+
+/**
+ * Immutable structure-of-arrays copy of the service journeys, sorted by departure time
+ *
+ * Rows are positions in departure order (ties by journey index, so the order is
+ * deterministic and a topological order of every connection DAG). Every column is a
+ * contiguous array of 32-bit values, except the distance, so a pass in departure order
+ * streams through a few small arrays instead of striding over ServiceJourney records.
+ * Stops and vehicle type groups are dense indices of the DataLoader.
+ *
+ * The table is a snapshot: journeys added to the DataLoader later are not in it.
+ */
+class JourneyTable {
+  public:
+    explicit JourneyTable(const DataLoader& dataLoader);
+
+    int size() const { return static_cast<int>(journeyIndex_.size()); }
+
+    // Columns by position
+    const int32_t* depTimes() const { return depTime_.data(); }
+    const int32_t* arrTimes() const { return arrTime_.data(); }
+    const int32_t* readyTimes() const { return readyTime_.data(); } // Arrival plus layover
+    const int32_t* fromStops() const { return fromStop_.data(); }
+    const int32_t* toStops() const { return toStop_.data(); }
+    const int32_t* groups() const { return group_.data(); }
+    const double*  distances() const { return distance_.data(); }
+
+    // Single values by position
+    int32_t depTime(int position) const { return depTime_[position]; }
+    int32_t arrTime(int position) const { return arrTime_[position]; }
+    int32_t readyTime(int position) const { return readyTime_[position]; }
+    int32_t fromStop(int position) const { return fromStop_[position]; }
+    int32_t toStop(int position) const { return toStop_[position]; }
+    int32_t group(int position) const { return group_[position]; }
+    double  distance(int position) const { return distance_[position]; }
+
+    /**
+     * Journey index in DataLoader::getServiceJourneys() of a position
+     */
+    int journeyIndex(int position) const { return journeyIndex_[position]; }
+
+    /**
+     * Journey ID of the data of a position
+     */
+    int journeyId(int position) const { return journeyId_[position]; }
+
+    /**
+     * Position of a journey index
+     */
+    int position(int journeyIdx) const { return position_[journeyIdx]; }
+
+    /**
+     * Journey indices in departure order
+     */
+    const std::vector<int32_t>& getOrder() const { return journeyIndex_; }
+
+    /**
+     * First position departing at or after a time (size() if none)
+     */
+    int lowerBound(int time) const;
+
+    /**
+     * Heap memory of the columns in bytes
+     */
+    size_t getMemoryUsage() const;
+
+  private:
+    std::vector<int32_t> depTime_;
+    std::vector<int32_t> arrTime_;
+    std::vector<int32_t> readyTime_;
+    std::vector<int32_t> fromStop_;
+    std::vector<int32_t> toStop_;
+    std::vector<int32_t> group_;
+    std::vector<double>  distance_;
+
+    std::vector<int32_t> journeyIndex_; // Position -> journey index
+    std::vector<int32_t> journeyId_;    // Position -> journey ID
+    std::vector<int32_t> position_;     // Journey index -> position
+};
+
+} // namespace data
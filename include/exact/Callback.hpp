@@ -1,10 +1,19 @@
 #pragma once
 
+#include "core/IncumbentStore.hpp"
+#include "core/ProgressListener.hpp"
+#include "core/StopToken.hpp"
+#include "exact/Telemetry.hpp"
+#include <cstdint>
 #include <string>
+#include <vector>
 #include "gurobi_c++.h"
 
 namespace exact {
 
+class NodeHeuristic;
+class TimeSpaceModel;
+
 /**
  * Callback handler for exact solver optimization
  */
@@ -35,13 +44,64 @@ class SolverCallback : public GRBCallback {
      */
     double getBestObjective() const { return bestObjective_; }
 
+    /**
+     * Share incumbents with other engines: better solutions of the store are injected as MIP
+     * starts at the next MIPNODE, and every new MIP incumbent is published to the store
+     * @param store Shared incumbent store
+     * @param model Time-space model of the optimized Gurobi model
+     */
+    void setIncumbentStore(core::IncumbentStore* store, const TimeSpaceModel* model);
+
+    /**
+     * Run an LP-guided heuristic: node relaxations go to the heuristic when it is due, and
+     * its improving solutions are injected as MIP starts at the next MIPNODE
+     * @param heuristic Heuristic with its own worker thread
+     * @param model Time-space model of the optimized Gurobi model
+     */
+    void setNodeHeuristic(NodeHeuristic* heuristic, const TimeSpaceModel* model);
+
+    /**
+     * Record progress samples (node count, bound, incumbent, gap, work) at the MIP callback
+     * @param telemetry Telemetry with its own consumer thread
+     */
+    void setTelemetry(SolverTelemetry* telemetry) { telemetry_ = telemetry; }
+
+    /**
+     * Abort the optimization once the token stops (e.g. another engine proved optimality)
+     */
+    void setStopToken(core::StopToken stop) { stop_ = std::move(stop); }
+
+    /**
+     * Report new incumbents and improved bounds (null = off)
+     */
+    void setProgress(core::ProgressListener* progress) { progress_ = progress; }
+
+    /**
+     * Number of store and heuristic solutions injected as MIP starts
+     */
+    int getInjectedCount() const { return injectedCount_; }
+
   private:
     bool   verbose_;
     int    solutionCount_;
     double bestObjective_;
 
+    core::IncumbentStore*    store_;
+    NodeHeuristic*           heuristic_;
+    SolverTelemetry*         telemetry_;
+    const TimeSpaceModel*    model_;
+    core::StopToken          stop_;
+    core::ProgressListener*  progress_;
+    double                   reportedBound_; // Last bound sent to progress_
+    std::vector<GRBVar>      vars_; // All model variables, for MIPSOL and node relaxations
+    uint64_t                 seenVersion_;
+    int                      injectedCount_;
+
+    void setModel(const TimeSpaceModel* model);
+    void handleMIP();
     void handleMIPSOL();
     void handleMIPNODE();
+    void injectSolution(const core::UnifiedSolution& solution, const std::string& source);
     void logMessage(const std::string& message) const;
 };
 
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "colgen/MasterProblem.hpp"
+#include <memory>
+#include <vector>
+#include "gurobi_c++.h"
+
+namespace exact {
+
+/**
+ * Restricted master problem of the column generation solved with Gurobi
+ *
+ * Columns are continuous variables in [0, 1] while the relaxation is solved. For the integer
+ * master they are switched to binaries, solved under a time limit and switched back, so
+ * further pricing rounds can continue on the same model.
+ *
+ * The constructor starts a Gurobi environment and throws GRBException if no license is
+ * available; callers fall back to a license-free master in that case.
+ */
+class GurobiMasterProblem : public colgen::MasterProblem {
+  public:
+    explicit GurobiMasterProblem(int threads = 0);
+
+    void initialize(int                     numJourneys,
+                    int                     numVehicleTypes,
+                    const std::vector<int>& slotCapacities) override;
+    void addColumns(const std::vector<colgen::Column>& columns) override;
+    void setUpperBound(double upperBound) override { upperBound_ = upperBound; }
+
+    colgen::MasterSolution  solveRelaxation(double timeLimit) override;
+    colgen::IntegerSolution solveInteger(double timeLimit) override;
+
+    std::string getName() const override { return "gurobi"; }
+
+  private:
+    std::unique_ptr<GRBEnv>   env_;
+    std::unique_ptr<GRBModel> model_;
+
+    int    numVehicleTypes_;
+    double upperBound_;
+
+    std::vector<GRBConstr> coverageRows_;
+    std::vector<GRBConstr> capacityRows_;
+    std::vector<GRBVar>    columnVars_;
+};
+
+} // namespace exact
@@ -1,10 +1,18 @@
 #pragma once
 
+#include "core/IncumbentStore.hpp"
+#include "core/ProgressListener.hpp"
+#include "core/StopToken.hpp"
 #include "core/UnifiedSolution.hpp"
 #include "exact/Callback.hpp"
 #include "exact/Config.hpp"
+#include "exact/NodeHeuristic.hpp"
+#include "exact/Telemetry.hpp"
+#include "exact/TimeSpaceModel.hpp"
+#include "network/ConnectionNetwork.hpp"
 #include <memory>
 #include <string>
+#include <vector>
 #include "gurobi_c++.h"
 
 namespace exact {
@@ -36,12 +44,29 @@ class GurobiSolver {
         // Model file discovery
         std::string modelDirectory  = "models"; // Directory to search for models
         std::string preferredFormat = ".lp";    // Preferred file format (.lp or .mps)
+
+        // In-process model (solveFromData)
+        bool        reduceNetwork         = true; // Aggregate events and prune dominated deadheads
+        std::string exportModelFile       = "";   // Write the built model to this file (LP/MPS)
+        int         nodeHeuristicInterval = 0;    // Round node relaxations every N nodes (0 = off)
+
+        // Telemetry (callback required), printed with verbose
+        double      telemetryInterval = 0.5; // Seconds between progress samples
+        std::string telemetryFile     = "";  // Append progress samples as CSV (empty = off)
+
+        // Portfolio racing (callback required)
+        core::IncumbentStore* incumbents = nullptr; // Shared incumbents (in-process model)
+        core::StopToken       stop;                 // Abort once stopped, caps the time limit
+
+        core::ProgressListener* progress = nullptr; // Incumbents and bounds (callback required)
     };
 
     /**
      * Constructor
+     * @param env Started Gurobi environment to share (e.g. kept by a daemon), a new one is
+     *            started if null. Models of one environment must not be solved concurrently.
      */
-    GurobiSolver();
+    explicit GurobiSolver(std::shared_ptr<GRBEnv> env = nullptr);
 
     /**
      * Destructor
@@ -56,6 +81,16 @@ class GurobiSolver {
      */
     core::UnifiedSolution solveFromFile(const std::string& filename, const SolverConfig& config);
 
+    /**
+     * Build the time-space network model from the loaded data and solve it, no model file
+     * needed. The optimal flow is decomposed into vehicle blocks.
+     * @param dataLoader Loaded MDVSP data
+     * @param config Solver configuration
+     * @return Unified solution
+     */
+    core::UnifiedSolution solveFromData(const data::DataLoader& dataLoader,
+                                        const SolverConfig&     config);
+
     /**
      * Solve with warm start from another solution
      * @param filename Path to model file
@@ -74,15 +109,28 @@ class GurobiSolver {
      */
     bool loadFromFile(const std::string& filename);
 
+    /**
+     * Progress samples of the last optimization (empty without callback)
+     */
+    const std::vector<TelemetrySample>& getTelemetry() const { return telemetrySamples_; }
+
   private:
-    std::unique_ptr<GRBEnv>             env_;
+    std::shared_ptr<GRBEnv>             env_;
     std::unique_ptr<GRBModel>           model_;
     std::unique_ptr<SolverCallback>     callback_;
     std::unique_ptr<SolverConfigurator> configurator_;
+    std::unique_ptr<TimeSpaceModel>     timeSpaceModel_; // Set while solving from data
+
+    // LP-guided heuristic (solving from data with nodeHeuristicInterval > 0)
+    std::unique_ptr<network::ConnectionNetwork> connectionNetwork_;
+    std::unique_ptr<NodeHeuristic>              nodeHeuristic_;
+
+    std::vector<TelemetrySample> telemetrySamples_;
 
     // Problem state
     bool problemBuilt_;
 
+    core::UnifiedSolution optimize(const SolverConfig& config);
     core::UnifiedSolution extractSolution();
     void                  setWarmStart(const core::UnifiedSolution& warmStart);
 
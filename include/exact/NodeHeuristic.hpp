@@ -0,0 +1,107 @@
+#pragma once
+
+#include "core/UnifiedSolution.hpp"
+#include "meta/LocalSearch.hpp"
+#include "network/ConnectionNetwork.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace exact {
+
+class TimeSpaceModel;
+
+/**
+ * LP-guided primal heuristic running beside branch-and-bound
+ *
+ * The callback hands over node relaxations. A worker thread rounds each one into vehicle
+ * blocks (TimeSpaceModel::roundBlocks), completes them (meta::LocalSearch::repair) and
+ * polishes them with local search. A result that beats the incumbent of its submission
+ * waits until the callback takes it. submit() and takeSolution() never wait for the worker:
+ * a relaxation that arrives while the worker is busy is not accepted.
+ */
+class NodeHeuristic {
+  public:
+    struct Config {
+        int    nodeInterval = 100; // Explored nodes between two relaxations
+        double minInterval  = 1.0; // Seconds between two relaxations
+        double polishTime   = 1.0; // Local search time per relaxation in seconds
+        bool   verbose      = false;
+    };
+
+    /**
+     * Start the worker thread
+     * @param model Time-space model the relaxations belong to
+     * @param network Connection network of the same instance
+     * @param config Heuristic configuration
+     */
+    NodeHeuristic(const TimeSpaceModel&             model,
+                  const network::ConnectionNetwork& network,
+                  const Config&                     config);
+
+    /**
+     * Stop and join the worker
+     */
+    ~NodeHeuristic();
+
+    NodeHeuristic(const NodeHeuristic&)            = delete;
+    NodeHeuristic& operator=(const NodeHeuristic&) = delete;
+
+    /**
+     * Check the rate limit: enough nodes and time since the last submission, worker idle.
+     * Called from the callback thread only.
+     * @param nodeCount Explored node count
+     */
+    bool isDue(double nodeCount) const;
+
+    /**
+     * Hand a node relaxation to the worker without waiting
+     * @param nodeCount Explored node count, for the rate limit
+     * @param relaxation Values of TimeSpaceModel::getVars()
+     * @param cutoff Objective a result has to beat
+     * @return true if the worker took the relaxation
+     */
+    bool submit(double nodeCount, std::vector<double> relaxation, double cutoff);
+
+    /**
+     * Take the pending improving solution without waiting
+     * @param solution Solution with journey indices (output)
+     * @return true if a solution was pending
+     */
+    bool takeSolution(core::UnifiedSolution& solution);
+
+    int getRoundCount() const { return roundCount_.load(std::memory_order_relaxed); }
+    int getImprovedCount() const { return improvedCount_.load(std::memory_order_relaxed); }
+
+  private:
+    const TimeSpaceModel&             model_;
+    const network::ConnectionNetwork& network_;
+    Config                            config_;
+
+    // Callback thread state for the rate limit
+    double                                lastNode_;
+    std::chrono::steady_clock::time_point lastTime_;
+
+    // Hand-over, guarded by mutex_
+    std::mutex              mutex_;
+    std::condition_variable wakeUp_;
+    std::vector<double>     relaxation_;
+    double                  cutoff_;
+    bool                    hasWork_;
+    bool                    hasSolution_;
+    bool                    shutdown_;
+    core::UnifiedSolution   solution_;
+
+    std::atomic<bool> busy_;
+    std::atomic<int>  roundCount_;
+    std::atomic<int>  improvedCount_;
+    std::thread       worker_;
+
+    void run();
+    void log(const std::string& message) const;
+};
+
+} // namespace exact
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace exact {
+
+/**
+ * Progress of the branch-and-bound at one point in time
+ */
+struct TelemetrySample {
+    double runtime;   // Seconds since the optimization started
+    double nodeCount; // Explored nodes
+    double objBound;  // Best bound
+    double objBest;   // Incumbent objective (GRB_INFINITY if none)
+    double gap;       // Relative gap, 1 if there is no incumbent
+    double work;      // Gurobi work units
+};
+
+/**
+ * Solver telemetry with a bounded cost for the callback
+ *
+ * The callback thread records samples at most every sample interval into a single-producer
+ * single-consumer ring buffer; isDue() and record() never lock and never allocate, a full
+ * ring drops the sample. A consumer thread drains the ring, keeps the history, prints a
+ * progress line every print interval and appends every sample to a CSV file if configured.
+ */
+class SolverTelemetry {
+  public:
+    struct Config {
+        double      sampleInterval = 0.5;   // Seconds between two samples
+        double      printInterval  = 5.0;   // Seconds between two progress lines
+        bool        print          = false; // Print progress lines
+        std::string csvFile        = "";    // Append samples to this file (empty = off)
+    };
+
+    /**
+     * Start the consumer thread
+     */
+    explicit SolverTelemetry(const Config& config);
+
+    /**
+     * Drain the ring and join the consumer
+     */
+    ~SolverTelemetry();
+
+    SolverTelemetry(const SolverTelemetry&)            = delete;
+    SolverTelemetry& operator=(const SolverTelemetry&) = delete;
+
+    /**
+     * Check if the next sample is due (producer thread only)
+     */
+    bool isDue() const { return std::chrono::steady_clock::now() >= nextSample_; }
+
+    /**
+     * Record a sample without waiting (producer thread only)
+     * @return false if the ring was full and the sample was dropped
+     */
+    bool record(const TelemetrySample& sample);
+
+    /**
+     * Drain the remaining samples and stop the consumer, idempotent
+     */
+    void stop();
+
+    /**
+     * Samples consumed so far
+     */
+    std::vector<TelemetrySample> getSamples() const;
+
+    /**
+     * Samples dropped because the ring was full
+     */
+    size_t getDropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+  private:
+    static constexpr size_t kRingSize = 1024; // Power of two
+
+    Config config_;
+
+    // Ring buffer, head_ written by the producer and tail_ by the consumer
+    std::array<TelemetrySample, kRingSize> ring_;
+    std::atomic<size_t>                    head_;
+    std::atomic<size_t>                    tail_;
+    std::atomic<size_t>                    dropped_;
+    std::chrono::steady_clock::time_point  nextSample_; // Producer only
+
+    // Consumer state
+    mutable std::mutex           historyMutex_;
+    std::vector<TelemetrySample> history_;
+    std::ofstream                csv_;
+    TelemetrySample              lastPrinted_;
+    std::atomic<bool>            running_;
+    std::thread                  consumer_;
+
+    void run();
+    void drain();
+    void print(const TelemetrySample& sample);
+};
+
+} // namespace exact
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "core/UnifiedSolution.hpp"
+#include "data/DataLoader.hpp"
+#include "network/TimeSpaceNetwork.hpp"
+#include <memory>
+#include <vector>
+#include "gurobi_c++.h"
+
+namespace exact {
+
+/**
+ * In-process MDVSP model on time-space networks (multi-commodity flow after Kliewer et al.)
+ *
+ * One commodity per (depot, vehicle type) with capacity. Each commodity is a flow over the
+ * time-space network of its vehicle type plus the pull-out and pull-in arcs of its depot.
+ * Names follow Model.md:
+ * - x_D{depot}V{type}S_T{trip}, x_D{depot}V{type}W_..., x_D{depot}V{type}DH_..., and
+ *   x_D{depot}V{type}D_... for the arcs
+ * - FlowCons_D{depot}V{type}_SP{stop}_N{node}, ServiceCoverage_T{trip}, Capacity_{id}
+ *
+ * Depots use their dense index, vehicle types, trips and stops their IDs.
+ */
+class TimeSpaceModel {
+  public:
+    /**
+     * Build the time-space networks of all vehicle types
+     * @param dataLoader Loaded MDVSP data
+     * @param options Network reductions
+     */
+    TimeSpaceModel(const data::DataLoader&                   dataLoader,
+                   const network::TimeSpaceNetwork::Options& options);
+    explicit TimeSpaceModel(const data::DataLoader& dataLoader);
+
+    /**
+     * Create the Gurobi model, the variable handles stay valid while it lives
+     */
+    std::unique_ptr<GRBModel> build(const GRBEnv& env);
+
+    /**
+     * Decompose the flow of the current solution of the built model into vehicle blocks
+     * (journey indices in driving order), appended to a solution
+     */
+    void extractBlocks(core::UnifiedSolution& solution) const;
+
+    /**
+     * Decompose a flow given as values of getVars(), e.g. a MIPSOL callback solution
+     */
+    void extractBlocks(const std::vector<double>& values, core::UnifiedSolution& solution) const;
+
+    /**
+     * Round a fractional flow (e.g. a node relaxation) into vehicle blocks. Vehicles are
+     * walked from the pull-out arc with the most flow left along the outgoing arc with the
+     * most flow left, skipping journeys already served; each walk takes one unit of flow.
+     * At most the depot capacity of vehicles per commodity, journeys may stay uncovered.
+     * Thread safe, only the networks are read.
+     * @param values Values of getVars()
+     * @param solution Receives the blocks (journey indices in driving order), costs along the
+     *                 network arcs
+     */
+    void roundBlocks(const std::vector<double>& values, core::UnifiedSolution& solution) const;
+
+    /**
+     * All variables of the built model, commodity by commodity
+     */
+    std::vector<GRBVar> getVars() const;
+
+    /**
+     * Partial MIP start from vehicle blocks: every service arc variable, 1 where a block of
+     * the commodity's (depot, vehicle type) serves the journey and 0 elsewhere. Gurobi
+     * completes the waiting, deadhead and depot arcs.
+     * @param solution Solution with vehicle blocks (journey indices)
+     * @param vars Service arc variables (output)
+     * @param values Start values (output)
+     */
+    void getServiceStart(const core::UnifiedSolution& solution,
+                         std::vector<GRBVar>&         vars,
+                         std::vector<double>&         values) const;
+
+    /**
+     * Model size summed over all commodities, with and without network reductions
+     */
+    const network::TimeSpaceSize& getSize() const { return size_; }
+    const network::TimeSpaceSize& getUnreducedSize() const { return unreducedSize_; }
+
+  private:
+    struct Commodity {
+        int                 depotIndex;
+        int                 vehicleTypeIndex;
+        int                 capacity;
+        std::vector<int>    arcs; // Arc indices in the network of the vehicle type
+        std::vector<GRBVar> vars; // One per arc
+    };
+
+    const data::DataLoader&                dataLoader_;
+    std::vector<network::TimeSpaceNetwork> networks_; // Per vehicle type index
+    std::vector<Commodity>                 commodities_;
+    network::TimeSpaceSize                 size_;
+    network::TimeSpaceSize                 unreducedSize_;
+};
+
+} // namespace exact
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "greedy/OpenBlockTails.hpp"
+#include <cstdint>
+
+namespace greedy {
+
+/**
+ * One service journey to be tested against all open blocks
+ */
+struct BlockScanQuery {
+    int32_t        depTime;            // Departure time of the journey
+    int32_t        fromStopIndex;      // Dense stop index where the journey starts
+    const int32_t* compatibleByType;   // Per vehicle type index: -1 if compatible, else 0
+    const double*  serviceCostByType;  // Per vehicle type index: cost of the journey itself
+};
+
+/**
+ * Instance-wide tables the kernels gather from
+ */
+struct BlockScanTables {
+    const int32_t* deadRunTime;     // Dense stop x stop matrix, -1 if missing
+    const double*  deadRunDistance; // Dense stop x stop matrix, -1 if missing
+    int32_t        numStops;
+    const double*  kmCostByType;
+    const double*  hourCostByType;
+};
+
+/**
+ * Cheapest feasible block for a journey
+ */
+struct BlockScanResult {
+    int    blockIdx; // -1 if no block can take the journey
+    double cost;     // Dead run plus service cost of the append
+};
+
+/**
+ * Batched feasibility and cost evaluation of one journey against all open blocks
+ *
+ * A block is feasible if its vehicle type serves the journey's group and
+ * readyTime + max(deadRunTime, 0) <= depTime. The cost is the dead run cost (only if
+ * distance and time are positive) plus the service cost, computed in the same order as
+ * core::DefaultCostPolicy so all kernels agree bit for bit. Ties go to the lowest index.
+ */
+using BlockScanKernel = BlockScanResult (*)(const OpenBlockTails&  tails,
+                                            const BlockScanQuery&  query,
+                                            const BlockScanTables& tables);
+
+/**
+ * Portable scalar kernel
+ */
+BlockScanResult scanBlocksScalar(const OpenBlockTails&  tails,
+                                 const BlockScanQuery&  query,
+                                 const BlockScanTables& tables);
+
+/**
+ * Select the widest kernel supported by the running CPU (AVX-512, AVX2 or scalar)
+ * @param name Receives the kernel name if not null
+ */
+BlockScanKernel selectBlockScanKernel(const char** name = nullptr);
+
+} // namespace greedy
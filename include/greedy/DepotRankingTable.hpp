@@ -0,0 +1,117 @@
+#pragma once
+
+#include "data/DataLoader.hpp"
+#include <vector>
+
+namespace greedy {
+
+/**
+ * Dead run between a depot and a stop (pull-out or pull-in)
+ */
+struct DepotLeg {
+    double distance; // -1 if no dead run exists
+    int    time;     // seconds, -1 if no dead run exists
+
+    bool exists() const { return distance >= 0 && time >= 0; }
+};
+
+/**
+ * Depot candidate for a (vehicle type, stop) pair
+ */
+struct DepotCandidate {
+    int      depotIndex; // Dense index into DataLoader::getDepotStops()
+    int      depotId;    // Stop ID of the depot
+    double   cost;       // Dead run cost for this vehicle type
+    DepotLeg leg;        // Underlying dead run
+};
+
+/**
+ * Precomputed depot rankings per (vehicle type, stop)
+ *
+ * For every vehicle type and stop the depots are stored as contiguous lists sorted
+ * ascending by dead run cost, once for pull-out (depot -> stop) and once for pull-in
+ * (stop -> depot). Depots without a dead run to/from the stop are left out. Ties keep
+ * the order of DataLoader::getDepotStops(), so the first candidate with free capacity
+ * is exactly the depot a linear scan over all depots would pick.
+ */
+class DepotRankingTable {
+  public:
+    /**
+     * Contiguous range of depot candidates
+     */
+    struct CandidateRange {
+        const DepotCandidate* first;
+        const DepotCandidate* last;
+
+        const DepotCandidate* begin() const { return first; }
+        const DepotCandidate* end() const { return last; }
+        bool                  empty() const { return first == last; }
+    };
+
+    /**
+     * Constructor
+     * @param dataLoader Loaded MDVSP data
+     */
+    explicit DepotRankingTable(const data::DataLoader& dataLoader);
+
+    /**
+     * Depots ranked by pull-out cost (depot -> stop)
+     */
+    CandidateRange pullOutCandidates(int vehicleTypeIndex, int stopIndex) const {
+        return range(pullOut_, pullOutOffsets_, vehicleTypeIndex, stopIndex);
+    }
+
+    /**
+     * Depots ranked by pull-in cost (stop -> depot)
+     */
+    CandidateRange pullInCandidates(int vehicleTypeIndex, int stopIndex) const {
+        return range(pullIn_, pullInOffsets_, vehicleTypeIndex, stopIndex);
+    }
+
+    /**
+     * Pull-out dead run from depot to stop
+     */
+    const DepotLeg& pullOutLeg(int depotIndex, int stopIndex) const {
+        return pullOutLegs_[depotIndex * numStops_ + stopIndex];
+    }
+
+    /**
+     * Pull-in dead run from stop to depot
+     */
+    const DepotLeg& pullInLeg(int depotIndex, int stopIndex) const {
+        return pullInLegs_[depotIndex * numStops_ + stopIndex];
+    }
+
+    int getNumDepots() const { return numDepots_; }
+    int getNumStops() const { return numStops_; }
+
+  private:
+    int numDepots_;
+    int numStops_;
+    int numVehicleTypes_;
+
+    // Flat depot x stop dead run matrices
+    std::vector<DepotLeg> pullOutLegs_;
+    std::vector<DepotLeg> pullInLegs_;
+
+    // Ranked candidates, (type, stop) -> [offsets[k], offsets[k + 1])
+    std::vector<DepotCandidate> pullOut_;
+    std::vector<DepotCandidate> pullIn_;
+    std::vector<int>            pullOutOffsets_;
+    std::vector<int>            pullInOffsets_;
+
+    CandidateRange range(const std::vector<DepotCandidate>& candidates,
+                         const std::vector<int>&            offsets,
+                         int                                vehicleTypeIndex,
+                         int                                stopIndex) const {
+        int key = vehicleTypeIndex * numStops_ + stopIndex;
+        return {candidates.data() + offsets[key], candidates.data() + offsets[key + 1]};
+    }
+
+    void buildRanking(const data::DataLoader&      dataLoader,
+                      const std::vector<DepotLeg>& legs,
+                      std::vector<DepotCandidate>& candidates,
+                      std::vector<int>&            offsets);
+};
+
+} // namespace greedy
@@ -1,8 +1,15 @@
 #pragma once
 
+#include "core/CostPolicy.hpp"
+#include "core/ScheduleState.hpp"
+#include "core/StopToken.hpp"
 #include "data/DataLoader.hpp"
 #include "data/DataStructures.hpp"
-#include <unordered_set>
+#include "data/JourneyTable.hpp"
+#include "greedy/BlockScanKernels.hpp"
+#include "greedy/DepotRankingTable.hpp"
+#include "greedy/OpenBlockTails.hpp"
+#include <functional>
 #include <vector>
 
 namespace greedy {
@@ -29,23 +36,91 @@ class GreedyMDVSPSolver {
      */
     data::MDVSPGreedySolution solve();
 
+    /**
+     * Start an online schedule; journeys are then assigned one at a time by dispatch(), which
+     * keeps the open block tails and capacity state between calls instead of re-solving
+     */
+    void beginDispatch();
+
+    /**
+     * Assign one released journey now. Journeys may be released in any order, a journey only
+     * joins a block whose last journey is ready before it departs.
+     * @param journeyIdx Journey index in DataLoader::getServiceJourneys()
+     * @return Index of the serving block, -1 if already assigned or no vehicle can take it
+     */
+    int dispatch(int journeyIdx);
+
+    /**
+     * Close the online schedule: add the pull-ins and pack the blocks
+     * @return Solution of the dispatched journeys, feasible if every dispatch succeeded
+     */
+    data::MDVSPGreedySolution finishDispatch();
+
     /**
      * Set verbosity level
      */
     void setVerbose(bool verbose) { verbose_ = verbose; }
 
+    /**
+     * Number of (journey, block) candidate pairs evaluated in the last solve
+     */
+    long long getCandidateEvaluations() const { return candidateEvaluations_; }
+
+    /**
+     * Diversify the journey order for portfolio variants: journeys departing within the same
+     * 5 minute bucket are processed in a seeded random order (0 = plain departure order)
+     */
+    void setOrderSeed(unsigned seed) { orderSeed_ = seed; }
+
+    /**
+     * Abort the construction once a lower bound on its final cost (every cost but the
+     * pull-ins) reaches the cutoff, e.g. the objective of a shared incumbent. The cutoff is
+     * polled every few journeys; an aborted solution is marked infeasible.
+     */
+    void setCutoff(std::function<double()> cutoff) { cutoff_ = std::move(cutoff); }
+
+    /**
+     * Abort the construction once the token stops, polled like the cutoff; an aborted
+     * solution is marked infeasible
+     */
+    void setStop(core::StopToken stop) { stop_ = std::move(stop); }
+
   private:
+    using Cost = core::DefaultCostPolicy;
+
     const data::DataLoader& dataLoader_;
     bool                    verbose_;
-
-    // Current solution state
+    long long               candidateEvaluations_;
+    unsigned                orderSeed_;
+    std::function<double()> cutoff_;
+    core::StopToken         stop_;
+    double                  costLowerBound_; // Cost of the construction without pull-ins
+
+    // Journey columns in departure order and per-type cost rates, resolved once
+    data::JourneyTable           journeys_;
+    std::vector<core::CostRates> costRates_;
+
+    // Block scan kernel and its gather tables
+    BlockScanKernel      scanKernel_;
+    const char*          scanKernelName_;
+    BlockScanTables      scanTables_;
+    std::vector<double>  kmCostByType_;
+    std::vector<double>  hourCostByType_;
+    std::vector<int32_t> compatibleByGroup_;  // group x type, -1 if compatible
+    std::vector<double>  serviceCostByType_;  // Scratch for the current journey
+
+    // Current solution state; journeys are packed into one array when the solve ends
     std::vector<data::VehicleBlock> currentBlocks_;
-    std::unordered_set<int>         assignedJourneys_;
+    OpenBlockTails                  blockTails_;      // Parallel to currentBlocks_
+    std::vector<int>                blockOfPosition_; // Valid where state_ has the position
+
+    // Online schedule: positions in release order and failed dispatches
+    std::vector<int> dispatchOrder_;
+    size_t           dispatchFailures_;
 
-    // Depot capacity tracking
-    std::unordered_map<int, std::unordered_map<int, int>> depotVehicleCount_; // depot ->
-                                                                              // vehicleType ->
-                                                                              // count
+    // Precomputed depot candidates, assigned positions and depot capacity tracking
+    DepotRankingTable   depotRanking_;
+    core::ScheduleState state_;
 
     /**
      * Initialize greedy algorithm
@@ -53,44 +128,53 @@ class GreedyMDVSPSolver {
     void initialize();
 
     /**
-     * Get sorted service journeys by departure time
+     * Journey table positions in processing order (departure order unless seeded)
      */
-    std::vector<int> getSortedJourneyIndices() const;
+    std::vector<int> getJourneyOrder() const;
 
     /**
      * Try to assign journey to existing vehicle block
-     * @param journeyIdx Index of journey in service journeys
+     * @param position Position of the journey in the journey table
      * @return true if successfully assigned, false otherwise
      */
-    bool tryAssignToExistingBlock(int journeyIdx);
+    bool tryAssignToExistingBlock(int position);
 
     /**
      * Create new vehicle block for journey
-     * @param journeyIdx Index of journey in service journeys
+     * @param position Position of the journey in the journey table
      * @return true if successfully created, false otherwise
      */
-    bool createNewBlock(int journeyIdx);
+    bool createNewBlock(int position);
 
     /**
-     * Check if journey can be appended to block
+     * Append journey (table position) to block
      */
-    bool canAppendJourney(const data::VehicleBlock& block, const data::ServiceJourney& journey) const;
+    void appendJourneyToBlock(int blockIdx, int position);
 
     /**
-     * Calculate cost of appending journey to block
+     * Add the pull-in from the last journey of every block back to its depot
      */
-    double calculateAppendCost(const data::VehicleBlock&   block,
-                               const data::ServiceJourney& journey) const;
+    void closeBlocks();
 
     /**
-     * Append journey to block
+     * Close the blocks and move them into the solution with its metrics
+     * @param order Positions in processing order, which is every block's driving order
      */
-    void appendJourneyToBlock(data::VehicleBlock& block, const data::ServiceJourney& journey);
+    void finishSolution(const std::vector<int>&    order,
+                        bool                       feasible,
+                        data::MDVSPGreedySolution& solution);
+
+    /**
+     * Lay out the journeys of all blocks in the solution's flat journey array
+     * @param order Positions in processing order, which is every block's driving order
+     */
+    void packJourneys(const std::vector<int>& order, data::MDVSPGreedySolution& solution) const;
 
     /**
      * Find best depot for starting a new block
+     * @return Ranked depot candidate with free capacity, nullptr if none
      */
-    int findBestDepot(const data::ServiceJourney& journey, int vehicleTypeId) const;
+    const DepotCandidate* findBestDepot(int position, int vehicleTypeIndex) const;
 
     /**
      * Check depot capacity constraints
@@ -108,19 +192,18 @@ class GreedyMDVSPSolver {
     double calculateBlockCost(const data::VehicleBlock& block) const;
 
     /**
-     * Get time for last service journey in block
-     */
-    int getBlockEndTime(const data::VehicleBlock& block) const;
-
-    /**
-     * Get end stop for last service journey in block
+     * Find best compatible vehicle type for journey
      */
-    int getBlockEndStop(const data::VehicleBlock& block) const;
+    int findBestVehicleType(const data::ServiceJourney& journey) const;
 
     /**
-     * Find best compatible vehicle type for journey
+     * Operating cost of the journey at a table position
      */
-    int findBestVehicleType(const data::ServiceJourney& journey) const;
+    double serviceCost(const core::CostRates& rates, int position) const {
+        return Cost::legCost(rates,
+                             journeys_.distance(position),
+                             journeys_.arrTime(position) - journeys_.depTime(position));
+    }
 
     /**
      * Log message if verbose mode is enabled
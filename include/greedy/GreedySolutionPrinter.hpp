@@ -43,7 +43,10 @@ class GreedySolutionPrinter {
     /**
      * Print vehicle block details
      */
-    void printBlock(const data::VehicleBlock& block, int blockId, std::ostream& out) const;
+    void printBlock(const data::VehicleBlock& block,
+                    data::JourneySpan         journeys,
+                    int                       blockId,
+                    std::ostream&             out) const;
 
     /**
      * Convert seconds to time string
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "data/DataLoader.hpp"
+#include "data/DataStructures.hpp"
+#include "greedy/GreedyMDVSPSolver.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace greedy {
+
+/**
+ * Online dispatch of journeys released one at a time
+ *
+ * Every released journey is assigned to a vehicle right away by the greedy assignment step
+ * (GreedyMDVSPSolver::dispatch), which keeps its open block tails, depot capacities and
+ * journey table between decisions, so a decision costs one batched block scan and never a
+ * re-solve. Released journeys must be journeys of the loaded instance, the feed decides
+ * when each one becomes known.
+ *
+ * Decision latencies are measured per journey against a fixed budget.
+ */
+class OnlineDispatcher {
+  public:
+    struct Decision {
+        int    journeyId;
+        int    blockIdx;      // -1 if unknown, already dispatched or no vehicle can take it
+        double latencyMicros;
+    };
+
+    struct Report {
+        size_t released   = 0;
+        size_t assigned   = 0;
+        size_t overBudget = 0;   // Decisions slower than the budget
+        double p50Micros  = 0.0;
+        double p99Micros  = 0.0;
+        double maxMicros  = 0.0;
+
+        data::MDVSPGreedySolution solution; // Online schedule of the released journeys
+
+        // Offline greedy over the same journeys (-1 if not compared)
+        int    offlineVehicles = -1;
+        double offlineCost     = 0.0;
+    };
+
+    /**
+     * Constructor
+     * @param dataLoader Loaded MDVSP data, the journeys that may be released
+     * @param latencyBudgetMicros Latency budget per decision in microseconds
+     */
+    OnlineDispatcher(const data::DataLoader& dataLoader, double latencyBudgetMicros);
+
+    /**
+     * Assign a released journey to a vehicle
+     * @param journeyId Journey ID of the data
+     */
+    Decision release(int journeyId);
+
+    /**
+     * Close the schedule and summarize the decisions
+     * @param compareOffline Also solve the released journeys with the offline greedy
+     */
+    Report finish(bool compareOffline);
+
+  private:
+    const data::DataLoader&      dataLoader_;
+    double                       latencyBudgetMicros_;
+    GreedyMDVSPSolver            solver_;
+    std::unordered_map<int, int> journeyIndexById_;
+
+    std::vector<int>    released_;  // Journey indices assigned, in release order
+    std::vector<double> latencies_; // Microseconds per decision
+};
+
+} // namespace greedy
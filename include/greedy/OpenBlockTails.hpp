@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace greedy {
+
+/**
+ * Structure-of-arrays view of the open blocks' last journeys
+ *
+ * One entry per block, in block order. The columns are contiguous 32-bit arrays so the
+ * block scan kernels can stream them with vector loads.
+ */
+class OpenBlockTails {
+  public:
+    /**
+     * Add a tail for a new block
+     * @param readyTime Arrival plus minimum layover of the block's last journey
+     * @param endStopIndex Dense stop index where the last journey ends
+     * @param vehicleTypeIndex Dense vehicle type index of the block
+     */
+    void push(int readyTime, int endStopIndex, int vehicleTypeIndex) {
+        readyTime_.push_back(readyTime);
+        endStopIndex_.push_back(endStopIndex);
+        vehicleTypeIndex_.push_back(vehicleTypeIndex);
+    }
+
+    /**
+     * Advance a block's tail after appending a journey
+     */
+    void advance(int blockIdx, int readyTime, int endStopIndex) {
+        readyTime_[blockIdx]    = readyTime;
+        endStopIndex_[blockIdx] = endStopIndex;
+    }
+
+    void clear() {
+        readyTime_.clear();
+        endStopIndex_.clear();
+        vehicleTypeIndex_.clear();
+    }
+
+    int size() const { return static_cast<int>(readyTime_.size()); }
+
+    const int32_t* readyTimes() const { return readyTime_.data(); }
+    const int32_t* endStopIndices() const { return endStopIndex_.data(); }
+    const int32_t* vehicleTypeIndices() const { return vehicleTypeIndex_.data(); }
+
+    int readyTime(int blockIdx) const { return readyTime_[blockIdx]; }
+    int endStopIndex(int blockIdx) const { return endStopIndex_[blockIdx]; }
+    int vehicleTypeIndex(int blockIdx) const { return vehicleTypeIndex_[blockIdx]; }
+
+  private:
+    std::vector<int32_t> readyTime_;
+    std::vector<int32_t> endStopIndex_;
+    std::vector<int32_t> vehicleTypeIndex_;
+};
+
+} // namespace greedy
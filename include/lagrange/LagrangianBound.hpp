@@ -0,0 +1,91 @@
+#pragma once
+
+#include "core/UnifiedSolution.hpp"
+#include "data/DataLoader.hpp"
+#include "lagrange/SlotFlowSubproblem.hpp"
+#include "network/ConnectionNetwork.hpp"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace lagrange {
+
+/**
+ * Lower bound and optimality gap of a solution
+ */
+struct BoundResult {
+    double lowerBound;   // Best Lagrangian bound (valid at any time)
+    double upperBound;   // Objective of the evaluated solution, infinity if none
+    double gap;          // (upperBound - lowerBound) / upperBound, infinity if no upper bound
+    int    iterations;   // Multiplier updates
+    double solutionTime; // Seconds
+};
+
+/**
+ * Lagrangian lower bound for the MDVSP without an external solver
+ *
+ * Relaxes the ServiceCoverage_T constraints of the model with multipliers pi_j. The rest
+ * decomposes into one min-cost flow per (depot, vehicle type) slot with the depot capacity
+ * as flow limit (see SlotFlowSubproblem), solved in parallel:
+ *
+ *   L(pi) = sum_j pi_j + sum_s F_s(pi) <= optimal cost   for every pi
+ *
+ * Multipliers follow Polyak subgradient steps towards the upper bound with step halving
+ * after stalls. Every L(pi) is a valid bound, so the best one is available at any time.
+ */
+class LagrangianBoundSolver {
+  public:
+    struct SolverConfig {
+        double timeLimit       = 10.0; // Seconds
+        int    maxIterations   = 200;  // Multiplier updates
+        int    threads         = 0;    // Subproblem threads (0 = all hardware threads)
+        int    stallIterations = 5;    // Halve the step scale after this many
+        double minStepScale    = 1e-3; // Stop below this scale
+        double targetGap       = 1e-4; // Stop at this relative gap
+        double deflection      = 0.5;  // Weight of the previous direction
+        bool   verbose         = false;
+    };
+
+    /**
+     * Called after every iteration with the iteration number and the best bound so far
+     */
+    using ProgressCallback = std::function<void(int iteration, double lowerBound)>;
+
+    /**
+     * Constructor, builds the connection network and the slot subproblems
+     * @param dataLoader Loaded MDVSP data
+     * @param threads Network build threads (0 = all hardware threads)
+     * @param preprocessor Optional safe arc reductions for the network
+     */
+    explicit LagrangianBoundSolver(const data::DataLoader&      dataLoader,
+                                   int                          threads      = 0,
+                                   const network::Preprocessor* preprocessor = nullptr);
+
+    /**
+     * Compute a lower bound and the gap of a solution
+     * @param solution Solution to evaluate, its objective is the upper bound (may be empty)
+     * @param config Solver configuration
+     * @param progress Optional per-iteration callback
+     */
+    BoundResult computeBound(const core::UnifiedSolution& solution,
+                             const SolverConfig&          config,
+                             const ProgressCallback&      progress = nullptr);
+
+    /**
+     * Multipliers of the best bound of the last run (per journey index)
+     */
+    const std::vector<double>& getMultipliers() const { return bestMultipliers_; }
+
+  private:
+    const data::DataLoader&                     dataLoader_;
+    std::unique_ptr<network::ConnectionNetwork> network_;
+    std::vector<SlotFlowSubproblem>             subproblems_;
+    std::vector<double>                         coverPrice_; // Cheapest single-journey block
+    std::vector<double>                         bestMultipliers_;
+    bool                                        verbose_;
+
+    void log(const std::string& message) const;
+};
+
+} // namespace lagrange
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "network/ConnectionNetwork.hpp"
+#include <chrono>
+#include <vector>
+
+namespace lagrange {
+
+/**
+ * Result of one slot subproblem
+ */
+struct SlotFlowResult {
+    double           value;        // Lower bound on the min-cost flow value (<= 0)
+    bool             exact;        // false if the deadline hit before the flow was optimal
+    int              flow;         // Number of vehicles in the flow
+    std::vector<int> usedJourneys; // Journey indices served by the flow
+};
+
+/**
+ * Lagrangian subproblem of one (depot, vehicle type) slot
+ *
+ * With the coverage rows relaxed, a slot may run up to cap vehicles over vertex-disjoint
+ * paths depot -> journeys -> depot. Journeys cost their service cost minus the multiplier,
+ * the remaining costs are the block cost model of the connection network. This is a
+ * min-cost flow on the node-split DAG, solved by successive shortest paths with Johnson
+ * potentials. The residual network is kept implicitly (successor and predecessor per
+ * journey), so no arc copies of the connection network are made.
+ *
+ * Each augmentation costs at least as much as the previous one (convexity of the flow
+ * cost in the flow value). If the deadline hits before the flow is optimal, the value is
+ * completed with the next path cost for the remaining capacity, which keeps it a valid
+ * lower bound.
+ */
+class SlotFlowSubproblem {
+  public:
+    /**
+     * Prepare a slot
+     * @param network Journey connection network
+     * @param depotIndex Dense depot index
+     * @param vehicleTypeIndex Dense vehicle type index
+     * @param capacity Maximum number of vehicles
+     */
+    SlotFlowSubproblem(const network::ConnectionNetwork& network,
+                       int                               depotIndex,
+                       int                               vehicleTypeIndex,
+                       int                               capacity);
+
+    /**
+     * Solve for the given multipliers
+     * @param multipliers Coverage multipliers per journey index
+     * @param deadline Stop augmenting after this point in time
+     */
+    SlotFlowResult solve(const std::vector<double>&            multipliers,
+                         std::chrono::steady_clock::time_point deadline) const;
+
+    int getCapacity() const { return capacity_; }
+
+  private:
+    const network::ConnectionNetwork& network_;
+    int                               depotIndex_;
+    int                               vehicleTypeIndex_;
+    int                               capacity_;
+
+    // Per node position, infinite if the arc does not exist for this slot
+    std::vector<double> startCost_; // Vehicle cost plus pull-out
+    std::vector<double> endCost_;   // Pull-in
+    std::vector<double> serviceCost_;
+    std::vector<char>   active_;    // Vehicle type may serve the journey
+};
+
+} // namespace lagrange
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "core/ProgressListener.hpp"
+#include "core/ScheduleState.hpp"
+#include "core/StopToken.hpp"
+#include "core/UnifiedSolution.hpp"
+#include "network/ConnectionNetwork.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace meta {
+
+/**
+ * Large neighbourhood search with exact repair
+ *
+ * Every round destroys a few related sets of blocks and rebuilds each one optimally. A
+ * neighbourhood is a set of blocks of one (depot, vehicle type) slot, chosen around a random
+ * block by one of three relations:
+ * - Time window: blocks with a journey departing near a journey of the seed block.
+ * - Slot: all blocks of the slot, the ones starting closest to the seed block first.
+ * - Line: blocks serving the line of a journey of the seed block.
+ *
+ * Within one slot, rebuilding the journeys of the destroyed blocks is a min-cost flow
+ * (the single-depot vehicle scheduling assignment), so it is solved exactly with up to the
+ * destroyed vehicles plus the slot's free capacity. Neighbourhoods of a round are solved
+ * concurrently on the current solution, then the improving ones are applied best first,
+ * skipping any that touch a block already changed in the round.
+ */
+class LargeNeighbourhoodSearch {
+  public:
+    struct SolverConfig {
+        double   timeLimit     = 10.0;  // Time limit in seconds
+        bool     verbose       = false;
+        int      threads       = 0;     // Neighbourhoods per round (0 = all hardware threads)
+        int      maxJourneys   = 150;   // Journeys per neighbourhood
+        int      windowSeconds = 3600;  // Half width of the time window relation
+        int      maxStall      = 100;   // Stop after this many rounds without improvement
+        unsigned seed          = 1;
+
+        core::StopToken stop; // Stop early once stopped (never by default)
+
+        core::ProgressListener* progress = nullptr; // Objective after improving rounds (optional)
+    };
+
+    /**
+     * Constructor
+     * @param network Connection network of the instance
+     */
+    explicit LargeNeighbourhoodSearch(const network::ConnectionNetwork& network);
+
+    /**
+     * Improve a solution until the time limit, the stall limit or the stop token
+     * @param start Feasible start solution (journey indices)
+     * @param config Search configuration
+     * @return Improved solution, re-costed with the network cost model
+     */
+    core::UnifiedSolution improve(const core::UnifiedSolution& start, const SolverConfig& config);
+
+    /**
+     * Neighbourhoods solved and applied in the last improve()
+     */
+    long long getNeighbourhoods() const { return neighbourhoods_; }
+    long long getImprovements() const { return improvements_; }
+
+  private:
+    enum class Relation { TimeWindow, Slot, Line };
+
+    struct Block {
+        int              depotIndex;
+        int              vehicleTypeIndex;
+        std::vector<int> journeys;
+        double           cost;
+    };
+
+    struct Neighbourhood {
+        Relation         relation;
+        int              depotIndex;
+        int              vehicleTypeIndex;
+        int              maxVehicles; // Destroyed blocks plus free slot capacity
+        std::vector<int> blocks;      // Indices into blocks_
+    };
+
+    struct Rebuild {
+        double             gain = 0.0; // Cost of the destroyed minus the rebuilt blocks
+        std::vector<Block> blocks;
+    };
+
+    const network::ConnectionNetwork& network_;
+    bool                              verbose_;
+    long long                         neighbourhoods_;
+    long long                         improvements_;
+
+    std::vector<Block>  blocks_;
+    core::ScheduleState state_; // Slot usage of blocks_
+
+    Neighbourhood select(Relation            relation,
+                         std::mt19937&       generator,
+                         const SolverConfig& config) const;
+    Rebuild       rebuild(const Neighbourhood& neighbourhood) const;
+    bool          apply(const Neighbourhood& neighbourhood, Rebuild& rebuilt);
+
+    core::UnifiedSolution buildSolution(const core::UnifiedSolution& start) const;
+
+    void log(const std::string& message) const;
+};
+
+} // namespace meta
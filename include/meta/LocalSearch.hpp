@@ -0,0 +1,95 @@
+#pragma once
+
+#include "core/ProgressListener.hpp"
+#include "core/ScheduleState.hpp"
+#include "core/StopToken.hpp"
+#include "core/UnifiedSolution.hpp"
+#include "network/ConnectionNetwork.hpp"
+#include <string>
+#include <vector>
+
+namespace meta {
+
+/**
+ * Local search over vehicle blocks
+ *
+ * First-improvement descent with two neighbourhoods, both keeping every journey covered:
+ * - Tail exchange (2-opt*): blocks a and b swap the journeys after a cut point each. A tail
+ *   may be empty, so one block can hand all its journeys to another and the vehicle is saved.
+ * - Slot change: a block moves to another (depot, vehicle type) slot with free capacity.
+ *
+ * Moves are rated with ConnectionNetwork::evaluateBlock, so the objective is exact under the
+ * shared cost model regardless of the algorithm that produced the start solution.
+ */
+class LocalSearch {
+  public:
+    struct SolverConfig {
+        double timeLimit = 10.0;  // Time limit in seconds
+        bool   verbose   = false;
+
+        core::StopToken stop; // Stop early once stopped (never by default)
+
+        core::ProgressListener* progress = nullptr; // Objective after improving passes (optional)
+    };
+
+    /**
+     * Constructor
+     * @param network Connection network of the instance
+     */
+    explicit LocalSearch(const network::ConnectionNetwork& network);
+
+    /**
+     * Re-cost a solution with the network cost model
+     * @return Copy with block costs and objective recomputed; FEASIBLE if every block is
+     *         feasible and every journey is covered exactly once, INFEASIBLE otherwise
+     */
+    core::UnifiedSolution evaluate(const core::UnifiedSolution& solution) const;
+
+    /**
+     * Improve a solution until no move improves, the time limit or the stop token
+     * @param start Start solution (journey indices)
+     * @param config Search configuration
+     * @return Improved solution, re-costed
+     */
+    core::UnifiedSolution improve(const core::UnifiedSolution& start, const SolverConfig& config);
+
+    /**
+     * Complete a partial solution (e.g. a rounded relaxation). Each block keeps the journeys
+     * it can still drive in order, blocks beyond the slot capacity are dissolved, then every
+     * uncovered journey is inserted where it adds the least cost, opening a vehicle in a
+     * free slot if no block can take it.
+     * @param partial Blocks (journey indices), journeys may be missing or served twice
+     * @return Re-costed solution, INFEASIBLE if some journey could not be placed
+     */
+    core::UnifiedSolution repair(const core::UnifiedSolution& partial) const;
+
+    /**
+     * Improving moves applied in the last improve()
+     */
+    long long getMoves() const { return moves_; }
+
+  private:
+    struct Block {
+        int              depotIndex;
+        int              vehicleTypeIndex;
+        std::vector<int> journeys;
+        double           cost;
+    };
+
+    const network::ConnectionNetwork& network_;
+    bool                              verbose_;
+    long long                         moves_;
+
+    std::vector<Block>  blocks_;
+    core::ScheduleState state_; // Slot usage of blocks_
+
+    bool tryTailExchange(int a, int b);
+    bool trySlotChange(int a);
+
+    core::UnifiedSolution buildSolution(const core::UnifiedSolution& start,
+                                        const std::vector<Block>&    blocks) const;
+
+    void log(const std::string& message) const;
+};
+
+} // namespace meta
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "core/CostPolicy.hpp"
+#include "data/DataLoader.hpp"
+#include "data/JourneySpan.hpp"
+#include "data/JourneyTable.hpp"
+#include <vector>
+
+namespace network {
+
+class Preprocessor;
+
+/**
+ * Cost and length of a vehicle block evaluated against the instance data
+ */
+struct BlockMetrics {
+    bool   feasible;
+    double cost;
+    double distance;
+    int    time;
+};
+
+/**
+ * Journey connection network (a DAG over service journeys)
+ *
+ * Nodes are the service journeys ordered by departure time, which is a topological order.
+ * An arc i -> j exists if a vehicle finishing i can still reach j in time:
+ * arr_i + minLayover_i + max(deadRun(to_i, from_j), 0) <= dep_j. This is the same
+ * connection rule the greedy heuristic applies. Vehicle type compatibility is a node
+ * property and is checked per subproblem, not stored on arcs.
+ *
+ * Costs follow the greedy block cost model: vehicle cost, pull-out (the dead run from depot
+ * to the first journey must exist), service journeys, dead runs between journeys and
+ * pull-in. Dead runs only cost when distance and time are positive.
+ */
+class ConnectionNetwork {
+  public:
+    struct Options {
+        int                 maxWaitSeconds = 0;       // Drop arcs with longer idle (0 = keep all)
+        int                 threads        = 0;       // Build threads (0 = all hardware threads)
+        const Preprocessor* preprocessor   = nullptr; // Drop arcs it proves useless
+    };
+
+    /**
+     * Build the network
+     * @param dataLoader Loaded MDVSP data
+     * @param options Build options
+     */
+    ConnectionNetwork(const data::DataLoader& dataLoader, const Options& options);
+    explicit ConnectionNetwork(const data::DataLoader& dataLoader);
+
+    const data::DataLoader& getDataLoader() const { return dataLoader_; }
+
+    /**
+     * Journey columns in departure order; positions of the table are positions of the DAG
+     */
+    const data::JourneyTable& getJourneyTable() const { return journeys_; }
+
+    int    getNumJourneys() const { return journeys_.size(); }
+    size_t getNumArcs() const { return predecessors_.size(); }
+
+    /**
+     * Connectable arcs dropped by the preprocessor
+     */
+    size_t getNumPrunedArcs() const { return prunedArcs_; }
+
+    /**
+     * Journey indices in departure order (topological order of the DAG)
+     */
+    const std::vector<int>& getOrder() const { return journeys_.getOrder(); }
+
+    /**
+     * Position of a journey in getOrder()
+     */
+    int getPosition(int journeyIdx) const { return journeys_.position(journeyIdx); }
+
+    /**
+     * Predecessor positions of the node at a position
+     */
+    const int* predecessorsBegin(int position) const {
+        return predecessors_.data() + predecessorOffsets_[position];
+    }
+    const int* predecessorsEnd(int position) const {
+        return predecessors_.data() + predecessorOffsets_[position + 1];
+    }
+
+    /**
+     * Check the connection rule between two journeys
+     */
+    bool canConnect(int fromJourney, int toJourney) const {
+        return connects(journeys_.position(fromJourney), journeys_.position(toJourney));
+    }
+
+    /**
+     * Check if a vehicle type may serve a journey
+     */
+    bool isCompatible(int vehicleTypeIndex, int journeyIdx) const {
+        return dataLoader_.isVehicleTypeIndexCompatible(
+            vehicleTypeIndex, journeys_.group(journeys_.position(journeyIdx)));
+    }
+
+    /**
+     * Check if a block of this depot may start with the journey (pull-out dead run exists)
+     */
+    bool hasPullOut(int depotIndex, int journeyIdx) const {
+        int fromStop = journeys_.fromStop(journeys_.position(journeyIdx));
+        return dataLoader_.getDeadRunTimeByIndex(depotStopIndex_[depotIndex], fromStop) >= 0 &&
+               dataLoader_.getDeadRunDistanceByIndex(depotStopIndex_[depotIndex], fromStop) >= 0;
+    }
+
+    double vehicleCost(int vehicleTypeIndex) const { return rates_[vehicleTypeIndex].vehicleCost; }
+    double pullOutCost(int vehicleTypeIndex, int depotIndex, int journeyIdx) const;
+    double pullInCost(int vehicleTypeIndex, int depotIndex, int journeyIdx) const;
+    double serviceCost(int vehicleTypeIndex, int journeyIdx) const;
+    double connectionCost(int vehicleTypeIndex, int fromJourney, int toJourney) const;
+
+    /**
+     * Evaluate a block (journey indices in driving order) with the greedy cost model
+     */
+    BlockMetrics
+    evaluateBlock(int depotIndex, int vehicleTypeIndex, data::JourneySpan journeys) const;
+
+    int getNumDepots() const { return static_cast<int>(depotStopIndex_.size()); }
+    int getNumVehicleTypes() const { return static_cast<int>(rates_.size()); }
+
+    /**
+     * Depot capacity for a vehicle type (dense indices)
+     */
+    int getCapacity(int depotIndex, int vehicleTypeIndex) const;
+
+  private:
+    using Cost = core::DefaultCostPolicy;
+
+    const data::DataLoader& dataLoader_;
+
+    // Journey columns by position in departure order
+    data::JourneyTable journeys_;
+
+    std::vector<int>             depotStopIndex_; // Depot index -> stop index
+    std::vector<core::CostRates> rates_;          // Per vehicle type index
+
+    // DAG in departure order, predecessors in CSR form
+    std::vector<int> predecessorOffsets_;
+    std::vector<int> predecessors_;
+    size_t           prunedArcs_ = 0;
+
+    // Connection rule between two positions
+    bool connects(int fromPosition, int toPosition) const;
+
+    double deadRunCost(int vehicleTypeIndex, int fromStopIndex, int toStopIndex) const;
+};
+
+} // namespace network
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "data/DataLoader.hpp"
+#include <utility>
+#include <vector>
+
+namespace network {
+
+/**
+ * Independent part of an MDVSP instance
+ */
+struct Component {
+    std::vector<int>                 journeys; // Journey indices, ascending
+    std::vector<std::pair<int, int>> slots;    // (depot index, vehicle type index) with capacity
+};
+
+/**
+ * Decomposition of an instance into independent subproblems
+ *
+ * A block uses one (depot, vehicle type) slot, starts with a journey reachable from the
+ * depot and continues over connections between journeys its type may serve. Connected
+ * components of the graph over journeys and slots with these links therefore never share
+ * a block or a capacity, and the optimal schedule is the union of the components' optima:
+ * - journey j and slot (d, t): t serves j, d has capacity for t and a pull-out to j
+ * - journeys i and j: connectable (connection network rule) with a common vehicle type
+ *   that has capacity at some depot
+ *
+ * Journeys of different operators (disjoint vehicle types) and depots with disjoint
+ * service regions end up in different components. Components are ordered by size,
+ * largest first.
+ */
+class Decomposition {
+  public:
+    /**
+     * Find the components
+     * @param dataLoader Loaded MDVSP data
+     */
+    explicit Decomposition(const data::DataLoader& dataLoader);
+
+    const std::vector<Component>& getComponents() const { return components_; }
+    int getNumComponents() const { return static_cast<int>(components_.size()); }
+
+  private:
+    std::vector<Component> components_;
+};
+
+} // namespace network
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "core/CostPolicy.hpp"
+#include "data/DataLoader.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace network {
+
+/**
+ * Reductions found by the preprocessor
+ */
+struct PreprocessStats {
+    int    unusableSlots       = 0;   // No compatible journey has a pull-out from the depot
+    int    dominatedSlots      = 0;   // Replaceable by a cheaper type with slack capacity
+    int    removedVehicleTypes = 0;   // Types left without any (depot, type) slot
+    double seconds             = 0.0; // Analysis time
+};
+
+/**
+ * Safe problem reductions on the loaded data
+ *
+ * Every reduction keeps at least one optimal schedule:
+ * - Unusable slots: a (depot, vehicle type) slot is dropped if no compatible journey has a
+ *   pull-out dead run from the depot, as no block of the slot can start.
+ * - Dominated slots: type A is dominated by type B if B serves every vehicle type group A
+ *   serves and no cost rate of B is higher. The slot (d, A) is dropped if some dominating B
+ *   has slack capacity at d, i.e. at least as many vehicles as B has compatible journeys.
+ *   Every A block of d can then run as a B block of d at no higher cost.
+ * - Connection arcs i -> j are dropped if the journeys have no vehicle type with a slot in
+ *   common, or if for every such slot with slack capacity the dead run costs more than
+ *   returning to the depot and pulling out a new vehicle (vehicle cost included) and no
+ *   slot without slack remains. Splitting the block there is always cheaper.
+ *
+ * Waiting is free in the cost model, so long waits never prove a connection useless and
+ * are kept (see ConnectionNetwork::Options::maxWaitSeconds for a heuristic filter).
+ *
+ * Slot reductions are applied to the data (capacity 0), so every algorithm sees them. Arc
+ * reductions apply to connection networks built with this preprocessor.
+ */
+class Preprocessor {
+  public:
+    /**
+     * Analyse the data
+     * @param dataLoader Loaded MDVSP data
+     * @param threads Analysis threads (0 = all hardware threads)
+     */
+    explicit Preprocessor(const data::DataLoader& dataLoader, int threads = 0);
+
+    /**
+     * Check if a slot was removed (dense indices)
+     */
+    bool isSlotRemoved(int depotIndex, int vehicleTypeIndex) const {
+        return removed_[depotIndex * numVehicleTypes_ + vehicleTypeIndex] != 0;
+    }
+
+    /**
+     * Set the capacity of all removed slots to 0
+     */
+    void apply(data::DataLoader& dataLoader) const;
+
+    /**
+     * Check if a connection arc may appear in an optimal schedule (journey indices)
+     */
+    bool keepArc(int fromJourney, int toJourney) const;
+
+    const PreprocessStats& getStats() const { return stats_; }
+
+  private:
+    using Cost = core::DefaultCostPolicy;
+
+    const data::DataLoader& dataLoader_;
+    int                     numVehicleTypes_;
+    int                     numDepots_;
+
+    std::vector<core::CostRates> rates_;          // Per vehicle type index
+    std::vector<int>             depotStopIndex_; // Depot index -> stop index
+    std::vector<char>            removed_;        // Per slot depot * types + type
+    std::vector<char>            active_;         // Per slot, capacity left after removal
+    std::vector<char>            slack_;          // Per slot, capacity can never bind
+
+    // Per journey: stops and a bit row of the vehicle types with a remaining slot
+    std::vector<int>      fromStopIndex_;
+    std::vector<int>      toStopIndex_;
+    std::vector<uint64_t> usableTypeBits_;
+    size_t                typeWords_;
+
+    PreprocessStats stats_;
+
+    double deadRunCost(int vehicleTypeIndex, int fromStopIndex, int toStopIndex) const;
+};
+
+} // namespace network
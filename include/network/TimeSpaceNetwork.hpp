@@ -0,0 +1,117 @@
+#pragma once
+
+#include "data/DataLoader.hpp"
+#include <vector>
+
+namespace network {
+
+/**
+ * Arc types of the time-space network (naming as in Model.md)
+ */
+enum class TimeSpaceArcType {
+    Service,  // S: service journey, departure node -> arrival node
+    Waiting,  // W: next node at the same stop
+    Deadhead, // DH: arrival node at one stop -> first reachable departure node at another
+    PullOut,  // D: depot -> first node of a stop
+    PullIn    // D: last node of a stop -> depot
+};
+
+/**
+ * Arc of the time-space network; depot arcs use -1 for the depot side
+ */
+struct TimeSpaceArc {
+    TimeSpaceArcType type;
+    int              fromNode;
+    int              toNode;
+    int              journeyIdx; // Service arcs only, -1 otherwise
+    int              depotIndex; // Depot arcs only, -1 otherwise
+    double           cost;       // Operating cost for the vehicle type (vehicle cost excluded)
+    double           distance;   // Driven distance (0 for waiting and free dead runs)
+    int              time;       // Driving time (0 for waiting and free dead runs)
+};
+
+/**
+ * Node of the time-space network: one or more events at a stop
+ */
+struct TimeSpaceNode {
+    int stopIndex;
+    int time; // Time of the first event in the node
+};
+
+/**
+ * Node and arc counts of a time-space network
+ */
+struct TimeSpaceSize {
+    size_t nodes        = 0;
+    size_t serviceArcs  = 0;
+    size_t waitingArcs  = 0;
+    size_t deadheadArcs = 0;
+    size_t depotArcs    = 0;
+
+    size_t arcs() const { return serviceArcs + waitingArcs + deadheadArcs + depotArcs; }
+
+    TimeSpaceSize& operator+=(const TimeSpaceSize& other);
+};
+
+/**
+ * Time-space network of one vehicle type following Kliewer et al.
+ *
+ * Every compatible service journey creates a departure event at its start stop and an
+ * arrival event at its end stop at arrival plus minimum layover. Events at a stop are linked
+ * by waiting arcs in time order. A deadhead arc leads from an arrival event to the first
+ * departure event at another stop that is reachable with the dead run, the same connection
+ * rule as the connection network (a missing dead run counts as free and immediate). Later
+ * departures are reached by waiting at the target stop. Depots connect to the first and last
+ * node of every stop, as waiting is free.
+ *
+ * Two reductions keep the network small without changing the set of feasible blocks:
+ * - Deadhead dominance: of several arrivals at stop a that reach the same departure at stop
+ *   b first, only the latest needs a deadhead arc; earlier ones wait for it at a. The arc
+ *   costs only depend on (a, b), so the dropped arcs are never cheaper.
+ * - Event aggregation: consecutive events at a stop share a node as long as no entry
+ *   (arrival, incoming deadhead) follows an exit (departure, outgoing deadhead), since every
+ *   entry can then reach every exit by waiting. Parallel deadheads between nodes collapse.
+ */
+class TimeSpaceNetwork {
+  public:
+    struct Options {
+        bool aggregateEvents         = true;
+        bool pruneDominatedDeadheads = true;
+    };
+
+    /**
+     * Build the network
+     * @param dataLoader Loaded MDVSP data
+     * @param vehicleTypeIndex Dense vehicle type index
+     * @param options Reductions to apply
+     */
+    TimeSpaceNetwork(const data::DataLoader& dataLoader,
+                     int                     vehicleTypeIndex,
+                     const Options&          options);
+    TimeSpaceNetwork(const data::DataLoader& dataLoader, int vehicleTypeIndex);
+
+    int getVehicleTypeIndex() const { return vehicleTypeIndex_; }
+
+    const std::vector<TimeSpaceNode>& getNodes() const { return nodes_; }
+    const std::vector<TimeSpaceArc>&  getArcs() const { return arcs_; }
+
+    /**
+     * Size of the built network
+     */
+    const TimeSpaceSize& getSize() const { return size_; }
+
+    /**
+     * Size without reductions: one node per event, one deadhead arc per arrival event and
+     * reachable stop
+     */
+    const TimeSpaceSize& getUnreducedSize() const { return unreducedSize_; }
+
+  private:
+    int                        vehicleTypeIndex_;
+    std::vector<TimeSpaceNode> nodes_;
+    std::vector<TimeSpaceArc>  arcs_;
+    TimeSpaceSize              size_;
+    TimeSpaceSize              unreducedSize_;
+};
+
+} // namespace network
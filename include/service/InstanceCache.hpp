@@ -0,0 +1,111 @@
+#pragma once
+
+#include "core/Solver.hpp"
+#include "core/UnifiedSolution.hpp"
+#include "network/ConnectionNetwork.hpp"
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace service {
+
+/**
+ * Loaded instance kept resident by the daemon
+ *
+ * Solves and repairs on one instance are serialized by its solve mutex; the solver and the
+ * connection network may only be used while holding it. The last solution is guarded by the
+ * state mutex, which is held only to read or publish it, so queries never wait for a solve.
+ */
+struct ResidentInstance {
+    std::string                                 path;
+    std::unique_ptr<MDVSPSolver>                solver;       // Loaded and preprocessed
+    std::unique_ptr<network::ConnectionNetwork> network;      // Built by the first repair request
+    std::unordered_map<int, int>                journeyIndex; // Journey ID -> index
+    core::UnifiedSolution                       lastSolution; // Journey indices
+    bool                                        hasSolution = false;
+    double                                      loadSeconds = 0.0;
+
+    std::mutex            solveMutex; // Solver and network
+    std::mutex            mutex;      // Last solution
+    std::atomic<size_t>   memoryBytes{0};
+    std::atomic<uint64_t> lastUse{0}; // Cache clock tick of the last acquire
+};
+
+/**
+ * Resident instances by data path with least-recently-used eviction under a memory budget
+ *
+ * A missing instance is loaded by the first request that asks for it; concurrent requests
+ * for the same path wait for that load instead of loading again. Eviction only drops the
+ * cache's reference, requests still holding the instance finish normally. The instance just
+ * acquired is never evicted, so one instance above the budget still works.
+ */
+class InstanceCache {
+  public:
+    struct Stats {
+        size_t   instances   = 0;
+        size_t   memoryBytes = 0;
+        uint64_t hits        = 0;
+        uint64_t misses      = 0;
+        uint64_t evictions   = 0;
+    };
+
+    /**
+     * @param memoryBudget Bytes of resident data before instances are evicted
+     * @param preprocess Apply the safe reductions of network::Preprocessor on load
+     */
+    InstanceCache(size_t memoryBudget, bool preprocess);
+
+    /**
+     * Get a resident instance, loading it on a miss
+     * @param path Data directory
+     * @param loaded Set to true if this call loaded the instance (output)
+     * @throws std::runtime_error if the data cannot be loaded
+     */
+    std::shared_ptr<ResidentInstance> acquire(const std::string& path, bool& loaded);
+
+    /**
+     * Get a resident instance without loading, nullptr if it is not resident
+     */
+    std::shared_ptr<ResidentInstance> find(const std::string& path);
+
+    /**
+     * Drop an instance, false if it was not resident
+     */
+    bool evict(const std::string& path);
+
+    /**
+     * Evict least recently used instances until the budget holds again, e.g. after an
+     * instance grew by a derived index
+     * @param keep Instance that must stay resident (optional)
+     */
+    void enforceBudget(const ResidentInstance* keep = nullptr);
+
+    Stats                    getStats() const;
+    std::vector<std::string> getPaths() const;
+    size_t                   getMemoryBudget() const { return memoryBudget_; }
+
+  private:
+    using Entry = std::shared_future<std::shared_ptr<ResidentInstance>>;
+
+    size_t memoryBudget_;
+    bool   preprocess_;
+
+    mutable std::mutex                     mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::atomic<uint64_t>                  clock_;
+    uint64_t                               hits_;
+    uint64_t                               misses_;
+    uint64_t                               evictions_;
+
+    std::shared_ptr<ResidentInstance> load(const std::string& path) const;
+
+    // Loaded instances of entries_, caller holds mutex_
+    std::vector<std::pair<std::string, std::shared_ptr<ResidentInstance>>> readyLocked() const;
+};
+
+} // namespace service
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace service {
+
+/**
+ * Minimal JSON value for the daemon protocol
+ *
+ * Covers what the requests and responses need: null, booleans, numbers (double), strings,
+ * arrays and objects with keys in insertion order. parse() throws std::invalid_argument on
+ * malformed input; dump() writes compact single-line JSON, so one message is one line.
+ */
+class JsonValue {
+  public:
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    JsonValue() : type_(Type::Null), bool_(false), number_(0.0) {}
+    JsonValue(bool value) : type_(Type::Bool), bool_(value), number_(0.0) {}
+    JsonValue(int value) : type_(Type::Number), bool_(false), number_(value) {}
+    JsonValue(double value) : type_(Type::Number), bool_(false), number_(value) {}
+    JsonValue(const char* value)
+      : type_(Type::String), bool_(false), number_(0.0), string_(value) {}
+    JsonValue(std::string value)
+      : type_(Type::String), bool_(false), number_(0.0), string_(std::move(value)) {}
+
+    static JsonValue array();
+    static JsonValue object();
+
+    /**
+     * Parse one JSON document
+     * @throws std::invalid_argument on syntax errors or trailing characters
+     */
+    static JsonValue parse(const std::string& text);
+
+    /**
+     * Compact JSON text without newlines
+     */
+    std::string dump() const;
+
+    Type getType() const { return type_; }
+    bool isNull() const { return type_ == Type::Null; }
+    bool isNumber() const { return type_ == Type::Number; }
+    bool isString() const { return type_ == Type::String; }
+    bool isArray() const { return type_ == Type::Array; }
+    bool isObject() const { return type_ == Type::Object; }
+
+    bool               asBool() const { return bool_; }
+    double             asNumber() const { return number_; }
+    const std::string& asString() const { return string_; }
+
+    /**
+     * Array elements (empty for other types)
+     */
+    const std::vector<JsonValue>& getItems() const { return items_; }
+
+    /**
+     * Append to an array
+     */
+    JsonValue& push(JsonValue value);
+
+    /**
+     * Set an object member, replacing an existing one
+     */
+    JsonValue& set(const std::string& key, JsonValue value);
+
+    /**
+     * Object member, nullptr if missing or not an object
+     */
+    const JsonValue* find(const std::string& key) const;
+
+    // Typed member lookups with defaults for missing members or wrong types
+    std::string getString(const std::string& key, const std::string& fallback = "") const;
+    double      getNumber(const std::string& key, double fallback = 0.0) const;
+    bool        getBool(const std::string& key, bool fallback = false) const;
+
+  private:
+    Type                                           type_;
+    bool                                           bool_;
+    double                                         number_;
+    std::string                                    string_;
+    std::vector<JsonValue>                         items_;
+    std::vector<std::pair<std::string, JsonValue>> members_;
+
+    void dump(std::string& out) const;
+};
+
+} // namespace service
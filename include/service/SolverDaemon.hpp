@@ -0,0 +1,126 @@
+#pragma once
+
+#include "core/StopToken.hpp"
+#include "service/InstanceCache.hpp"
+#include "service/Json.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class GRBEnv;
+
+namespace service {
+
+/**
+ * Long-running solver daemon on a Unix domain socket
+ *
+ * Clients send one JSON request per line and get one JSON response line per request, in
+ * completion order; a request's "id" is echoed to match them. Loaded instances (data,
+ * preprocessing, journey index, connection network) stay resident in an InstanceCache, and
+ * every worker keeps one started Gurobi environment, so only the first request on an
+ * instance pays for loading and no request pays for the Gurobi start.
+ *
+ * Requests ("op"):
+ * - load {instance}: make an instance resident
+ * - solve {instance, method, timeLimit, gap, threads, blocks}: solve with MDVSPSolver
+ * - repair {instance, blocks?, timeLimit}: complete and polish the given blocks (journey IDs)
+ *   or the last solution with meta::LocalSearch
+ * - query {instance, blocks}: resident state and last solution
+ * - evict {instance}, status, ping, shutdown
+ *
+ * Requests on one instance run one at a time, requests on different instances in parallel.
+ */
+class SolverDaemon {
+  public:
+    struct Config {
+        std::string socketPath   = "/tmp/mdvsp.sock";
+        int         workers      = 0;    // Worker threads (0 = all hardware threads)
+        size_t      memoryBudget = 4096; // Resident instance data in MB
+        bool        preprocess   = true; // Apply the safe reductions on load
+        bool        verbose      = false;
+    };
+
+    explicit SolverDaemon(const Config& config);
+    ~SolverDaemon();
+
+    SolverDaemon(const SolverDaemon&)            = delete;
+    SolverDaemon& operator=(const SolverDaemon&) = delete;
+
+    /**
+     * Serve until a shutdown request or requestStop()
+     * @return 0 on a clean shutdown, 1 if the socket could not be opened
+     */
+    int run();
+
+    /**
+     * Ask run() to return; async-signal-safe, so it may be called from a signal handler
+     */
+    void requestStop();
+
+    /**
+     * Handle one request without the socket (also used by the workers)
+     * @param request Parsed request
+     * @param env Started Gurobi environment (optional)
+     * @return Response with "ok" and either the result or "error"
+     */
+    JsonValue handle(const JsonValue& request, std::shared_ptr<GRBEnv> env = nullptr);
+
+  private:
+    struct Connection;
+    struct Job {
+        std::shared_ptr<Connection> connection;
+        std::string                 line;
+    };
+
+    Config        config_;
+    InstanceCache cache_;
+    int           numWorkers_;
+    int           listenFd_;
+    int           wakePipe_[2];
+
+    std::atomic<bool>     stopping_;
+    std::atomic<uint64_t> served_;
+    core::StopToken       shutdown_; // Stopped by requestStop(), solves in flight return early
+
+    mutable std::mutex       queueMutex_;
+    std::condition_variable  queueReady_;
+    std::deque<Job>          queue_;
+    std::vector<std::thread> workers_;
+
+    // One Gurobi environment for all workers; every model copies its parameters on creation
+    std::mutex              envMutex_;
+    std::shared_ptr<GRBEnv> env_;
+    bool                    envTried_;
+
+    bool openSocket();
+    void serve();
+    void workerLoop();
+
+    /**
+     * Resident Gurobi environment, started by the first request that needs it
+     * @return nullptr if Gurobi is not available
+     */
+    std::shared_ptr<GRBEnv> gurobiEnvironment();
+
+    JsonValue handleLoad(const JsonValue& request);
+    JsonValue handleSolve(const JsonValue& request, std::shared_ptr<GRBEnv> env);
+    JsonValue handleRepair(const JsonValue& request);
+    JsonValue handleQuery(const JsonValue& request);
+    JsonValue handleStatus() const;
+
+    std::shared_ptr<ResidentInstance> acquire(const JsonValue& request, bool& loaded);
+
+    static JsonValue instanceInfo(const ResidentInstance& instance);
+    static JsonValue solutionInfo(const ResidentInstance&      instance,
+                                  const core::UnifiedSolution& solution,
+                                  bool                         withBlocks);
+
+    void log(const std::string& message) const;
+};
+
+} // namespace service
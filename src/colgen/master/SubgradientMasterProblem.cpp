@@ -0,0 +1,265 @@
+#include "colgen/SubgradientMasterProblem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace colgen {
+
+SubgradientMasterProblem::SubgradientMasterProblem()
+  : SubgradientMasterProblem(Parameters()) {}
+
+SubgradientMasterProblem::SubgradientMasterProblem(const Parameters& parameters)
+  : parameters_(parameters),
+    numJourneys_(0),
+    numVehicleTypes_(0),
+    upperBound_(std::numeric_limits<double>::infinity()),
+    dualsInitialized_(false) {}
+
+void SubgradientMasterProblem::initialize(int                     numJourneys,
+                                          int                     numVehicleTypes,
+                                          const std::vector<int>& slotCapacities) {
+    numJourneys_      = numJourneys;
+    numVehicleTypes_  = numVehicleTypes;
+    slotCapacities_   = slotCapacities;
+    dualsInitialized_ = false;
+    columns_.clear();
+    columnSlot_.clear();
+    primalAverage_.clear();
+    coverageDuals_.assign(numJourneys_, 0.0);
+}
+
+void SubgradientMasterProblem::addColumns(const std::vector<Column>& columns) {
+    for (const auto& column : columns) {
+        columns_.push_back(column);
+        columnSlot_.push_back(column.depotIndex * numVehicleTypes_ + column.vehicleTypeIndex);
+        primalAverage_.push_back(0.0);
+    }
+}
+
+double SubgradientMasterProblem::reducedCost(int column, const std::vector<double>& duals) const {
+    double value = columns_[column].cost;
+    for (int journey : columns_[column].journeys) {
+        value -= duals[journey];
+    }
+    return value;
+}
+
+double SubgradientMasterProblem::evaluate(const std::vector<double>& duals,
+                                          std::vector<char>&         chosen,
+                                          std::vector<double>&       capacityDuals) const {
+    int numSlots = static_cast<int>(slotCapacities_.size());
+
+    // Negative reduced cost columns per slot
+    std::vector<std::vector<std::pair<double, int>>> negative(numSlots);
+    for (int k = 0; k < static_cast<int>(columns_.size()); ++k) {
+        double value = reducedCost(k, duals);
+        if (value < 0.0) {
+            negative[columnSlot_[k]].emplace_back(value, k);
+        }
+    }
+
+    double value = std::accumulate(duals.begin(), duals.end(), 0.0);
+    chosen.assign(columns_.size(), 0);
+    capacityDuals.assign(numSlots, 0.0);
+
+    for (int s = 0; s < numSlots; ++s) {
+        auto& candidates = negative[s];
+        int   take       = std::min(static_cast<int>(candidates.size()), slotCapacities_[s]);
+        if (take <= 0)
+            continue;
+
+        std::partial_sort(candidates.begin(), candidates.begin() + take, candidates.end());
+        for (int i = 0; i < take; ++i) {
+            value += candidates[i].first;
+            chosen[candidates[i].second] = 1;
+        }
+
+        // A full slot prices further columns against its cheapest excluded threshold
+        if (static_cast<int>(candidates.size()) >= slotCapacities_[s]) {
+            capacityDuals[s] = candidates[take - 1].first;
+        }
+    }
+
+    return value;
+}
+
+MasterSolution SubgradientMasterProblem::solveRelaxation(double timeLimit) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    MasterSolution result{false, 0.0, false, {}, {}};
+    if (columns_.empty())
+        return result;
+
+    // Start from the cheapest per-journey share of any column
+    if (!dualsInitialized_) {
+        std::vector<double> share(numJourneys_, std::numeric_limits<double>::infinity());
+        for (const auto& column : columns_) {
+            double perJourney = column.cost / static_cast<double>(column.journeys.size());
+            for (int journey : column.journeys) {
+                share[journey] = std::min(share[journey], perJourney);
+            }
+        }
+        for (int j = 0; j < numJourneys_; ++j) {
+            coverageDuals_[j] = std::isfinite(share[j]) ? share[j] : 0.0;
+        }
+        dualsInitialized_ = true;
+    }
+
+    std::vector<double> duals = coverageDuals_;
+    std::vector<double> bestCapacityDuals;
+    std::vector<double> capacityDuals;
+    std::vector<char>   chosen;
+    std::vector<int>    coverCount(numJourneys_);
+
+    double bestValue = -std::numeric_limits<double>::infinity();
+    double stepScale = parameters_.initialStepScale;
+    int    stall     = 0;
+
+    for (int iteration = 0; iteration < parameters_.maxIterations; ++iteration) {
+        double value = evaluate(duals, chosen, capacityDuals);
+
+        if (value > bestValue + 1e-9) {
+            bestValue         = value;
+            coverageDuals_    = duals;
+            bestCapacityDuals = capacityDuals;
+            stall             = 0;
+        }
+        else if (++stall >= parameters_.stallIterations) {
+            stepScale *= 0.5;
+            stall = 0;
+        }
+
+        // Volume-style primal average of the subproblem solutions
+        for (size_t k = 0; k < columns_.size(); ++k) {
+            primalAverage_[k] = parameters_.primalAveraging * chosen[k] +
+                                (1.0 - parameters_.primalAveraging) * primalAverage_[k];
+        }
+
+        // Subgradient of the dualized coverage rows
+        std::fill(coverCount.begin(), coverCount.end(), 0);
+        for (size_t k = 0; k < columns_.size(); ++k) {
+            if (chosen[k]) {
+                for (int journey : columns_[k].journeys) {
+                    ++coverCount[journey];
+                }
+            }
+        }
+
+        double norm = 0.0;
+        for (int j = 0; j < numJourneys_; ++j) {
+            double gradient = 1.0 - coverCount[j];
+            norm += gradient * gradient;
+        }
+        if (norm == 0.0) {
+            // The subproblem solution is a partition, so the bound is tight
+            break;
+        }
+
+        double gap  = std::isfinite(upperBound_) ? upperBound_ - value : 0.0;
+        double step = stepScale * std::max(gap, 1e-3 * (std::abs(value) + 1.0)) / norm;
+        for (int j = 0; j < numJourneys_; ++j) {
+            duals[j] += step * (1.0 - coverCount[j]);
+        }
+
+        double elapsed =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        if (stepScale < parameters_.minStepScale || (timeLimit > 0 && elapsed > timeLimit))
+            break;
+    }
+
+    result.solved        = true;
+    result.objective     = bestValue;
+    result.coverageDuals = coverageDuals_;
+    result.capacityDuals = bestCapacityDuals;
+    return result;
+}
+
+IntegerSolution SubgradientMasterProblem::selectColumns(const std::vector<int>& ordering) const {
+    IntegerSolution   solution{false, 0.0, {}};
+    std::vector<char> covered(numJourneys_, 0);
+    std::vector<int>  slotUsed(slotCapacities_.size(), 0);
+    int               numCovered = 0;
+
+    for (int k : ordering) {
+        int slot = columnSlot_[k];
+        if (slotUsed[slot] >= slotCapacities_[slot])
+            continue;
+
+        const auto& journeys = columns_[k].journeys;
+        if (std::any_of(journeys.begin(), journeys.end(), [&](int j) { return covered[j] != 0; }))
+            continue;
+
+        for (int journey : journeys) {
+            covered[journey] = 1;
+        }
+        numCovered += static_cast<int>(journeys.size());
+        ++slotUsed[slot];
+        solution.columns.push_back(k);
+        solution.objective += columns_[k].cost;
+    }
+
+    solution.feasible = numCovered == numJourneys_;
+    return solution;
+}
+
+IntegerSolution SubgradientMasterProblem::solveInteger(double /*timeLimit*/) {
+    int numColumns = static_cast<int>(columns_.size());
+
+    std::vector<double> reduced(numColumns);
+    std::vector<double> perJourney(numColumns);
+    for (int k = 0; k < numColumns; ++k) {
+        reduced[k]    = reducedCost(k, coverageDuals_);
+        perJourney[k] = columns_[k].cost / static_cast<double>(columns_[k].journeys.size());
+    }
+
+    // Rounded primal average first, then orderings over all columns
+    std::vector<std::vector<int>> orderings(3);
+    for (int k = 0; k < numColumns; ++k) {
+        if (primalAverage_[k] >= 0.5) {
+            orderings[0].push_back(k);
+        }
+        orderings[1].push_back(k);
+        orderings[2].push_back(k);
+    }
+    auto byAverage = [&](int a, int b) {
+        if (primalAverage_[a] != primalAverage_[b])
+            return primalAverage_[a] > primalAverage_[b];
+        return reduced[a] < reduced[b];
+    };
+    std::stable_sort(orderings[0].begin(), orderings[0].end(), byAverage);
+    std::stable_sort(orderings[1].begin(), orderings[1].end(), byAverage);
+    std::stable_sort(orderings[2].begin(), orderings[2].end(), [&](int a, int b) {
+        return perJourney[a] < perJourney[b];
+    });
+
+    // Prefer the cheapest partition, otherwise the packing with the lowest cost per journey
+    IntegerSolution best{false, std::numeric_limits<double>::infinity(), {}};
+    double          bestRatio = std::numeric_limits<double>::infinity();
+    for (const auto& ordering : orderings) {
+        IntegerSolution candidate = selectColumns(ordering);
+        if (candidate.feasible) {
+            if (!best.feasible || candidate.objective < best.objective) {
+                best = std::move(candidate);
+            }
+            continue;
+        }
+        if (best.feasible || candidate.columns.empty())
+            continue;
+
+        int covered = 0;
+        for (int k : candidate.columns) {
+            covered += static_cast<int>(columns_[k].journeys.size());
+        }
+        double ratio = candidate.objective / covered;
+        if (ratio < bestRatio) {
+            bestRatio = ratio;
+            best      = std::move(candidate);
+        }
+    }
+
+    return best;
+}
+
+} // namespace colgen
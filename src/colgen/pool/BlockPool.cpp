@@ -0,0 +1,585 @@
+#include "colgen/BlockPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <numeric>
+
+namespace colgen {
+
+namespace {
+// splitmix64 finalizer
+uint64_t mix(uint64_t value) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+} // namespace
+
+BlockPool::BlockPool(const network::ConnectionNetwork& network)
+  : network_(network),
+    numVehicleTypes_(network.getNumVehicleTypes()),
+    singlesAdded_(false),
+    duplicates_(0),
+    rejected_(0),
+    verbose_(false) {}
+
+uint64_t BlockPool::hashKey(int slot, data::JourneySpan journeys) {
+    uint64_t hash = mix(static_cast<uint64_t>(slot));
+    for (int journey : journeys) {
+        hash = mix(hash ^ static_cast<uint32_t>(journey));
+    }
+    return hash;
+}
+
+int BlockPool::find(uint64_t hash, int slot, data::JourneySpan journeys) const {
+    auto it = firstByHash_.find(hash);
+    if (it == firstByHash_.end())
+        return -1;
+
+    for (int k = it->second; k >= 0; k = blocks_[k].nextSameHash) {
+        const Block& block = blocks_[k];
+        if (block.slot == slot && static_cast<size_t>(block.journeyCount) == journeys.size() &&
+            std::equal(journeys.begin(), journeys.end(), journeysOf(block).begin())) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+void BlockPool::reserve(size_t blocks, size_t journeys) {
+    blocks_.reserve(blocks);
+    journeys_.reserve(journeys);
+    firstByHash_.reserve(blocks);
+}
+
+int BlockPool::add(int depotIndex, int vehicleTypeIndex, data::JourneySpan journeys) {
+    int numJourneys = network_.getNumJourneys();
+    if (depotIndex < 0 || depotIndex >= network_.getNumDepots() || vehicleTypeIndex < 0 ||
+        vehicleTypeIndex >= numVehicleTypes_ ||
+        std::any_of(journeys.begin(), journeys.end(), [numJourneys](int j) {
+            return j < 0 || j >= numJourneys;
+        })) {
+        ++rejected_;
+        return -1;
+    }
+
+    int      slot = depotIndex * numVehicleTypes_ + vehicleTypeIndex;
+    uint64_t hash = hashKey(slot, journeys);
+    int      k    = find(hash, slot, journeys);
+    if (k >= 0) {
+        ++duplicates_;
+        return k;
+    }
+
+    auto metrics = network_.evaluateBlock(depotIndex, vehicleTypeIndex, journeys);
+    if (!metrics.feasible) {
+        ++rejected_;
+        return -1;
+    }
+
+    auto inserted = firstByHash_.emplace(hash, -1);
+    k             = static_cast<int>(blocks_.size());
+    blocks_.push_back({journeys_.size(),
+                       static_cast<int>(journeys.size()),
+                       slot,
+                       metrics.cost,
+                       inserted.first->second});
+    inserted.first->second = k;
+    journeys_.insert(journeys_.end(), journeys.begin(), journeys.end());
+    return k;
+}
+
+int BlockPool::addSolution(const core::UnifiedSolution& solution) {
+    const auto& dataLoader = network_.getDataLoader();
+
+    size_t before = blocks_.size();
+    for (const auto& block : solution.blocks) {
+        add(dataLoader.getDepotIndex(block.depotId),
+            dataLoader.getVehicleTypeIndex(block.vehicleTypeId),
+            solution.journeysOf(block));
+    }
+    return static_cast<int>(blocks_.size() - before);
+}
+
+void BlockPool::addSingles() {
+    int numJourneys = network_.getNumJourneys();
+    int numDepots   = network_.getNumDepots();
+
+    for (int j = 0; j < numJourneys; ++j) {
+        std::vector<int> single{j};
+        int              bestDepot = -1;
+        int              bestType  = -1;
+        double           bestCost  = std::numeric_limits<double>::infinity();
+        for (int d = 0; d < numDepots; ++d) {
+            if (!network_.hasPullOut(d, j))
+                continue;
+            for (int t = 0; t < numVehicleTypes_; ++t) {
+                if (network_.getCapacity(d, t) <= 0 || !network_.isCompatible(t, j))
+                    continue;
+                auto metrics = network_.evaluateBlock(d, t, single);
+                if (metrics.feasible && metrics.cost < bestCost) {
+                    bestDepot = d;
+                    bestType  = t;
+                    bestCost  = metrics.cost;
+                }
+            }
+        }
+        if (bestDepot >= 0) {
+            add(bestDepot, bestType, single);
+        }
+    }
+    singlesAdded_ = true;
+}
+
+BlockPool::RecombineResult BlockPool::recombine(MasterProblem&               master,
+                                                const core::UnifiedSolution& incumbent,
+                                                const RecombineConfig&       config) {
+    auto startTime = std::chrono::steady_clock::now();
+    auto elapsed   = [&startTime]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    };
+
+    verbose_ = config.verbose;
+    RecombineResult result{incumbent, false, 0};
+
+    int numJourneys = network_.getNumJourneys();
+    int numDepots   = network_.getNumDepots();
+    int numSlots    = numDepots * numVehicleTypes_;
+
+    // The incumbent's blocks are always offered, so its partition stays reachable
+    const auto&      dataLoader  = network_.getDataLoader();
+    std::vector<int> required;
+    std::vector<int> timesCovered(numJourneys, 0);
+    double           incumbentCost = 0.0;
+    bool             incumbentOk   = incumbent.isFeasible() && !incumbent.blocks.empty();
+    for (const auto& block : incumbent.blocks) {
+        auto journeys = incumbent.journeysOf(block);
+        int  k        = add(dataLoader.getDepotIndex(block.depotId),
+                            dataLoader.getVehicleTypeIndex(block.vehicleTypeId),
+                            journeys);
+        if (k < 0) {
+            incumbentOk = false;
+            continue;
+        }
+        required.push_back(k);
+        incumbentCost += blocks_[k].cost;
+        for (int journey : journeys) {
+            ++timesCovered[journey];
+        }
+    }
+    incumbentOk = incumbentOk && std::all_of(timesCovered.begin(),
+                                             timesCovered.end(),
+                                             [](int count) { return count == 1; });
+
+    if (!singlesAdded_) {
+        addSingles();
+    }
+
+    // Required blocks and single-journey blocks, then the cheapest per journey
+    int               numBlocks = static_cast<int>(blocks_.size());
+    std::vector<char> selected(numBlocks, 0);
+    std::vector<int>  columnIds;
+    for (int k : required) {
+        selected[k] = 1;
+    }
+    for (int k = 0; k < numBlocks; ++k) {
+        if (blocks_[k].journeyCount == 1) {
+            selected[k] = 1;
+        }
+    }
+    if (config.maxColumns == 0 || blocks_.size() <= config.maxColumns) {
+        std::fill(selected.begin(), selected.end(), 1);
+    }
+    else {
+        std::vector<int> ranked;
+        for (int k = 0; k < numBlocks; ++k) {
+            if (!selected[k]) {
+                ranked.push_back(k);
+            }
+        }
+        auto perJourney = [this](int k) { return blocks_[k].cost / blocks_[k].journeyCount; };
+        size_t keep     = std::min(ranked.size(), config.maxColumns);
+        std::nth_element(ranked.begin(), ranked.begin() + keep, ranked.end(), [&](int a, int b) {
+            return perJourney(a) < perJourney(b);
+        });
+        for (size_t i = 0; i < keep; ++i) {
+            selected[ranked[i]] = 1;
+        }
+    }
+
+    std::vector<Column> columns;
+    std::vector<int>    columnOf(numBlocks, -1);
+    for (int k = 0; k < numBlocks; ++k) {
+        if (!selected[k])
+            continue;
+        const Block& block = blocks_[k];
+        auto         span  = journeysOf(block);
+        columnOf[k]        = static_cast<int>(columns.size());
+        columns.push_back({block.slot / numVehicleTypes_,
+                           block.slot % numVehicleTypes_,
+                           span.toVector(),
+                           block.cost});
+        columnIds.push_back(k);
+    }
+    result.columns = columns.size();
+
+    std::vector<int> capacities(numSlots, 0);
+    for (int slot = 0; slot < numSlots; ++slot) {
+        capacities[slot] =
+            std::max(0, network_.getCapacity(slot / numVehicleTypes_, slot % numVehicleTypes_));
+    }
+    master.initialize(numJourneys, numVehicleTypes_, capacities);
+    master.addColumns(columns);
+    if (incumbentOk) {
+        master.setUpperBound(incumbentCost);
+    }
+    log("Master: " + master.getName() + ", " + std::to_string(columns.size()) + " of " +
+        std::to_string(blocks_.size()) + " pooled blocks");
+
+    core::StopToken deadline = config.stop.child(config.timeLimit);
+    if (deadline.stopRequested()) {
+        log("Stopped before the master");
+        return result;
+    }
+
+    // The relaxation guides the integer master and the exchange below with its duals
+    auto relaxation = master.solveRelaxation(0.4 * deadline.remaining());
+    auto integer    = master.solveInteger(std::max(1.0, 0.5 * deadline.remaining()));
+
+    double objective = 0.0;
+    for (int column : integer.columns) {
+        objective += columns[column].cost;
+    }
+    std::vector<int> partition;
+    if (integer.feasible && (!incumbentOk || objective < incumbentCost)) {
+        partition = integer.columns;
+    }
+    else if (incumbentOk) {
+        for (int k : required) {
+            partition.push_back(columnOf[k]);
+        }
+    }
+    else {
+        partition = integer.columns;
+        if (!completePartition(columns, capacities, partition)) {
+            log("Master found no partition");
+            return result;
+        }
+    }
+    log("Master partition " + (integer.feasible ? std::to_string(objective) : "incomplete") +
+        ", relaxation " + std::to_string(relaxation.objective) + " (" +
+        std::to_string(elapsed()) + "s)");
+
+    // A heuristic master leaves room for single-block exchanges, an exact one none
+    const std::vector<double> noDuals;
+    objective = exchangeColumns(columns,
+                                capacities,
+                                relaxation.solved ? relaxation.coverageDuals : noDuals,
+                                deadline,
+                                partition);
+    if (incumbentOk && objective >= incumbentCost - 1e-6) {
+        log("No improvement over the incumbent: " + std::to_string(objective) + " vs " +
+            std::to_string(incumbentCost));
+        return result;
+    }
+
+    // Remainders created by the exchanges join the pool
+    std::vector<int> chosen;
+    for (int column : partition) {
+        const Column& block = columns[column];
+        chosen.push_back(column < static_cast<int>(columnIds.size())
+                             ? columnIds[column]
+                             : add(block.depotIndex, block.vehicleTypeIndex, block.journeys));
+    }
+    log("Recombined schedule: " + std::to_string(objective) + " with " +
+        std::to_string(chosen.size()) + " vehicles (incumbent " + std::to_string(incumbentCost) +
+        ", " + std::to_string(elapsed()) + "s)");
+
+    result.solution = buildSolution(chosen, objective);
+    result.improved = true;
+    return result;
+}
+
+double BlockPool::exchangeColumns(std::vector<Column>&       columns,
+                                  const std::vector<int>&    capacities,
+                                  const std::vector<double>& duals,
+                                  const core::StopToken&     stop,
+                                  std::vector<int>&          partition) const {
+    int  numJourneys = network_.getNumJourneys();
+    int  numPooled   = static_cast<int>(columns.size());
+    auto slotOf      = [this, &columns](int k) {
+        return columns[k].depotIndex * numVehicleTypes_ + columns[k].vehicleTypeIndex;
+    };
+    auto perJourney = [&columns](int k) {
+        return columns[k].cost / static_cast<double>(columns[k].journeys.size());
+    };
+
+    // Columns by journey, and the partition as the owner of every journey
+    std::vector<std::vector<int>> columnsOf(numJourneys);
+    for (int k = 0; k < numPooled; ++k) {
+        for (int journey : columns[k].journeys) {
+            columnsOf[journey].push_back(k);
+        }
+    }
+    std::vector<int>  owner(numJourneys, -1);
+    std::vector<int>  slotUsed(capacities.size(), 0);
+    std::vector<char> inPartition(numPooled, 0);
+    double            objective = 0.0;
+    for (int k : partition) {
+        for (int journey : columns[k].journeys) {
+            owner[journey] = k;
+        }
+        ++slotUsed[slotOf(k)];
+        inPartition[k] = 1;
+        objective += columns[k].cost;
+    }
+
+    // Most promising entering columns first: Lagrangian reduced cost, else cost per journey
+    std::vector<double> score(numPooled);
+    for (int k = 0; k < numPooled; ++k) {
+        score[k] = perJourney(k);
+        if (!duals.empty()) {
+            score[k] = columns[k].cost;
+            for (int journey : columns[k].journeys) {
+                score[k] -= duals[journey];
+            }
+        }
+    }
+    std::vector<int> order(numPooled);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&score](int a, int b) { return score[a] < score[b]; });
+
+    // Entering a column removes the blocks it overlaps. The journeys they leave uncovered are
+    // covered again by their remainders (the blocks without the entering journeys) or by the
+    // cheapest pooled blocks lying entirely among them. Remainders are appended to columns.
+    std::vector<char> released(numJourneys, 0);
+    std::vector<int>  leaving;
+    std::vector<int>  uncovered;
+    std::vector<int>  candidates;
+    std::vector<int>  entering;
+    bool              improved = true;
+    for (int pass = 0; improved && pass < 5; ++pass) {
+        improved = false;
+        for (int i = 0; i < numPooled; ++i) {
+            int k = order[i];
+            if (inPartition[k])
+                continue;
+            if (i % 64 == 0 && stop.stopRequested())
+                break;
+
+            leaving.clear();
+            for (int journey : columns[k].journeys) {
+                if (std::find(leaving.begin(), leaving.end(), owner[journey]) == leaving.end()) {
+                    leaving.push_back(owner[journey]);
+                }
+            }
+            double delta = columns[k].cost;
+            for (int l : leaving) {
+                delta -= columns[l].cost;
+                --slotUsed[slotOf(l)];
+                for (int journey : columns[l].journeys) {
+                    released[journey] = 1;
+                }
+            }
+            for (int journey : columns[k].journeys) {
+                released[journey] = 0;
+            }
+
+            uncovered.clear();
+            candidates.clear();
+            size_t firstRemainder = columns.size();
+            for (int l : leaving) {
+                std::vector<int> remainder;
+                for (int journey : columns[l].journeys) {
+                    if (released[journey]) {
+                        uncovered.push_back(journey);
+                        remainder.push_back(journey);
+                    }
+                }
+                if (remainder.empty())
+                    continue;
+                auto metrics = network_.evaluateBlock(
+                    columns[l].depotIndex, columns[l].vehicleTypeIndex, remainder);
+                if (metrics.feasible) {
+                    candidates.push_back(static_cast<int>(columns.size()));
+                    columns.push_back({columns[l].depotIndex,
+                                       columns[l].vehicleTypeIndex,
+                                       std::move(remainder),
+                                       metrics.cost});
+                }
+            }
+
+            entering.assign(1, k);
+            bool counted = slotUsed[slotOf(k)] < capacities[slotOf(k)];
+            bool fits    = counted;
+            if (fits) {
+                ++slotUsed[slotOf(k)];
+                for (int journey : uncovered) {
+                    for (int c : columnsOf[journey]) {
+                        if (std::all_of(columns[c].journeys.begin(),
+                                        columns[c].journeys.end(),
+                                        [&released](int j) { return released[j] != 0; })) {
+                            candidates.push_back(c);
+                        }
+                    }
+                }
+                std::sort(candidates.begin(), candidates.end(), [&](int a, int b) {
+                    return perJourney(a) < perJourney(b);
+                });
+
+                size_t covered = 0;
+                for (int c : candidates) {
+                    double rest = static_cast<double>(uncovered.size() - covered);
+                    if (covered == uncovered.size() || delta + rest * perJourney(c) >= -1e-6)
+                        break;
+                    if (slotUsed[slotOf(c)] >= capacities[slotOf(c)] ||
+                        std::any_of(columns[c].journeys.begin(),
+                                    columns[c].journeys.end(),
+                                    [&released](int j) { return released[j] == 0; }))
+                        continue;
+                    for (int journey : columns[c].journeys) {
+                        released[journey] = 0;
+                    }
+                    covered += columns[c].journeys.size();
+                    delta += columns[c].cost;
+                    ++slotUsed[slotOf(c)];
+                    entering.push_back(c);
+                }
+                fits = covered == uncovered.size() && delta < -1e-6;
+            }
+
+            if (!fits) {
+                for (size_t e = counted ? 0 : 1; e < entering.size(); ++e) {
+                    --slotUsed[slotOf(entering[e])];
+                }
+                for (int l : leaving) {
+                    ++slotUsed[slotOf(l)];
+                }
+                for (int journey : uncovered) {
+                    released[journey] = 0;
+                }
+                columns.resize(firstRemainder);
+                continue;
+            }
+
+            // Keep only the remainders that entered
+            std::vector<Column> kept;
+            for (int& c : entering) {
+                if (c >= static_cast<int>(firstRemainder)) {
+                    kept.push_back(std::move(columns[c]));
+                    c = static_cast<int>(firstRemainder + kept.size() - 1);
+                }
+            }
+            columns.resize(firstRemainder);
+            for (auto& column : kept) {
+                columns.push_back(std::move(column));
+            }
+            inPartition.resize(columns.size(), 0);
+
+            for (int l : leaving) {
+                inPartition[l] = 0;
+            }
+            for (int c : entering) {
+                inPartition[c] = 1;
+                for (int journey : columns[c].journeys) {
+                    owner[journey] = c;
+                    if (c >= numPooled) {
+                        columnsOf[journey].push_back(c);
+                    }
+                }
+            }
+            objective += delta;
+            improved = true;
+        }
+    }
+
+    partition.clear();
+    for (int k = 0; k < static_cast<int>(columns.size()); ++k) {
+        if (inPartition[k]) {
+            partition.push_back(k);
+        }
+    }
+    return objective;
+}
+
+bool BlockPool::completePartition(const std::vector<Column>& columns,
+                                  const std::vector<int>&    capacities,
+                                  std::vector<int>&          chosen) const {
+    int numJourneys = network_.getNumJourneys();
+
+    std::vector<char> covered(numJourneys, 0);
+    std::vector<int>  slotUsed(capacities.size(), 0);
+    int               numCovered = 0;
+    for (int k : chosen) {
+        for (int journey : columns[k].journeys) {
+            covered[journey] = 1;
+        }
+        numCovered += static_cast<int>(columns[k].journeys.size());
+        ++slotUsed[columns[k].depotIndex * numVehicleTypes_ + columns[k].vehicleTypeIndex];
+    }
+
+    // Greedy set cover of the rest with the blocks that only hold uncovered journeys,
+    // cheapest per journey first (single-journey blocks are always among them)
+    std::vector<int> order(columns.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&columns](int a, int b) {
+        return columns[a].cost / columns[a].journeys.size() <
+               columns[b].cost / columns[b].journeys.size();
+    });
+    for (int k : order) {
+        if (numCovered == numJourneys)
+            break;
+        const Column& column = columns[k];
+        int           slot   = column.depotIndex * numVehicleTypes_ + column.vehicleTypeIndex;
+        if (slotUsed[slot] >= capacities[slot] ||
+            std::any_of(column.journeys.begin(), column.journeys.end(), [&](int j) {
+                return covered[j] != 0;
+            }))
+            continue;
+
+        for (int journey : column.journeys) {
+            covered[journey] = 1;
+        }
+        numCovered += static_cast<int>(column.journeys.size());
+        ++slotUsed[slot];
+        chosen.push_back(k);
+    }
+
+    return numCovered == numJourneys;
+}
+
+core::UnifiedSolution BlockPool::buildSolution(const std::vector<int>& blocks,
+                                               double                  objective) const {
+    const auto& dataLoader = network_.getDataLoader();
+
+    core::UnifiedSolution solution("block_pool", objective, 0.0, "FEASIBLE");
+    solution.blocks.reserve(blocks.size());
+    for (int k : blocks) {
+        const Block& pooled   = blocks_[k];
+        int          depot    = pooled.slot / numVehicleTypes_;
+        int          type     = pooled.slot % numVehicleTypes_;
+        auto         journeys = journeysOf(pooled);
+        auto         metrics  = network_.evaluateBlock(depot, type, journeys);
+
+        core::VehicleBlock block{};
+        block.blockNumber   = static_cast<int>(solution.blocks.size()) + 1;
+        block.depotId       = dataLoader.getDepotStops()[depot];
+        block.vehicleTypeId = dataLoader.getVehicleTypes()[type].id;
+        block.totalCost     = metrics.cost;
+        block.totalDistance = metrics.distance;
+        block.totalTime     = metrics.time;
+        solution.addBlock(block, journeys);
+    }
+
+    return solution;
+}
+
+void BlockPool::log(const std::string& message) const {
+    if (verbose_) {
+        std::cout << "[BlockPool] " << message << std::endl;
+    }
+}
+
+} // namespace colgen
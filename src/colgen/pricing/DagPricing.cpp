@@ -0,0 +1,99 @@
+#include "colgen/DagPricing.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace colgen {
+
+namespace {
+constexpr double kReducedCostTolerance = 1e-6;
+}
+
+DagPricer::DagPricer(const network::ConnectionNetwork& network) : network_(network) {}
+
+double DagPricer::reducedCost(const Column&              column,
+                              const std::vector<double>& coverageDuals,
+                              double                     capacityDual) {
+    double value = column.cost - capacityDual;
+    for (int journey : column.journeys) {
+        value -= coverageDuals[journey];
+    }
+    return value;
+}
+
+std::vector<Column> DagPricer::price(int                        depotIndex,
+                                     int                        vehicleTypeIndex,
+                                     const std::vector<double>& coverageDuals,
+                                     double                     capacityDual,
+                                     int                        maxColumns) const {
+    const double infinity = std::numeric_limits<double>::infinity();
+    const auto&  order    = network_.getOrder();
+    int          numNodes = network_.getNumJourneys();
+
+    std::vector<double> label(numNodes, infinity);
+    std::vector<int>    parent(numNodes, -1);
+
+    // Forward pass in topological order
+    double vehicleCost = network_.vehicleCost(vehicleTypeIndex);
+    for (int q = 0; q < numNodes; ++q) {
+        int journeyIdx = order[q];
+        if (!network_.isCompatible(vehicleTypeIndex, journeyIdx))
+            continue;
+
+        double best       = infinity;
+        int    bestParent = -1;
+        if (network_.hasPullOut(depotIndex, journeyIdx)) {
+            best = vehicleCost + network_.pullOutCost(vehicleTypeIndex, depotIndex, journeyIdx);
+        }
+
+        for (const int* p = network_.predecessorsBegin(q); p != network_.predecessorsEnd(q); ++p) {
+            if (label[*p] == infinity)
+                continue;
+            double value =
+                label[*p] + network_.connectionCost(vehicleTypeIndex, order[*p], journeyIdx);
+            if (value < best) {
+                best       = value;
+                bestParent = *p;
+            }
+        }
+
+        if (best == infinity)
+            continue;
+
+        label[q]  = best + network_.serviceCost(vehicleTypeIndex, journeyIdx) -
+                   coverageDuals[journeyIdx];
+        parent[q] = bestParent;
+    }
+
+    // Close every path at the depot and keep the most negative ones
+    std::vector<std::pair<double, int>> candidates;
+    for (int q = 0; q < numNodes; ++q) {
+        if (label[q] == infinity)
+            continue;
+        double value =
+            label[q] + network_.pullInCost(vehicleTypeIndex, depotIndex, order[q]) - capacityDual;
+        if (value < -kReducedCostTolerance) {
+            candidates.emplace_back(value, q);
+        }
+    }
+
+    int take = std::min(static_cast<int>(candidates.size()), maxColumns);
+    std::partial_sort(candidates.begin(), candidates.begin() + take, candidates.end());
+
+    std::vector<Column> columns;
+    columns.reserve(take);
+    for (int i = 0; i < take; ++i) {
+        Column column;
+        column.depotIndex       = depotIndex;
+        column.vehicleTypeIndex = vehicleTypeIndex;
+        for (int q = candidates[i].second; q >= 0; q = parent[q]) {
+            column.journeys.push_back(order[q]);
+        }
+        std::reverse(column.journeys.begin(), column.journeys.end());
+        column.cost = network_.evaluateBlock(depotIndex, vehicleTypeIndex, column.journeys).cost;
+        columns.push_back(std::move(column));
+    }
+
+    return columns;
+}
+
+} // namespace colgen
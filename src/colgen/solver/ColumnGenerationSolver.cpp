@@ -0,0 +1,371 @@
+#include "colgen/ColumnGenerationSolver.hpp"
+#include "colgen/BlockPool.hpp"
+#include "core/ParallelFor.hpp"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <numeric>
+
+namespace colgen {
+
+namespace {
+// Share of the time limit for the rounds, the rest is kept for the integer master and the
+// cover completion, so a deadline ends the rounds without discarding their columns
+constexpr double kPricingShare = 0.8;
+} // namespace
+
+ColumnGenerationSolver::ColumnGenerationSolver(const data::DataLoader&        dataLoader,
+                                               std::unique_ptr<MasterProblem> master)
+  : dataLoader_(dataLoader),
+    master_(std::move(master)),
+    verbose_(false),
+    numVehicleTypes_(0),
+    lowerBound_(-std::numeric_limits<double>::infinity()),
+    iterations_(0) {}
+
+int ColumnGenerationSolver::addColumns(std::vector<Column> candidates) {
+    std::vector<Column> fresh;
+    for (auto& column : candidates) {
+        int slot = column.depotIndex * numVehicleTypes_ + column.vehicleTypeIndex;
+        if (columnKeys_.emplace(slot, column.journeys).second) {
+            fresh.push_back(std::move(column));
+        }
+    }
+
+    if (!fresh.empty()) {
+        master_->addColumns(fresh);
+        columns_.insert(columns_.end(), fresh.begin(), fresh.end());
+    }
+    return static_cast<int>(fresh.size());
+}
+
+core::UnifiedSolution ColumnGenerationSolver::solve(const core::UnifiedSolution& initial,
+                                                    const SolverConfig&          config) {
+    core::StopToken finish  = config.stop.child(config.timeLimit);
+    core::StopToken pricing = finish.share(kPricingShare);
+
+    verbose_    = config.verbose;
+    // All costs are nonnegative, so 0 is the Lagrangian value at zero multipliers; the priced
+    // bound of a round is weaker while the multipliers still overshoot
+    lowerBound_ = 0.0;
+    iterations_ = 0;
+    columns_.clear();
+    columnKeys_.clear();
+
+    network::ConnectionNetwork::Options networkOptions;
+    networkOptions.maxWaitSeconds = config.maxWaitSeconds;
+    networkOptions.threads        = config.threads;
+    networkOptions.preprocessor   = config.preprocessor;
+    network::ConnectionNetwork network(dataLoader_, networkOptions);
+    DagPricer                  pricer(network);
+
+    int numJourneys  = network.getNumJourneys();
+    int numDepots    = network.getNumDepots();
+    numVehicleTypes_ = network.getNumVehicleTypes();
+    int numSlots     = numDepots * numVehicleTypes_;
+
+    log("Connection network: " + std::to_string(numJourneys) + " journeys, " +
+        std::to_string(network.getNumArcs()) + " arcs (" +
+        std::to_string(network.getNumPrunedArcs()) + " pruned)");
+
+    slotCapacities_.assign(numSlots, 0);
+    for (int d = 0; d < numDepots; ++d) {
+        for (int t = 0; t < numVehicleTypes_; ++t) {
+            slotCapacities_[d * numVehicleTypes_ + t] = std::max(0, network.getCapacity(d, t));
+        }
+    }
+    master_->initialize(numJourneys, numVehicleTypes_, slotCapacities_);
+
+    // Seed with the blocks of the initial solution (journeys as service journey indices,
+    // like the greedy stores them)
+    std::vector<Column> seed;
+    std::vector<int>    timesCovered(numJourneys, 0);
+    double              initialCost = 0.0;
+    bool                initialOk   = initial.isFeasible() && !initial.blocks.empty();
+    for (const auto& block : initial.blocks) {
+        Column column;
+        column.depotIndex       = dataLoader_.getDepotIndex(block.depotId);
+        column.vehicleTypeIndex = dataLoader_.getVehicleTypeIndex(block.vehicleTypeId);
+        column.journeys         = initial.journeysOf(block).toVector();
+
+        bool inRange = std::all_of(column.journeys.begin(), column.journeys.end(), [&](int j) {
+            return j >= 0 && j < numJourneys;
+        });
+        if (!inRange) {
+            initialOk = false;
+            continue;
+        }
+
+        auto metrics =
+            network.evaluateBlock(column.depotIndex, column.vehicleTypeIndex, column.journeys);
+        if (!metrics.feasible) {
+            initialOk = false;
+            continue;
+        }
+        for (int journey : column.journeys) {
+            ++timesCovered[journey];
+        }
+        column.cost = metrics.cost;
+        initialCost += metrics.cost;
+        seed.push_back(std::move(column));
+    }
+
+    // Only a partition of all journeys is an upper bound
+    initialOk = initialOk && std::all_of(timesCovered.begin(), timesCovered.end(), [](int count) {
+                    return count == 1;
+                });
+
+    // One cheapest single-journey block per journey keeps the master feasible
+    coverPrice_.assign(numJourneys, 0.0);
+    for (int j = 0; j < numJourneys; ++j) {
+        Column best{-1, -1, {j}, std::numeric_limits<double>::infinity()};
+        for (int d = 0; d < numDepots; ++d) {
+            if (!network.hasPullOut(d, j))
+                continue;
+            for (int t = 0; t < numVehicleTypes_; ++t) {
+                if (slotCapacities_[d * numVehicleTypes_ + t] <= 0 || !network.isCompatible(t, j))
+                    continue;
+                double cost = network.evaluateBlock(d, t, best.journeys).cost;
+                if (cost < best.cost) {
+                    best.depotIndex       = d;
+                    best.vehicleTypeIndex = t;
+                    best.cost             = cost;
+                }
+            }
+        }
+        if (best.depotIndex >= 0) {
+            coverPrice_[j] = best.cost;
+            seed.push_back(std::move(best));
+        }
+        else {
+            log("Journey " + std::to_string(j) + " cannot be served by any slot");
+        }
+    }
+
+    addColumns(std::move(seed));
+    if (initialOk) {
+        master_->setUpperBound(initialCost);
+    }
+
+    log("Master: " + master_->getName() + ", initial columns: " + std::to_string(columns_.size()));
+
+    // Column generation rounds
+    std::vector<std::vector<Column>> priced(numSlots);
+    while (iterations_ < config.maxIterations && !pricing.stopRequested()) {
+        ++iterations_;
+
+        auto master = master_->solveRelaxation(std::min(pricing.remaining(), config.timeLimit));
+        if (!master.solved) {
+            log("Master relaxation failed");
+            break;
+        }
+
+        core::parallelFor(numSlots, config.threads, [&](int slot) {
+            priced[slot].clear();
+            if (slotCapacities_[slot] <= 0)
+                return;
+            double capacityDual = master.capacityDuals.empty() ? 0.0 : master.capacityDuals[slot];
+            priced[slot]        = pricer.price(slot / numVehicleTypes_,
+                                               slot % numVehicleTypes_,
+                                               master.coverageDuals,
+                                               capacityDual,
+                                               config.maxColumnsPerPricing);
+        });
+
+        // Lagrangian bound: sum(pi) + sum_s cap_s * min(0, min reduced cost without mu_s)
+        const auto&         duals = master.coverageDuals;
+        double              bound = std::accumulate(duals.begin(), duals.end(), 0.0);
+        std::vector<Column> candidates;
+        for (int slot = 0; slot < numSlots; ++slot) {
+            double capacityDual = master.capacityDuals.empty() ? 0.0 : master.capacityDuals[slot];
+            if (priced[slot].empty()) {
+                bound += slotCapacities_[slot] * std::min(0.0, capacityDual);
+                continue;
+            }
+            double best = DagPricer::reducedCost(priced[slot].front(), duals, 0.0);
+            bound += slotCapacities_[slot] * std::min(0.0, best);
+            for (auto& column : priced[slot]) {
+                candidates.push_back(std::move(column));
+            }
+        }
+        lowerBound_ = std::max(lowerBound_, bound);
+        if (config.progress) {
+            config.progress->bound("colgen", lowerBound_);
+        }
+
+        int added = addColumns(std::move(candidates));
+        log("Iteration " + std::to_string(iterations_) + ": master " +
+            std::to_string(master.objective) + ", bound " + std::to_string(lowerBound_) +
+            ", new columns " + std::to_string(added));
+
+        if (added == 0)
+            break;
+    }
+
+    if (config.stop.interrupted() && initialOk) {
+        log("Interrupted after " + std::to_string(iterations_) + " iterations, keeping the "
+            "initial solution");
+        return initial;
+    }
+    if (pricing.stopRequested()) {
+        log("Time share of the rounds used after " + std::to_string(iterations_) +
+            " iterations");
+    }
+
+    // Integer master over all generated columns, completed by residual pricing if partial
+    double integerLimit = std::min(finish.remaining(), config.timeLimit);
+    auto   integer      = master_->solveInteger(std::max(1.0, integerLimit));
+    std::vector<Column> blocks;
+    for (int k : integer.columns) {
+        blocks.push_back(columns_[k]);
+    }
+    if (!integer.feasible && !completeCover(pricer, config, blocks)) {
+        log("Integer master found no complete schedule");
+        return initial;
+    }
+
+    double objective = 0.0;
+    for (const auto& block : blocks) {
+        objective += block.cost;
+    }
+    bool                  improved = !initialOk || objective < initialCost;
+    core::UnifiedSolution best     = improved ? buildSolution(network, blocks, objective) : initial;
+    log("Integer master: " + std::to_string(objective) + " with " + std::to_string(blocks.size()) +
+        " vehicles" + (improved ? "" : ", initial solution kept"));
+
+    // A master that only packs whole columns (the subgradient one) rarely beats the seed, so
+    // the generated columns are recombined by exchanges with trimmed remainders
+    if (!finish.stopRequested()) {
+        BlockPool pool(network);
+        for (const auto& column : columns_) {
+            pool.add(column.depotIndex, column.vehicleTypeIndex, column.journeys);
+        }
+        BlockPool::RecombineConfig poolConfig;
+        poolConfig.timeLimit = std::max(1.0, std::min(finish.remaining(), config.timeLimit));
+        poolConfig.verbose   = config.verbose;
+        poolConfig.stop      = finish;
+        auto recombined      = pool.recombine(*master_, best, poolConfig);
+        if (recombined.improved) {
+            best     = std::move(recombined.solution);
+            improved = true;
+        }
+    }
+    if (!improved) {
+        log("No improvement over the initial solution: " + std::to_string(initialCost));
+        return initial;
+    }
+
+    best.algorithmType = "colgen";
+    if (config.progress) {
+        config.progress->incumbent("colgen", best.objectiveValue);
+    }
+    return best;
+}
+
+bool ColumnGenerationSolver::completeCover(const DagPricer&     pricer,
+                                           const SolverConfig&  config,
+                                           std::vector<Column>& blocks) const {
+    int numJourneys = static_cast<int>(coverPrice_.size());
+    int numSlots    = static_cast<int>(slotCapacities_.size());
+
+    std::vector<char> covered(numJourneys, 0);
+    std::vector<int>  slotUsed(numSlots, 0);
+    int               numCovered = 0;
+    for (const auto& block : blocks) {
+        for (int journey : block.journeys) {
+            covered[journey] = 1;
+        }
+        numCovered += static_cast<int>(block.journeys.size());
+        ++slotUsed[block.depotIndex * numVehicleTypes_ + block.vehicleTypeIndex];
+    }
+
+    // Covered journeys are blocked, uncovered ones are worth slightly more than their cheapest
+    // single block, so a single block always prices out if nothing better exists
+    std::vector<double>              duals(numJourneys);
+    std::vector<std::vector<Column>> priced(numSlots);
+    while (numCovered < numJourneys) {
+        for (int j = 0; j < numJourneys; ++j) {
+            duals[j] = covered[j] ? -std::numeric_limits<double>::infinity() : coverPrice_[j] + 1.0;
+        }
+
+        core::parallelFor(numSlots, config.threads, [&](int slot) {
+            priced[slot].clear();
+            if (slotUsed[slot] >= slotCapacities_[slot])
+                return;
+            priced[slot] = pricer.price(slot / numVehicleTypes_,
+                                        slot % numVehicleTypes_,
+                                        duals,
+                                        0.0,
+                                        config.maxColumnsPerPricing);
+        });
+
+        std::vector<std::pair<double, Column*>> candidates;
+        for (auto& columns : priced) {
+            for (auto& column : columns) {
+                candidates.emplace_back(DagPricer::reducedCost(column, duals, 0.0), &column);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+
+        // At most one block per slot and round, as the candidates of a slot overlap heavily
+        int               accepted = 0;
+        std::vector<char> taken(numSlots, 0);
+        for (auto& candidate : candidates) {
+            Column& column = *candidate.second;
+            int     slot   = column.depotIndex * numVehicleTypes_ + column.vehicleTypeIndex;
+            if (slotUsed[slot] >= slotCapacities_[slot] || taken[slot])
+                continue;
+            taken[slot] = 1;
+            if (std::any_of(column.journeys.begin(), column.journeys.end(), [&](int j) {
+                    return covered[j] != 0;
+                }))
+                continue;
+
+            for (int journey : column.journeys) {
+                covered[journey] = 1;
+            }
+            numCovered += static_cast<int>(column.journeys.size());
+            ++slotUsed[slot];
+            blocks.push_back(std::move(column));
+            ++accepted;
+        }
+
+        if (accepted == 0)
+            return false;
+    }
+
+    return true;
+}
+
+core::UnifiedSolution
+ColumnGenerationSolver::buildSolution(const network::ConnectionNetwork& network,
+                                      const std::vector<Column>&        blocks,
+                                      double                            objective) const {
+    core::UnifiedSolution solution("colgen", objective, 0.0, "FEASIBLE");
+    solution.blocks.reserve(blocks.size());
+    for (const auto& column : blocks) {
+        auto metrics =
+            network.evaluateBlock(column.depotIndex, column.vehicleTypeIndex, column.journeys);
+
+        core::VehicleBlock block{};
+        block.blockNumber   = static_cast<int>(solution.blocks.size()) + 1;
+        block.depotId       = dataLoader_.getDepotStops()[column.depotIndex];
+        block.vehicleTypeId = dataLoader_.getVehicleTypes()[column.vehicleTypeIndex].id;
+        block.totalCost     = metrics.cost;
+        block.totalDistance = metrics.distance;
+        block.totalTime     = metrics.time;
+        solution.addBlock(block, column.journeys);
+    }
+
+    return solution;
+}
+
+void ColumnGenerationSolver::log(const std::string& message) const {
+    if (verbose_) {
+        std::cout << "[ColumnGenerationSolver] " << message << std::endl;
+    }
+}
+
+} // namespace colgen
@@ -3,16 +3,18 @@
 #include "data/DataStructures.hpp"
 #include <algorithm>
 #include <sstream>
+#include <utility>
 
 namespace core {
 
-UnifiedSolution SolutionConverter::fromGreedySolution(const data::MDVSPGreedySolution& greedySolution) {
+UnifiedSolution SolutionConverter::fromGreedySolution(data::MDVSPGreedySolution greedySolution) {
     UnifiedSolution unified("greedy",
                             greedySolution.totalObjectiveCost,
                             greedySolution.solutionTime,
                             greedySolution.isFeasible ? "FEASIBLE" : "INFEASIBLE");
 
-    // Convert vehicle blocks
+    // Convert vehicle blocks, the journey ranges stay valid in the moved journey array
+    unified.blocks.reserve(greedySolution.blocks.size());
     for (size_t i = 0; i < greedySolution.blocks.size(); ++i) {
         const auto& greedyBlock = greedySolution.blocks[i];
 
@@ -20,18 +22,20 @@ UnifiedSolution SolutionConverter::fromGreedySolution(const data::MDVSPGreedySol
         block.blockNumber   = static_cast<int>(i);
         block.depotId       = greedyBlock.depotStopId;
         block.vehicleTypeId = greedyBlock.vehicleTypeId;
-        block.journeyIds    = greedyBlock.serviceJourneyIds;
+        block.journeyOffset = greedyBlock.journeyOffset;
+        block.journeyCount  = greedyBlock.journeyCount;
         block.totalCost     = greedyBlock.totalCost;
         block.totalDistance = greedyBlock.totalDistance;
         block.totalTime     = greedyBlock.totalTime;
 
         unified.blocks.push_back(block);
     }
+    unified.journeys = std::move(greedySolution.journeys);
 
     return unified;
 }
 
-data::MDVSPGreedySolution SolutionConverter::toGreedySolution(const UnifiedSolution& unified) {
+data::MDVSPGreedySolution SolutionConverter::toGreedySolution(UnifiedSolution unified) {
     data::MDVSPGreedySolution greedy;
 
     greedy.totalObjectiveCost = unified.objectiveValue;
@@ -40,17 +44,20 @@ data::MDVSPGreedySolution SolutionConverter::toGreedySolution(const UnifiedSolut
     greedy.totalVehiclesUsed  = unified.getNumVehicles();
 
     // Convert vehicle blocks
+    greedy.blocks.reserve(unified.blocks.size());
     for (const auto& block : unified.blocks) {
         data::VehicleBlock greedyBlock;
         greedyBlock.vehicleTypeId     = block.vehicleTypeId;
         greedyBlock.depotStopId       = block.depotId;
-        greedyBlock.serviceJourneyIds = block.journeyIds;
+        greedyBlock.journeyOffset     = block.journeyOffset;
+        greedyBlock.journeyCount      = block.journeyCount;
         greedyBlock.totalCost         = block.totalCost;
         greedyBlock.totalDistance     = block.totalDistance;
         greedyBlock.totalTime         = block.totalTime;
 
         greedy.blocks.push_back(greedyBlock);
     }
+    greedy.journeys = std::move(unified.journeys);
 
     return greedy;
 }
@@ -61,7 +68,7 @@ std::vector<double> SolutionConverter::generateSolverVariables(const UnifiedSolu
     std::vector<double> variables(totalJourneys * totalVehicles, 0.0);
 
     for (const auto& block : solution.blocks) {
-        for (int journeyId : block.journeyIds) {
+        for (int journeyId : solution.journeysOf(block)) {
             if (journeyId >= 0 && journeyId < totalJourneys && block.blockNumber >= 0 &&
                 block.blockNumber < totalVehicles) {
                 // Variable naming: x[journey][vehicle] = journey * totalVehicles + vehicle
@@ -109,7 +116,7 @@ std::vector<int> SolutionConverter::parseJourneyIds(const std::string& journeyId
     return journeyIds;
 }
 
-std::string SolutionConverter::formatJourneyIds(const std::vector<int>& journeyIds) {
+std::string SolutionConverter::formatJourneyIds(data::JourneySpan journeyIds) {
     if (journeyIds.empty()) {
         return "";
     }
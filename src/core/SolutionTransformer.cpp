@@ -2,12 +2,13 @@
 #include <chrono>
 #include <iomanip>
 #include <sstream>
+#include <utility>
 
 namespace core {
 
-UnifiedSolution SolutionTransformer::transform(const data::MDVSPGreedySolution& greedySolution,
-                                               const data::DataLoader&          dataLoader,
-                                               const std::string&               problemInstance) {
+UnifiedSolution SolutionTransformer::transform(data::MDVSPGreedySolution greedySolution,
+                                               const data::DataLoader&   dataLoader,
+                                               const std::string&        problemInstance) {
     UnifiedSolution unified;
 
     // Set basic solution information
@@ -18,8 +19,9 @@ UnifiedSolution SolutionTransformer::transform(const data::MDVSPGreedySolution&
     unified.problemInstance     = problemInstance;
     unified.timestamp           = getCurrentTimestamp();
 
-    // Convert vehicle blocks
-    unified.blocks = convertBlocks(greedySolution.blocks);
+    // Convert vehicle blocks, the journey ranges stay valid in the moved journey array
+    unified.blocks   = convertBlocks(greedySolution.blocks);
+    unified.journeys = std::move(greedySolution.journeys);
 
     return unified;
 }
@@ -35,6 +37,7 @@ std::string SolutionTransformer::getCurrentTimestamp() {
 std::vector<VehicleBlock>
 SolutionTransformer::convertBlocks(const std::vector<data::VehicleBlock>& greedyBlocks) {
     std::vector<VehicleBlock> unifiedBlocks;
+    unifiedBlocks.reserve(greedyBlocks.size());
 
     for (size_t i = 0; i < greedyBlocks.size(); ++i) {
         const auto& greedyBlock = greedyBlocks[i];
@@ -46,7 +49,8 @@ SolutionTransformer::convertBlocks(const std::vector<data::VehicleBlock>& greedy
         unifiedBlock.totalCost     = greedyBlock.totalCost;
         unifiedBlock.totalDistance = greedyBlock.totalDistance;
         unifiedBlock.totalTime     = greedyBlock.totalTime;
-        unifiedBlock.journeyIds    = greedyBlock.serviceJourneyIds;
+        unifiedBlock.journeyOffset = greedyBlock.journeyOffset;
+        unifiedBlock.journeyCount  = greedyBlock.journeyCount;
 
         unifiedBlocks.push_back(unifiedBlock);
     }
@@ -1,33 +1,80 @@
 #include "core/Solver.hpp"
+#include "colgen/BlockPool.hpp"
+#include "colgen/ColumnGenerationSolver.hpp"
+#include "colgen/SubgradientMasterProblem.hpp"
+#include "core/IncumbentStore.hpp"
+#include "core/ParallelFor.hpp"
+#include "core/RollingHorizon.hpp"
+#include "core/UnifiedSolutionDatabase.hpp"
 #include "data/DataLoader.hpp"
+#include "exact/GurobiMasterProblem.hpp"
 #include "exact/GurobiSolver.hpp"
 #include "greedy/GreedyMDVSPSolver.hpp"
+#include "meta/LargeNeighbourhoodSearch.hpp"
+#include "meta/LocalSearch.hpp"
+#include "network/ConnectionNetwork.hpp"
+#include "network/Decomposition.hpp"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <future>
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace {
+core::UnifiedSolution fromGreedySolution(data::MDVSPGreedySolution greedySolution) {
+    core::UnifiedSolution solution;
+    solution.algorithmType  = "greedy";
+    solution.status         = greedySolution.isFeasible ? "FEASIBLE" : "INFEASIBLE";
+    solution.objectiveValue = greedySolution.totalObjectiveCost;
+
+    // Block metadata is converted, the flat journey array is moved as a whole
+    solution.blocks.reserve(greedySolution.blocks.size());
+    for (const auto& block : greedySolution.blocks) {
+        core::VehicleBlock unifiedBlock{};
+        unifiedBlock.vehicleTypeId = block.vehicleTypeId;
+        unifiedBlock.depotId       = block.depotStopId;
+        unifiedBlock.journeyOffset = block.journeyOffset;
+        unifiedBlock.journeyCount  = block.journeyCount;
+        unifiedBlock.totalCost     = block.totalCost;
+        unifiedBlock.totalTime     = block.totalTime;
+
+        solution.blocks.push_back(unifiedBlock);
+    }
+    solution.journeys = std::move(greedySolution.journeys);
+    return solution;
+}
+} // namespace
 
 MDVSPSolver::MDVSPSolver() : problemLoaded_(false) {}
 
 MDVSPSolver::~MDVSPSolver() = default;
 
-bool MDVSPSolver::loadProblem(const std::string& dataPath) {
+bool MDVSPSolver::loadProblem(const std::string&     dataPath,
+                              bool                   preprocess,
+                              const core::StopToken& stop) {
     try {
         logMessage("Loading problem from: " + dataPath);
 
-        dataLoader_ = std::make_unique<data::DataLoader>(dataPath);
+        auto dataLoader = std::make_unique<data::DataLoader>(dataPath);
+        dataLoader->setStopCondition([stop]() { return stop.stopRequested(); });
 
         // Load CSV data
-        if (!dataLoader_->loadAll()) {
+        if (!dataLoader->loadAll()) {
             logMessage("Failed to load CSV data", true);
             return false;
         }
 
         logMessage("Problem loaded successfully from CSV data");
-        logMessage("  Service journeys: " + std::to_string(dataLoader_->getServiceJourneys().size()));
-        logMessage("  Vehicle types: " + std::to_string(dataLoader_->getVehicleTypes().size()));
-        logMessage("  Stop points: " + std::to_string(dataLoader_->getStopPoints().size()));
+        logMessage("  Service journeys: " + std::to_string(dataLoader->getServiceJourneys().size()));
+        logMessage("  Vehicle types: " + std::to_string(dataLoader->getVehicleTypes().size()));
+        logMessage("  Stop points: " + std::to_string(dataLoader->getStopPoints().size()));
 
-        problemLoaded_ = true;
-        return true;
+        return loadProblem(std::move(dataLoader), preprocess);
     }
     catch (const std::exception& e) {
         logMessage("Error loading problem: " + std::string(e.what()), true);
@@ -35,6 +82,32 @@ bool MDVSPSolver::loadProblem(const std::string& dataPath) {
     }
 }
 
+bool MDVSPSolver::loadProblem(std::unique_ptr<data::DataLoader> dataLoader, bool preprocess) {
+    if (!dataLoader || !dataLoader->isLoaded()) {
+        logMessage("Data is not loaded", true);
+        return false;
+    }
+    dataLoader_ = std::move(dataLoader);
+
+    // Before the reductions, so the fingerprint depends on the data only
+    fingerprint_ = dataLoader_->computeFingerprintText();
+
+    // Safe reductions, slot removals go into the data so every method sees them
+    preprocessor_.reset();
+    if (preprocess) {
+        preprocessor_ = std::make_unique<network::Preprocessor>(*dataLoader_);
+        preprocessor_->apply(*dataLoader_);
+
+        const auto& stats = preprocessor_->getStats();
+        logMessage("Preprocessing: " + std::to_string(stats.unusableSlots) + " unusable and " +
+                   std::to_string(stats.dominatedSlots) + " dominated depot slots removed, " +
+                   std::to_string(stats.removedVehicleTypes) + " vehicle types removed");
+    }
+
+    problemLoaded_ = true;
+    return true;
+}
+
 core::UnifiedSolution MDVSPSolver::solve(const SolverConfig& config) {
     if (!problemLoaded_) {
         logMessage("No problem loaded!", true);
@@ -48,29 +121,197 @@ core::UnifiedSolution MDVSPSolver::solve(const SolverConfig& config) {
 
     auto startTime = std::chrono::high_resolution_clock::now();
 
-    core::UnifiedSolution solution;
+    // Every phase below polls this deadline and returns its best solution once it passes
+    SolverConfig run = config;
+    run.stop         = config.stop.child(config.timeLimit);
 
-    if (config.method == "greedy") {
-        solution = solveGreedy(config);
+    // Parts of a decomposed or rolling horizon solve are no stored instances
+    core::UnifiedSolution stored;
+    if (!run.warmStartDatabase.empty() && run.initial == nullptr && !run.decompose &&
+        run.rollingWindowSeconds <= 0) {
+        stored = loadStoredSolution(run.warmStartDatabase, run.problemName, run.stop);
+        if (stored.isFeasible()) {
+            run.initial = &stored;
+        }
     }
-    else if (config.method == "exact") {
-        solution = solveExact(config);
+
+    // The seed is known by now, so a reused result was started from the same one. A start
+    // solution of the caller has no stored identity and is never matched.
+    std::string parameters = getRunParameters(run);
+    if (!run.reuseDatabase.empty() && (run.initial == nullptr || run.initial->storedId >= 0)) {
+        auto reused = loadStoredResult(run, parameters);
+        if (reused.isFeasible()) {
+            return reused;
+        }
     }
-    else if (config.method == "meta") {
-        solution = solveMeta(config);
+
+    core::UnifiedSolution solution;
+    if (run.decompose) {
+        solution = solveDecomposed(run);
+    }
+    else if (run.rollingWindowSeconds > 0) {
+        solution = solveRollingHorizon(run);
     }
     else {
-        logMessage("Unknown method: " + config.method + ", using greedy", true);
-        solution = solveGreedy(config);
+        solution = solveWithMethod(run);
+    }
+    if (run.stop.stopRequested()) {
+        logMessage("Stopped by the time limit or on request, returning the best solution found");
     }
 
     auto endTime  = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
     solution.solutionTimeSeconds = duration.count() / 1000.0;
+    solution.instanceHash        = fingerprint_;
+    solution.runParameters       = parameters;
+    solution.storedId            = -1; // A new result, even if it kept a stored start
 
     return solution;
 }
 
+std::string MDVSPSolver::getRunParameters(const SolverConfig& config) const {
+    // A start solution is named by its database ID and objective, a warm start database
+    // without a usable solution of the instance leaves the run cold
+    std::string warmStart = "0";
+    if (config.initial != nullptr) {
+        warmStart = (config.initial->storedId >= 0 ? std::to_string(config.initial->storedId)
+                                                   : std::string("initial")) +
+                    "/" + std::to_string(config.initial->objectiveValue);
+    }
+
+    std::ostringstream parameters;
+    parameters << "method=" << config.method << " time=" << config.timeLimit
+               << " gap=" << config.optimalityGap << " iterations=" << config.maxIterations
+               << " threads=" << core::resolveThreadCount(config.threads)
+               << " preprocess=" << (preprocessor_ != nullptr) << " decompose=" << config.decompose
+               << " window=" << config.rollingWindowSeconds
+               << " overlap=" << config.rollingOverlapSeconds
+               << " nodeHeuristic=" << config.nodeHeuristicInterval << " warmStart=" << warmStart;
+    return parameters.str();
+}
+
+core::UnifiedSolution MDVSPSolver::loadStoredResult(const SolverConfig& config,
+                                                    const std::string&  parameters) {
+    core::UnifiedSolutionDatabase database(config.reuseDatabase);
+    if (!database.initialize()) {
+        return core::UnifiedSolution();
+    }
+    auto stored = database.loadStoredResult(
+        fingerprint_, parameters, core::JourneyIdMap(dataLoader_->getServiceJourneys()));
+    if (stored.blocks.empty()) {
+        logMessage("No stored result of this run, solving");
+        return core::UnifiedSolution();
+    }
+
+    // Same content, so the journey indices are the same and a schedule covers all of them
+    std::string id = std::to_string(stored.storedId);
+    if (stored.getNumJourneys() != static_cast<int>(dataLoader_->getServiceJourneys().size())) {
+        logMessage("Stored result " + id + " does not cover the instance, solving", true);
+        return core::UnifiedSolution();
+    }
+
+    logMessage("Reusing stored result " + id + ": objective " +
+               std::to_string(stored.objectiveValue) + " (" + stored.algorithmType + ", " +
+               stored.timestamp + ")");
+    stored.problemInstance = config.problemName;
+    if (config.progress) {
+        config.progress->incumbent("stored", stored.objectiveValue);
+    }
+    return stored;
+}
+
+core::UnifiedSolution MDVSPSolver::solveWithMethod(const SolverConfig& config) {
+    if (config.method == "greedy") {
+        return solveGreedy(config);
+    }
+    else if (config.method == "exact") {
+        return solveExact(config);
+    }
+    else if (config.method == "meta") {
+        return solveMeta(config);
+    }
+    else if (config.method == "colgen") {
+        return solveColumnGeneration(config);
+    }
+    else if (config.method == "portfolio") {
+        return solvePortfolio(config);
+    }
+    else if (config.method == "pool") {
+        return solveBlockPool(config);
+    }
+
+    logMessage("Unknown method: " + config.method + ", using greedy", true);
+    return solveGreedy(config);
+}
+
+core::UnifiedSolution MDVSPSolver::solveDecomposed(const SolverConfig& config) {
+    network::Decomposition decomposition(*dataLoader_);
+    const auto&            components    = decomposition.getComponents();
+    int                    numComponents = decomposition.getNumComponents();
+
+    logMessage("Decomposition: " + std::to_string(numComponents) + " independent components");
+    if (numComponents <= 1) {
+        return solveWithMethod(config);
+    }
+
+    // Components run concurrently, the threads of the configuration are shared among them
+    int totalThreads = core::resolveThreadCount(config.threads);
+    int workers      = std::min(numComponents, totalThreads);
+
+    std::vector<core::UnifiedSolution> results(numComponents);
+    core::parallelFor(numComponents, workers, [&](int c) {
+        const auto& component = components[c];
+        try {
+            SolverConfig subConfig = config;
+            subConfig.decompose    = false;
+            subConfig.threads      = std::max(1, totalThreads / workers);
+            subConfig.progress     = nullptr; // Objectives of parts are no incumbents
+            subConfig.initial      = nullptr;
+            subConfig.warmStartDatabase.clear();
+            subConfig.reuseDatabase.clear();
+            // Component names never match a model file of the full instance
+            subConfig.problemName = config.problemName + "_component" + std::to_string(c);
+
+            MDVSPSolver subSolver;
+            if (subSolver.loadProblem(
+                    dataLoader_->createSubproblem(component.journeys, component.slots), false)) {
+                results[c] = subSolver.solve(subConfig);
+            }
+        }
+        catch (const std::exception& e) {
+            logMessage("Error in component " + std::to_string(c) + ": " + e.what(), true);
+        }
+    });
+
+    // Merge, mapping journey indices of the components back to the full instance
+    core::UnifiedSolution merged(results[0].algorithmType, 0.0, 0.0, "OPTIMAL");
+    merged.problemInstance = config.problemName;
+    for (int c = 0; c < numComponents; ++c) {
+        const auto& result = results[c];
+        logMessage("  Component " + std::to_string(c) + ": " +
+                   std::to_string(components[c].journeys.size()) + " journeys, " +
+                   std::to_string(result.getNumVehicles()) + " vehicles, " + result.status);
+
+        // The first failing component decides the status, otherwise all must be optimal
+        if (merged.isFeasible() && result.status != "OPTIMAL") {
+            merged.status = result.isFeasible() ? "FEASIBLE" : result.status;
+        }
+        merged.objectiveValue += result.objectiveValue;
+        for (const auto& block : result.blocks) {
+            auto& added       = merged.addBlock(block, result.journeysOf(block));
+            added.blockNumber = static_cast<int>(merged.blocks.size());
+            for (int k = 0; k < added.journeyCount; ++k) {
+                int& journey = merged.journeys[added.journeyOffset + k];
+                journey      = components[c].journeys[journey];
+            }
+        }
+    }
+    if (config.progress && merged.isFeasible()) {
+        config.progress->incumbent("decomposition", merged.objectiveValue);
+    }
+    return merged;
+}
+
 core::UnifiedSolution MDVSPSolver::solve() {
     SolverConfig defaultConfig;
     defaultConfig.verbose = true;
@@ -86,7 +327,7 @@ core::UnifiedSolution MDVSPSolver::solveWithWarmStart(const core::UnifiedSolutio
 
     if (targetMethod == "exact") {
         try {
-            exact::GurobiSolver               gurobiSolver;
+            exact::GurobiSolver               gurobiSolver(gurobiEnv_);
             exact::GurobiSolver::SolverConfig gurobiConfig;
             gurobiConfig.timeLimit   = 3600.0;
             gurobiConfig.verbose     = true;
@@ -106,28 +347,218 @@ core::UnifiedSolution MDVSPSolver::solveWithWarmStart(const core::UnifiedSolutio
     return warmStart;
 }
 
+core::UnifiedSolution MDVSPSolver::loadStoredSolution(const std::string&     databasePath,
+                                                      const std::string&     problemInstance,
+                                                      const core::StopToken& stop) {
+    if (!problemLoaded_) {
+        logMessage("No problem loaded!", true);
+        return core::UnifiedSolution();
+    }
+
+    core::UnifiedSolutionDatabase database(databasePath);
+    if (!database.initialize()) {
+        return core::UnifiedSolution();
+    }
+    auto stored = database.loadBestSolution(
+        problemInstance, fingerprint_, core::JourneyIdMap(dataLoader_->getServiceJourneys()));
+    if (stored.blocks.empty()) {
+        logMessage("No stored solution of " + problemInstance);
+        return core::UnifiedSolution();
+    }
+    logMessage("Stored solution: objective " + std::to_string(stored.objectiveValue) + ", " +
+               std::to_string(stored.blocks.size()) + " vehicles (" + stored.algorithmType +
+               ", " + stored.timestamp + ")");
+    if (stored.instanceHash != fingerprint_) {
+        logMessage("Stored solution is of other data (" +
+                   (stored.instanceHash.empty() ? "no fingerprint" : stored.instanceHash) + ")");
+    }
+
+    network::ConnectionNetwork::Options networkOptions;
+    networkOptions.preprocessor = preprocessor_.get();
+    network::ConnectionNetwork network(*dataLoader_, networkOptions);
+    meta::LocalSearch          localSearch(network);
+
+    core::SolutionValidator::Options options;
+    options.stop = stop;
+    auto report  = core::SolutionValidator(network).validate(stored, options);
+    if (report.stopped) {
+        return core::UnifiedSolution();
+    }
+
+    core::UnifiedSolution solution;
+    if (report.isValid()) {
+        solution = localSearch.evaluate(stored);
+    }
+    else {
+        // Journey IDs the data no longer has were dropped on load; rows saved before journey
+        // IDs hold indices, out of range ones are dropped here. The rest is kept where still
+        // drivable.
+        logMessage("Stored solution does not fit the data (" + report.summary() +
+                   "), repairing it");
+        int                   numJourneys = network.getNumJourneys();
+        core::UnifiedSolution partial     = stored;
+        partial.clearBlocks();
+        std::vector<int> kept;
+        for (const auto& block : stored.blocks) {
+            kept.clear();
+            for (int journeyIdx : stored.journeysOf(block)) {
+                if (journeyIdx >= 0 && journeyIdx < numJourneys) {
+                    kept.push_back(journeyIdx);
+                }
+            }
+            partial.addBlock(block, kept);
+        }
+        solution = localSearch.repair(partial);
+        if (!solution.isFeasible()) {
+            logMessage("Stored solution could not be repaired", true);
+            return core::UnifiedSolution();
+        }
+        logMessage("Repaired stored solution: objective " +
+                   std::to_string(solution.objectiveValue));
+    }
+
+    solution.algorithmType   = "stored_" + stored.algorithmType;
+    solution.storedId        = stored.storedId; // Names the seed in getRunParameters()
+    solution.status          = "FEASIBLE"; // Optimality was proven for the stored data only
+    solution.problemInstance = problemInstance;
+    return solution;
+}
+
+lagrange::BoundResult MDVSPSolver::computeLowerBound(const core::UnifiedSolution& solution,
+                                                     double                       timeLimit,
+                                                     bool                         verbose) {
+    const double          infinity = std::numeric_limits<double>::infinity();
+    lagrange::BoundResult result{-infinity, infinity, infinity, 0, 0.0};
+    if (!problemLoaded_) {
+        logMessage("No problem loaded!", true);
+        return result;
+    }
+
+    logMessage("Computing Lagrangian lower bound...");
+
+    try {
+        lagrange::LagrangianBoundSolver::SolverConfig boundConfig;
+        boundConfig.timeLimit = timeLimit;
+        boundConfig.verbose   = verbose;
+
+        lagrange::LagrangianBoundSolver boundSolver(*dataLoader_, 0, preprocessor_.get());
+        result = boundSolver.computeBound(solution, boundConfig);
+
+        logMessage("Lower bound: " + std::to_string(result.lowerBound) + " after " +
+                   std::to_string(result.iterations) + " iterations");
+    }
+    catch (const std::exception& e) {
+        logMessage("Error in Lagrangian bound: " + std::string(e.what()), true);
+    }
+    return result;
+}
+
+core::ValidationReport MDVSPSolver::validateSolution(const core::UnifiedSolution& solution,
+                                                     const core::StopToken&       stop) const {
+    if (!problemLoaded_) {
+        throw std::runtime_error("No problem loaded");
+    }
+    network::ConnectionNetwork       network(*dataLoader_);
+    core::SolutionValidator::Options options;
+    options.stop = stop;
+    return core::SolutionValidator(network).validate(solution, options);
+}
+
+core::UnifiedSolution MDVSPSolver::solveRollingHorizon(const SolverConfig& config) {
+    try {
+        core::RollingHorizon horizon(
+            *dataLoader_, config.rollingWindowSeconds, config.rollingOverlapSeconds);
+        int numWindows = horizon.getNumWindows();
+
+        logMessage("Rolling horizon: " + std::to_string(numWindows) + " windows of " +
+                   std::to_string(config.rollingWindowSeconds) + "s, overlap " +
+                   std::to_string(config.rollingOverlapSeconds) + "s");
+        if (numWindows <= 1) {
+            return solveWithMethod(config);
+        }
+
+        core::UnifiedSolution window;
+        auto                  prepare = [&horizon](int w) { return horizon.prepareWindow(w); };
+        auto                  next    = std::async(std::launch::async, prepare, 0);
+        for (int w = 0; w < numWindows; ++w) {
+            auto windowData = next.get();
+            horizon.addStartStates(*windowData);
+
+            // The next window's journeys do not depend on this window's result
+            if (w + 1 < numWindows) {
+                next = std::async(std::launch::async, prepare, w + 1);
+            }
+
+            // Remaining windows share the remaining time evenly
+            SolverConfig windowConfig         = config;
+            windowConfig.rollingWindowSeconds = 0;
+            windowConfig.timeLimit            = config.stop.remaining() / (numWindows - w);
+            windowConfig.problemName = config.problemName + "_window" + std::to_string(w);
+            windowConfig.progress    = nullptr;
+            windowConfig.initial     = nullptr;
+            windowConfig.warmStartDatabase.clear();
+            windowConfig.reuseDatabase.clear();
+            if (config.stop.stopRequested()) {
+                // The day must stay covered, so stopped windows get the greedy without deadline
+                windowConfig.method    = "greedy";
+                windowConfig.timeLimit = config.timeLimit;
+                windowConfig.stop      = core::StopToken();
+            }
+
+            int         numJourneys = static_cast<int>(windowData->getServiceJourneys().size());
+            MDVSPSolver windowSolver;
+            if (!windowSolver.loadProblem(std::move(windowData), false))
+                throw std::runtime_error("window data not loaded");
+            window = windowSolver.solve(windowConfig);
+
+            const auto& range = horizon.getWindows()[w];
+            logMessage("  Window " + std::to_string(w) + " [" + std::to_string(range.beginTime) +
+                       ", " + std::to_string(range.endTime) + "): " + std::to_string(numJourneys) +
+                       " journeys with start states, " + std::to_string(window.getNumVehicles()) +
+                       " vehicles, " + window.status);
+            // Blocks of the earlier windows cover no day and the window's objective belongs
+            // to no schedule of it, so the day is solved at once like after an error
+            if (!window.isFeasible()) {
+                logMessage("Window " + std::to_string(w) + " is " + window.status +
+                               ", solving at once",
+                           true);
+                return solveWithMethod(config);
+            }
+            horizon.commit(w, window);
+        }
+
+        core::UnifiedSolution solution(window.algorithmType, 0.0, 0.0, "FEASIBLE");
+        solution.problemInstance = config.problemName;
+        horizon.addBlocks(solution);
+        for (const auto& block : solution.blocks) {
+            solution.objectiveValue += block.totalCost;
+        }
+        if (config.progress) {
+            config.progress->incumbent("rolling_horizon", solution.objectiveValue);
+        }
+        return solution;
+    }
+    catch (const std::exception& e) {
+        logMessage("Error in rolling horizon: " + std::string(e.what()) + ", solving at once",
+                   true);
+        return solveWithMethod(config);
+    }
+}
+
 core::UnifiedSolution MDVSPSolver::solveGreedy(const SolverConfig& config) {
     logMessage("Solving with greedy heuristic...");
+    if (config.progress) {
+        config.progress->phase("greedy");
+    }
 
     try {
         greedy::GreedyMDVSPSolver greedySolver(*dataLoader_);
-        auto                      greedySolution = greedySolver.solve();
+        greedySolver.setStop(config.stop);
 
-        core::UnifiedSolution solution;
-        solution.algorithmType   = "greedy";
-        solution.status          = "FEASIBLE";
-        solution.objectiveValue  = greedySolution.totalObjectiveCost;
+        auto solution            = fromGreedySolution(greedySolver.solve());
         solution.problemInstance = config.problemName;
-
-        for (const auto& block : greedySolution.blocks) {
-            core::VehicleBlock unifiedBlock;
-            unifiedBlock.vehicleTypeId = block.vehicleTypeId;
-            unifiedBlock.depotId       = block.depotStopId;
-            unifiedBlock.journeyIds    = block.serviceJourneyIds;
-            unifiedBlock.totalCost     = block.totalCost;
-            unifiedBlock.totalTime     = block.totalTime;
-
-            solution.blocks.push_back(unifiedBlock);
+        if (config.progress && solution.isFeasible()) {
+            config.progress->incumbent("greedy", solution.objectiveValue);
         }
 
         logMessage("Greedy solution completed successfully");
@@ -139,36 +570,476 @@ core::UnifiedSolution MDVSPSolver::solveGreedy(const SolverConfig& config) {
     }
 }
 
+core::UnifiedSolution MDVSPSolver::startSolution(const SolverConfig& config) {
+    if (config.initial == nullptr || !config.initial->isFeasible()) {
+        return solveGreedy(config);
+    }
+
+    logMessage("Starting from " + config.initial->algorithmType + " solution with objective " +
+               std::to_string(config.initial->objectiveValue));
+    if (config.progress) {
+        config.progress->incumbent("stored", config.initial->objectiveValue);
+    }
+    return *config.initial;
+}
+
 core::UnifiedSolution MDVSPSolver::solveExact(const SolverConfig& config) {
     logMessage("Solving with Gurobi exact solver...");
+    if (config.progress) {
+        config.progress->phase("exact");
+    }
 
     try {
-        exact::GurobiSolver gurobiSolver;
+        exact::GurobiSolver gurobiSolver(gurobiEnv_);
 
         exact::GurobiSolver::SolverConfig gurobiConfig;
         gurobiConfig.timeLimit     = config.timeLimit;
         gurobiConfig.optimalityGap = config.optimalityGap;
         gurobiConfig.verbose       = config.verbose;
         gurobiConfig.problemName   = config.problemName;
+        gurobiConfig.threads       = config.threads;
 
-        // Use auto-discovery for model file
-        auto solution            = gurobiSolver.solveFromFile("", gurobiConfig);
+        gurobiConfig.nodeHeuristicInterval = config.nodeHeuristicInterval;
+        gurobiConfig.telemetryFile         = config.telemetryFile;
+        gurobiConfig.stop                  = config.stop;
+        gurobiConfig.progress              = config.progress;
+
+        // A start solution is injected into the in-process model through the incumbent
+        // store, or set as MIP start of a model file
+        const core::UnifiedSolution* initial =
+            config.initial && config.initial->isFeasible() ? config.initial : nullptr;
+        core::IncumbentStore incumbents;
+        if (initial) {
+            incumbents.offer(*initial);
+            gurobiConfig.incumbents = &incumbents;
+            logMessage("Warm start from " + initial->algorithmType + " solution with objective " +
+                       std::to_string(initial->objectiveValue));
+        }
+
+        // Prefer a prepared model file, otherwise build the time-space model in process
+        std::string modelFile = exact::SolverConfigurator::findModelFile(
+            gurobiConfig.problemName, gurobiConfig.modelDirectory, gurobiConfig.preferredFormat);
+        core::UnifiedSolution solution;
+        if (modelFile.empty()) {
+            solution = gurobiSolver.solveFromData(*dataLoader_, gurobiConfig);
+        }
+        else if (initial) {
+            solution = gurobiSolver.solveFromFileWithWarmStart(modelFile, *initial, gurobiConfig);
+        }
+        else {
+            solution = gurobiSolver.solveFromFile(modelFile, gurobiConfig);
+        }
         solution.problemInstance = config.problemName;
 
+        // The exact solve may end without an incumbent of its own
+        if (initial && !solution.isFeasible()) {
+            logMessage("Exact solver found no solution, keeping the start solution");
+            solution                 = *initial;
+            solution.problemInstance = config.problemName;
+        }
+
         return solution;
     }
     catch (const std::exception& e) {
         logMessage("Error in Gurobi solver: " + std::string(e.what()), true);
-        return solveGreedy(config);
+        return startSolution(config);
     }
 
     logMessage("Gurobi not available - using greedy fallback");
-    return solveGreedy(config);
+    return startSolution(config);
 }
 
 core::UnifiedSolution MDVSPSolver::solveMeta(const SolverConfig& config) {
-    logMessage("Meta-heuristic solver not yet implemented - using greedy fallback");
-    return solveGreedy(config);
+    logMessage("Solving with greedy, local search and large neighbourhood search...");
+
+    auto initial = startSolution(config);
+    try {
+        network::ConnectionNetwork::Options networkOptions;
+        networkOptions.threads      = config.threads;
+        networkOptions.preprocessor = preprocessor_.get();
+        network::ConnectionNetwork network(*dataLoader_, networkOptions);
+
+        // The descent mostly ends at a local optimum early, its unused time goes to the LNS
+        meta::LocalSearch::SolverConfig searchConfig;
+        searchConfig.stop      = config.stop.share(0.5);
+        searchConfig.timeLimit = searchConfig.stop.remaining();
+        searchConfig.verbose   = config.verbose;
+        searchConfig.progress  = config.progress;
+
+        meta::LocalSearch localSearch(network);
+
+        auto solution = localSearch.improve(localSearch.evaluate(initial), searchConfig);
+        logMessage("Local search finished: " + std::to_string(localSearch.getMoves()) +
+                   " moves, objective " + std::to_string(solution.objectiveValue));
+        if (!solution.isFeasible())
+            return solution;
+
+        // Exact rebuilds of related blocks for the rest of the time
+        meta::LargeNeighbourhoodSearch::SolverConfig lnsConfig;
+        lnsConfig.stop      = config.stop;
+        lnsConfig.timeLimit = config.stop.remaining();
+        lnsConfig.verbose   = config.verbose;
+        lnsConfig.threads   = config.threads;
+        lnsConfig.progress  = config.progress;
+
+        meta::LargeNeighbourhoodSearch lns(network);
+
+        auto improved = lns.improve(solution, lnsConfig);
+        logMessage("LNS finished: " + std::to_string(lns.getImprovements()) + " of " +
+                   std::to_string(lns.getNeighbourhoods()) +
+                   " neighbourhoods improved, objective " +
+                   std::to_string(improved.objectiveValue));
+        return improved.isFeasible() ? improved : solution;
+    }
+    catch (const std::exception& e) {
+        logMessage("Error in local search: " + std::string(e.what()), true);
+        return initial;
+    }
+}
+
+core::UnifiedSolution MDVSPSolver::solvePortfolio(const SolverConfig& config) {
+    logMessage("Solving with the portfolio (greedy variants, local search, exact)...");
+
+    if (config.progress) {
+        config.progress->phase("portfolio");
+    }
+
+    // Stops every engine once the exact one proves optimality, without stopping the caller
+    core::StopToken stop = config.stop.child(config.timeLimit);
+
+    network::ConnectionNetwork::Options networkOptions;
+    networkOptions.threads      = config.threads;
+    networkOptions.preprocessor = preprocessor_.get();
+    network::ConnectionNetwork network(*dataLoader_, networkOptions);
+
+    core::IncumbentStore incumbents;
+    std::atomic<bool>    provenOptimal{false};
+    std::atomic<int>     producers{0}; // Engines other than the local search still running
+
+    // Debug builds validate every incumbent before it is shared
+    core::SolutionValidator validator(network);
+    auto                    valid = [&](const core::UnifiedSolution& solution,
+                                        const std::string&           engine) {
+#ifndef NDEBUG
+        auto report = validator.validate(solution);
+        if (!report.isValid()) {
+            logMessage("Portfolio: invalid incumbent from " + engine + ": " + report.summary() +
+                           " (" + report.violations.front().describe() + ")",
+                       true);
+            return false;
+        }
+#else
+        (void) validator;
+        (void) solution;
+        (void) engine;
+#endif
+        return true;
+    };
+
+    // Heuristic results are re-costed with the network cost model before they are shared
+    auto publish = [&](const core::UnifiedSolution& solution,
+                       const std::string&           engine,
+                       const char*                  progressName) {
+        auto evaluated = meta::LocalSearch(network).evaluate(solution);
+        if (evaluated.isFeasible() && valid(evaluated, engine) && incumbents.offer(evaluated)) {
+            logMessage("Portfolio: new incumbent " + std::to_string(evaluated.objectiveValue) +
+                       " (" + engine + ")");
+            if (config.progress) {
+                config.progress->incumbent(progressName, evaluated.objectiveValue);
+            }
+        }
+    };
+
+    if (config.initial && config.initial->isFeasible()) {
+        publish(*config.initial, "start solution", "stored");
+    }
+
+    std::vector<std::thread> engines;
+
+    // The greedy variants and the local search take one thread each, exact gets the rest
+    constexpr int numGreedyVariants = 3;
+    int           exactThreads =
+        std::max(1, core::resolveThreadCount(config.threads) - numGreedyVariants - 1);
+
+    // Greedy variants, pruned by the incumbent
+    producers += numGreedyVariants + 1;
+    for (int variant = 0; variant < numGreedyVariants; ++variant) {
+        engines.emplace_back([&, variant]() {
+            try {
+                greedy::GreedyMDVSPSolver greedySolver(*dataLoader_);
+                greedySolver.setOrderSeed(static_cast<unsigned>(variant));
+                greedySolver.setCutoff([&]() { return incumbents.getObjective(); });
+                greedySolver.setStop(stop);
+
+                auto greedySolution = greedySolver.solve();
+                if (greedySolution.isFeasible) {
+                    publish(fromGreedySolution(std::move(greedySolution)),
+                            "greedy variant " + std::to_string(variant),
+                            "greedy");
+                }
+            }
+            catch (const std::exception& e) {
+                logMessage("Error in greedy variant: " + std::string(e.what()), true);
+            }
+            --producers;
+        });
+    }
+
+    // Exact solver, exchanging incumbents through its callback
+    core::UnifiedSolution exactSolution;
+    engines.emplace_back([&]() {
+        try {
+            exact::GurobiSolver               gurobiSolver(gurobiEnv_);
+            exact::GurobiSolver::SolverConfig gurobiConfig;
+            gurobiConfig.timeLimit     = stop.remaining();
+            gurobiConfig.optimalityGap = config.optimalityGap;
+            gurobiConfig.threads       = exactThreads;
+            gurobiConfig.verbose       = config.verbose;
+            gurobiConfig.problemName   = config.problemName;
+            gurobiConfig.incumbents    = &incumbents;
+            gurobiConfig.stop          = stop;
+            gurobiConfig.progress      = config.progress;
+
+            gurobiConfig.nodeHeuristicInterval = config.nodeHeuristicInterval;
+
+            exactSolution = gurobiSolver.solveFromData(*dataLoader_, gurobiConfig);
+            if (exactSolution.status == "OPTIMAL") {
+                incumbents.offer(exactSolution);
+                provenOptimal = true;
+                stop.requestStop();
+            }
+        }
+        catch (const std::exception& e) {
+            logMessage("Exact engine not available: " + std::string(e.what()), true);
+        }
+        --producers;
+    });
+
+    // Local search polishes every new incumbent until the others are done or time is up
+    engines.emplace_back([&]() {
+        try {
+            meta::LocalSearch localSearch(network);
+            uint64_t          seen = 0;
+            while (!stop.stopRequested()) {
+                uint64_t version = incumbents.getVersion();
+                if (version == seen) {
+                    if (producers == 0)
+                        break;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                    continue;
+                }
+
+                meta::LocalSearch::SolverConfig searchConfig;
+                searchConfig.timeLimit = stop.remaining();
+                searchConfig.stop      = stop;
+
+                core::UnifiedSolution start    = *incumbents.get();
+                auto                  improved = localSearch.improve(start, searchConfig);
+
+                seen = version;
+                if (improved.isFeasible() && valid(improved, "local search") &&
+                    incumbents.offer(improved)) {
+                    seen = incumbents.getVersion();
+                    logMessage("Portfolio: new incumbent " +
+                               std::to_string(improved.objectiveValue) + " (local search)");
+                    if (config.progress) {
+                        config.progress->incumbent("local_search", improved.objectiveValue);
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e) {
+            logMessage("Error in local search: " + std::string(e.what()), true);
+        }
+    });
+
+    for (auto& engine : engines) {
+        engine.join();
+    }
+
+    const core::UnifiedSolution* best = incumbents.get();
+    if (best == nullptr) {
+        logMessage("Portfolio found no feasible solution", true);
+        exactSolution.problemInstance = config.problemName;
+        return exactSolution;
+    }
+
+    core::UnifiedSolution solution = *best;
+    solution.algorithmType         = "portfolio_" + best->algorithmType;
+    solution.status                = provenOptimal ? "OPTIMAL" : "FEASIBLE";
+    solution.problemInstance       = config.problemName;
+    for (size_t k = 0; k < solution.blocks.size(); ++k) {
+        solution.blocks[k].blockNumber = static_cast<int>(k) + 1;
+    }
+    logMessage("Portfolio finished: objective " + std::to_string(solution.objectiveValue) +
+               " from " + best->algorithmType + (provenOptimal ? ", proven optimal" : ""));
+    return solution;
+}
+
+core::UnifiedSolution MDVSPSolver::solveColumnGeneration(const SolverConfig& config) {
+    logMessage("Solving with column generation...");
+    if (config.progress) {
+        config.progress->phase("colgen");
+    }
+
+    auto initial = startSolution(config);
+
+    // Prefer the Gurobi master, fall back to the license-free subgradient master
+    std::unique_ptr<colgen::MasterProblem> master;
+    try {
+        master = std::make_unique<exact::GurobiMasterProblem>(config.threads);
+    }
+    catch (GRBException& e) {
+        logMessage("Gurobi master not available (" + e.getMessage() +
+                   "), using subgradient master");
+        master = std::make_unique<colgen::SubgradientMasterProblem>();
+    }
+
+    try {
+        colgen::ColumnGenerationSolver::SolverConfig colgenConfig;
+        colgenConfig.timeLimit     = config.timeLimit;
+        colgenConfig.maxIterations = config.maxIterations;
+        colgenConfig.threads       = config.threads;
+        colgenConfig.verbose       = config.verbose;
+        colgenConfig.preprocessor  = preprocessor_.get();
+        colgenConfig.stop          = config.stop;
+        colgenConfig.progress      = config.progress;
+
+        colgen::ColumnGenerationSolver colgenSolver(*dataLoader_, std::move(master));
+
+        auto solution            = colgenSolver.solve(initial, colgenConfig);
+        solution.problemInstance = config.problemName;
+
+        logMessage("Column generation finished: " + std::to_string(colgenSolver.getIterations()) +
+                   " iterations, " + std::to_string(colgenSolver.getNumColumns()) +
+                   " columns, lower bound " + std::to_string(colgenSolver.getLowerBound()));
+        return solution;
+    }
+    catch (GRBException& e) {
+        logMessage("Error in column generation master: " + e.getMessage(), true);
+        return initial;
+    }
+    catch (const std::exception& e) {
+        logMessage("Error in column generation: " + std::string(e.what()), true);
+        return initial;
+    }
+}
+
+core::UnifiedSolution MDVSPSolver::solveBlockPool(const SolverConfig& config) {
+    logMessage("Solving with block pool recombination...");
+    if (config.progress) {
+        config.progress->phase("block_pool");
+    }
+
+    network::ConnectionNetwork::Options networkOptions;
+    networkOptions.threads      = config.threads;
+    networkOptions.preprocessor = preprocessor_.get();
+    network::ConnectionNetwork network(*dataLoader_, networkOptions);
+    colgen::BlockPool          pool(network);
+
+    if (!config.poolDatabase.empty()) {
+        core::UnifiedSolutionDatabase database(config.poolDatabase, config.verbose);
+        if (database.initialize()) {
+            long visited = database.forEachStoredBlock(
+                fingerprint_, core::JourneyIdMap(dataLoader_->getServiceJourneys()),
+                [&](const core::VehicleBlock& block, data::JourneySpan journeys) {
+                    pool.add(dataLoader_->getDepotIndex(block.depotId),
+                             dataLoader_->getVehicleTypeIndex(block.vehicleTypeId),
+                             journeys);
+                });
+            logMessage("Block pool: " + std::to_string(pool.size()) + " distinct of " +
+                       std::to_string(std::max(0L, visited)) + " stored blocks");
+        }
+    }
+
+    // Half of the time collects blocks from greedy variants and their local optima
+    core::UnifiedSolution best;
+    auto offer = [&](const core::UnifiedSolution& solution, const char* engine) {
+        pool.addSolution(solution);
+        if (solution.isFeasible() &&
+            (!best.isFeasible() || solution.objectiveValue < best.objectiveValue)) {
+            best = solution;
+            if (config.progress) {
+                config.progress->incumbent(engine, solution.objectiveValue);
+            }
+        }
+    };
+
+    if (config.initial) {
+        offer(*config.initial, "stored");
+    }
+
+    core::StopToken   collect = config.stop.share(0.5);
+    meta::LocalSearch localSearch(network);
+    int               runs = 0;
+    for (int variant = 0; variant < config.maxIterations && !collect.stopRequested(); ++variant) {
+        try {
+            greedy::GreedyMDVSPSolver greedySolver(*dataLoader_);
+            greedySolver.setOrderSeed(static_cast<unsigned>(variant));
+            greedySolver.setStop(collect);
+
+            auto greedySolution = greedySolver.solve();
+            if (!greedySolution.isFeasible)
+                continue;
+            auto start = localSearch.evaluate(fromGreedySolution(std::move(greedySolution)));
+            offer(start, "greedy");
+
+            meta::LocalSearch::SolverConfig searchConfig;
+            searchConfig.stop      = collect;
+            searchConfig.timeLimit = collect.remaining();
+            offer(localSearch.improve(start, searchConfig), "local_search");
+            ++runs;
+        }
+        catch (const std::exception& e) {
+            logMessage("Error in block pool run: " + std::string(e.what()), true);
+        }
+    }
+    logMessage("Block pool: " + std::to_string(pool.size()) + " distinct blocks from " +
+               std::to_string(runs) + " runs (" + std::to_string(pool.getDuplicates()) +
+               " duplicates, " + std::to_string(pool.getRejected()) + " rejected)");
+    if (!best.isFeasible()) {
+        logMessage("Block pool found no feasible schedule", true);
+        return best;
+    }
+
+    // Prefer the Gurobi master, fall back to the license-free subgradient master
+    std::unique_ptr<colgen::MasterProblem> master;
+    try {
+        master = std::make_unique<exact::GurobiMasterProblem>(config.threads);
+    }
+    catch (GRBException& e) {
+        logMessage("Gurobi master not available (" + e.getMessage() +
+                   "), using subgradient master");
+        master = std::make_unique<colgen::SubgradientMasterProblem>();
+    }
+
+    try {
+        colgen::BlockPool::RecombineConfig recombineConfig;
+        recombineConfig.timeLimit = config.stop.remaining();
+        recombineConfig.verbose   = config.verbose;
+        recombineConfig.stop      = config.stop;
+
+        auto recombined = pool.recombine(*master, best, recombineConfig);
+        if (recombined.improved) {
+            meta::LocalSearch::SolverConfig searchConfig;
+            searchConfig.stop      = config.stop;
+            searchConfig.timeLimit = config.stop.remaining();
+
+            offer(recombined.solution, "block_pool");
+            offer(localSearch.improve(recombined.solution, searchConfig), "local_search");
+        }
+        logMessage("Block pool finished: " + std::to_string(recombined.columns) +
+                   " master columns, objective " + std::to_string(best.objectiveValue));
+    }
+    catch (GRBException& e) {
+        logMessage("Error in block pool master: " + e.getMessage(), true);
+    }
+    catch (const std::exception& e) {
+        logMessage("Error in block pool recombination: " + std::string(e.what()), true);
+    }
+
+    best.problemInstance = config.problemName;
+    return best;
 }
 
 void MDVSPSolver::logMessage(const std::string& message, bool verbose) const {
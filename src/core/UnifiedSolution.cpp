@@ -1,5 +1,6 @@
 #include "core/UnifiedSolution.hpp"
 #include <chrono>
+#include <ctime>
 #include <iomanip>
 #include <numeric>
 #include <sstream>
@@ -12,7 +13,8 @@ UnifiedSolution::UnifiedSolution()
     solutionTimeSeconds(0.0),
     status("UNKNOWN"),
     problemInstance("default"),
-    timestamp(generateTimestamp()) {}
+    timestamp(generateTimestamp()),
+    storedId(-1) {}
 
 UnifiedSolution::UnifiedSolution(const std::string& algType,
                                  double             objective,
@@ -23,11 +25,27 @@ UnifiedSolution::UnifiedSolution(const std::string& algType,
     solutionTimeSeconds(solutionTime),
     status(solutionStatus),
     problemInstance("default"),
-    timestamp(generateTimestamp()) {}
+    timestamp(generateTimestamp()),
+    storedId(-1) {}
+
+VehicleBlock& UnifiedSolution::addBlock(const VehicleBlock& block,
+                                        data::JourneySpan   blockJourneys) {
+    blocks.push_back(block);
+    VehicleBlock& stored = blocks.back();
+    stored.journeyOffset = static_cast<int>(journeys.size());
+    stored.journeyCount  = static_cast<int>(blockJourneys.size());
+    journeys.insert(journeys.end(), blockJourneys.begin(), blockJourneys.end());
+    return stored;
+}
+
+void UnifiedSolution::clearBlocks() {
+    blocks.clear();
+    journeys.clear();
+}
 
 int UnifiedSolution::getNumJourneys() const {
     return std::accumulate(blocks.begin(), blocks.end(), 0, [](int sum, const VehicleBlock& block) {
-        return sum + static_cast<int>(block.journeyIds.size());
+        return sum + block.journeyCount;
     });
 }
 
@@ -35,8 +53,12 @@ std::string UnifiedSolution::generateTimestamp() const {
     auto now    = std::chrono::system_clock::now();
     auto time_t = std::chrono::system_clock::to_time_t(now);
 
+    // Solutions are created concurrently, so the reentrant localtime_r is needed
+    std::tm local{};
+    localtime_r(&time_t, &local);
+
     std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
+    ss << std::put_time(&local, "%Y-%m-%d %H:%M:%S");
     return ss.str();
 }
 
@@ -0,0 +1,24 @@
+#include "core/DatabaseProgressSink.hpp"
+#include "core/UnifiedSolutionDatabase.hpp"
+
+namespace core {
+
+DatabaseProgressSink::DatabaseProgressSink(const std::string& dbPath,
+                                           const std::string& problemInstance,
+                                           const std::string& method)
+  : dbPath_(dbPath), problemInstance_(problemInstance), method_(method) {}
+
+void DatabaseProgressSink::onEvent(const ProgressEvent& event) { events_.push_back(event); }
+
+void DatabaseProgressSink::finish() {
+    if (events_.empty())
+        return;
+
+    UnifiedSolutionDatabase database(dbPath_);
+    if (database.initialize()) {
+        database.saveProgress(problemInstance_, method_, events_);
+    }
+    events_.clear();
+}
+
+} // namespace core
@@ -1,10 +1,58 @@
 #include "core/UnifiedSolutionDatabase.hpp"
 #include <SQLiteCpp/SQLiteCpp.h>
+#include <cstdlib>
 #include <iostream>
 #include <sstream>
 
 namespace core {
 
+namespace {
+// Journey indices of the comma-separated journey_ids column
+void parseJourneys(const char* text, std::vector<int>& journeys) {
+    journeys.clear();
+    while (*text != '\0') {
+        char* end   = nullptr;
+        long  value = std::strtol(text, &end, 10);
+        if (end == text)
+            break;
+        journeys.push_back(static_cast<int>(value));
+        text = *end == ',' ? end + 1 : end;
+    }
+}
+
+// Turn parsed journey IDs into journey indices of the loaded data, dropping IDs it no longer
+// has; rows saved before journey IDs hold the indices already. Returns the number dropped.
+int toJourneyIndices(std::vector<int>& journeys, bool storedById, const JourneyIdMap& journeyIds) {
+    if (!storedById)
+        return 0;
+
+    size_t kept = 0;
+    for (int journeyId : journeys) {
+        int journeyIdx = journeyIds.getIndex(journeyId);
+        if (journeyIdx >= 0) {
+            journeys[kept++] = journeyIdx;
+        }
+    }
+    int dropped = static_cast<int>(journeys.size() - kept);
+    journeys.resize(kept);
+    return dropped;
+}
+} // namespace
+
+JourneyIdMap::JourneyIdMap(const std::vector<data::ServiceJourney>& journeys) {
+    ids_.reserve(journeys.size());
+    indices_.reserve(journeys.size());
+    for (const auto& journey : journeys) {
+        indices_.emplace(journey.id, static_cast<int>(ids_.size()));
+        ids_.push_back(journey.id);
+    }
+}
+
+int JourneyIdMap::getIndex(int journeyId) const {
+    auto it = indices_.find(journeyId);
+    return (it != indices_.end()) ? it->second : -1;
+}
+
 UnifiedSolutionDatabase::UnifiedSolutionDatabase(const std::string& dbPath, bool verbose)
   : dbPath_(dbPath), verbose_(verbose), initialized_(false) {}
 
@@ -50,7 +98,10 @@ void UnifiedSolutionDatabase::createTables() {
             problem_instance TEXT NOT NULL,
             timestamp TEXT NOT NULL,
             num_vehicles INTEGER NOT NULL,
-            num_journeys INTEGER NOT NULL
+            num_journeys INTEGER NOT NULL,
+            instance_hash TEXT,
+            run_parameters TEXT,
+            journey_key TEXT
         );
     )";
 
@@ -69,8 +120,47 @@ void UnifiedSolutionDatabase::createTables() {
         );
     )";
 
+    const char* createProgressTable = R"(
+        CREATE TABLE IF NOT EXISTS unified_progress_events (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            run_id INTEGER NOT NULL,
+            problem_instance TEXT NOT NULL,
+            method TEXT NOT NULL,
+            seconds REAL NOT NULL,
+            kind TEXT NOT NULL,
+            engine TEXT NOT NULL,
+            value REAL NOT NULL
+        );
+    )";
+
     db_->exec(createSolutionsTable);
     db_->exec(createBlocksTable);
+    db_->exec(createProgressTable);
+
+    // Columns of later versions, added to databases created before them
+    addColumnIfMissing("unified_solutions", "instance_hash", "TEXT");
+    addColumnIfMissing("unified_solutions", "run_parameters", "TEXT");
+    // 'id' where journey_ids lists journey IDs, NULL where older rows list journey indices
+    addColumnIfMissing("unified_solutions", "journey_key", "TEXT");
+
+    // Block lookups by solution (block pools read every block of an instance)
+    db_->exec("CREATE INDEX IF NOT EXISTS idx_unified_blocks_solution "
+              "ON unified_vehicle_blocks(solution_id)");
+    // Result reuse looks up runs by instance content and parameters
+    db_->exec("CREATE INDEX IF NOT EXISTS idx_unified_solutions_run "
+              "ON unified_solutions(instance_hash, run_parameters)");
+}
+
+void UnifiedSolutionDatabase::addColumnIfMissing(const std::string& table,
+                                                 const std::string& column,
+                                                 const std::string& type) {
+    SQLite::Statement columns(*db_, "PRAGMA table_info(" + table + ")");
+    while (columns.executeStep()) {
+        if (columns.getColumn(1).getString() == column)
+            return;
+    }
+    db_->exec("ALTER TABLE " + table + " ADD COLUMN " + column + " " + type);
+    logInfo("Added column " + table + "." + column);
 }
 
 bool UnifiedSolutionDatabase::prepareStatements() {
@@ -78,8 +168,9 @@ bool UnifiedSolutionDatabase::prepareStatements() {
         insertSolutionStmt_ = std::make_unique<SQLite::Statement>(*db_, R"(
             INSERT INTO unified_solutions 
             (algorithm_type, objective_value, solution_time_seconds, status, 
-             problem_instance, timestamp, num_vehicles, num_journeys)
-            VALUES (?, ?, ?, ?, ?, ?, ?, ?)
+             problem_instance, timestamp, num_vehicles, num_journeys,
+             instance_hash, run_parameters, journey_key)
+            VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, 'id')
         )");
 
         insertBlockStmt_ = std::make_unique<SQLite::Statement>(*db_, R"(
@@ -97,11 +188,17 @@ bool UnifiedSolutionDatabase::prepareStatements() {
     }
 }
 
-int UnifiedSolutionDatabase::saveSolution(const UnifiedSolution& solution) {
+int UnifiedSolutionDatabase::saveSolution(const UnifiedSolution& solution,
+                                          const JourneyIdMap&    journeyIds,
+                                          const StopToken&       stop) {
     if (!initialized_) {
         logError("Database not initialized");
         return -1;
     }
+    if (stop.stopRequested()) {
+        logError("Save stopped before it started");
+        return -1;
+    }
 
     try {
         logInfo("Saving unified solution to database...");
@@ -118,19 +215,27 @@ int UnifiedSolutionDatabase::saveSolution(const UnifiedSolution& solution) {
         insertSolutionStmt_->bind(6, solution.timestamp);
         insertSolutionStmt_->bind(7, solution.getNumVehicles());
         insertSolutionStmt_->bind(8, solution.getNumJourneys());
+        // NULL if unknown: such rows only seed warm starts by name, after validation
+        if (solution.instanceHash.empty()) {
+            insertSolutionStmt_->bind(9);
+        }
+        else {
+            insertSolutionStmt_->bind(9, solution.instanceHash);
+        }
+        insertSolutionStmt_->bind(10, solution.runParameters);
 
         insertSolutionStmt_->exec();
         int64_t solutionId = db_->getLastInsertRowid();
 
-        // Save vehicle blocks
-        if (!saveVehicleBlocks(static_cast<int>(solutionId), solution.blocks)) {
+        // Save vehicle blocks, the transaction rolls back on failure or stop
+        insertSolutionStmt_->reset();
+        if (!saveVehicleBlocks(static_cast<int>(solutionId), solution, journeyIds, stop)) {
             logError("Failed to save vehicle blocks");
             return -1;
         }
 
         // Commit transaction
         transaction.commit();
-        insertSolutionStmt_->reset();
 
         logInfo("Solution saved successfully with ID: " + std::to_string(solutionId));
         return static_cast<int>(solutionId);
@@ -141,10 +246,18 @@ int UnifiedSolutionDatabase::saveSolution(const UnifiedSolution& solution) {
     }
 }
 
-bool UnifiedSolutionDatabase::saveVehicleBlocks(int                              solutionId,
-                                                const std::vector<VehicleBlock>& blocks) {
+bool UnifiedSolutionDatabase::saveVehicleBlocks(int                    solutionId,
+                                                const UnifiedSolution& solution,
+                                                const JourneyIdMap&    journeyIds,
+                                                const StopToken&       stop) {
     try {
-        for (const auto& block : blocks) {
+        std::string journeyText; // Reused, so the column text is not reallocated per block
+        for (size_t k = 0; k < solution.blocks.size(); ++k) {
+            const auto& block = solution.blocks[k];
+            if (k % 256 == 0 && stop.stopRequested()) {
+                logError("Save stopped after " + std::to_string(k) + " blocks");
+                return false;
+            }
             insertBlockStmt_->bind(1, solutionId);
             insertBlockStmt_->bind(2, block.blockNumber);
             insertBlockStmt_->bind(3, block.depotId);
@@ -154,13 +267,13 @@ bool UnifiedSolutionDatabase::saveVehicleBlocks(int
             insertBlockStmt_->bind(7, block.totalTime);
 
             // Convert journey IDs to comma-separated string
-            std::ostringstream journeyStream;
-            for (size_t i = 0; i < block.journeyIds.size(); ++i) {
-                if (i > 0)
-                    journeyStream << ",";
-                journeyStream << block.journeyIds[i];
+            journeyText.clear();
+            for (int journeyIdx : solution.journeysOf(block)) {
+                if (!journeyText.empty())
+                    journeyText += ',';
+                journeyText += std::to_string(journeyIds.getId(journeyIdx));
             }
-            insertBlockStmt_->bind(8, journeyStream.str());
+            insertBlockStmt_->bind(8, journeyText);
 
             insertBlockStmt_->exec();
             insertBlockStmt_->reset();
@@ -173,9 +286,206 @@ bool UnifiedSolutionDatabase::saveVehicleBlocks(int
     }
 }
 
-UnifiedSolution UnifiedSolutionDatabase::loadSolution(int solutionId) {
-    // TODO: Implement solution loading by ID
-    return UnifiedSolution();
+int UnifiedSolutionDatabase::saveProgress(const std::string&                problemInstance,
+                                          const std::string&                method,
+                                          const std::vector<ProgressEvent>& events) {
+    if (!initialized_) {
+        logError("Database not initialized");
+        return -1;
+    }
+
+    try {
+        SQLite::Transaction transaction(*db_);
+
+        int runId = db_->execAndGet("SELECT COALESCE(MAX(run_id), 0) + 1 "
+                                    "FROM unified_progress_events")
+                        .getInt();
+
+        SQLite::Statement insert(*db_, R"(
+            INSERT INTO unified_progress_events
+            (run_id, problem_instance, method, seconds, kind, engine, value)
+            VALUES (?, ?, ?, ?, ?, ?, ?)
+        )");
+        for (const auto& event : events) {
+            insert.bind(1, runId);
+            insert.bind(2, problemInstance);
+            insert.bind(3, method);
+            insert.bind(4, event.seconds);
+            insert.bind(5, ProgressEvent::kindName(event.kind));
+            insert.bind(6, event.engine);
+            insert.bind(7, event.value);
+            insert.exec();
+            insert.reset();
+        }
+
+        transaction.commit();
+        logInfo("Progress of run " + std::to_string(runId) + " saved: " +
+                std::to_string(events.size()) + " events");
+        return runId;
+    }
+    catch (const std::exception& e) {
+        logError("Failed to save progress: " + std::string(e.what()));
+        return -1;
+    }
+}
+
+long UnifiedSolutionDatabase::forEachStoredBlock(
+    const std::string&                                                instanceHash,
+    const JourneyIdMap&                                               journeyIds,
+    const std::function<void(const VehicleBlock&, data::JourneySpan)>& visit) {
+    if (!initialized_) {
+        logError("Database not initialized");
+        return -1;
+    }
+
+    try {
+        SQLite::Statement query(*db_, R"(
+            SELECT b.block_number, b.depot_id, b.vehicle_type_id, b.total_cost,
+                   b.total_distance, b.total_time, b.journey_ids, s.journey_key
+            FROM unified_vehicle_blocks b
+            JOIN unified_solutions s ON s.id = b.solution_id
+            WHERE s.instance_hash = ? AND s.status IN ('FEASIBLE', 'OPTIMAL')
+        )");
+        query.bind(1, instanceHash);
+
+        long             visited = 0;
+        std::vector<int> journeys; // Reused, parsed in place from the comma-separated text
+        while (query.executeStep()) {
+            VehicleBlock block{};
+            block.blockNumber   = query.getColumn(0).getInt();
+            block.depotId       = query.getColumn(1).getInt();
+            block.vehicleTypeId = query.getColumn(2).getInt();
+            block.totalCost     = query.getColumn(3).getDouble();
+            block.totalDistance = query.getColumn(4).getDouble();
+            block.totalTime     = query.getColumn(5).getInt();
+
+            parseJourneys(query.getColumn(6).getText(), journeys);
+            toJourneyIndices(journeys, !query.getColumn(7).isNull(), journeyIds);
+            block.journeyCount = static_cast<int>(journeys.size());
+
+            visit(block, journeys);
+            ++visited;
+        }
+
+        logInfo("Visited " + std::to_string(visited) + " stored blocks of instance " +
+                instanceHash);
+        return visited;
+    }
+    catch (const std::exception& e) {
+        logError("Failed to read stored blocks: " + std::string(e.what()));
+        return -1;
+    }
+}
+
+UnifiedSolution UnifiedSolutionDatabase::loadSolution(int                 solutionId,
+                                                      const JourneyIdMap& journeyIds) {
+    if (!initialized_) {
+        logError("Database not initialized");
+        return UnifiedSolution();
+    }
+
+    try {
+        SQLite::Statement query(*db_, R"(
+            SELECT algorithm_type, objective_value, solution_time_seconds, status,
+                   problem_instance, timestamp, instance_hash, run_parameters, journey_key
+            FROM unified_solutions WHERE id = ?
+        )");
+        query.bind(1, solutionId);
+        if (!query.executeStep()) {
+            logInfo("No stored solution with ID " + std::to_string(solutionId));
+            return UnifiedSolution();
+        }
+
+        UnifiedSolution solution(query.getColumn(0).getString(),
+                                 query.getColumn(1).getDouble(),
+                                 query.getColumn(2).getDouble(),
+                                 query.getColumn(3).getString());
+        solution.problemInstance = query.getColumn(4).getString();
+        solution.timestamp       = query.getColumn(5).getString();
+        solution.instanceHash    = query.getColumn(6).getString();
+        solution.runParameters   = query.getColumn(7).getString();
+        solution.storedId        = solutionId;
+        if (!loadVehicleBlocks(solutionId, !query.getColumn(8).isNull(), journeyIds, solution)) {
+            return UnifiedSolution();
+        }
+
+        logInfo("Loaded solution " + std::to_string(solutionId) + " with " +
+                std::to_string(solution.blocks.size()) + " blocks");
+        return solution;
+    }
+    catch (const std::exception& e) {
+        logError("Failed to load solution: " + std::string(e.what()));
+        return UnifiedSolution();
+    }
+}
+
+UnifiedSolution UnifiedSolutionDatabase::loadBestSolution(const std::string&  problemInstance,
+                                                          const std::string&  instanceHash,
+                                                          const JourneyIdMap& journeyIds) {
+    if (!initialized_) {
+        logError("Database not initialized");
+        return UnifiedSolution();
+    }
+
+    try {
+        SQLite::Statement same(*db_, R"(
+            SELECT id FROM unified_solutions
+            WHERE instance_hash = ? AND status IN ('FEASIBLE', 'OPTIMAL')
+            ORDER BY objective_value ASC, id DESC LIMIT 1
+        )");
+        same.bind(1, instanceHash);
+        if (same.executeStep()) {
+            return loadSolution(same.getColumn(0).getInt(), journeyIds);
+        }
+
+        // Otherwise the data has drifted since (or the row predates fingerprints): the
+        // newest solution is the closest to the current data
+        SQLite::Statement drifted(*db_, R"(
+            SELECT id FROM unified_solutions
+            WHERE problem_instance = ?1 AND (instance_hash IS NULL OR instance_hash <> ?2)
+              AND status IN ('FEASIBLE', 'OPTIMAL')
+            ORDER BY id DESC LIMIT 1
+        )");
+        drifted.bind(1, problemInstance);
+        drifted.bind(2, instanceHash);
+        if (!drifted.executeStep()) {
+            logInfo("No stored solution of " + problemInstance);
+            return UnifiedSolution();
+        }
+        return loadSolution(drifted.getColumn(0).getInt(), journeyIds);
+    }
+    catch (const std::exception& e) {
+        logError("Failed to find the best solution: " + std::string(e.what()));
+        return UnifiedSolution();
+    }
+}
+
+UnifiedSolution UnifiedSolutionDatabase::loadStoredResult(const std::string&  instanceHash,
+                                                          const std::string&  runParameters,
+                                                          const JourneyIdMap& journeyIds) {
+    if (!initialized_) {
+        logError("Database not initialized");
+        return UnifiedSolution();
+    }
+
+    try {
+        SQLite::Statement query(*db_, R"(
+            SELECT id FROM unified_solutions
+            WHERE instance_hash = ? AND run_parameters = ?
+              AND status IN ('FEASIBLE', 'OPTIMAL')
+            ORDER BY objective_value ASC, id DESC LIMIT 1
+        )");
+        query.bind(1, instanceHash);
+        query.bind(2, runParameters);
+        if (!query.executeStep()) {
+            return UnifiedSolution();
+        }
+        return loadSolution(query.getColumn(0).getInt(), journeyIds);
+    }
+    catch (const std::exception& e) {
+        logError("Failed to find a stored result: " + std::string(e.what()));
+        return UnifiedSolution();
+    }
 }
 
 std::vector<UnifiedSolution>
@@ -200,9 +510,46 @@ bool UnifiedSolutionDatabase::clearAlgorithm(const std::string& algorithmType) {
     return false;
 }
 
-std::vector<VehicleBlock> UnifiedSolutionDatabase::loadVehicleBlocks(int solutionId) {
-    // TODO: Implement vehicle block loading
-    return std::vector<VehicleBlock>();
+bool UnifiedSolutionDatabase::loadVehicleBlocks(int                 solutionId,
+                                                bool                storedById,
+                                                const JourneyIdMap& journeyIds,
+                                                UnifiedSolution&    solution) {
+    try {
+        SQLite::Statement query(*db_, R"(
+            SELECT block_number, depot_id, vehicle_type_id, total_cost, total_distance,
+                   total_time, journey_ids
+            FROM unified_vehicle_blocks WHERE solution_id = ?
+            ORDER BY block_number
+        )");
+        query.bind(1, solutionId);
+
+        std::vector<int> journeys;
+        int              dropped = 0;
+        while (query.executeStep()) {
+            VehicleBlock block{};
+            block.blockNumber   = query.getColumn(0).getInt();
+            block.depotId       = query.getColumn(1).getInt();
+            block.vehicleTypeId = query.getColumn(2).getInt();
+            block.totalCost     = query.getColumn(3).getDouble();
+            block.totalDistance = query.getColumn(4).getDouble();
+            block.totalTime     = query.getColumn(5).getInt();
+
+            parseJourneys(query.getColumn(6).getText(), journeys);
+            dropped += toJourneyIndices(journeys, storedById, journeyIds);
+            if (!journeys.empty()) {
+                solution.addBlock(block, journeys);
+            }
+        }
+        if (dropped > 0) {
+            logInfo("Dropped " + std::to_string(dropped) + " journeys of solution " +
+                    std::to_string(solutionId) + " the data no longer has");
+        }
+        return true;
+    }
+    catch (const std::exception& e) {
+        logError("Failed to load vehicle blocks: " + std::string(e.what()));
+        return false;
+    }
 }
 
 void UnifiedSolutionDatabase::logInfo(const std::string& message) const {
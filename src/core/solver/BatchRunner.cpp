@@ -0,0 +1,374 @@
+#include "core/BatchRunner.hpp"
+#include "core/ParallelFor.hpp"
+#include "core/Solver.hpp"
+#include "core/UnifiedSolutionDatabase.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace core {
+
+namespace {
+// Queued saves still get this long after a stop, so finished results are kept without a hung
+// database blocking the exit
+constexpr double kDrainSeconds = 10.0;
+
+bool isKnownMethod(const std::string& method) {
+    return method == "greedy" || method == "exact" || method == "meta" || method == "colgen" ||
+           method == "portfolio" || method == "pool";
+}
+
+std::string problemNameOf(const std::string& dataPath) {
+    std::string path = dataPath;
+    while (path.size() > 1 && path.back() == '/') {
+        path.pop_back();
+    }
+    size_t lastSlash = path.find_last_of('/');
+    return lastSlash == std::string::npos ? path : path.substr(lastSlash + 1);
+}
+} // namespace
+
+BatchRunner::BatchRunner(const Config& config)
+  : config_(config),
+    cores_(resolveThreadCount(config.cores)),
+    throughput_(0.0),
+    writesClosed_(false) {}
+
+std::vector<BatchJob> BatchRunner::readManifest(const std::string& manifestPath) const {
+    std::ifstream file(manifestPath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open manifest: " + manifestPath);
+    }
+
+    std::vector<BatchJob> jobs;
+    std::string           line;
+    int                   lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::istringstream fields(line);
+
+        BatchJob job;
+        if (!(fields >> job.dataPath) || job.dataPath[0] == '#')
+            continue;
+
+        auto fail = [&](const std::string& message) {
+            throw std::runtime_error(manifestPath + ":" + std::to_string(lineNumber) + ": " +
+                                     message);
+        };
+        if (!(fields >> job.method)) {
+            fail("missing method");
+        }
+        if (!isKnownMethod(job.method)) {
+            fail("unknown method \"" + job.method + "\"");
+        }
+
+        // Greedy is fast, its limit only bounds the reservation of the scheduler
+        job.timeLimit = job.method == "greedy" ? std::min(config_.timeLimit, 60.0)
+                                               : config_.timeLimit;
+        job.threads   = defaultThreads(job.method);
+        std::string timeLimit;
+        std::string threads;
+        try {
+            if (fields >> timeLimit) {
+                job.timeLimit = std::stod(timeLimit);
+            }
+            if (fields >> threads) {
+                job.threads = std::stoi(threads);
+            }
+        }
+        catch (const std::exception&) {
+            fail("bad time limit or thread count");
+        }
+        if (job.timeLimit <= 0.0 || job.threads <= 0) {
+            fail("time limit and thread count must be positive");
+        }
+
+        job.threads     = std::min(job.threads, cores_);
+        job.problemName = problemNameOf(job.dataPath);
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+std::vector<BatchResult> BatchRunner::run(const std::vector<BatchJob>& jobs) {
+    auto startTime = std::chrono::steady_clock::now();
+    log("Running " + std::to_string(jobs.size()) + " jobs on " + std::to_string(cores_) +
+        " cores");
+
+    std::vector<BatchResult> results(jobs.size());
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        results[j].job         = jobs[j];
+        results[j].job.threads = std::max(1, std::min(jobs[j].threads, cores_));
+    }
+
+    writesClosed_ = false;
+    writeStop_    = StopToken();
+    std::thread writer;
+    if (!config_.databasePath.empty()) {
+        writer = std::thread(&BatchRunner::writerLoop, this, std::ref(results));
+    }
+
+    std::mutex               scheduleMutex;
+    std::condition_variable  jobDone;
+    int                      freeCores = cores_;
+    int                      completed = 0;
+    std::vector<int>         state(jobs.size(), 0); // 0 pending, 1 running, 2 done
+    std::vector<double>      expectedEnd(jobs.size(), 0.0);
+    std::vector<std::thread> running;
+    running.reserve(jobs.size());
+
+    auto elapsed = [&startTime]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime)
+            .count();
+    };
+
+    size_t numStarted = 0;
+    while (numStarted < jobs.size()) {
+        std::unique_lock<std::mutex> lock(scheduleMutex);
+        if (config_.stop.stopRequested()) {
+            log("Stopped, " + std::to_string(jobs.size() - numStarted) + " jobs not started");
+            for (size_t j = 0; j < jobs.size(); ++j) {
+                if (state[j] == 0) {
+                    results[j].status = "STOPPED";
+                }
+            }
+            break;
+        }
+
+        double                       now        = elapsed();
+        bool                         reserved   = false;
+        double                       shadowTime = 0.0; // Reserved job starts by then
+        int                          spareCores = 0;   // Left over at the shadow time
+        bool                         launched   = false;
+
+        for (size_t j = 0; j < jobs.size(); ++j) {
+            int threads = results[j].job.threads;
+            if (state[j] != 0)
+                continue;
+
+            if (threads > freeCores) {
+                if (!reserved) {
+                    reserved = true;
+                    reserve(results, state, expectedEnd, freeCores, j, shadowTime, spareCores);
+                }
+                continue;
+            }
+            // Later jobs may not delay the reserved one: they end before it starts or
+            // only use cores it leaves free
+            if (reserved && now + results[j].job.timeLimit > shadowTime) {
+                if (threads > spareCores)
+                    continue;
+                spareCores -= threads;
+            }
+
+            state[j]       = 1;
+            expectedEnd[j] = now + results[j].job.timeLimit;
+            freeCores -= threads;
+            ++numStarted;
+            launched = true;
+            running.emplace_back([&, j, threads]() {
+                runJob(results[j].job, static_cast<int>(j), results[j]);
+
+                std::lock_guard<std::mutex> doneLock(scheduleMutex);
+                state[j] = 2;
+                freeCores += threads;
+                ++completed;
+                log(std::to_string(completed) + "/" + std::to_string(jobs.size()) + " " +
+                    results[j].job.problemName + " " + results[j].job.method + ": " +
+                    results[j].status + " " + std::to_string(results[j].objective) + " in " +
+                    std::to_string(results[j].wallSeconds) + "s" +
+                    (results[j].error.empty() ? "" : " (" + results[j].error + ")"));
+                jobDone.notify_one();
+            });
+        }
+        if (!launched) {
+            // Woken by a finished job, or now and then to notice a stop
+            jobDone.wait_for(lock, std::chrono::milliseconds(200));
+        }
+    }
+    for (auto& thread : running) {
+        thread.join();
+    }
+
+    if (writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(writeMutex_);
+            writesClosed_ = true;
+            if (config_.stop.stopRequested()) {
+                writeStop_ = StopToken::withTimeLimit(kDrainSeconds);
+            }
+        }
+        writeReady_.notify_one();
+        writer.join();
+    }
+
+    double wallSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    throughput_ = wallSeconds > 0.0 ? jobs.size() * 3600.0 / wallSeconds : 0.0;
+    printSummary(results, wallSeconds);
+    return results;
+}
+
+void BatchRunner::runJob(const BatchJob& job, int resultIndex, BatchResult& result) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    try {
+        MDVSPSolver solver;
+        if (!solver.loadProblem(job.dataPath, config_.preprocess, config_.stop)) {
+            throw std::runtime_error("failed to load " + job.dataPath);
+        }
+
+        MDVSPSolver::SolverConfig solverConfig;
+        solverConfig.method        = job.method;
+        solverConfig.problemName   = job.problemName;
+        solverConfig.timeLimit     = job.timeLimit;
+        solverConfig.optimalityGap = config_.optimalityGap;
+        solverConfig.threads       = job.threads;
+        solverConfig.verbose       = config_.verbose;
+        solverConfig.stop          = config_.stop;
+        solverConfig.poolDatabase  = config_.databasePath;
+        if (config_.warmStart) {
+            solverConfig.warmStartDatabase = config_.databasePath;
+        }
+        if (config_.reuseResults) {
+            solverConfig.reuseDatabase = config_.databasePath;
+        }
+
+        UnifiedSolution solution = solver.solve(solverConfig);
+        result.status            = solution.status;
+        result.algorithm         = solution.algorithmType;
+        result.objective         = solution.objectiveValue;
+        result.vehicles          = solution.getNumVehicles();
+
+        // A reused result is stored already; no write is queued, so the writer never sets
+        // its solutionId
+        if (solution.storedId >= 0) {
+            result.reused     = true;
+            result.solutionId = solution.storedId;
+        }
+        else if (solution.isFeasible() && !config_.databasePath.empty()) {
+            JourneyIdMap                journeyIds(solver.getDataLoader()->getServiceJourneys());
+            std::lock_guard<std::mutex> lock(writeMutex_);
+            writes_.push_back({resultIndex, std::move(solution), std::move(journeyIds)});
+            writeReady_.notify_one();
+        }
+    }
+    catch (const std::exception& e) {
+        result.status = "ERROR";
+        result.error  = e.what();
+    }
+
+    result.wallSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void BatchRunner::writerLoop(std::vector<BatchResult>& results) {
+    UnifiedSolutionDatabase database(config_.databasePath, config_.verbose);
+    bool                    available = database.initialize();
+    if (!available) {
+        std::cerr << "[BatchRunner] Database not available, results are not saved: "
+                  << config_.databasePath << std::endl;
+    }
+
+    while (true) {
+        PendingWrite write;
+        StopToken    stop;
+        {
+            std::unique_lock<std::mutex> lock(writeMutex_);
+            writeReady_.wait(lock, [this]() { return writesClosed_ || !writes_.empty(); });
+            if (writes_.empty())
+                return;
+            write = std::move(writes_.front());
+            writes_.pop_front();
+            stop  = writeStop_;
+        }
+
+        // Only the writer sets solutionId, the job thread leaves it alone
+        if (available) {
+            results[write.resultIndex].solutionId =
+                database.saveSolution(write.solution, write.journeyIds, stop);
+        }
+    }
+}
+
+void BatchRunner::printSummary(const std::vector<BatchResult>& results, double wallSeconds) const {
+    int    feasible    = 0;
+    int    failed      = 0;
+    int    saved       = 0;
+    int    reused      = 0;
+    double coreSeconds = 0.0;
+    for (const auto& result : results) {
+        if (result.status == "FEASIBLE" || result.status == "OPTIMAL") {
+            ++feasible;
+        }
+        else if (result.status == "ERROR") {
+            ++failed;
+        }
+        if (result.reused) {
+            ++reused;
+        }
+        else if (result.solutionId > 0) {
+            ++saved;
+        }
+        coreSeconds += result.wallSeconds * result.job.threads;
+    }
+
+    std::cout << "=== Batch Summary ===" << std::endl;
+    std::cout << "  Jobs: " << results.size() << " (" << feasible << " feasible, " << failed
+              << " failed, " << saved << " saved, " << reused << " reused)" << std::endl;
+    std::cout << "  Wall time: " << std::fixed << std::setprecision(3) << wallSeconds << "s"
+              << std::endl;
+    std::cout << "  Throughput: " << std::setprecision(1) << throughput_ << " instances/hour"
+              << std::endl;
+    if (wallSeconds > 0.0) {
+        std::cout << "  Core utilization: " << std::setprecision(1)
+                  << 100.0 * coreSeconds / (wallSeconds * cores_) << "% of " << cores_
+                  << " cores" << std::endl;
+    }
+}
+
+void BatchRunner::reserve(const std::vector<BatchResult>& results,
+                          const std::vector<int>&         state,
+                          const std::vector<double>&      expectedEnd,
+                          int                             freeCores,
+                          size_t                          job,
+                          double&                         shadowTime,
+                          int&                            spareCores) const {
+    // Running jobs by expected end, until enough cores are free for the reserved job
+    std::vector<size_t> ends;
+    for (size_t j = 0; j < state.size(); ++j) {
+        if (state[j] == 1) {
+            ends.push_back(j);
+        }
+    }
+    std::sort(ends.begin(), ends.end(),
+              [&expectedEnd](size_t a, size_t b) { return expectedEnd[a] < expectedEnd[b]; });
+
+    int needed = results[job].job.threads;
+    shadowTime = 0.0;
+    for (size_t j : ends) {
+        if (freeCores >= needed)
+            break;
+        freeCores += results[j].job.threads;
+        shadowTime = expectedEnd[j];
+    }
+    spareCores = freeCores - needed;
+}
+
+int BatchRunner::defaultThreads(const std::string& method) const {
+    if (method == "greedy")
+        return 1;
+    return std::max(1, config_.exactThreads);
+}
+
+void BatchRunner::log(const std::string& message) const {
+    std::cout << "[BatchRunner] " << message << std::endl;
+}
+
+} // namespace core
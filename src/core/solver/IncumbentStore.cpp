@@ -0,0 +1,47 @@
+#include "core/IncumbentStore.hpp"
+#include <limits>
+
+namespace core {
+
+IncumbentStore::~IncumbentStore() {
+    Snapshot* snapshot = all_.load(std::memory_order_acquire);
+    while (snapshot != nullptr) {
+        Snapshot* next = snapshot->next;
+        delete snapshot;
+        snapshot = next;
+    }
+}
+
+bool IncumbentStore::offer(const UnifiedSolution& solution) {
+    // Cheap rejection before copying the solution
+    if (!(solution.objectiveValue < getObjective()))
+        return false;
+
+    auto* snapshot = new Snapshot{solution, all_.load(std::memory_order_relaxed)};
+    while (!all_.compare_exchange_weak(
+        snapshot->next, snapshot, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+
+    Snapshot* current = best_.load(std::memory_order_acquire);
+    while (current == nullptr ||
+           snapshot->solution.objectiveValue < current->solution.objectiveValue) {
+        if (best_.compare_exchange_weak(
+                current, snapshot, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            version_.fetch_add(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+    return false;
+}
+
+double IncumbentStore::getObjective() const {
+    const Snapshot* current = best_.load(std::memory_order_acquire);
+    return current ? current->solution.objectiveValue : std::numeric_limits<double>::infinity();
+}
+
+const UnifiedSolution* IncumbentStore::get() const {
+    const Snapshot* current = best_.load(std::memory_order_acquire);
+    return current ? &current->solution : nullptr;
+}
+
+} // namespace core
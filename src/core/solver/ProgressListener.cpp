@@ -0,0 +1,166 @@
+#include "core/ProgressListener.hpp"
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <utility>
+
+namespace core {
+
+const char* ProgressEvent::kindName(Kind kind) {
+    switch (kind) {
+        case Kind::Phase:
+            return "phase";
+        case Kind::Incumbent:
+            return "incumbent";
+        case Kind::Bound:
+            return "bound";
+    }
+    return "unknown";
+}
+
+void ConsoleProgressSink::onEvent(const ProgressEvent& event) {
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(3) << "[Progress] " << event.seconds << "s "
+         << event.engine << ' ' << ProgressEvent::kindName(event.kind);
+    if (event.kind != ProgressEvent::Kind::Phase) {
+        line << ' ' << std::setprecision(2) << event.value;
+    }
+    line << '\n';
+    std::cout << line.str() << std::flush;
+}
+
+CsvProgressSink::CsvProgressSink(const std::string& path, const std::string& run) : run_(run) {
+    csv_.open(path, std::ios::app);
+    if (!csv_.is_open()) {
+        std::cerr << "[Progress] Cannot open " << path << std::endl;
+    }
+    else if (csv_.tellp() == 0) {
+        csv_ << "run,seconds,kind,engine,value\n";
+    }
+}
+
+void CsvProgressSink::onEvent(const ProgressEvent& event) {
+    if (!csv_.is_open())
+        return;
+    csv_ << run_ << ',' << std::fixed << std::setprecision(6) << event.seconds << ','
+         << ProgressEvent::kindName(event.kind) << ',' << event.engine << ','
+         << std::setprecision(4) << event.value << '\n';
+}
+
+void CsvProgressSink::finish() {
+    if (csv_.is_open()) {
+        csv_.flush();
+    }
+}
+
+ProgressListener::ProgressListener()
+  : start_(std::chrono::steady_clock::now()),
+    bestIncumbent_(std::numeric_limits<double>::infinity()),
+    bestBound_(-std::numeric_limits<double>::infinity()),
+    closing_(false) {
+    dispatcher_ = std::thread(&ProgressListener::run, this);
+}
+
+ProgressListener::~ProgressListener() { close(); }
+
+void ProgressListener::addSink(std::unique_ptr<ProgressSink> sink) {
+    std::lock_guard<std::mutex> lock(sinkMutex_);
+    sinks_.push_back(std::move(sink));
+}
+
+void ProgressListener::phase(const char* engine) {
+    report(ProgressEvent::Kind::Phase, engine, 0.0);
+}
+
+void ProgressListener::incumbent(const char* engine, double objective) {
+    report(ProgressEvent::Kind::Incumbent, engine, objective);
+}
+
+void ProgressListener::bound(const char* engine, double bound) {
+    report(ProgressEvent::Kind::Bound, engine, bound);
+}
+
+void ProgressListener::report(ProgressEvent::Kind kind, const char* engine, double value) {
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (kind == ProgressEvent::Kind::Incumbent) {
+        if (value >= bestIncumbent_)
+            return;
+        bestIncumbent_ = value;
+    }
+    else if (kind == ProgressEvent::Kind::Bound) {
+        if (value <= bestBound_)
+            return;
+        bestBound_ = value;
+    }
+
+    ProgressEvent event{kind, seconds, engine, value};
+    history_.push_back(event);
+    if (!closing_) {
+        pending_.push_back(event);
+        ready_.notify_one();
+    }
+}
+
+void ProgressListener::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closing_)
+            return;
+        closing_ = true;
+    }
+    ready_.notify_one();
+    dispatcher_.join();
+
+    std::lock_guard<std::mutex> lock(sinkMutex_);
+    for (auto& sink : sinks_) {
+        sink->finish();
+    }
+}
+
+std::vector<ProgressEvent> ProgressListener::getEvents() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return history_;
+}
+
+double ProgressListener::timeToTarget(double target) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& event : history_) {
+        if (event.kind == ProgressEvent::Kind::Incumbent && event.value <= target)
+            return event.seconds;
+    }
+    return -1.0;
+}
+
+void ProgressListener::run() {
+    std::vector<ProgressEvent> events;
+    while (true) {
+        bool last = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this]() { return closing_ || !pending_.empty(); });
+            events.swap(pending_);
+            last = closing_;
+        }
+        dispatch(events);
+        events.clear();
+        if (last)
+            return;
+    }
+}
+
+void ProgressListener::dispatch(const std::vector<ProgressEvent>& events) {
+    if (events.empty())
+        return;
+    std::lock_guard<std::mutex> lock(sinkMutex_);
+    for (const auto& event : events) {
+        for (auto& sink : sinks_) {
+            sink->onEvent(event);
+        }
+    }
+}
+
+} // namespace core
@@ -0,0 +1,193 @@
+#include "core/RollingHorizon.hpp"
+#include "core/CostPolicy.hpp"
+#include <algorithm>
+#include <climits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace core {
+
+RollingHorizon::RollingHorizon(const data::DataLoader& dataLoader,
+                               int                     windowSeconds,
+                               int                     overlapSeconds)
+  : dataLoader_(dataLoader), nextJourneyId_(0) {
+    if (windowSeconds <= 0 || overlapSeconds < 0 || overlapSeconds >= windowSeconds) {
+        throw std::invalid_argument("Rolling horizon needs 0 <= overlap < window length");
+    }
+
+    const auto& journeys = dataLoader_.getServiceJourneys();
+    order_.resize(journeys.size());
+    std::iota(order_.begin(), order_.end(), 0);
+    std::stable_sort(order_.begin(), order_.end(), [&journeys](int a, int b) {
+        return journeys[a].depTime < journeys[b].depTime;
+    });
+    for (const auto& journey : journeys) {
+        nextJourneyId_ = std::max(nextJourneyId_, journey.id + 1);
+    }
+    if (order_.empty())
+        return;
+
+    // Position of the first journey departing at or after a time
+    auto positionOf = [&](int time) {
+        return static_cast<int>(
+            std::lower_bound(order_.begin(), order_.end(), time, [&journeys](int j, int t) {
+                return journeys[j].depTime < t;
+            }) -
+            order_.begin());
+    };
+
+    int lastDeparture = journeys[order_.back()].depTime;
+    int beginTime     = journeys[order_.front()].depTime;
+    while (true) {
+        HorizonWindow window;
+        window.beginTime    = beginTime;
+        window.endTime      = beginTime + windowSeconds;
+        window.firstJourney = positionOf(beginTime);
+
+        if (window.endTime > lastDeparture) {
+            window.commitTime  = INT_MAX;
+            window.lastJourney = static_cast<int>(order_.size());
+            windows_.push_back(window);
+            break;
+        }
+        window.commitTime  = beginTime + windowSeconds - overlapSeconds;
+        window.lastJourney = positionOf(window.endTime);
+        windows_.push_back(window);
+        beginTime = window.commitTime;
+    }
+}
+
+std::unique_ptr<data::DataLoader> RollingHorizon::prepareWindow(int window) const {
+    const auto& w = windows_[window];
+
+    std::vector<int> journeys(order_.begin() + w.firstJourney, order_.begin() + w.lastJourney);
+
+    std::vector<std::pair<int, int>> slots;
+    const auto&                      vehicleTypes = dataLoader_.getVehicleTypes();
+    const auto&                      depotStops   = dataLoader_.getDepotStops();
+    for (int d = 0; d < static_cast<int>(depotStops.size()); ++d) {
+        for (int t = 0; t < static_cast<int>(vehicleTypes.size()); ++t) {
+            if (dataLoader_.getVehicleCapacityAtStop(vehicleTypes[t].id, depotStops[d]) > 0) {
+                slots.emplace_back(d, t);
+            }
+        }
+    }
+    return dataLoader_.createSubproblem(journeys, slots);
+}
+
+void RollingHorizon::addStartStates(data::DataLoader& windowData) const {
+    const auto& journeys = dataLoader_.getServiceJourneys();
+
+    std::unordered_map<int, int> groupOfType;
+    int                          journeyId = nextJourneyId_;
+    for (const auto& block : fixed_) {
+        auto group = groupOfType.find(block.vehicleTypeId);
+        if (group == groupOfType.end()) {
+            int groupId = windowData.addVehicleTypeGroup(
+                {block.vehicleTypeId}, "START_V" + std::to_string(block.vehicleTypeId));
+            group = groupOfType.emplace(block.vehicleTypeId, groupId).first;
+        }
+
+        // Only the ends matter to the window, the covered service cost is a constant
+        const auto&          first      = journeys[block.journeys.front()];
+        const auto&          last       = journeys[block.journeys.back()];
+        data::ServiceJourney startState = first;
+
+        startState.id                      = journeyId++;
+        startState.toStopId                = last.toStopId;
+        startState.arrTime                 = last.arrTime;
+        startState.minLayoverTime          = last.minLayoverTime;
+        startState.vehTypeGroupId          = group->second;
+        startState.maxShiftBackwardSeconds = 0;
+        startState.maxShiftForwardSeconds  = 0;
+        startState.distance                = 0.0;
+        for (int journeyIdx : block.journeys) {
+            startState.distance += journeys[journeyIdx].distance;
+        }
+        windowData.addServiceJourney(startState);
+    }
+}
+
+void RollingHorizon::commit(int window, const UnifiedSolution& solution) {
+    const auto& journeys = dataLoader_.getServiceJourneys();
+    const auto& w        = windows_[window];
+    int         numNew   = w.lastJourney - w.firstJourney;
+
+    std::vector<FixedBlock> previous = std::move(fixed_);
+    fixed_.clear();
+    for (const auto& block : solution.blocks) {
+        FixedBlock fixed{block.depotId, block.vehicleTypeId, {}};
+        for (int journeyIdx : solution.journeysOf(block)) {
+            if (journeyIdx < numNew) {
+                fixed.journeys.push_back(order_[w.firstJourney + journeyIdx]);
+            }
+            else {
+                const auto& startState = previous[journeyIdx - numNew].journeys;
+                fixed.journeys.insert(fixed.journeys.end(), startState.begin(), startState.end());
+            }
+        }
+
+        // Journeys of the overlap go back to the next window
+        auto cut = std::find_if(fixed.journeys.begin(), fixed.journeys.end(), [&](int j) {
+            return journeys[j].depTime >= w.commitTime;
+        });
+        fixed.journeys.erase(cut, fixed.journeys.end());
+        if (!fixed.journeys.empty()) {
+            fixed_.push_back(std::move(fixed));
+        }
+    }
+}
+
+void RollingHorizon::addBlocks(UnifiedSolution& solution) const {
+    size_t numJourneys = 0;
+    for (const auto& fixed : fixed_) {
+        numJourneys += fixed.journeys.size();
+    }
+    solution.blocks.reserve(solution.blocks.size() + fixed_.size());
+    solution.journeys.reserve(solution.journeys.size() + numJourneys);
+
+    for (const auto& fixed : fixed_) {
+        VehicleBlock block{};
+        block.blockNumber   = static_cast<int>(solution.blocks.size()) + 1;
+        block.depotId       = fixed.depotId;
+        block.vehicleTypeId = fixed.vehicleTypeId;
+        evaluateBlock(block, fixed.journeys);
+        solution.addBlock(block, fixed.journeys);
+    }
+}
+
+void RollingHorizon::evaluateBlock(VehicleBlock& block, data::JourneySpan blockJourneys) const {
+    using Cost = DefaultCostPolicy;
+
+    const auto* vehicleType = dataLoader_.getVehicleType(block.vehicleTypeId);
+    CostRates   rates       = vehicleType ? CostRates(*vehicleType) : CostRates();
+    const auto& journeys    = dataLoader_.getServiceJourneys();
+
+    block.totalCost     = rates.vehicleCost;
+    block.totalDistance = 0.0;
+    block.totalTime     = 0;
+
+    auto addDeadRun = [&](int fromStopId, int toStopId) {
+        double distance = dataLoader_.getDeadRunDistance(fromStopId, toStopId);
+        int    time     = dataLoader_.getDeadRunTime(fromStopId, toStopId);
+        block.totalCost += Cost::deadRunCost(rates, distance, time);
+        if (distance > 0 && time > 0) {
+            block.totalDistance += distance;
+            block.totalTime += time;
+        }
+    };
+
+    int stopId = block.depotId;
+    for (int journeyIdx : blockJourneys) {
+        const auto& journey = journeys[journeyIdx];
+        addDeadRun(stopId, journey.fromStopId);
+        block.totalCost += Cost::serviceCost(rates, journey);
+        block.totalDistance += journey.distance;
+        block.totalTime += journey.arrTime - journey.depTime;
+        stopId = journey.toStopId;
+    }
+    addDeadRun(stopId, block.depotId);
+}
+
+} // namespace core
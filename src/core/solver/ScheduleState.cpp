@@ -0,0 +1,140 @@
+#include "core/ScheduleState.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace core {
+
+namespace {
+std::vector<int> depotCapacities(const data::DataLoader& dataLoader) {
+    const auto& depots       = dataLoader.getDepotStops();
+    const auto& vehicleTypes = dataLoader.getVehicleTypes();
+
+    std::vector<int> capacities(depots.size() * vehicleTypes.size(), 0);
+    for (size_t d = 0; d < depots.size(); ++d) {
+        for (size_t t = 0; t < vehicleTypes.size(); ++t) {
+            capacities[d * vehicleTypes.size() + t] =
+                dataLoader.getVehicleCapacityAtStop(vehicleTypes[t].id, depots[d]);
+        }
+    }
+    return capacities;
+}
+} // namespace
+
+ScheduleState::ScheduleState(int numJourneys, std::vector<int> capacities, int numVehicleTypes)
+  : numJourneys_(numJourneys),
+    numVehicleTypes_(numVehicleTypes),
+    numAssigned_(0),
+    epoch_(1),
+    words_((static_cast<size_t>(numJourneys) + 63) / 64, 0),
+    wordEpoch_(words_.size(), 0),
+    capacity_(std::move(capacities)),
+    used_(capacity_.size(), 0),
+    usedEpoch_(capacity_.size(), 0),
+    openCheckpoints_(0) {}
+
+ScheduleState::ScheduleState(const data::DataLoader& dataLoader)
+  : ScheduleState(static_cast<int>(dataLoader.getServiceJourneys().size()),
+                  depotCapacities(dataLoader),
+                  static_cast<int>(dataLoader.getVehicleTypes().size())) {}
+
+void ScheduleState::assign(int journey) {
+    if (isAssigned(journey))
+        return;
+    setBit(journey, true);
+    record(Change::Assign, journey);
+}
+
+void ScheduleState::unassign(int journey) {
+    if (!isAssigned(journey))
+        return;
+    setBit(journey, false);
+    record(Change::Unassign, journey);
+}
+
+void ScheduleState::acquire(int depotIndex, int vehicleTypeIndex) {
+    int slot = depotIndex * numVehicleTypes_ + vehicleTypeIndex;
+    addUsed(slot, 1);
+    record(Change::Acquire, slot);
+}
+
+void ScheduleState::release(int depotIndex, int vehicleTypeIndex) {
+    int slot = depotIndex * numVehicleTypes_ + vehicleTypeIndex;
+    addUsed(slot, -1);
+    record(Change::Release, slot);
+}
+
+void ScheduleState::rollback(Checkpoint checkpoint) {
+    while (undoLog_.size() > checkpoint) {
+        const auto& entry = undoLog_.back();
+        switch (entry.change) {
+            case Change::Assign:
+                setBit(entry.index, false);
+                break;
+            case Change::Unassign:
+                setBit(entry.index, true);
+                break;
+            case Change::Acquire:
+                addUsed(entry.index, -1);
+                break;
+            case Change::Release:
+                addUsed(entry.index, 1);
+                break;
+        }
+        undoLog_.pop_back();
+    }
+    commit(checkpoint);
+}
+
+void ScheduleState::commit(Checkpoint) {
+    if (openCheckpoints_ > 0 && --openCheckpoints_ == 0) {
+        undoLog_.clear();
+    }
+}
+
+void ScheduleState::reset() {
+    numAssigned_     = 0;
+    openCheckpoints_ = 0;
+    undoLog_.clear();
+
+    // Every stamp is older than the new epoch; only a wrap-around needs a real clear
+    if (++epoch_ == 0) {
+        std::fill(wordEpoch_.begin(), wordEpoch_.end(), 0);
+        std::fill(usedEpoch_.begin(), usedEpoch_.end(), 0);
+        epoch_ = 1;
+    }
+}
+
+uint64_t& ScheduleState::touchWord(int w) {
+    if (wordEpoch_[w] != epoch_) {
+        wordEpoch_[w] = epoch_;
+        words_[w]     = 0;
+    }
+    return words_[w];
+}
+
+int& ScheduleState::touchUsed(int slot) {
+    if (usedEpoch_[slot] != epoch_) {
+        usedEpoch_[slot] = epoch_;
+        used_[slot]      = 0;
+    }
+    return used_[slot];
+}
+
+void ScheduleState::setBit(int journey, bool value) {
+    uint64_t  bit  = uint64_t{1} << (journey & 63);
+    uint64_t& word = touchWord(journey >> 6);
+    word           = value ? word | bit : word & ~bit;
+    numAssigned_ += value ? 1 : -1;
+}
+
+void ScheduleState::addUsed(int slot, int delta) {
+    touchUsed(slot) += delta;
+}
+
+void ScheduleState::record(Change change, int index) {
+    if (openCheckpoints_ > 0) {
+        undoLog_.push_back({change, index});
+    }
+}
+
+} // namespace core
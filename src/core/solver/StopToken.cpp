@@ -0,0 +1,83 @@
+#include "core/StopToken.hpp"
+#include <algorithm>
+#include <csignal>
+#include <limits>
+
+namespace core {
+
+namespace {
+// Flag the SIGINT handler sets; kept alive by the token registered in stopOnInterrupt()
+std::shared_ptr<void>    interruptOwner;
+std::atomic<bool>* volatile interruptFlag = nullptr;
+
+extern "C" void handleInterrupt(int) {
+    if (interruptFlag != nullptr) {
+        interruptFlag->store(true);
+    }
+    std::signal(SIGINT, SIG_DFL);
+}
+
+StopToken::Clock::time_point deadlineAfter(double seconds) {
+    if (!(seconds < 1e9)) {
+        return StopToken::Clock::time_point::max();
+    }
+    return StopToken::Clock::now() +
+           std::chrono::duration_cast<StopToken::Clock::duration>(
+               std::chrono::duration<double>(std::max(0.0, seconds)));
+}
+} // namespace
+
+StopToken::StopToken() : state_(std::make_shared<State>()) {
+    state_->deadline = Clock::time_point::max();
+}
+
+StopToken StopToken::withTimeLimit(double seconds) {
+    return StopToken().child(seconds);
+}
+
+StopToken StopToken::child(double seconds) const {
+    auto state      = std::make_shared<State>();
+    state->deadline = std::min(state_->deadline, deadlineAfter(seconds));
+    state->parent   = state_;
+    return StopToken(std::move(state));
+}
+
+StopToken StopToken::share(double fraction) const {
+    double seconds = remaining();
+    return child(seconds == std::numeric_limits<double>::infinity() ? seconds
+                                                                     : seconds * fraction);
+}
+
+void StopToken::requestStop() const {
+    state_->stopped.store(true, std::memory_order_relaxed);
+}
+
+bool StopToken::stopRequested() const {
+    if (interrupted())
+        return true;
+    return state_->deadline != Clock::time_point::max() && Clock::now() >= state_->deadline;
+}
+
+bool StopToken::interrupted() const {
+    for (const State* state = state_.get(); state != nullptr; state = state->parent.get()) {
+        if (state->stopped.load(std::memory_order_relaxed))
+            return true;
+    }
+    return false;
+}
+
+double StopToken::remaining() const {
+    if (stopRequested())
+        return 0.0;
+    if (state_->deadline == Clock::time_point::max())
+        return std::numeric_limits<double>::infinity();
+    return std::chrono::duration<double>(state_->deadline - Clock::now()).count();
+}
+
+void StopToken::stopOnInterrupt(const StopToken& token) {
+    interruptOwner = token.state_;
+    interruptFlag  = &token.state_->stopped;
+    std::signal(SIGINT, handleInterrupt);
+}
+
+} // namespace core
@@ -0,0 +1,328 @@
+#include "core/SolutionValidator.hpp"
+#include "core/ParallelFor.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+
+namespace core {
+
+std::string Violation::describe() const {
+    std::ostringstream out;
+    out << SolutionValidator::kindName(kind) << ":";
+    const char* separator = " ";
+    auto        field     = [&](const char* name, long long value) {
+        out << separator << name << " " << value;
+        separator = ", ";
+    };
+    if (block >= 0)
+        field("block", block);
+    if (position >= 0)
+        field("position", position);
+    if (journey >= 0)
+        field("journey", journey);
+    if (depotId >= 0)
+        field("depot", depotId);
+    if (vehicleTypeId >= 0)
+        field("vehicle type", vehicleTypeId);
+    if (kind == Kind::Capacity || kind == Kind::BlockCost || kind == Kind::Objective) {
+        out << separator << "expected " << expected << ", found " << actual;
+    }
+    return out.str();
+}
+
+int ValidationReport::count(Violation::Kind kind) const {
+    return static_cast<int>(
+        std::count_if(violations.begin(), violations.end(), [kind](const Violation& violation) {
+            return violation.kind == kind;
+        }));
+}
+
+std::string ValidationReport::summary() const {
+    if (violations.empty())
+        return stopped ? "incomplete" : "valid";
+
+    std::vector<int> counts(static_cast<int>(Violation::Kind::Objective) + 1, 0);
+    for (const auto& violation : violations) {
+        ++counts[static_cast<int>(violation.kind)];
+    }
+
+    std::string text;
+    for (size_t k = 0; k < counts.size(); ++k) {
+        if (counts[k] == 0)
+            continue;
+        if (!text.empty()) {
+            text += ", ";
+        }
+        text += std::to_string(counts[k]) + " " +
+                SolutionValidator::kindName(static_cast<Violation::Kind>(k));
+    }
+    if (stopped)
+        return text + " (incomplete)";
+    return truncated ? text + " (truncated)" : text;
+}
+
+SolutionValidator::SolutionValidator(const network::ConnectionNetwork& network)
+  : network_(network) {
+    int numDepots = network_.getNumDepots();
+    int numTypes  = network_.getNumVehicleTypes();
+    slotCapacity_.resize(static_cast<size_t>(numDepots) * numTypes);
+    for (int d = 0; d < numDepots; ++d) {
+        for (int t = 0; t < numTypes; ++t) {
+            slotCapacity_[d * numTypes + t] = std::max(0, network_.getCapacity(d, t));
+        }
+    }
+}
+
+ValidationReport SolutionValidator::validate(const UnifiedSolution& solution) const {
+    return validate(solution, Options());
+}
+
+ValidationReport SolutionValidator::validate(const UnifiedSolution& solution,
+                                             const Options&         options) const {
+    const auto& dataLoader  = network_.getDataLoader();
+    int         numJourneys = network_.getNumJourneys();
+    int         numBlocks   = static_cast<int>(solution.blocks.size());
+    size_t      numWords    = (static_cast<size_t>(numJourneys) + 63) / 64;
+
+    // Coverage bitsets: a bit already set in seen means the journey is served twice
+    std::vector<std::atomic<uint64_t>> seen(numWords);
+    std::vector<std::atomic<uint64_t>> twice(numWords);
+    std::atomic<bool>                  anyTwice{false};
+    std::atomic<bool>                  stopped{false};
+
+    std::vector<std::vector<Violation>> blockViolations(numBlocks);
+    std::vector<double>                 blockCosts(numBlocks, 0.0);
+    std::vector<int>                    blockSlots(numBlocks, -1);
+
+    parallelFor(numBlocks, options.threads, [&](int b) {
+        if (stopped.load(std::memory_order_relaxed) ||
+            (b % 64 == 0 && options.stop.stopRequested())) {
+            stopped.store(true, std::memory_order_relaxed);
+            return;
+        }
+        const auto& block = solution.blocks[b];
+        if (!hasJourneyRange(solution, block)) {
+            Violation violation{Violation::Kind::JourneyRange};
+            violation.block = b;
+            blockViolations[b].push_back(violation);
+            return;
+        }
+        auto journeys = solution.journeysOf(block);
+        blockSlots[b] = checkBlock(block, journeys, b, options, blockViolations[b], blockCosts[b]);
+
+        for (int journeyIdx : journeys) {
+            if (journeyIdx < 0 || journeyIdx >= numJourneys)
+                continue;
+            uint64_t bit = uint64_t{1} << (journeyIdx & 63);
+            if (seen[journeyIdx >> 6].fetch_or(bit, std::memory_order_relaxed) & bit) {
+                twice[journeyIdx >> 6].fetch_or(bit, std::memory_order_relaxed);
+                anyTwice.store(true, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    ValidationReport report;
+    auto             add = [&](const Violation& violation) {
+        if (options.maxViolations > 0 && report.violations.size() >= options.maxViolations) {
+            report.truncated = true;
+            return;
+        }
+        report.violations.push_back(violation);
+    };
+
+    for (int b = 0; b < numBlocks; ++b) {
+        for (const auto& violation : blockViolations[b]) {
+            add(violation);
+        }
+        report.recomputedObjective += blockCosts[b];
+    }
+
+    // Coverage, capacity and the objective need every block
+    if (stopped.load()) {
+        report.stopped = true;
+        return report;
+    }
+
+    // Every occurrence after the first of a journey served twice, in block order
+    if (anyTwice.load()) {
+        std::vector<uint64_t> reported(numWords, 0);
+        for (int b = 0; b < numBlocks; ++b) {
+            if (!hasJourneyRange(solution, solution.blocks[b]))
+                continue;
+            auto journeys = solution.journeysOf(solution.blocks[b]);
+            for (int k = 0; k < static_cast<int>(journeys.size()); ++k) {
+                int journeyIdx = journeys[k];
+                if (journeyIdx < 0 || journeyIdx >= numJourneys)
+                    continue;
+                uint64_t bit = uint64_t{1} << (journeyIdx & 63);
+                if (!(twice[journeyIdx >> 6].load(std::memory_order_relaxed) & bit))
+                    continue;
+                if (reported[journeyIdx >> 6] & bit) {
+                    Violation violation{Violation::Kind::DuplicateJourney};
+                    violation.block    = b;
+                    violation.position = k;
+                    violation.journey  = journeyIdx;
+                    add(violation);
+                }
+                reported[journeyIdx >> 6] |= bit;
+            }
+        }
+    }
+
+    for (size_t w = 0; w < numWords; ++w) {
+        uint64_t missing = ~seen[w].load(std::memory_order_relaxed);
+        while (missing != 0) {
+            int journeyIdx = static_cast<int>(w * 64) + __builtin_ctzll(missing);
+            missing &= missing - 1;
+            if (journeyIdx >= numJourneys)
+                break;
+            Violation violation{Violation::Kind::UncoveredJourney};
+            violation.journey = journeyIdx;
+            add(violation);
+        }
+    }
+
+    int              numTypes = network_.getNumVehicleTypes();
+    std::vector<int> slotUsage(slotCapacity_.size(), 0);
+    for (int slot : blockSlots) {
+        if (slot >= 0) {
+            ++slotUsage[slot];
+        }
+    }
+    for (size_t slot = 0; slot < slotUsage.size(); ++slot) {
+        if (slotUsage[slot] <= slotCapacity_[slot])
+            continue;
+        Violation violation{Violation::Kind::Capacity};
+        violation.depotId       = dataLoader.getDepotStops()[slot / numTypes];
+        violation.vehicleTypeId = dataLoader.getVehicleTypes()[slot % numTypes].id;
+        violation.expected      = slotCapacity_[slot];
+        violation.actual        = slotUsage[slot];
+        add(violation);
+    }
+
+    if (options.checkCosts &&
+        costsDiffer(report.recomputedObjective, solution.objectiveValue, options.costTolerance)) {
+        Violation violation{Violation::Kind::Objective};
+        violation.expected = report.recomputedObjective;
+        violation.actual   = solution.objectiveValue;
+        add(violation);
+    }
+    return report;
+}
+
+int SolutionValidator::checkBlock(const VehicleBlock&     block,
+                                  data::JourneySpan       journeys,
+                                  int                     blockIdx,
+                                  const Options&          options,
+                                  std::vector<Violation>& out,
+                                  double&                 cost) const {
+    const auto& dataLoader  = network_.getDataLoader();
+    int         numJourneys = network_.getNumJourneys();
+
+    auto violation = [&](Violation::Kind kind, int position) -> Violation& {
+        Violation entry{kind};
+        entry.block    = blockIdx;
+        entry.position = position;
+        entry.journey  = position >= 0 ? journeys[position] : -1;
+        out.push_back(entry);
+        return out.back();
+    };
+
+    int depotIdx = dataLoader.getDepotIndex(block.depotId);
+    int typeIdx  = dataLoader.getVehicleTypeIndex(block.vehicleTypeId);
+    if (depotIdx < 0) {
+        violation(Violation::Kind::UnknownDepot, -1).depotId = block.depotId;
+    }
+    if (typeIdx < 0) {
+        violation(Violation::Kind::UnknownVehicleType, -1).vehicleTypeId = block.vehicleTypeId;
+    }
+    if (journeys.empty()) {
+        violation(Violation::Kind::EmptyBlock, -1);
+    }
+
+    bool knownJourneys = true;
+    for (int k = 0; k < static_cast<int>(journeys.size()); ++k) {
+        if (journeys[k] < 0 || journeys[k] >= numJourneys) {
+            violation(Violation::Kind::UnknownJourney, k);
+            knownJourneys = false;
+        }
+    }
+
+    int slot = depotIdx >= 0 && typeIdx >= 0 ? depotIdx * network_.getNumVehicleTypes() + typeIdx
+                                             : -1;
+    if (slot < 0 || journeys.empty() || !knownJourneys)
+        return slot;
+
+    // Feasibility and cost in one pass, same terms as ConnectionNetwork::evaluateBlock
+    if (!network_.hasPullOut(depotIdx, journeys.front())) {
+        violation(Violation::Kind::NoPullOut, 0);
+    }
+    cost = network_.vehicleCost(typeIdx) + network_.pullOutCost(typeIdx, depotIdx, journeys[0]);
+    for (int k = 0; k < static_cast<int>(journeys.size()); ++k) {
+        if (!network_.isCompatible(typeIdx, journeys[k])) {
+            violation(Violation::Kind::Incompatible, k);
+        }
+        if (k > 0) {
+            if (!network_.canConnect(journeys[k - 1], journeys[k])) {
+                violation(Violation::Kind::Connection, k);
+            }
+            cost += network_.connectionCost(typeIdx, journeys[k - 1], journeys[k]);
+        }
+        cost += network_.serviceCost(typeIdx, journeys[k]);
+    }
+    cost += network_.pullInCost(typeIdx, depotIdx, journeys.back());
+
+    if (options.checkCosts && costsDiffer(cost, block.totalCost, options.costTolerance)) {
+        auto& entry    = violation(Violation::Kind::BlockCost, -1);
+        entry.expected = cost;
+        entry.actual   = block.totalCost;
+    }
+    return slot;
+}
+
+bool SolutionValidator::hasJourneyRange(const UnifiedSolution& solution,
+                                        const VehicleBlock&    block) {
+    return block.journeyOffset >= 0 && block.journeyCount >= 0 &&
+           static_cast<size_t>(block.journeyOffset) + block.journeyCount <=
+               solution.journeys.size();
+}
+
+bool SolutionValidator::costsDiffer(double expected, double actual, double tolerance) {
+    return !(std::fabs(expected - actual) <= tolerance * std::max(1.0, std::fabs(expected)));
+}
+
+const char* SolutionValidator::kindName(Violation::Kind kind) {
+    switch (kind) {
+        case Violation::Kind::UnknownJourney:
+            return "UnknownJourney";
+        case Violation::Kind::JourneyRange:
+            return "JourneyRange";
+        case Violation::Kind::DuplicateJourney:
+            return "DuplicateJourney";
+        case Violation::Kind::UncoveredJourney:
+            return "UncoveredJourney";
+        case Violation::Kind::EmptyBlock:
+            return "EmptyBlock";
+        case Violation::Kind::UnknownDepot:
+            return "UnknownDepot";
+        case Violation::Kind::UnknownVehicleType:
+            return "UnknownVehicleType";
+        case Violation::Kind::Incompatible:
+            return "Incompatible";
+        case Violation::Kind::NoPullOut:
+            return "NoPullOut";
+        case Violation::Kind::Connection:
+            return "Connection";
+        case Violation::Kind::Capacity:
+            return "Capacity";
+        case Violation::Kind::BlockCost:
+            return "BlockCost";
+        case Violation::Kind::Objective:
+            return "Objective";
+    }
+    return "Unknown";
+}
+
+} // namespace core
@@ -1,54 +1,123 @@
 #include "data/DataLoader.hpp"
 #include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <type_traits>
+#include <unordered_set>
 
 namespace data {
 
-DataLoader::DataLoader(const std::string& dataDirectory)
-  : dataDirectory_(dataDirectory), loaded_(false) {
-    // Ensure directory ends with /
-    if (!dataDirectory_.empty() && dataDirectory_.back() != '/') {
-        dataDirectory_ += '/';
-    }
+namespace {
+uint64_t mix(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
 }
 
-bool DataLoader::loadAll() {
-    std::cout << "Loading MDVSP data from: " << dataDirectory_ << std::endl;
+// Streaming hash of a sequence of fields, one mixing step per 64-bit word
+class FieldHash {
+  public:
+    explicit FieldHash(uint64_t seed) : hash_(mix(seed)) {}
 
-    if (!loadStopPoints()) {
-        std::cerr << "Failed to load stop points" << std::endl;
-        return false;
+    FieldHash& addInt(uint64_t value) {
+        hash_ = mix(hash_ ^ value);
+        return *this;
     }
 
-    if (!loadVehicleTypes()) {
-        std::cerr << "Failed to load vehicle types" << std::endl;
-        return false;
+    FieldHash& addReal(double value) {
+        uint64_t bits = 0;
+        value         = value == 0.0 ? 0.0 : value; // -0.0 parses from "-0"
+        std::memcpy(&bits, &value, sizeof(bits));
+        hash_ = mix(hash_ ^ bits);
+        return *this;
     }
 
-    if (!loadVehicleTypeGroups()) {
-        std::cerr << "Failed to load vehicle type groups" << std::endl;
-        return false;
+    FieldHash& addText(const std::string& value) {
+        addInt(value.size());
+        for (size_t i = 0; i < value.size(); i += 8) {
+            uint64_t word = 0;
+            std::memcpy(&word, value.data() + i, std::min<size_t>(8, value.size() - i));
+            hash_ = mix(hash_ ^ word);
+        }
+        return *this;
     }
 
-    if (!loadServiceJourneys()) {
-        std::cerr << "Failed to load service journeys" << std::endl;
-        return false;
+    uint64_t value() const { return hash_; }
+
+  private:
+    uint64_t hash_;
+};
+
+// Hash of a table with its rows in file order
+template <typename Row, typename HashRow>
+uint64_t hashRows(uint64_t table, const std::vector<Row>& rows, HashRow hashRow) {
+    FieldHash hash(table);
+    hash.addInt(rows.size());
+    for (const auto& row : rows) {
+        hashRow(hash, row);
     }
+    return hash.value();
+}
+} // namespace
 
-    if (!loadDeadRunTimes()) {
-        std::cerr << "Failed to load dead run times" << std::endl;
-        return false;
+DataLoader::DataLoader(const std::string& dataDirectory)
+  : dataDirectory_(dataDirectory), loaded_(false), tables_(std::make_shared<SharedTables>()) {
+    // Ensure directory ends with /
+    if (!dataDirectory_.empty() && dataDirectory_.back() != '/') {
+        dataDirectory_ += '/';
     }
+}
 
-    if (!loadVehicleCapacities()) {
-        std::cerr << "Failed to load vehicle capacities" << std::endl;
-        return false;
+DataLoader::DataLoader(const DataLoader& source, const std::vector<int>& journeyIndices)
+  : dataDirectory_(source.dataDirectory_),
+    loaded_(source.loaded_),
+    stopCondition_(source.stopCondition_),
+    tables_(source.tables_),
+    vehicleTypeGroups_(source.vehicleTypeGroups_),
+    vehicleCapacities_(source.vehicleCapacities_),
+    vehicleTypeToGroups_(source.vehicleTypeToGroups_),
+    vehicleTypeToGroupMap_(source.vehicleTypeToGroupMap_),
+    vehicleCapacityMap_(source.vehicleCapacityMap_),
+    depotStops_(source.depotStops_),
+    depotIndexMap_(source.depotIndexMap_),
+    groupIndexMap_(source.groupIndexMap_),
+    compatibilityBits_(source.compatibilityBits_),
+    compatibilityWords_(source.compatibilityWords_) {
+    serviceJourneys_.reserve(journeyIndices.size());
+    for (int journeyIdx : journeyIndices) {
+        serviceJourneys_.push_back(source.serviceJourneys_[journeyIdx]);
     }
+}
 
-    if (!loadVehicleTypeToGroups()) {
-        std::cerr << "Failed to load vehicle type to groups mapping" << std::endl;
+bool DataLoader::loadAll() {
+    std::cout << "Loading MDVSP data from: " << dataDirectory_ << std::endl;
+    // Never refill tables a subproblem copy may share
+    tables_ = std::make_shared<SharedTables>();
+
+    using LoadStep = bool (DataLoader::*)();
+    const std::pair<LoadStep, const char*> steps[] = {
+        {&DataLoader::loadStopPoints, "stop points"},
+        {&DataLoader::loadVehicleTypes, "vehicle types"},
+        {&DataLoader::loadVehicleTypeGroups, "vehicle type groups"},
+        {&DataLoader::loadServiceJourneys, "service journeys"},
+        {&DataLoader::loadDeadRunTimes, "dead run times"},
+        {&DataLoader::loadVehicleCapacities, "vehicle capacities"},
+        {&DataLoader::loadVehicleTypeToGroups, "vehicle type to groups mapping"}};
+
+    for (const auto& step : steps) {
+        if (!stopRequested() && (this->*step.first)())
+            continue;
+        if (stopRequested()) {
+            std::cerr << "Loading stopped before all files were read" << std::endl;
+        }
+        else {
+            std::cerr << "Failed to load " << step.second << std::endl;
+        }
         return false;
     }
 
@@ -57,8 +126,8 @@ bool DataLoader::loadAll() {
 
     std::cout << "Successfully loaded MDVSP data:" << std::endl;
     std::cout << "  - Service journeys: " << serviceJourneys_.size() << std::endl;
-    std::cout << "  - Vehicle types: " << vehicleTypes_.size() << std::endl;
-    std::cout << "  - Stop points: " << stopPoints_.size() << std::endl;
+    std::cout << "  - Vehicle types: " << tables_->vehicleTypes.size() << std::endl;
+    std::cout << "  - Stop points: " << tables_->stopPoints.size() << std::endl;
     std::cout << "  - Vehicle type groups: " << vehicleTypeGroups_.size() << std::endl;
 
     return true;
@@ -74,7 +143,9 @@ bool DataLoader::loadServiceJourneys() {
     std::string line;
     std::getline(file, line); // Skip header
 
-    while (std::getline(file, line)) {
+    for (size_t lineCount = 1; std::getline(file, line); ++lineCount) {
+        if (lineCount % 4096 == 0 && stopRequested())
+            return false;
         if (line.empty())
             continue;
 
@@ -129,7 +200,7 @@ bool DataLoader::loadVehicleTypes() {
         vehType.hourCost    = std::stod(fields[5]);
         vehType.capacity    = std::stoi(fields[6]);
 
-        vehicleTypes_.push_back(vehType);
+        tables_->vehicleTypes.push_back(vehType);
     }
 
     return true;
@@ -159,7 +230,7 @@ bool DataLoader::loadStopPoints() {
         stop.name                       = fields[2];
         stop.vehicleCapacityForCharging = std::stoi(fields[3]);
 
-        stopPoints_.push_back(stop);
+        tables_->stopPoints.push_back(stop);
     }
 
     return true;
@@ -204,7 +275,9 @@ bool DataLoader::loadDeadRunTimes() {
     std::string line;
     std::getline(file, line); // Skip header
 
-    while (std::getline(file, line)) {
+    for (size_t lineCount = 1; std::getline(file, line); ++lineCount) {
+        if (lineCount % 4096 == 0 && stopRequested())
+            return false;
         if (line.empty())
             continue;
 
@@ -217,9 +290,7 @@ bool DataLoader::loadDeadRunTimes() {
         double distance = std::stod(fields[2]);
         int    runTime  = std::stoi(fields[3]);
 
-        std::string key        = makeKey(fromStop, toStop);
-        deadRunTimes_[key]     = runTime;
-        deadRunDistances_[key] = distance;
+        tables_->deadRuns.emplace_back(fromStop, toStop, distance, runTime);
     }
 
     return true;
@@ -308,10 +379,6 @@ int DataLoader::timeStringToSeconds(const std::string& timeStr) {
     return hours * 3600 + minutes * 60 + seconds;
 }
 
-std::string DataLoader::makeKey(int from, int to) const {
-    return std::to_string(from) + "_" + std::to_string(to);
-}
-
 void DataLoader::buildLookupMaps() {
     // Build vehicle type to group mapping
     for (const auto& mapping : vehicleTypeToGroups_) {
@@ -326,35 +393,231 @@ void DataLoader::buildLookupMaps() {
     }
 
     // Build stop point and vehicle type maps
-    for (const auto& stop : stopPoints_) {
-        stopPointMap_[stop.id] = stop;
+    for (const auto& stop : tables_->stopPoints) {
+        tables_->stopPointMap[stop.id] = stop;
     }
 
-    for (const auto& vehType : vehicleTypes_) {
-        vehicleTypeMap_[vehType.id] = vehType;
+    for (const auto& vehType : tables_->vehicleTypes) {
+        tables_->vehicleTypeMap[vehType.id] = vehType;
+    }
+
+    buildDenseIndices();
+}
+
+void DataLoader::buildDenseIndices() {
+    // Depots from vehicle capacity constraints (VEHTYPECAPTOSTOPPOINT), in file order
+    for (const auto& capacity : vehicleCapacities_) {
+        if (capacity.maxCapacity > 0 && depotIndexMap_.count(capacity.stopPointId) == 0) {
+            depotIndexMap_[capacity.stopPointId] = static_cast<int>(depotStops_.size());
+            depotStops_.push_back(capacity.stopPointId);
+        }
+    }
+
+    // Only stops a vehicle can stand at get an index, so the dead run matrices grow with the
+    // stops of the schedule rather than the whole stop table. Stop points keep their file
+    // order, stops missing from the stop table follow.
+    std::unordered_set<int> usedStops(depotStops_.begin(), depotStops_.end());
+    for (const auto& journey : serviceJourneys_) {
+        usedStops.insert(journey.fromStopId);
+        usedStops.insert(journey.toStopId);
+    }
+    for (const auto& stop : tables_->stopPoints) {
+        if (usedStops.count(stop.id) > 0) {
+            addStopIndex(stop.id);
+        }
+    }
+    for (const auto& journey : serviceJourneys_) {
+        addStopIndex(journey.fromStopId);
+        addStopIndex(journey.toStopId);
+    }
+    for (int depotId : depotStops_) {
+        addStopIndex(depotId);
+    }
+
+    for (size_t i = 0; i < tables_->vehicleTypes.size(); ++i) {
+        tables_->vehicleTypeIndexMap[tables_->vehicleTypes[i].id] = static_cast<int>(i);
+    }
+
+    // Groups from the group table first, then groups only referenced by journeys or mappings
+    auto addGroupIndex = [this](int groupId) {
+        groupIndexMap_.emplace(groupId, static_cast<int>(groupIndexMap_.size()));
+    };
+    for (const auto& group : vehicleTypeGroups_) {
+        addGroupIndex(group.id);
+    }
+    for (const auto& journey : serviceJourneys_) {
+        addGroupIndex(journey.vehTypeGroupId);
+    }
+    for (const auto& mapping : vehicleTypeToGroups_) {
+        addGroupIndex(mapping.vehicleTypeGroupId);
+    }
+
+    buildDeadRunMatrix();
+    buildCompatibilityMatrix();
+}
+
+void DataLoader::buildDeadRunMatrix() {
+    size_t numStops = tables_->stopIds.size();
+    tables_->deadRunTimeMatrix.assign(numStops * numStops, -1);
+    tables_->deadRunDistanceMatrix.assign(numStops * numStops, -1.0);
+
+    // Later rows overwrite earlier ones, as with the former keyed map; rows touching a stop
+    // without index can never be driven
+    for (const auto& deadRun : tables_->deadRuns) {
+        int fromIndex = getStopIndex(deadRun.fromStopId);
+        int toIndex   = getStopIndex(deadRun.toStopId);
+        if (fromIndex < 0 || toIndex < 0)
+            continue;
+
+        size_t cell = static_cast<size_t>(fromIndex) * numStops + toIndex;
+        tables_->deadRunTimeMatrix[cell]     = deadRun.runTime;
+        tables_->deadRunDistanceMatrix[cell] = deadRun.distance;
+    }
+}
+
+void DataLoader::buildCompatibilityMatrix() {
+    compatibilityWords_ = (tables_->vehicleTypes.size() + 63) / 64;
+    compatibilityBits_.assign(groupIndexMap_.size() * compatibilityWords_, 0);
+
+    for (const auto& mapping : vehicleTypeToGroups_) {
+        int typeIndex = getVehicleTypeIndex(mapping.vehicleTypeId);
+        if (typeIndex < 0)
+            continue;
+
+        size_t row = static_cast<size_t>(groupIndexMap_[mapping.vehicleTypeGroupId]);
+        compatibilityBits_[row * compatibilityWords_ + (typeIndex >> 6)] |= uint64_t{1}
+                                                                            << (typeIndex & 63);
+    }
+}
+
+size_t DataLoader::getMemoryUsage() const {
+    auto vectorBytes = [](const auto& vector) {
+        return vector.capacity() * sizeof(typename std::decay_t<decltype(vector)>::value_type);
+    };
+    // Hash map nodes hold the pair and a next pointer, buckets one pointer each
+    auto mapBytes = [](const auto& map) {
+        using Entry = typename std::decay_t<decltype(map)>::value_type;
+        return map.size() * (sizeof(Entry) + sizeof(void*)) + map.bucket_count() * sizeof(void*);
+    };
+
+    // Tables shared with subproblem copies are counted in full
+    const auto& tables = *tables_;
+    return vectorBytes(serviceJourneys_) + vectorBytes(tables.vehicleTypes) +
+           vectorBytes(tables.stopPoints) + vectorBytes(vehicleTypeGroups_) +
+           vectorBytes(vehicleCapacities_) + vectorBytes(vehicleTypeToGroups_) +
+           vectorBytes(tables.deadRuns) + mapBytes(vehicleTypeToGroupMap_) +
+           mapBytes(vehicleCapacityMap_) + mapBytes(tables.stopPointMap) +
+           mapBytes(tables.vehicleTypeMap) + vectorBytes(depotStops_) +
+           vectorBytes(tables.stopIds) + mapBytes(depotIndexMap_) + mapBytes(tables.stopIndexMap) +
+           mapBytes(tables.vehicleTypeIndexMap) + mapBytes(groupIndexMap_) +
+           vectorBytes(tables.deadRunTimeMatrix) + vectorBytes(tables.deadRunDistanceMatrix) +
+           vectorBytes(compatibilityBits_);
+}
+
+uint64_t DataLoader::computeFingerprint() const {
+    // Row order matters in every table: journey order defines the journey indices, type and
+    // depot order the dense indices, and the last of duplicate rows wins
+    const uint64_t tables[] = {
+        hashRows(1, serviceJourneys_,
+                 [](FieldHash& hash, const ServiceJourney& journey) {
+                     hash.addInt(journey.id)
+                         .addInt(journey.lineId)
+                         .addInt(journey.fromStopId)
+                         .addInt(journey.toStopId)
+                         .addInt(journey.depTime)
+                         .addInt(journey.arrTime)
+                         .addInt(journey.minAheadTime)
+                         .addInt(journey.minLayoverTime)
+                         .addInt(journey.vehTypeGroupId)
+                         .addInt(journey.maxShiftBackwardSeconds)
+                         .addInt(journey.maxShiftForwardSeconds)
+                         .addReal(journey.distance);
+                 }),
+        hashRows(2, tables_->vehicleTypes,
+                 [](FieldHash& hash, const VehicleType& type) {
+                     hash.addInt(type.id)
+                         .addText(type.code)
+                         .addText(type.name)
+                         .addReal(type.vehicleCost)
+                         .addReal(type.kmCost)
+                         .addReal(type.hourCost)
+                         .addInt(type.capacity);
+                 }),
+        hashRows(3, tables_->stopPoints,
+                 [](FieldHash& hash, const StopPoint& stop) {
+                     hash.addInt(stop.id)
+                         .addText(stop.code)
+                         .addText(stop.name)
+                         .addInt(stop.vehicleCapacityForCharging);
+                 }),
+        hashRows(4, vehicleTypeGroups_,
+                 [](FieldHash& hash, const VehicleTypeGroup& group) {
+                     hash.addInt(group.id).addText(group.code).addText(group.name);
+                 }),
+        hashRows(5, tables_->deadRuns,
+                 [](FieldHash& hash, const DeadRunTime& deadRun) {
+                     hash.addInt(deadRun.fromStopId)
+                         .addInt(deadRun.toStopId)
+                         .addReal(deadRun.distance)
+                         .addInt(deadRun.runTime);
+                 }),
+        hashRows(6, vehicleCapacities_,
+                 [](FieldHash& hash, const VehicleCapacityAtStop& capacity) {
+                     hash.addInt(capacity.vehicleTypeId)
+                         .addInt(capacity.stopPointId)
+                         .addInt(capacity.minCapacity)
+                         .addInt(capacity.maxCapacity);
+                 }),
+        hashRows(7, vehicleTypeToGroups_,
+                 [](FieldHash& hash, const VehicleTypeToGroup& mapping) {
+                     hash.addInt(mapping.id)
+                         .addInt(mapping.vehicleTypeId)
+                         .addInt(mapping.vehicleTypeGroupId);
+                 })};
+
+    FieldHash fingerprint(0);
+    for (uint64_t table : tables) {
+        fingerprint.addInt(table);
+    }
+    return fingerprint.value();
+}
+
+std::string DataLoader::computeFingerprintText() const {
+    std::ostringstream text;
+    text << std::hex << std::setw(16) << std::setfill('0') << computeFingerprint();
+    return text.str();
+}
+
+void DataLoader::addStopIndex(int stopId) {
+    if (tables_->stopIndexMap.emplace(stopId, static_cast<int>(tables_->stopIds.size())).second) {
+        tables_->stopIds.push_back(stopId);
     }
 }
 
 int DataLoader::getDeadRunTime(int fromStop, int toStop) const {
-    std::string key = makeKey(fromStop, toStop);
-    auto        it  = deadRunTimes_.find(key);
-    return (it != deadRunTimes_.end()) ? it->second : -1;
+    int fromIndex = getStopIndex(fromStop);
+    int toIndex   = getStopIndex(toStop);
+    return (fromIndex >= 0 && toIndex >= 0) ? getDeadRunTimeByIndex(fromIndex, toIndex) : -1;
 }
 
 double DataLoader::getDeadRunDistance(int fromStop, int toStop) const {
-    std::string key = makeKey(fromStop, toStop);
-    auto        it  = deadRunDistances_.find(key);
-    return (it != deadRunDistances_.end()) ? it->second : -1.0;
+    int fromIndex = getStopIndex(fromStop);
+    int toIndex   = getStopIndex(toStop);
+    return (fromIndex >= 0 && toIndex >= 0) ? getDeadRunDistanceByIndex(fromIndex, toIndex) : -1.0;
 }
 
 bool DataLoader::isVehicleTypeCompatible(int vehicleTypeId, int vehicleTypeGroupId) const {
-    auto it = vehicleTypeToGroupMap_.find(vehicleTypeGroupId);
-    if (it == vehicleTypeToGroupMap_.end())
+    int typeIndex  = getVehicleTypeIndex(vehicleTypeId);
+    int groupIndex = getVehicleTypeGroupIndex(vehicleTypeGroupId);
+    if (typeIndex < 0 || groupIndex < 0)
         return false;
 
-    const auto& compatibleTypes = it->second;
-    return std::find(compatibleTypes.begin(), compatibleTypes.end(), vehicleTypeId) !=
-           compatibleTypes.end();
+    return isVehicleTypeIndexCompatible(typeIndex, groupIndex);
+}
+
+int DataLoader::getVehicleTypeGroupIndex(int vehicleTypeGroupId) const {
+    auto it = groupIndexMap_.find(vehicleTypeGroupId);
+    return (it != groupIndexMap_.end()) ? it->second : -1;
 }
 
 std::vector<int> DataLoader::getCompatibleVehicleTypes(int vehicleTypeGroupId) const {
@@ -362,20 +625,19 @@ std::vector<int> DataLoader::getCompatibleVehicleTypes(int vehicleTypeGroupId) c
     return (it != vehicleTypeToGroupMap_.end()) ? it->second : std::vector<int>();
 }
 
-std::vector<int> DataLoader::getDepotStops() const {
-    std::vector<int> depots;
+int DataLoader::getDepotIndex(int stopId) const {
+    auto it = depotIndexMap_.find(stopId);
+    return (it != depotIndexMap_.end()) ? it->second : -1;
+}
 
-    // Get depots from vehicle capacity constraints (VEHTYPECAPTOSTOPPOINT)
-    for (const auto& capacity : vehicleCapacities_) {
-        if (capacity.maxCapacity > 0) {
-            // Check if this stop is not already in the list
-            if (std::find(depots.begin(), depots.end(), capacity.stopPointId) == depots.end()) {
-                depots.push_back(capacity.stopPointId);
-            }
-        }
-    }
+int DataLoader::getStopIndex(int stopId) const {
+    auto it = tables_->stopIndexMap.find(stopId);
+    return (it != tables_->stopIndexMap.end()) ? it->second : -1;
+}
 
-    return depots;
+int DataLoader::getVehicleTypeIndex(int vehicleTypeId) const {
+    auto it = tables_->vehicleTypeIndexMap.find(vehicleTypeId);
+    return (it != tables_->vehicleTypeIndexMap.end()) ? it->second : -1;
 }
 
 int DataLoader::getVehicleCapacityAtStop(int vehicleTypeId, int stopId) const {
@@ -384,14 +646,70 @@ int DataLoader::getVehicleCapacityAtStop(int vehicleTypeId, int stopId) const {
     return (it != vehicleCapacityMap_.end()) ? it->second : 0;
 }
 
+void DataLoader::setVehicleCapacityAtStop(int vehicleTypeId, int stopId, int capacity) {
+    // Depot indices stay stable, a depot without capacity keeps its index
+    vehicleCapacityMap_[std::to_string(vehicleTypeId) + "_" + std::to_string(stopId)] = capacity;
+}
+
+std::unique_ptr<DataLoader>
+DataLoader::createSubproblem(const std::vector<int>&                 journeyIndices,
+                             const std::vector<std::pair<int, int>>& slots) const {
+    std::unique_ptr<DataLoader> subproblem(new DataLoader(*this, journeyIndices));
+
+    for (size_t d = 0; d < depotStops_.size(); ++d) {
+        for (size_t t = 0; t < tables_->vehicleTypes.size(); ++t) {
+            subproblem->setVehicleCapacityAtStop(tables_->vehicleTypes[t].id, depotStops_[d], 0);
+        }
+    }
+    for (const auto& [depotIndex, vehicleTypeIndex] : slots) {
+        int vehicleTypeId = tables_->vehicleTypes[vehicleTypeIndex].id;
+        int depotId       = depotStops_[depotIndex];
+        subproblem->setVehicleCapacityAtStop(
+            vehicleTypeId, depotId, getVehicleCapacityAtStop(vehicleTypeId, depotId));
+    }
+    return subproblem;
+}
+
+int DataLoader::addVehicleTypeGroup(const std::vector<int>& vehicleTypeIds,
+                                    const std::string&      code) {
+    int groupId = 0;
+    for (const auto& [id, index] : groupIndexMap_) {
+        groupId = std::max(groupId, id + 1);
+    }
+    int mappingId = 0;
+    for (const auto& mapping : vehicleTypeToGroups_) {
+        mappingId = std::max(mappingId, mapping.id + 1);
+    }
+
+    int groupIndex = static_cast<int>(groupIndexMap_.size());
+    vehicleTypeGroups_.emplace_back(groupId, code, code);
+    groupIndexMap_[groupId] = groupIndex;
+    compatibilityBits_.resize(groupIndexMap_.size() * compatibilityWords_, 0);
+
+    for (int vehicleTypeId : vehicleTypeIds) {
+        int typeIndex = getVehicleTypeIndex(vehicleTypeId);
+        if (typeIndex < 0)
+            continue;
+        vehicleTypeToGroups_.emplace_back(mappingId++, vehicleTypeId, groupId);
+        vehicleTypeToGroupMap_[groupId].push_back(vehicleTypeId);
+        compatibilityBits_[static_cast<size_t>(groupIndex) * compatibilityWords_ +
+                           (typeIndex >> 6)] |= uint64_t{1} << (typeIndex & 63);
+    }
+    return groupId;
+}
+
+void DataLoader::addServiceJourney(const ServiceJourney& journey) {
+    serviceJourneys_.push_back(journey);
+}
+
 const StopPoint* DataLoader::getStopPoint(int id) const {
-    auto it = stopPointMap_.find(id);
-    return (it != stopPointMap_.end()) ? &it->second : nullptr;
+    auto it = tables_->stopPointMap.find(id);
+    return (it != tables_->stopPointMap.end()) ? &it->second : nullptr;
 }
 
 const VehicleType* DataLoader::getVehicleType(int id) const {
-    auto it = vehicleTypeMap_.find(id);
-    return (it != vehicleTypeMap_.end()) ? &it->second : nullptr;
+    auto it = tables_->vehicleTypeMap.find(id);
+    return (it != tables_->vehicleTypeMap.end()) ? &it->second : nullptr;
 }
 
 } // namespace data
@@ -0,0 +1,54 @@
+#include "data/JourneyTable.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace data {
+
+JourneyTable::JourneyTable(const DataLoader& dataLoader) {
+    const auto& journeys    = dataLoader.getServiceJourneys();
+    int         numJourneys = static_cast<int>(journeys.size());
+
+    journeyIndex_.resize(numJourneys);
+    std::iota(journeyIndex_.begin(), journeyIndex_.end(), 0);
+    std::stable_sort(journeyIndex_.begin(), journeyIndex_.end(), [&journeys](int a, int b) {
+        return journeys[a].depTime < journeys[b].depTime;
+    });
+
+    depTime_.resize(numJourneys);
+    arrTime_.resize(numJourneys);
+    readyTime_.resize(numJourneys);
+    fromStop_.resize(numJourneys);
+    toStop_.resize(numJourneys);
+    group_.resize(numJourneys);
+    distance_.resize(numJourneys);
+    journeyId_.resize(numJourneys);
+    position_.resize(numJourneys);
+
+    for (int p = 0; p < numJourneys; ++p) {
+        const auto& journey = journeys[journeyIndex_[p]];
+        depTime_[p]         = journey.depTime;
+        arrTime_[p]         = journey.arrTime;
+        readyTime_[p]       = journey.arrTime + journey.minLayoverTime;
+        fromStop_[p]        = dataLoader.getStopIndex(journey.fromStopId);
+        toStop_[p]          = dataLoader.getStopIndex(journey.toStopId);
+        group_[p]           = dataLoader.getVehicleTypeGroupIndex(journey.vehTypeGroupId);
+        distance_[p]        = journey.distance;
+        journeyId_[p]       = journey.id;
+
+        position_[journeyIndex_[p]] = p;
+    }
+}
+
+int JourneyTable::lowerBound(int time) const {
+    return static_cast<int>(std::lower_bound(depTime_.begin(), depTime_.end(), time) -
+                            depTime_.begin());
+}
+
+size_t JourneyTable::getMemoryUsage() const {
+    size_t columns = depTime_.capacity() + arrTime_.capacity() + readyTime_.capacity() +
+                     fromStop_.capacity() + toStop_.capacity() + group_.capacity() +
+                     journeyIndex_.capacity() + journeyId_.capacity() + position_.capacity();
+    return columns * sizeof(int32_t) + distance_.capacity() * sizeof(double);
+}
+
+} // namespace data
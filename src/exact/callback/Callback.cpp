@@ -1,16 +1,56 @@
 #include "exact/Callback.hpp"
+#include "exact/NodeHeuristic.hpp"
+#include "exact/TimeSpaceModel.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <memory>
 
 namespace exact {
 
 SolverCallback::SolverCallback(bool verbose)
-  : verbose_(verbose), solutionCount_(0), bestObjective_(GRB_INFINITY) {}
+  : verbose_(verbose),
+    solutionCount_(0),
+    bestObjective_(GRB_INFINITY),
+    store_(nullptr),
+    heuristic_(nullptr),
+    telemetry_(nullptr),
+    model_(nullptr),
+    progress_(nullptr),
+    reportedBound_(-GRB_INFINITY),
+    seenVersion_(0),
+    injectedCount_(0) {}
 
 SolverCallback::~SolverCallback() = default;
 
+void SolverCallback::setIncumbentStore(core::IncumbentStore* store, const TimeSpaceModel* model) {
+    store_ = store;
+    setModel(model);
+}
+
+void SolverCallback::setNodeHeuristic(NodeHeuristic* heuristic, const TimeSpaceModel* model) {
+    heuristic_ = heuristic;
+    setModel(model);
+}
+
+void SolverCallback::setModel(const TimeSpaceModel* model) {
+    if (model != model_) {
+        model_ = model;
+        vars_  = model ? model->getVars() : std::vector<GRBVar>();
+    }
+}
+
 void SolverCallback::callback() {
     try {
-        if (where == GRB_CB_MIPSOL) {
+        if (stop_.stopRequested()) {
+            abort();
+            return;
+        }
+
+        if (where == GRB_CB_MIP) {
+            handleMIP();
+        }
+        else if (where == GRB_CB_MIPSOL) {
             handleMIPSOL();
         }
         else if (where == GRB_CB_MIPNODE) {
@@ -22,31 +62,105 @@ void SolverCallback::callback() {
     }
 }
 
+void SolverCallback::handleMIP() {
+    // Bounds move in many tiny steps, only relative improvements of 1e-4 are reported
+    if (progress_) {
+        double bound = getDoubleInfo(GRB_CB_MIP_OBJBND);
+        if (bound > reportedBound_ + 1e-4 * std::max(1.0, std::abs(bound))) {
+            reportedBound_ = bound;
+            progress_->bound("exact", bound);
+        }
+    }
+
+    // Only a clock read unless a sample is due, printing happens on the consumer thread
+    if (!telemetry_ || !telemetry_->isDue())
+        return;
+
+    TelemetrySample sample;
+    sample.runtime   = getDoubleInfo(GRB_CB_RUNTIME);
+    sample.nodeCount = getDoubleInfo(GRB_CB_MIP_NODCNT);
+    sample.objBound  = getDoubleInfo(GRB_CB_MIP_OBJBND);
+    sample.objBest   = getDoubleInfo(GRB_CB_MIP_OBJBST);
+    sample.work      = getDoubleInfo(GRB_CB_WORK);
+    sample.gap       = sample.objBest < GRB_INFINITY && std::abs(sample.objBest) > 0
+                           ? std::abs(sample.objBest - sample.objBound) / std::abs(sample.objBest)
+                           : 1.0;
+    telemetry_->record(sample);
+}
+
 void SolverCallback::handleMIPSOL() {
     solutionCount_++;
     double objVal = getDoubleInfo(GRB_CB_MIPSOL_OBJ);
 
     if (objVal < bestObjective_) {
         bestObjective_ = objVal;
+        if (progress_) {
+            progress_->incumbent("exact", objVal);
+        }
 
         if (verbose_) {
             logMessage("New best solution found: " + std::to_string(objVal));
         }
+
+        if (store_ && model_ && objVal < store_->getObjective()) {
+            std::unique_ptr<double[]> values(
+                getSolution(vars_.data(), static_cast<int>(vars_.size())));
+
+            core::UnifiedSolution solution("exact_gurobi", objVal, 0.0, "FEASIBLE");
+            model_->extractBlocks(std::vector<double>(values.get(), values.get() + vars_.size()),
+                                  solution);
+            store_->offer(solution);
+            seenVersion_ = store_->getVersion();
+        }
     }
 }
 
 void SolverCallback::handleMIPNODE() {
-    if (verbose_) {
-        double objBound = getDoubleInfo(GRB_CB_MIPNODE_OBJBND);
-        double objBest  = getDoubleInfo(GRB_CB_MIPNODE_OBJBST);
+    // Inject a better incumbent of another engine, Gurobi completes the partial start
+    if (store_ && model_ && store_->getVersion() != seenVersion_) {
+        seenVersion_ = store_->getVersion();
+
+        const core::UnifiedSolution* incumbent = store_->get();
+        if (incumbent && incumbent->objectiveValue < bestObjective_) {
+            injectSolution(*incumbent, "incumbent");
+        }
+    }
+
+    // LP-guided heuristic: collect a finished rounding, hand over the next relaxation
+    if (heuristic_ && model_) {
+        core::UnifiedSolution rounded;
+        if (heuristic_->takeSolution(rounded) && rounded.objectiveValue < bestObjective_) {
+            if (store_) {
+                store_->offer(rounded);
+            }
+            injectSolution(rounded, "rounded relaxation");
+        }
 
-        if (objBest < GRB_INFINITY) {
-            double gap = (objBest - objBound) / objBest;
-            logMessage("Node processed. Gap: " + std::to_string(gap * 100) + "%");
+        double nodeCount = getDoubleInfo(GRB_CB_MIPNODE_NODCNT);
+        if (heuristic_->isDue(nodeCount) && getIntInfo(GRB_CB_MIPNODE_STATUS) == GRB_OPTIMAL) {
+            std::unique_ptr<double[]> relaxation(
+                getNodeRel(vars_.data(), static_cast<int>(vars_.size())));
+            heuristic_->submit(nodeCount,
+                               std::vector<double>(relaxation.get(),
+                                                   relaxation.get() + vars_.size()),
+                               bestObjective_);
         }
     }
 }
 
+void SolverCallback::injectSolution(const core::UnifiedSolution& solution,
+                                    const std::string&           source) {
+    std::vector<GRBVar> vars;
+    std::vector<double> values;
+    model_->getServiceStart(solution, vars, values);
+    setSolution(vars.data(), values.data(), static_cast<int>(vars.size()));
+
+    double objVal = useSolution();
+    ++injectedCount_;
+    logMessage("Injected " + source + " " + std::to_string(solution.objectiveValue) +
+               ", completed to " + std::to_string(objVal));
+}
+
 void SolverCallback::logMessage(const std::string& message) const {
     if (verbose_) {
         std::cout << "[Callback] " << message << std::endl;
@@ -0,0 +1,124 @@
+#include "exact/NodeHeuristic.hpp"
+#include "exact/TimeSpaceModel.hpp"
+#include <iostream>
+
+namespace exact {
+
+NodeHeuristic::NodeHeuristic(const TimeSpaceModel&             model,
+                             const network::ConnectionNetwork& network,
+                             const Config&                     config)
+  : model_(model),
+    network_(network),
+    config_(config),
+    lastNode_(0.0),
+    lastTime_(std::chrono::steady_clock::now()),
+    cutoff_(0.0),
+    hasWork_(false),
+    hasSolution_(false),
+    shutdown_(false),
+    busy_(false),
+    roundCount_(0),
+    improvedCount_(0) {
+    worker_ = std::thread(&NodeHeuristic::run, this);
+}
+
+NodeHeuristic::~NodeHeuristic() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    wakeUp_.notify_one();
+    worker_.join();
+}
+
+bool NodeHeuristic::isDue(double nodeCount) const {
+    return !busy_.load(std::memory_order_acquire) &&
+           nodeCount - lastNode_ >= config_.nodeInterval &&
+           std::chrono::duration<double>(std::chrono::steady_clock::now() - lastTime_).count() >=
+               config_.minInterval;
+}
+
+bool NodeHeuristic::submit(double nodeCount, std::vector<double> relaxation, double cutoff) {
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock() || busy_.load(std::memory_order_acquire))
+        return false;
+
+    relaxation_ = std::move(relaxation);
+    cutoff_     = cutoff;
+    hasWork_    = true;
+    busy_.store(true, std::memory_order_release);
+    lock.unlock();
+    wakeUp_.notify_one();
+
+    lastNode_ = nodeCount;
+    lastTime_ = std::chrono::steady_clock::now();
+    return true;
+}
+
+bool NodeHeuristic::takeSolution(core::UnifiedSolution& solution) {
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock() || !hasSolution_)
+        return false;
+
+    solution     = std::move(solution_);
+    hasSolution_ = false;
+    return true;
+}
+
+void NodeHeuristic::run() {
+    meta::LocalSearch localSearch(network_);
+
+    meta::LocalSearch::SolverConfig searchConfig;
+    searchConfig.timeLimit = config_.polishTime;
+    searchConfig.verbose   = false;
+
+    while (true) {
+        std::vector<double> relaxation;
+        double              cutoff;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wakeUp_.wait(lock, [this]() { return hasWork_ || shutdown_; });
+            if (shutdown_)
+                return;
+            relaxation = std::move(relaxation_);
+            cutoff     = cutoff_;
+            hasWork_   = false;
+        }
+
+        // The worker must not throw, a failed round is skipped
+        try {
+            core::UnifiedSolution rounded("exact_node_heuristic", 0.0, 0.0, "FEASIBLE");
+            model_.roundBlocks(relaxation, rounded);
+
+            auto solution = localSearch.repair(rounded);
+            if (solution.isFeasible()) {
+                solution = localSearch.improve(solution, searchConfig);
+            }
+            roundCount_.fetch_add(1, std::memory_order_relaxed);
+
+            if (solution.isFeasible() && solution.objectiveValue < cutoff) {
+                solution.algorithmType = "exact_node_heuristic";
+                log("Rounded relaxation to " + std::to_string(solution.objectiveValue));
+
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!hasSolution_ || solution.objectiveValue < solution_.objectiveValue) {
+                    solution_    = std::move(solution);
+                    hasSolution_ = true;
+                    improvedCount_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+        catch (const std::exception& e) {
+            log("Rounding failed: " + std::string(e.what()));
+        }
+        busy_.store(false, std::memory_order_release);
+    }
+}
+
+void NodeHeuristic::log(const std::string& message) const {
+    if (config_.verbose) {
+        std::cout << "[NodeHeuristic] " << message << std::endl;
+    }
+}
+
+} // namespace exact
@@ -0,0 +1,113 @@
+#include "exact/Telemetry.hpp"
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "gurobi_c++.h"
+
+namespace exact {
+
+SolverTelemetry::SolverTelemetry(const Config& config)
+  : config_(config),
+    head_(0),
+    tail_(0),
+    dropped_(0),
+    nextSample_(std::chrono::steady_clock::now()),
+    lastPrinted_{0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+    running_(true) {
+    if (!config_.csvFile.empty()) {
+        csv_.open(config_.csvFile, std::ios::app);
+        if (csv_.is_open() && csv_.tellp() == 0) {
+            csv_ << "runtime,nodes,bound,incumbent,gap,work\n";
+        }
+    }
+    consumer_ = std::thread(&SolverTelemetry::run, this);
+}
+
+SolverTelemetry::~SolverTelemetry() { stop(); }
+
+bool SolverTelemetry::record(const TelemetrySample& sample) {
+    nextSample_ = std::chrono::steady_clock::now() +
+                  std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                      std::chrono::duration<double>(config_.sampleInterval));
+
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= kRingSize) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    ring_[head & (kRingSize - 1)] = sample;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void SolverTelemetry::stop() {
+    if (!consumer_.joinable())
+        return;
+    running_.store(false, std::memory_order_release);
+    consumer_.join();
+    drain();
+    if (csv_.is_open()) {
+        csv_.flush();
+    }
+}
+
+std::vector<TelemetrySample> SolverTelemetry::getSamples() const {
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    return history_;
+}
+
+void SolverTelemetry::run() {
+    while (running_.load(std::memory_order_acquire)) {
+        drain();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+}
+
+void SolverTelemetry::drain() {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t head = head_.load(std::memory_order_acquire);
+    if (tail == head)
+        return;
+
+    std::vector<TelemetrySample> samples;
+    samples.reserve(head - tail);
+    for (; tail != head; ++tail) {
+        samples.push_back(ring_[tail & (kRingSize - 1)]);
+    }
+    tail_.store(tail, std::memory_order_release);
+
+    for (const auto& sample : samples) {
+        if (csv_.is_open()) {
+            csv_ << sample.runtime << ',' << sample.nodeCount << ',' << sample.objBound << ','
+                 << sample.objBest << ',' << sample.gap << ',' << sample.work << '\n';
+        }
+        if (config_.print && sample.runtime - lastPrinted_.runtime >= config_.printInterval) {
+            print(sample);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(historyMutex_);
+    history_.insert(history_.end(), samples.begin(), samples.end());
+}
+
+void SolverTelemetry::print(const TelemetrySample& sample) {
+    double elapsed  = sample.runtime - lastPrinted_.runtime;
+    double nodeRate = elapsed > 0 ? (sample.nodeCount - lastPrinted_.nodeCount) / elapsed : 0.0;
+    lastPrinted_    = sample;
+
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(1) << "[Callback] " << sample.runtime << "s, "
+         << std::setprecision(0) << sample.nodeCount << " nodes (" << nodeRate << "/s), bound "
+         << std::setprecision(2) << sample.objBound << ", incumbent ";
+    if (sample.objBest < GRB_INFINITY) {
+        line << sample.objBest << ", gap " << sample.gap * 100 << "%";
+    }
+    else {
+        line << "none";
+    }
+    line << ", work " << sample.work << '\n';
+    std::cout << line.str() << std::flush;
+}
+
+} // namespace exact
@@ -0,0 +1,373 @@
+#include "exact/TimeSpaceModel.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace exact {
+
+using network::TimeSpaceArcType;
+
+TimeSpaceModel::TimeSpaceModel(const data::DataLoader& dataLoader)
+  : TimeSpaceModel(dataLoader, network::TimeSpaceNetwork::Options()) {}
+
+TimeSpaceModel::TimeSpaceModel(const data::DataLoader&                   dataLoader,
+                               const network::TimeSpaceNetwork::Options& options)
+  : dataLoader_(dataLoader) {
+    const auto& vehicleTypes = dataLoader_.getVehicleTypes();
+    const auto& depotStops   = dataLoader_.getDepotStops();
+
+    networks_.reserve(vehicleTypes.size());
+    for (int t = 0; t < static_cast<int>(vehicleTypes.size()); ++t) {
+        networks_.emplace_back(dataLoader_, t, options);
+    }
+
+    for (int d = 0; d < static_cast<int>(depotStops.size()); ++d) {
+        for (int t = 0; t < static_cast<int>(vehicleTypes.size()); ++t) {
+            int capacity = dataLoader_.getVehicleCapacityAtStop(vehicleTypes[t].id, depotStops[d]);
+            if (capacity <= 0)
+                continue;
+
+            Commodity   commodity{d, t, capacity, {}, {}};
+            const auto& arcs      = networks_[t].getArcs();
+            size_t      depotArcs = 0;
+            for (int k = 0; k < static_cast<int>(arcs.size()); ++k) {
+                if (arcs[k].depotIndex >= 0 && arcs[k].depotIndex != d)
+                    continue;
+                depotArcs += arcs[k].depotIndex >= 0 ? 1 : 0;
+                commodity.arcs.push_back(k);
+            }
+
+            // The network is shared by the depots of a type, only its own depot arcs count
+            network::TimeSpaceSize size = networks_[t].getSize();
+            size.depotArcs              = depotArcs;
+            size_ += size;
+
+            network::TimeSpaceSize unreduced = networks_[t].getUnreducedSize();
+            unreduced.depotArcs              = depotArcs;
+            unreducedSize_ += unreduced;
+
+            commodities_.push_back(std::move(commodity));
+        }
+    }
+}
+
+std::unique_ptr<GRBModel> TimeSpaceModel::build(const GRBEnv& env) {
+    auto model = std::make_unique<GRBModel>(env);
+    model->set(GRB_StringAttr_ModelName, "mdvsp_time_space");
+    model->set(GRB_IntAttr_ModelSense, GRB_MINIMIZE);
+
+    const auto& journeys   = dataLoader_.getServiceJourneys();
+    const auto& depotStops = dataLoader_.getDepotStops();
+
+    auto stopId = [this](const network::TimeSpaceNetwork& network, int node) {
+        return std::to_string(dataLoader_.getStopIdByIndex(network.getNodes()[node].stopIndex));
+    };
+
+    std::vector<GRBLinExpr> coverage(journeys.size());
+    int                     capacityId = 0;
+    for (auto& commodity : commodities_) {
+        const auto& network     = networks_[commodity.vehicleTypeIndex];
+        const auto& arcs        = network.getArcs();
+        const auto& vehicleType = dataLoader_.getVehicleTypes()[commodity.vehicleTypeIndex];
+        std::string commodityName =
+            "D" + std::to_string(commodity.depotIndex) + "V" + std::to_string(vehicleType.id);
+        std::string depotStop = std::to_string(depotStops[commodity.depotIndex]);
+
+        std::vector<GRBLinExpr> balance(network.getNodes().size());
+        GRBLinExpr              pullOuts;
+        commodity.vars.clear();
+        commodity.vars.reserve(commodity.arcs.size());
+
+        for (int k : commodity.arcs) {
+            const auto& arc  = arcs[k];
+            double      cost = arc.cost;
+            double      ub   = commodity.capacity;
+            char        type = GRB_INTEGER;
+            std::string name = "x_" + commodityName;
+
+            switch (arc.type) {
+                case TimeSpaceArcType::Service:
+                    ub   = 1.0;
+                    type = GRB_BINARY;
+                    name += "S_T" + std::to_string(journeys[arc.journeyIdx].id);
+                    break;
+                case TimeSpaceArcType::Waiting:
+                case TimeSpaceArcType::Deadhead:
+                    name += arc.type == TimeSpaceArcType::Waiting ? "W_" : "DH_";
+                    name += stopId(network, arc.fromNode) + "_" + stopId(network, arc.toNode);
+                    name += "_N" + std::to_string(arc.fromNode) + "_" + std::to_string(arc.toNode);
+                    break;
+                case TimeSpaceArcType::PullOut:
+                    cost += vehicleType.vehicleCost;
+                    name += "D_" + depotStop + "_" + stopId(network, arc.toNode) + "_O";
+                    break;
+                case TimeSpaceArcType::PullIn:
+                    name += "D_" + stopId(network, arc.fromNode) + "_" + depotStop + "_I";
+                    break;
+            }
+
+            GRBVar var = model->addVar(0.0, ub, cost, type, name);
+            if (arc.fromNode >= 0) {
+                balance[arc.fromNode].addTerm(-1.0, var);
+            }
+            if (arc.toNode >= 0) {
+                balance[arc.toNode].addTerm(1.0, var);
+            }
+            if (arc.type == TimeSpaceArcType::PullOut) {
+                pullOuts.addTerm(1.0, var);
+            }
+            if (arc.type == TimeSpaceArcType::Service) {
+                coverage[arc.journeyIdx].addTerm(1.0, var);
+            }
+            commodity.vars.push_back(var);
+        }
+
+        for (size_t v = 0; v < balance.size(); ++v) {
+            model->addConstr(balance[v],
+                             GRB_EQUAL,
+                             0.0,
+                             "FlowCons_" + commodityName + "_SP" + stopId(network, v) + "_N" +
+                                 std::to_string(v));
+        }
+        model->addConstr(pullOuts,
+                         GRB_LESS_EQUAL,
+                         commodity.capacity,
+                         "Capacity_" + std::to_string(capacityId++));
+    }
+
+    // Journeys without a compatible commodity keep an empty row and make the model infeasible
+    for (size_t j = 0; j < journeys.size(); ++j) {
+        model->addConstr(
+            coverage[j], GRB_EQUAL, 1.0, "ServiceCoverage_T" + std::to_string(journeys[j].id));
+    }
+
+    model->update();
+    return model;
+}
+
+void TimeSpaceModel::extractBlocks(core::UnifiedSolution& solution) const {
+    std::vector<double> values;
+    for (const auto& commodity : commodities_) {
+        for (const auto& var : commodity.vars) {
+            values.push_back(var.get(GRB_DoubleAttr_X));
+        }
+    }
+    extractBlocks(values, solution);
+}
+
+void TimeSpaceModel::extractBlocks(const std::vector<double>& values,
+                                   core::UnifiedSolution&     solution) const {
+    auto&  blocks   = solution.blocks;
+    auto&  journeys = solution.journeys;
+    size_t offset = 0;
+    for (const auto& commodity : commodities_) {
+        const auto& network = networks_[commodity.vehicleTypeIndex];
+        const auto& arcs    = network.getArcs();
+        size_t      numArcs = commodity.arcs.size();
+
+        // Integral flow per arc and outgoing arcs with flow per node
+        std::vector<long>             flow(numArcs);
+        std::vector<std::vector<int>> outgoing(network.getNodes().size());
+        for (size_t k = 0; k < numArcs; ++k) {
+            flow[k] = std::lround(values[offset + k]);
+            int from = arcs[commodity.arcs[k]].fromNode;
+            if (flow[k] > 0 && from >= 0) {
+                outgoing[from].push_back(static_cast<int>(k));
+            }
+        }
+        std::vector<size_t> cursor(outgoing.size(), 0);
+
+        const auto& vehicleType = dataLoader_.getVehicleTypes()[commodity.vehicleTypeIndex];
+        for (size_t start = 0; start < numArcs; ++start) {
+            if (arcs[commodity.arcs[start]].type != TimeSpaceArcType::PullOut)
+                continue;
+
+            // Every unit of pull-out flow is one vehicle, walk it along arcs with flow left
+            while (flow[start] > 0) {
+                core::VehicleBlock block{};
+                block.blockNumber   = static_cast<int>(blocks.size()) + 1;
+                block.depotId       = dataLoader_.getDepotStops()[commodity.depotIndex];
+                block.vehicleTypeId = vehicleType.id;
+                block.totalCost     = vehicleType.vehicleCost;
+                block.totalDistance = 0.0;
+                block.totalTime     = 0;
+                block.journeyOffset = static_cast<int>(journeys.size());
+
+                size_t k = start;
+                while (true) {
+                    const auto& arc = arcs[commodity.arcs[k]];
+                    --flow[k];
+                    block.totalCost += arc.cost;
+                    block.totalDistance += arc.distance;
+                    block.totalTime += arc.time;
+                    if (arc.type == TimeSpaceArcType::Service) {
+                        journeys.push_back(arc.journeyIdx);
+                    }
+                    if (arc.toNode < 0)
+                        break;
+
+                    auto& next = cursor[arc.toNode];
+                    auto& out  = outgoing[arc.toNode];
+                    while (next < out.size() && flow[out[next]] == 0) {
+                        ++next;
+                    }
+                    if (next == out.size())
+                        break; // Flow not conserved (numerical noise), end the block here
+                    k = out[next];
+                }
+
+                block.journeyCount = static_cast<int>(journeys.size()) - block.journeyOffset;
+                if (block.journeyCount > 0) {
+                    blocks.push_back(block);
+                }
+            }
+        }
+        offset += numArcs;
+    }
+}
+
+void TimeSpaceModel::roundBlocks(const std::vector<double>& values,
+                                 core::UnifiedSolution&     solution) const {
+    constexpr double kMinFlow = 0.05; // Pull-out flow below this does not start a vehicle
+
+    struct Candidate {
+        size_t commodity;
+        size_t arc; // Pull-out arc, offset into the commodity
+    };
+
+    // Remaining flow and outgoing arcs per commodity
+    std::vector<std::vector<double>>              flow(commodities_.size());
+    std::vector<std::vector<std::vector<size_t>>> outgoing(commodities_.size());
+    std::vector<Candidate>                        pullOuts;
+    std::vector<int>                              vehicles(commodities_.size(), 0);
+
+    size_t offset = 0;
+    for (size_t c = 0; c < commodities_.size(); ++c) {
+        const auto& commodity = commodities_[c];
+        const auto& network   = networks_[commodity.vehicleTypeIndex];
+        const auto& arcs      = network.getArcs();
+        size_t      numArcs   = commodity.arcs.size();
+
+        flow[c].assign(values.begin() + offset, values.begin() + offset + numArcs);
+        outgoing[c].resize(network.getNodes().size());
+        for (size_t k = 0; k < numArcs; ++k) {
+            const auto& arc = arcs[commodity.arcs[k]];
+            if (arc.fromNode >= 0) {
+                outgoing[c][arc.fromNode].push_back(k);
+            }
+            else if (arc.type == TimeSpaceArcType::PullOut) {
+                pullOuts.push_back({c, k});
+            }
+        }
+        offset += numArcs;
+    }
+
+    std::vector<char> served(dataLoader_.getServiceJourneys().size(), 0);
+    auto&             blocks   = solution.blocks;
+    auto&             journeys = solution.journeys;
+    while (true) {
+        // Pull-out with the most flow left among commodities with capacity left
+        const Candidate* best     = nullptr;
+        double           bestFlow = kMinFlow;
+        for (const auto& candidate : pullOuts) {
+            if (vehicles[candidate.commodity] < commodities_[candidate.commodity].capacity &&
+                flow[candidate.commodity][candidate.arc] >= bestFlow) {
+                best     = &candidate;
+                bestFlow = flow[candidate.commodity][candidate.arc];
+            }
+        }
+        if (best == nullptr)
+            break;
+
+        size_t      c           = best->commodity;
+        const auto& commodity   = commodities_[c];
+        const auto& arcs        = networks_[commodity.vehicleTypeIndex].getArcs();
+        const auto& vehicleType = dataLoader_.getVehicleTypes()[commodity.vehicleTypeIndex];
+        ++vehicles[c];
+
+        core::VehicleBlock block{};
+        block.depotId       = dataLoader_.getDepotStops()[commodity.depotIndex];
+        block.vehicleTypeId = vehicleType.id;
+        block.totalCost     = vehicleType.vehicleCost;
+        block.totalDistance = 0.0;
+        block.totalTime     = 0;
+        block.journeyOffset = static_cast<int>(journeys.size());
+
+        // The network is acyclic, so the walk ends at a pull-in or where no flow is left
+        size_t k = best->arc;
+        while (true) {
+            const auto& arc = arcs[commodity.arcs[k]];
+            flow[c][k]      = std::max(0.0, flow[c][k] - 1.0);
+            block.totalCost += arc.cost;
+            block.totalDistance += arc.distance;
+            block.totalTime += arc.time;
+            if (arc.type == TimeSpaceArcType::Service) {
+                served[arc.journeyIdx] = 1;
+                journeys.push_back(arc.journeyIdx);
+            }
+            if (arc.toNode < 0)
+                break;
+
+            double nextFlow = 0.0;
+            size_t next     = k;
+            for (size_t out : outgoing[c][arc.toNode]) {
+                const auto& outArc = arcs[commodity.arcs[out]];
+                if (outArc.type == TimeSpaceArcType::Service && served[outArc.journeyIdx])
+                    continue;
+                if (flow[c][out] > nextFlow) {
+                    nextFlow = flow[c][out];
+                    next     = out;
+                }
+            }
+            if (next == k)
+                break;
+            k = next;
+        }
+
+        block.journeyCount = static_cast<int>(journeys.size()) - block.journeyOffset;
+        if (block.journeyCount > 0) {
+            block.blockNumber = static_cast<int>(blocks.size()) + 1;
+            blocks.push_back(block);
+        }
+    }
+}
+
+std::vector<GRBVar> TimeSpaceModel::getVars() const {
+    std::vector<GRBVar> vars;
+    for (const auto& commodity : commodities_) {
+        vars.insert(vars.end(), commodity.vars.begin(), commodity.vars.end());
+    }
+    return vars;
+}
+
+void TimeSpaceModel::getServiceStart(const core::UnifiedSolution& solution,
+                                     std::vector<GRBVar>&         vars,
+                                     std::vector<double>&         values) const {
+    // Slot (depot * types + type) serving each journey, -1 if uncovered
+    int              numTypes = static_cast<int>(dataLoader_.getVehicleTypes().size());
+    std::vector<int> servedBy(dataLoader_.getServiceJourneys().size(), -1);
+    for (const auto& block : solution.blocks) {
+        int depotIndex       = dataLoader_.getDepotIndex(block.depotId);
+        int vehicleTypeIndex = dataLoader_.getVehicleTypeIndex(block.vehicleTypeId);
+        if (depotIndex < 0 || vehicleTypeIndex < 0)
+            continue;
+        for (int journeyIdx : solution.journeysOf(block)) {
+            servedBy[journeyIdx] = depotIndex * numTypes + vehicleTypeIndex;
+        }
+    }
+
+    vars.clear();
+    values.clear();
+    for (const auto& commodity : commodities_) {
+        const auto& arcs = networks_[commodity.vehicleTypeIndex].getArcs();
+        int         slot = commodity.depotIndex * numTypes + commodity.vehicleTypeIndex;
+        for (size_t k = 0; k < commodity.arcs.size(); ++k) {
+            const auto& arc = arcs[commodity.arcs[k]];
+            if (arc.type != TimeSpaceArcType::Service)
+                continue;
+            vars.push_back(commodity.vars[k]);
+            values.push_back(servedBy[arc.journeyIdx] == slot ? 1.0 : 0.0);
+        }
+    }
+}
+
+} // namespace exact
@@ -0,0 +1,107 @@
+#include "exact/GurobiMasterProblem.hpp"
+#include <algorithm>
+
+namespace exact {
+
+GurobiMasterProblem::GurobiMasterProblem(int threads)
+  : numVehicleTypes_(0),
+    upperBound_(GRB_INFINITY) {
+    env_ = std::make_unique<GRBEnv>(true);
+    env_->set(GRB_IntParam_LogToConsole, 0);
+    env_->start();
+    if (threads > 0) {
+        env_->set(GRB_IntParam_Threads, threads);
+    }
+}
+
+void GurobiMasterProblem::initialize(int                     numJourneys,
+                                     int                     numVehicleTypes,
+                                     const std::vector<int>& slotCapacities) {
+    model_           = std::make_unique<GRBModel>(*env_);
+    numVehicleTypes_ = numVehicleTypes;
+    columnVars_.clear();
+    coverageRows_.clear();
+    capacityRows_.clear();
+
+    model_->set(GRB_StringAttr_ModelName, "mdvsp_master");
+    model_->set(GRB_IntAttr_ModelSense, GRB_MINIMIZE);
+
+    // Rows start empty, columns are added through GRBColumn
+    for (int j = 0; j < numJourneys; ++j) {
+        coverageRows_.push_back(
+            model_->addConstr(GRBLinExpr(), GRB_EQUAL, 1.0, "cover_" + std::to_string(j)));
+    }
+    for (size_t s = 0; s < slotCapacities.size(); ++s) {
+        capacityRows_.push_back(model_->addConstr(GRBLinExpr(),
+                                                  GRB_LESS_EQUAL,
+                                                  slotCapacities[s],
+                                                  "capacity_" + std::to_string(s)));
+    }
+    model_->update();
+}
+
+void GurobiMasterProblem::addColumns(const std::vector<colgen::Column>& columns) {
+    for (const auto& column : columns) {
+        GRBColumn coefficients;
+        for (int journey : column.journeys) {
+            coefficients.addTerm(1.0, coverageRows_[journey]);
+        }
+        int slot = column.depotIndex * numVehicleTypes_ + column.vehicleTypeIndex;
+        coefficients.addTerm(1.0, capacityRows_[slot]);
+
+        columnVars_.push_back(model_->addVar(0.0, 1.0, column.cost, GRB_CONTINUOUS, coefficients));
+    }
+    model_->update();
+}
+
+colgen::MasterSolution GurobiMasterProblem::solveRelaxation(double timeLimit) {
+    colgen::MasterSolution result{false, 0.0, true, {}, {}};
+
+    model_->set(GRB_DoubleParam_TimeLimit, std::max(1.0, timeLimit));
+    model_->optimize();
+    if (model_->get(GRB_IntAttr_Status) != GRB_OPTIMAL)
+        return result;
+
+    result.solved    = true;
+    result.objective = model_->get(GRB_DoubleAttr_ObjVal);
+    for (auto& row : coverageRows_) {
+        result.coverageDuals.push_back(row.get(GRB_DoubleAttr_Pi));
+    }
+    for (auto& row : capacityRows_) {
+        result.capacityDuals.push_back(std::min(0.0, row.get(GRB_DoubleAttr_Pi)));
+    }
+    return result;
+}
+
+colgen::IntegerSolution GurobiMasterProblem::solveInteger(double timeLimit) {
+    colgen::IntegerSolution result{false, 0.0, {}};
+
+    for (auto& var : columnVars_) {
+        var.set(GRB_CharAttr_VType, GRB_BINARY);
+    }
+    if (upperBound_ < GRB_INFINITY) {
+        model_->set(GRB_DoubleParam_Cutoff, upperBound_);
+    }
+    model_->set(GRB_DoubleParam_TimeLimit, std::max(1.0, timeLimit));
+    model_->optimize();
+
+    if (model_->get(GRB_IntAttr_SolCount) > 0) {
+        result.feasible  = true;
+        result.objective = model_->get(GRB_DoubleAttr_ObjVal);
+        for (size_t k = 0; k < columnVars_.size(); ++k) {
+            if (columnVars_[k].get(GRB_DoubleAttr_X) > 0.5) {
+                result.columns.push_back(static_cast<int>(k));
+            }
+        }
+    }
+
+    // Restore the relaxation for further pricing rounds
+    for (auto& var : columnVars_) {
+        var.set(GRB_CharAttr_VType, GRB_CONTINUOUS);
+    }
+    model_->set(GRB_DoubleParam_Cutoff, GRB_INFINITY);
+    model_->update();
+    return result;
+}
+
+} // namespace exact
@@ -1,6 +1,7 @@
 #include "exact/GurobiSolver.hpp"
 #include "core/UnifiedSolution.hpp"
 #include "exact/Config.hpp"
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 
@@ -8,12 +9,15 @@ namespace exact {
 
 using core::UnifiedSolution;
 
-GurobiSolver::GurobiSolver() : problemBuilt_(false) {
+GurobiSolver::GurobiSolver(std::shared_ptr<GRBEnv> env)
+  : env_(std::move(env)), problemBuilt_(false) {
     try {
-        // Initialize Gurobi environment
-        env_ = std::make_unique<GRBEnv>();
-        env_->set(GRB_IntParam_LogToConsole, 0); // Disable console output by default
-        env_->start();
+        // Initialize Gurobi environment unless a started one is shared
+        if (!env_) {
+            env_ = std::make_shared<GRBEnv>();
+            env_->set(GRB_IntParam_LogToConsole, 0); // Disable console output by default
+            env_->start();
+        }
 
         // Initialize configurator
         configurator_ = std::make_unique<SolverConfigurator>();
@@ -46,6 +50,7 @@ bool GurobiSolver::loadFromFile(const std::string& filename) {
 
         model_        = std::make_unique<GRBModel>(*env_, filename);
         problemBuilt_ = true;
+        timeSpaceModel_.reset();
 
         logMessage("Model loaded successfully from file");
         logMessage("  Variables: " + std::to_string(model_->get(GRB_IntAttr_NumVars)));
@@ -95,27 +100,80 @@ UnifiedSolution GurobiSolver::solveFromFile(const std::string& filename, const S
             return UnifiedSolution();
         }
 
-        // Configure solver
-        configurator_->configureSolver(model_.get());
-        configurator_->setTimeLimit(model_.get(), config.timeLimit);
+        auto solution = optimize(config);
 
-        // Apply additional config settings
-        model_->set(GRB_DoubleParam_MIPGap, config.optimalityGap);
-        model_->set(GRB_IntParam_LogToConsole, config.verbose ? 1 : 0);
-        model_->set(GRB_StringParam_LogFile, config.logFile);
+        auto endTime  = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+        solution.solutionTimeSeconds = duration.count() / 1000.0;
+
+        return solution;
+    }
+    catch (GRBException& e) {
+        logMessage("Gurobi optimization error: " + std::string(e.getMessage()), true);
+        return UnifiedSolution();
+    }
+    catch (const std::exception& e) {
+        logMessage("Error during optimization: " + std::string(e.what()), true);
+        return UnifiedSolution();
+    }
+}
+
+UnifiedSolution GurobiSolver::solveFromData(const data::DataLoader& dataLoader,
+                                            const SolverConfig&     config) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    try {
+        logMessage("=== Gurobi Exact Solver (time-space network) ===");
+
+        // A heuristic left from an aborted solve still reads the previous model
+        nodeHeuristic_.reset();
+        connectionNetwork_.reset();
+
+        network::TimeSpaceNetwork::Options options;
+        options.aggregateEvents         = config.reduceNetwork;
+        options.pruneDominatedDeadheads = config.reduceNetwork;
+        timeSpaceModel_ = std::make_unique<TimeSpaceModel>(dataLoader, options);
+
+        const auto& before = timeSpaceModel_->getUnreducedSize();
+        const auto& after  = timeSpaceModel_->getSize();
+        logMessage("Network nodes: " + std::to_string(before.nodes) + " -> " +
+                   std::to_string(after.nodes));
+        logMessage("Network arcs: " + std::to_string(before.arcs()) + " -> " +
+                   std::to_string(after.arcs()) + " (waiting " + std::to_string(after.waitingArcs) +
+                   ", deadhead " + std::to_string(after.deadheadArcs) + ")");
+
+        model_        = timeSpaceModel_->build(*env_);
+        problemBuilt_ = true;
+        logMessage("  Variables: " + std::to_string(model_->get(GRB_IntAttr_NumVars)));
+        logMessage("  Constraints: " + std::to_string(model_->get(GRB_IntAttr_NumConstrs)));
+
+        if (!config.exportModelFile.empty()) {
+            model_->write(config.exportModelFile);
+            logMessage("Model written to: " + config.exportModelFile);
+        }
 
-        if (config.threads > 0) {
-            model_->set(GRB_IntParam_Threads, config.threads);
+        if (config.useCallback && config.nodeHeuristicInterval > 0) {
+            network::ConnectionNetwork::Options networkOptions;
+            networkOptions.threads = config.threads;
+            connectionNetwork_ =
+                std::make_unique<network::ConnectionNetwork>(dataLoader, networkOptions);
+
+            NodeHeuristic::Config heuristicConfig;
+            heuristicConfig.nodeInterval = config.nodeHeuristicInterval;
+            heuristicConfig.verbose      = config.verbose;
+            nodeHeuristic_ = std::make_unique<NodeHeuristic>(
+                *timeSpaceModel_, *connectionNetwork_, heuristicConfig);
         }
 
-        // Solve the model
-        logMessage("Starting optimization...");
-        model_->optimize();
+        auto solution = optimize(config);
 
-        // Extract and return solution
-        auto solution            = extractSolution();
-        solution.algorithmType   = "exact_gurobi";
-        solution.problemInstance = config.problemName;
+        if (nodeHeuristic_) {
+            logMessage("Node heuristic: " + std::to_string(nodeHeuristic_->getRoundCount()) +
+                       " relaxations rounded, " +
+                       std::to_string(nodeHeuristic_->getImprovedCount()) + " improved");
+            nodeHeuristic_.reset();
+            connectionNetwork_.reset();
+        }
 
         auto endTime  = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
@@ -133,6 +191,69 @@ UnifiedSolution GurobiSolver::solveFromFile(const std::string& filename, const S
     }
 }
 
+UnifiedSolution GurobiSolver::optimize(const SolverConfig& config) {
+    // Configure solver
+    configurator_->configureSolver(model_.get());
+    // The token deadline caps the time limit (a zero limit would mean none)
+    double timeLimit = std::max(0.01, std::min(config.timeLimit, config.stop.remaining()));
+    configurator_->setTimeLimit(model_.get(), timeLimit);
+
+    // Apply additional config settings
+    model_->set(GRB_DoubleParam_MIPGap, config.optimalityGap);
+    model_->set(GRB_IntParam_LogToConsole, config.verbose ? 1 : 0);
+    model_->set(GRB_StringParam_LogFile, config.logFile);
+
+    if (config.threads > 0) {
+        model_->set(GRB_IntParam_Threads, config.threads);
+    }
+
+    std::unique_ptr<SolverTelemetry> telemetry;
+    if (config.useCallback) {
+        SolverTelemetry::Config telemetryConfig;
+        telemetryConfig.sampleInterval = config.telemetryInterval;
+        telemetryConfig.print          = config.verbose;
+        telemetryConfig.csvFile        = config.telemetryFile;
+        telemetry = std::make_unique<SolverTelemetry>(telemetryConfig);
+
+        callback_ = std::make_unique<SolverCallback>(config.verbose);
+        callback_->setTelemetry(telemetry.get());
+        if (config.incumbents && timeSpaceModel_) {
+            callback_->setIncumbentStore(config.incumbents, timeSpaceModel_.get());
+        }
+        if (nodeHeuristic_ && timeSpaceModel_) {
+            callback_->setNodeHeuristic(nodeHeuristic_.get(), timeSpaceModel_.get());
+        }
+        callback_->setStopToken(config.stop);
+        callback_->setProgress(config.progress);
+        model_->setCallback(callback_.get());
+    }
+
+    // Solve the model
+    logMessage("Starting optimization...");
+    model_->optimize();
+
+    telemetrySamples_.clear();
+    if (telemetry) {
+        telemetry->stop();
+        telemetrySamples_ = telemetry->getSamples();
+        if (telemetry->getDropped() > 0) {
+            logMessage("Telemetry samples dropped: " + std::to_string(telemetry->getDropped()));
+        }
+        callback_->setTelemetry(nullptr);
+    }
+
+    if (callback_ && callback_->getInjectedCount() > 0) {
+        logMessage("Heuristic incumbents injected: " +
+                   std::to_string(callback_->getInjectedCount()));
+    }
+
+    // Extract and return solution
+    auto solution            = extractSolution();
+    solution.algorithmType   = "exact_gurobi";
+    solution.problemInstance = config.problemName;
+    return solution;
+}
+
 UnifiedSolution GurobiSolver::solveFromFileWithWarmStart(const std::string&     filename,
                                                          const UnifiedSolution& warmStart,
                                                          const SolverConfig&    config) {
@@ -182,6 +303,14 @@ core::UnifiedSolution GurobiSolver::extractSolution() {
                            std::to_string(solution.objectiveValue));
             }
         }
+        else if (status == GRB_INTERRUPTED) {
+            solution.status = "INTERRUPTED";
+            if (model_->get(GRB_IntAttr_SolCount) > 0) {
+                solution.objectiveValue = model_->get(GRB_DoubleAttr_ObjVal);
+                logMessage("Optimization stopped, best solution found: " +
+                           std::to_string(solution.objectiveValue));
+            }
+        }
         else if (status == GRB_INFEASIBLE) {
             solution.status = "INFEASIBLE";
             logMessage("Problem is infeasible", true);
@@ -193,9 +322,16 @@ core::UnifiedSolution GurobiSolver::extractSolution() {
 
         // Extract variable values (simplified - would need to match variable names to solution
         // structure)
-        if (solution.status == "OPTIMAL" || solution.status == "TIME_LIMIT") {
-            logMessage("Solution extraction from Gurobi variables - placeholder implementation");
-            // TODO: Map Gurobi variables back to UnifiedSolution blocks
+        if (solution.status == "OPTIMAL" || solution.status == "TIME_LIMIT" ||
+            solution.status == "INTERRUPTED") {
+            if (timeSpaceModel_ && model_->get(GRB_IntAttr_SolCount) > 0) {
+                timeSpaceModel_->extractBlocks(solution);
+                logMessage("  Vehicle blocks: " + std::to_string(solution.blocks.size()));
+            }
+            else {
+                logMessage("Solution extraction from model files is not implemented");
+                // TODO: Map Gurobi variables back to UnifiedSolution blocks
+            }
         }
     }
     catch (GRBException& e) {
@@ -20,7 +20,7 @@ void GreedySolutionPrinter::printSolution(const data::MDVSPGreedySolution& solut
     if (!solution.blocks.empty()) {
         out << "=== Vehicle Blocks ===" << std::endl;
         for (int i = 0; i < solution.blocks.size(); ++i) {
-            printBlock(solution.blocks[i], i + 1, out);
+            printBlock(solution.blocks[i], solution.journeysOf(solution.blocks[i]), i + 1, out);
             out << std::endl;
         }
     }
@@ -46,7 +46,7 @@ void GreedySolutionPrinter::printSummary(const data::MDVSPGreedySolution& soluti
         for (const auto& block : solution.blocks) {
             totalDistance += block.totalDistance;
             totalTime += block.totalTime;
-            totalJourneys += block.serviceJourneyIds.size();
+            totalJourneys += block.journeyCount;
             vehicleTypeUsage[block.vehicleTypeId]++;
             depotUsage[block.depotStopId]++;
         }
@@ -84,6 +84,7 @@ void GreedySolutionPrinter::printSummary(const data::MDVSPGreedySolution& soluti
 }
 
 void GreedySolutionPrinter::printBlock(const data::VehicleBlock& block,
+                                       data::JourneySpan         journeys,
                                        int                       blockId,
                                        std::ostream&             out) const {
     out << "Block " << blockId << ":" << std::endl;
@@ -97,13 +98,13 @@ void GreedySolutionPrinter::printBlock(const data::VehicleBlock& block,
     out << "  Total Distance: " << std::fixed << std::setprecision(1)
         << block.totalDistance / 1000.0 << " km" << std::endl;
     out << "  Total Time: " << secondsToTimeString(block.totalTime) << std::endl;
-    out << "  Service Journeys: " << block.serviceJourneyIds.size() << std::endl;
+    out << "  Service Journeys: " << journeys.size() << std::endl;
 
-    if (!block.serviceJourneyIds.empty()) {
+    if (!journeys.empty()) {
         out << "  Journey Schedule:" << std::endl;
 
-        for (int i = 0; i < block.serviceJourneyIds.size(); ++i) {
-            int         journeyIdx = block.serviceJourneyIds[i];
+        for (int i = 0; i < journeys.size(); ++i) {
+            int         journeyIdx = journeys[i];
             const auto& journey    = dataLoader_.getServiceJourneys()[journeyIdx];
 
             const auto* fromStop = dataLoader_.getStopPoint(journey.fromStopId);
@@ -141,7 +142,7 @@ bool GreedySolutionPrinter::validateSolution(const data::MDVSPGreedySolution& so
 
     // Check if all journeys are covered
     for (const auto& block : solution.blocks) {
-        for (int journeyIdx : block.serviceJourneyIds) {
+        for (int journeyIdx : solution.journeysOf(block)) {
             if (coveredJourneys.count(journeyIdx)) {
                 out << "ERROR: Journey " << journeyIdx << " is covered by multiple blocks!"
                     << std::endl;
@@ -165,11 +166,11 @@ bool GreedySolutionPrinter::validateSolution(const data::MDVSPGreedySolution& so
 
     // Check time constraints within blocks
     for (int blockIdx = 0; blockIdx < solution.blocks.size(); ++blockIdx) {
-        const auto& block = solution.blocks[blockIdx];
+        auto journeys = solution.journeysOf(solution.blocks[blockIdx]);
 
-        for (int i = 1; i < block.serviceJourneyIds.size(); ++i) {
-            int prevJourneyIdx = block.serviceJourneyIds[i - 1];
-            int currJourneyIdx = block.serviceJourneyIds[i];
+        for (int i = 1; i < journeys.size(); ++i) {
+            int prevJourneyIdx = journeys[i - 1];
+            int currJourneyIdx = journeys[i];
 
             const auto& prevJourney = allJourneys[prevJourneyIdx];
             const auto& currJourney = allJourneys[currJourneyIdx];
@@ -194,7 +195,7 @@ bool GreedySolutionPrinter::validateSolution(const data::MDVSPGreedySolution& so
     for (int blockIdx = 0; blockIdx < solution.blocks.size(); ++blockIdx) {
         const auto& block = solution.blocks[blockIdx];
 
-        for (int journeyIdx : block.serviceJourneyIds) {
+        for (int journeyIdx : solution.journeysOf(block)) {
             const auto& journey = allJourneys[journeyIdx];
 
             if (!dataLoader_.isVehicleTypeCompatible(block.vehicleTypeId, journey.vehTypeGroupId)) {
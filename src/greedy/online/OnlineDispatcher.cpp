@@ -0,0 +1,87 @@
+#include "greedy/OnlineDispatcher.hpp"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace greedy {
+
+namespace {
+// Value at a quantile of unsorted samples (the samples are reordered)
+double quantile(std::vector<double>& samples, double q) {
+    if (samples.empty())
+        return 0.0;
+    auto nth = samples.begin() + static_cast<size_t>(q * (samples.size() - 1));
+    std::nth_element(samples.begin(), nth, samples.end());
+    return *nth;
+}
+} // namespace
+
+OnlineDispatcher::OnlineDispatcher(const data::DataLoader& dataLoader, double latencyBudgetMicros)
+  : dataLoader_(dataLoader), latencyBudgetMicros_(latencyBudgetMicros), solver_(dataLoader) {
+    const auto& journeys = dataLoader_.getServiceJourneys();
+    journeyIndexById_.reserve(journeys.size());
+    for (size_t j = 0; j < journeys.size(); ++j) {
+        journeyIndexById_.emplace(journeys[j].id, static_cast<int>(j));
+    }
+    released_.reserve(journeys.size());
+    latencies_.reserve(journeys.size());
+    solver_.beginDispatch();
+}
+
+OnlineDispatcher::Decision OnlineDispatcher::release(int journeyId) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    int  blockIdx = -1;
+    auto found    = journeyIndexById_.find(journeyId);
+    if (found != journeyIndexById_.end()) {
+        blockIdx = solver_.dispatch(found->second);
+        if (blockIdx >= 0) {
+            released_.push_back(found->second);
+        }
+    }
+
+    double latency = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() -
+                                                               startTime)
+                         .count();
+    latencies_.push_back(latency);
+    return {journeyId, blockIdx, latency};
+}
+
+OnlineDispatcher::Report OnlineDispatcher::finish(bool compareOffline) {
+    Report report;
+    report.released   = latencies_.size();
+    report.assigned   = released_.size();
+    report.overBudget = std::count_if(latencies_.begin(),
+                                      latencies_.end(),
+                                      [this](double latency) {
+                                          return latency > latencyBudgetMicros_;
+                                      });
+
+    std::vector<double> samples = latencies_;
+    report.p50Micros            = quantile(samples, 0.50);
+    report.p99Micros            = quantile(samples, 0.99);
+    report.maxMicros = samples.empty() ? 0.0 : *std::max_element(samples.begin(), samples.end());
+    report.solution  = solver_.finishDispatch();
+
+    // Offline greedy over the released journeys with every depot slot open
+    if (compareOffline && !released_.empty()) {
+        std::vector<std::pair<int, int>> slots;
+        for (size_t d = 0; d < dataLoader_.getDepotStops().size(); ++d) {
+            for (size_t t = 0; t < dataLoader_.getVehicleTypes().size(); ++t) {
+                slots.emplace_back(static_cast<int>(d), static_cast<int>(t));
+            }
+        }
+        auto              subproblem = dataLoader_.createSubproblem(released_, slots);
+        GreedyMDVSPSolver offline(*subproblem);
+        auto              solution = offline.solve();
+        report.offlineVehicles     = static_cast<int>(solution.totalVehiclesUsed);
+        report.offlineCost         = solution.totalObjectiveCost;
+    }
+
+    solver_.beginDispatch();
+    released_.clear();
+    latencies_.clear();
+    return report;
+}
+
+} // namespace greedy
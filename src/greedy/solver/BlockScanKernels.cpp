@@ -0,0 +1,238 @@
+#include "greedy/BlockScanKernels.hpp"
+#include "core/CostPolicy.hpp"
+#include <algorithm>
+#include <limits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MDVSP_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace greedy {
+
+namespace {
+
+constexpr double kDistanceDivisor = core::StandardCostUnits::kDistanceDivisor;
+constexpr double kTimeDivisor     = core::StandardCostUnits::kTimeDivisor;
+
+/**
+ * Scalar scan of blocks [begin, end), continuing from the current best
+ */
+void scanRangeScalar(const OpenBlockTails&  tails,
+                     const BlockScanQuery&  query,
+                     const BlockScanTables& tables,
+                     int                    begin,
+                     int                    end,
+                     BlockScanResult&       best) {
+    const int32_t* readyTimes = tails.readyTimes();
+    const int32_t* endStops   = tails.endStopIndices();
+    const int32_t* types      = tails.vehicleTypeIndices();
+
+    for (int i = begin; i < end; ++i) {
+        int type = types[i];
+        if (!query.compatibleByType[type])
+            continue;
+
+        int cell         = endStops[i] * tables.numStops + query.fromStopIndex;
+        int deadHeadTime = tables.deadRunTime[cell];
+        if (readyTimes[i] + std::max(deadHeadTime, 0) > query.depTime)
+            continue;
+
+        double distance = tables.deadRunDistance[cell];
+        double deadCost = (distance > 0 && deadHeadTime > 0)
+                              ? tables.kmCostByType[type] * distance / kDistanceDivisor +
+                                    tables.hourCostByType[type] * deadHeadTime / kTimeDivisor
+                              : 0.0;
+        double cost     = deadCost + query.serviceCostByType[type];
+
+        if (cost < best.cost) {
+            best.cost     = cost;
+            best.blockIdx = i;
+        }
+    }
+}
+
+#ifdef MDVSP_X86_KERNELS
+
+/**
+ * Fold per-lane bests into the result; ties go to the lowest block index
+ */
+void reduceLanes(const double* costs, const int64_t* indices, int lanes, BlockScanResult& best) {
+    for (int lane = 0; lane < lanes; ++lane) {
+        if (indices[lane] < 0)
+            continue;
+        if (costs[lane] < best.cost || (costs[lane] == best.cost && indices[lane] < best.blockIdx)) {
+            best.cost     = costs[lane];
+            best.blockIdx = static_cast<int>(indices[lane]);
+        }
+    }
+}
+
+__attribute__((target("avx2"))) BlockScanResult
+scanBlocksAvx2(const OpenBlockTails& tails, const BlockScanQuery& query, const BlockScanTables& tables) {
+    const int32_t* readyTimes = tails.readyTimes();
+    const int32_t* endStops   = tails.endStopIndices();
+    const int32_t* types      = tails.vehicleTypeIndices();
+    const int      numBlocks  = tails.size();
+
+    const __m128i depTime   = _mm_set1_epi32(query.depTime);
+    const __m128i fromStop  = _mm_set1_epi32(query.fromStopIndex);
+    const __m128i numStops  = _mm_set1_epi32(tables.numStops);
+    const __m128i zeroInt   = _mm_setzero_si128();
+    const __m256d zero      = _mm256_setzero_pd();
+    const __m256d distDiv   = _mm256_set1_pd(kDistanceDivisor);
+    const __m256d timeDiv   = _mm256_set1_pd(kTimeDivisor);
+    const __m256i laneStep  = _mm256_set1_epi64x(4);
+    __m256d       bestCost  = _mm256_set1_pd(std::numeric_limits<double>::max());
+    __m256i       bestIndex = _mm256_set1_epi64x(-1);
+    __m256i       index     = _mm256_setr_epi64x(0, 1, 2, 3);
+
+    int i = 0;
+    for (; i + 4 <= numBlocks; i += 4, index = _mm256_add_epi64(index, laneStep)) {
+        __m128i ready = _mm_loadu_si128(reinterpret_cast<const __m128i*>(readyTimes + i));
+        __m128i stop  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(endStops + i));
+        __m128i type  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(types + i));
+
+        // Feasibility: compatible type and readyTime + max(deadRun, 0) <= depTime
+        __m128i compatible = _mm_i32gather_epi32(query.compatibleByType, type, 4);
+        __m128i cell       = _mm_add_epi32(_mm_mullo_epi32(stop, numStops), fromStop);
+        __m128i deadTime   = _mm_i32gather_epi32(tables.deadRunTime, cell, 4);
+        __m128i earliest   = _mm_add_epi32(ready, _mm_max_epi32(deadTime, zeroInt));
+        __m128i feasible   = _mm_andnot_si128(_mm_cmpgt_epi32(earliest, depTime), compatible);
+        if (_mm_testz_si128(feasible, feasible))
+            continue;
+
+        // Append cost: dead run cost (if distance and time are positive) plus service cost
+        __m256d distance = _mm256_i32gather_pd(tables.deadRunDistance, cell, 8);
+        __m256d kmCost   = _mm256_i32gather_pd(tables.kmCostByType, type, 8);
+        __m256d hourCost = _mm256_i32gather_pd(tables.hourCostByType, type, 8);
+        __m256d service  = _mm256_i32gather_pd(query.serviceCostByType, type, 8);
+        __m256d seconds  = _mm256_cvtepi32_pd(deadTime);
+
+        __m256d leg      = _mm256_add_pd(_mm256_div_pd(_mm256_mul_pd(kmCost, distance), distDiv),
+                                    _mm256_div_pd(_mm256_mul_pd(hourCost, seconds), timeDiv));
+        __m256d positive = _mm256_and_pd(_mm256_cmp_pd(distance, zero, _CMP_GT_OQ),
+                                         _mm256_cmp_pd(seconds, zero, _CMP_GT_OQ));
+        __m256d cost     = _mm256_add_pd(_mm256_and_pd(leg, positive), service);
+
+        // Keep the strictly cheaper feasible lanes
+        __m256d feasibleMask = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(feasible));
+        __m256d better = _mm256_and_pd(feasibleMask, _mm256_cmp_pd(cost, bestCost, _CMP_LT_OQ));
+        bestCost       = _mm256_blendv_pd(bestCost, cost, better);
+        bestIndex      = _mm256_castpd_si256(_mm256_blendv_pd(
+            _mm256_castsi256_pd(bestIndex), _mm256_castsi256_pd(index), better));
+    }
+
+    alignas(32) double  laneCosts[4];
+    alignas(32) int64_t laneIndices[4];
+    _mm256_store_pd(laneCosts, bestCost);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(laneIndices), bestIndex);
+
+    BlockScanResult best{-1, std::numeric_limits<double>::max()};
+    reduceLanes(laneCosts, laneIndices, 4, best);
+    scanRangeScalar(tails, query, tables, i, numBlocks, best);
+    return best;
+}
+
+__attribute__((target("avx512f"))) BlockScanResult
+scanBlocksAvx512(const OpenBlockTails& tails, const BlockScanQuery& query, const BlockScanTables& tables) {
+    const int32_t* readyTimes = tails.readyTimes();
+    const int32_t* endStops   = tails.endStopIndices();
+    const int32_t* types      = tails.vehicleTypeIndices();
+    const int      numBlocks  = tails.size();
+
+    const __m256i depTime   = _mm256_set1_epi32(query.depTime);
+    const __m256i fromStop  = _mm256_set1_epi32(query.fromStopIndex);
+    const __m256i numStops  = _mm256_set1_epi32(tables.numStops);
+    const __m256i zeroInt   = _mm256_setzero_si256();
+    const __m512d zero      = _mm512_setzero_pd();
+    const __m512d distDiv   = _mm512_set1_pd(kDistanceDivisor);
+    const __m512d timeDiv   = _mm512_set1_pd(kTimeDivisor);
+    const __m512i laneStep  = _mm512_set1_epi64(8);
+    __m512d       bestCost  = _mm512_set1_pd(std::numeric_limits<double>::max());
+    __m512i       bestIndex = _mm512_set1_epi64(-1);
+    __m512i       index     = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+
+    int i = 0;
+    for (; i + 8 <= numBlocks; i += 8, index = _mm512_add_epi64(index, laneStep)) {
+        __m256i ready = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(readyTimes + i));
+        __m256i stop  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(endStops + i));
+        __m256i type  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(types + i));
+
+        // Feasibility: compatible type and readyTime + max(deadRun, 0) <= depTime
+        __m256i compatible = _mm256_i32gather_epi32(query.compatibleByType, type, 4);
+        __m256i cell       = _mm256_add_epi32(_mm256_mullo_epi32(stop, numStops), fromStop);
+        __m256i deadTime   = _mm256_i32gather_epi32(tables.deadRunTime, cell, 4);
+        __m256i earliest   = _mm256_add_epi32(ready, _mm256_max_epi32(deadTime, zeroInt));
+        __m256i feasible   = _mm256_andnot_si256(_mm256_cmpgt_epi32(earliest, depTime), compatible);
+        __mmask8 feasibleMask =
+            static_cast<__mmask8>(_mm256_movemask_ps(_mm256_castsi256_ps(feasible)));
+        if (feasibleMask == 0)
+            continue;
+
+        // Append cost, gathering distances only for feasible lanes
+        __m512d distance =
+            _mm512_mask_i32gather_pd(zero, feasibleMask, cell, tables.deadRunDistance, 8);
+        __m512d kmCost   = _mm512_i32gather_pd(type, tables.kmCostByType, 8);
+        __m512d hourCost = _mm512_i32gather_pd(type, tables.hourCostByType, 8);
+        __m512d service  = _mm512_i32gather_pd(type, query.serviceCostByType, 8);
+        __m512d seconds  = _mm512_cvtepi32_pd(deadTime);
+
+        __m512d  leg      = _mm512_add_pd(_mm512_div_pd(_mm512_mul_pd(kmCost, distance), distDiv),
+                                    _mm512_div_pd(_mm512_mul_pd(hourCost, seconds), timeDiv));
+        __mmask8 positive = _mm512_cmp_pd_mask(distance, zero, _CMP_GT_OQ) &
+                            _mm512_cmp_pd_mask(seconds, zero, _CMP_GT_OQ);
+        __m512d  cost     = _mm512_add_pd(_mm512_maskz_mov_pd(positive, leg), service);
+
+        // Keep the strictly cheaper feasible lanes
+        __mmask8 better = feasibleMask & _mm512_cmp_pd_mask(cost, bestCost, _CMP_LT_OQ);
+        bestCost        = _mm512_mask_mov_pd(bestCost, better, cost);
+        bestIndex       = _mm512_mask_mov_epi64(bestIndex, better, index);
+    }
+
+    alignas(64) double  laneCosts[8];
+    alignas(64) int64_t laneIndices[8];
+    _mm512_store_pd(laneCosts, bestCost);
+    _mm512_store_si512(laneIndices, bestIndex);
+
+    BlockScanResult best{-1, std::numeric_limits<double>::max()};
+    reduceLanes(laneCosts, laneIndices, 8, best);
+    scanRangeScalar(tails, query, tables, i, numBlocks, best);
+    return best;
+}
+
+#endif // MDVSP_X86_KERNELS
+
+} // namespace
+
+BlockScanResult scanBlocksScalar(const OpenBlockTails&  tails,
+                                 const BlockScanQuery&  query,
+                                 const BlockScanTables& tables) {
+    BlockScanResult best{-1, std::numeric_limits<double>::max()};
+    scanRangeScalar(tails, query, tables, 0, tails.size(), best);
+    return best;
+}
+
+BlockScanKernel selectBlockScanKernel(const char** name) {
+    BlockScanKernel kernel     = &scanBlocksScalar;
+    const char*     kernelName = "scalar";
+
+#ifdef MDVSP_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        kernel     = &scanBlocksAvx512;
+        kernelName = "avx512";
+    }
+    else if (__builtin_cpu_supports("avx2")) {
+        kernel     = &scanBlocksAvx2;
+        kernelName = "avx2";
+    }
+#endif
+
+    if (name != nullptr) {
+        *name = kernelName;
+    }
+    return kernel;
+}
+
+} // namespace greedy
@@ -0,0 +1,73 @@
+#include "greedy/DepotRankingTable.hpp"
+#include <algorithm>
+
+namespace greedy {
+
+DepotRankingTable::DepotRankingTable(const data::DataLoader& dataLoader)
+  : numDepots_(static_cast<int>(dataLoader.getDepotStops().size())),
+    numStops_(dataLoader.getNumStopIndices()),
+    numVehicleTypes_(static_cast<int>(dataLoader.getVehicleTypes().size())) {
+    const auto& depots = dataLoader.getDepotStops();
+
+    // Resolve string-keyed dead runs once per (depot, stop)
+    pullOutLegs_.resize(static_cast<size_t>(numDepots_) * numStops_);
+    pullInLegs_.resize(static_cast<size_t>(numDepots_) * numStops_);
+
+    for (int d = 0; d < numDepots_; ++d) {
+        for (int s = 0; s < numStops_; ++s) {
+            int stopId = dataLoader.getStopIdByIndex(s);
+
+            pullOutLegs_[d * numStops_ + s] = {dataLoader.getDeadRunDistance(depots[d], stopId),
+                                               dataLoader.getDeadRunTime(depots[d], stopId)};
+            pullInLegs_[d * numStops_ + s]  = {dataLoader.getDeadRunDistance(stopId, depots[d]),
+                                               dataLoader.getDeadRunTime(stopId, depots[d])};
+        }
+    }
+
+    buildRanking(dataLoader, pullOutLegs_, pullOut_, pullOutOffsets_);
+    buildRanking(dataLoader, pullInLegs_, pullIn_, pullInOffsets_);
+}
+
+void DepotRankingTable::buildRanking(const data::DataLoader&      dataLoader,
+                                     const std::vector<DepotLeg>& legs,
+                                     std::vector<DepotCandidate>& candidates,
+                                     std::vector<int>&            offsets) {
+    const auto& depots       = dataLoader.getDepotStops();
+    const auto& vehicleTypes = dataLoader.getVehicleTypes();
+
+    offsets.assign(static_cast<size_t>(numVehicleTypes_) * numStops_ + 1, 0);
+    candidates.clear();
+
+    for (int t = 0; t < numVehicleTypes_; ++t) {
+        const auto& vehicleType = vehicleTypes[t];
+
+        for (int s = 0; s < numStops_; ++s) {
+            size_t first = candidates.size();
+
+            for (int d = 0; d < numDepots_; ++d) {
+                // Depots without capacity for this type can never be chosen
+                if (dataLoader.getVehicleCapacityAtStop(vehicleType.id, depots[d]) <= 0)
+                    continue;
+
+                const auto& leg = legs[d * numStops_ + s];
+                if (!leg.exists())
+                    continue;
+
+                double cost = vehicleType.kmCost * leg.distance / 100.0 +
+                              vehicleType.hourCost * leg.time / 3600.0;
+                candidates.push_back({d, depots[d], cost, leg});
+            }
+
+            // Stable sort keeps depot order for equal costs
+            std::stable_sort(candidates.begin() + first,
+                             candidates.end(),
+                             [](const DepotCandidate& a, const DepotCandidate& b) {
+                                 return a.cost < b.cost;
+                             });
+
+            offsets[t * numStops_ + s + 1] = static_cast<int>(candidates.size());
+        }
+    }
+}
+
+} // namespace greedy
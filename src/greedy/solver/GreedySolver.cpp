@@ -4,46 +4,84 @@
 #include <iostream>
 #include <limits>
 #include <numeric>
+#include <random>
 
 namespace greedy {
 
 GreedyMDVSPSolver::GreedyMDVSPSolver(const data::DataLoader& dataLoader)
-  : dataLoader_(dataLoader), verbose_(false) {}
+  : dataLoader_(dataLoader),
+    verbose_(false),
+    candidateEvaluations_(0),
+    orderSeed_(0),
+    costLowerBound_(0.0),
+    journeys_(dataLoader),
+    dispatchFailures_(0),
+    depotRanking_(dataLoader),
+    state_(dataLoader) {
+    for (const auto& vehicleType : dataLoader_.getVehicleTypes()) {
+        costRates_.emplace_back(vehicleType);
+        kmCostByType_.push_back(vehicleType.kmCost);
+        hourCostByType_.push_back(vehicleType.hourCost);
+    }
+    serviceCostByType_.resize(costRates_.size());
+    blockOfPosition_.resize(journeys_.size());
+
+    // Compatibility rows as lane masks for the block scan kernels
+    int numTypes  = static_cast<int>(costRates_.size());
+    int numGroups = 0;
+    for (int p = 0; p < journeys_.size(); ++p) {
+        numGroups = std::max(numGroups, journeys_.group(p) + 1);
+    }
+    compatibleByGroup_.assign(static_cast<size_t>(numGroups) * numTypes, 0);
+    for (int g = 0; g < numGroups; ++g) {
+        for (int t = 0; t < numTypes; ++t) {
+            compatibleByGroup_[g * numTypes + t] =
+                dataLoader_.isVehicleTypeIndexCompatible(t, g) ? -1 : 0;
+        }
+    }
+
+    scanTables_ = {dataLoader_.getDeadRunTimeMatrix(),
+                   dataLoader_.getDeadRunDistanceMatrix(),
+                   dataLoader_.getNumStopIndices(),
+                   kmCostByType_.data(),
+                   hourCostByType_.data()};
+    scanKernel_ = selectBlockScanKernel(&scanKernelName_);
+}
 
 data::MDVSPGreedySolution GreedyMDVSPSolver::solve() {
     auto startTime = std::chrono::high_resolution_clock::now();
 
     log("Starting Greedy MDVSP Solver...");
+    log("Block scan kernel: " + std::string(scanKernelName_));
 
     data::MDVSPGreedySolution solution;
     initialize();
 
-    // Get journeys sorted by departure time
-    auto sortedJourneys = getSortedJourneyIndices();
+    // Journey table positions, already sorted by departure time
+    auto order = getJourneyOrder();
 
-    log("Processing " + std::to_string(sortedJourneys.size()) + " service journeys...");
+    log("Processing " + std::to_string(order.size()) + " service journeys...");
 
     // Greedy assignment
-    for (int journeyIdx : sortedJourneys) {
-        const auto& journey = dataLoader_.getServiceJourneys()[journeyIdx];
-
-        // Try to assign to existing block first (cheaper)
-        if (!tryAssignToExistingBlock(journeyIdx)) {
-            // Create new block if necessary
-            if (!createNewBlock(journeyIdx)) {
-                log("WARNING: Could not assign journey " + std::to_string(journey.id));
-                solution.isFeasible = false;
-            }
+    for (size_t k = 0; k < order.size(); ++k) {
+        int position = order[k];
+
+        if (cutoff_ && k % 64 == 0 && costLowerBound_ >= cutoff_()) {
+            log("Cutoff reached after " + std::to_string(k) + " journeys, construction aborted");
+            break;
+        }
+        if (k % 64 == 0 && stop_.stopRequested()) {
+            log("Stopped after " + std::to_string(k) + " journeys, construction aborted");
+            break;
         }
 
-        assignedJourneys_.insert(journeyIdx);
+        // Try to assign to existing block first (cheaper), create new block if necessary
+        if (!tryAssignToExistingBlock(position) && !createNewBlock(position)) {
+            log("WARNING: Could not assign journey " +
+                std::to_string(journeys_.journeyId(position)));
+        }
     }
-
-    // Calculate solution metrics
-    solution.blocks             = currentBlocks_;
-    solution.totalObjectiveCost = calculateTotalCost();
-    solution.totalVehiclesUsed  = currentBlocks_.size();
-    solution.isFeasible = (assignedJourneys_.size() == dataLoader_.getServiceJourneys().size());
+    finishSolution(order, state_.allAssigned(), solution);
 
     auto endTime  = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
@@ -54,259 +92,262 @@ data::MDVSPGreedySolution GreedyMDVSPSolver::solve() {
     log("  - Vehicles used: " + std::to_string(solution.totalVehiclesUsed));
     log("  - Feasible: " + std::string(solution.isFeasible ? "YES" : "NO"));
     log("  - Solution time: " + std::to_string(solution.solutionTime) + " seconds");
+    log("  - Candidate evaluations: " + std::to_string(candidateEvaluations_) + " (" +
+        std::to_string(static_cast<long long>(
+            solution.solutionTime > 0 ? candidateEvaluations_ / solution.solutionTime : 0)) +
+        " per second)");
 
     return solution;
 }
 
-void GreedyMDVSPSolver::initialize() {
-    currentBlocks_.clear();
-    assignedJourneys_.clear();
-    depotVehicleCount_.clear();
+void GreedyMDVSPSolver::beginDispatch() {
+    initialize();
+    dispatchOrder_.clear();
+    dispatchOrder_.reserve(journeys_.size());
+    dispatchFailures_ = 0;
 }
 
-std::vector<int> GreedyMDVSPSolver::getSortedJourneyIndices() const {
-    const auto& journeys = dataLoader_.getServiceJourneys();
+int GreedyMDVSPSolver::dispatch(int journeyIdx) {
+    int position = journeys_.position(journeyIdx);
+    if (state_.isAssigned(position))
+        return -1;
 
-    std::vector<int> indices(journeys.size());
-    std::iota(indices.begin(), indices.end(), 0);
+    if (!tryAssignToExistingBlock(position) && !createNewBlock(position)) {
+        ++dispatchFailures_;
+        return -1;
+    }
+    dispatchOrder_.push_back(position);
+    return blockOfPosition_[position];
+}
 
-    // Sort by departure time
-    std::sort(indices.begin(), indices.end(), [&journeys](int a, int b) {
-        return journeys[a].depTime < journeys[b].depTime;
-    });
+data::MDVSPGreedySolution GreedyMDVSPSolver::finishDispatch() {
+    data::MDVSPGreedySolution solution;
+    finishSolution(dispatchOrder_, dispatchFailures_ == 0, solution);
+    return solution;
+}
 
-    return indices;
+void GreedyMDVSPSolver::initialize() {
+    currentBlocks_.clear();
+    blockTails_.clear();
+    candidateEvaluations_ = 0;
+    costLowerBound_       = 0.0;
+    state_.reset();
 }
 
-bool GreedyMDVSPSolver::tryAssignToExistingBlock(int journeyIdx) {
-    const auto& journey = dataLoader_.getServiceJourneys()[journeyIdx];
+std::vector<int> GreedyMDVSPSolver::getJourneyOrder() const {
+    std::vector<int> positions(journeys_.size());
+    std::iota(positions.begin(), positions.end(), 0);
 
-    double bestCost     = std::numeric_limits<double>::max();
-    int    bestBlockIdx = -1;
+    // Variants: random order within departure buckets (a block's journeys stay in time order,
+    // since a journey only fits a block whose last journey is ready before it departs)
+    if (orderSeed_ != 0) {
+        constexpr int bucketSeconds = 300;
 
-    // Check all existing blocks
-    for (int i = 0; i < currentBlocks_.size(); ++i) {
-        auto& block = currentBlocks_[i];
+        std::mt19937     generator(orderSeed_);
+        std::vector<int> key(positions.size());
+        for (int& value : key) {
+            value = static_cast<int>(generator());
+        }
 
-        if (canAppendJourney(block, journey)) {
-            double cost = calculateAppendCost(block, journey);
-            if (cost < bestCost) {
-                bestCost     = cost;
-                bestBlockIdx = i;
+        // Positions are in departure order, so every bucket is a contiguous range
+        for (size_t first = 0; first < positions.size();) {
+            int    bucket = journeys_.depTime(first) / bucketSeconds;
+            size_t last   = first + 1;
+            while (last < positions.size() && journeys_.depTime(last) / bucketSeconds == bucket) {
+                ++last;
             }
+            std::stable_sort(positions.begin() + first,
+                             positions.begin() + last,
+                             [&key](int a, int b) { return key[a] < key[b]; });
+            first = last;
         }
     }
 
+    return positions;
+}
+
+bool GreedyMDVSPSolver::tryAssignToExistingBlock(int position) {
+    int numTypes = static_cast<int>(costRates_.size());
+
+    // Service cost depends only on the block's vehicle type
+    for (int t = 0; t < numTypes; ++t) {
+        serviceCostByType_[t] = serviceCost(costRates_[t], position);
+    }
+
+    BlockScanQuery query{journeys_.depTime(position),
+                         journeys_.fromStop(position),
+                         compatibleByGroup_.data() + journeys_.group(position) * numTypes,
+                         serviceCostByType_.data()};
+
+    // Check all existing blocks in one batched pass
+    BlockScanResult best = scanKernel_(blockTails_, query, scanTables_);
+    candidateEvaluations_ += blockTails_.size();
+
     // Assign to best block if found
-    if (bestBlockIdx != -1) {
-        appendJourneyToBlock(currentBlocks_[bestBlockIdx], journey);
+    if (best.blockIdx != -1) {
+        appendJourneyToBlock(best.blockIdx, position);
         return true;
     }
 
     return false;
 }
 
-bool GreedyMDVSPSolver::createNewBlock(int journeyIdx) {
-    const auto& journey = dataLoader_.getServiceJourneys()[journeyIdx];
+bool GreedyMDVSPSolver::createNewBlock(int position) {
+    const auto& journey = dataLoader_.getServiceJourneys()[journeys_.journeyIndex(position)];
 
     // Find best vehicle type for this journey
     int vehicleTypeId = findBestVehicleType(journey);
     if (vehicleTypeId == -1) {
         return false;
     }
+    int vehicleTypeIndex = dataLoader_.getVehicleTypeIndex(vehicleTypeId);
 
-    // Find best depot
-    int depotId = findBestDepot(journey, vehicleTypeId);
-    if (depotId == -1) {
-        return false;
-    }
-
-    // Check depot capacity
-    if (!hasDepotCapacity(depotId, vehicleTypeId)) {
+    // Find best depot with free capacity
+    const DepotCandidate* depot = findBestDepot(position, vehicleTypeIndex);
+    if (depot == nullptr) {
         return false;
     }
 
     // Create new block
     data::VehicleBlock newBlock;
     newBlock.vehicleTypeId = vehicleTypeId;
-    newBlock.depotStopId   = depotId;
-    newBlock.serviceJourneyIds.push_back(journeyIdx);
+    newBlock.depotStopId   = depot->depotId;
+    newBlock.journeyCount  = 1;
 
     // Calculate initial costs
-    const auto* vehicleType = dataLoader_.getVehicleType(vehicleTypeId);
-    if (vehicleType) {
-        newBlock.totalCost = vehicleType->vehicleCost;
-
-        // Add dead head cost from depot to first journey
-        int    deadHeadTime     = dataLoader_.getDeadRunTime(depotId, journey.fromStopId);
-        double deadHeadDistance = dataLoader_.getDeadRunDistance(depotId, journey.fromStopId);
-
-        if (deadHeadTime > 0 && deadHeadDistance > 0) {
-            newBlock.totalCost += vehicleType->kmCost * deadHeadDistance / 100.0; // km cost
-            newBlock.totalCost += vehicleType->hourCost * deadHeadTime / 3600.0;  // hour cost
-            newBlock.totalDistance += deadHeadDistance;
-            newBlock.totalTime += deadHeadTime;
-        }
-
-        // Add service journey costs
-        newBlock.totalCost += vehicleType->kmCost * journey.distance / 100.0;
-        newBlock.totalCost += vehicleType->hourCost * (journey.arrTime - journey.depTime) / 3600.0;
-        newBlock.totalDistance += journey.distance;
-        newBlock.totalTime += (journey.arrTime - journey.depTime);
-
-        // Add return to depot cost
-        int    returnTime     = dataLoader_.getDeadRunTime(journey.toStopId, depotId);
-        double returnDistance = dataLoader_.getDeadRunDistance(journey.toStopId, depotId);
-
-        if (returnTime > 0 && returnDistance > 0) {
-            newBlock.totalCost += vehicleType->kmCost * returnDistance / 100.0;
-            newBlock.totalCost += vehicleType->hourCost * returnTime / 3600.0;
-            newBlock.totalDistance += returnDistance;
-            newBlock.totalTime += returnTime;
-        }
-    }
-
-    currentBlocks_.push_back(newBlock);
-
-    // Update depot capacity tracking
-    depotVehicleCount_[depotId][vehicleTypeId]++;
-
-    return true;
-}
-
-bool GreedyMDVSPSolver::canAppendJourney(const data::VehicleBlock&   block,
-                                         const data::ServiceJourney& journey) const {
-    if (block.serviceJourneyIds.empty())
-        return false;
-
-    // Check vehicle type compatibility
-    if (!dataLoader_.isVehicleTypeCompatible(block.vehicleTypeId, journey.vehTypeGroupId)) {
-        return false;
+    const auto& rates  = costRates_[vehicleTypeIndex];
+    newBlock.totalCost = rates.vehicleCost;
+
+    // Add dead head cost from depot to first journey
+    const auto& pullOut = depot->leg;
+    if (pullOut.time > 0 && pullOut.distance > 0) {
+        newBlock.totalCost += Cost::legCost(rates, pullOut.distance, pullOut.time);
+        newBlock.totalDistance += pullOut.distance;
+        newBlock.totalTime += pullOut.time;
     }
 
-    // Check time constraints
-    int         lastJourneyIdx = block.serviceJourneyIds.back();
-    const auto& lastJourney    = dataLoader_.getServiceJourneys()[lastJourneyIdx];
-
-    int deadHeadTime = dataLoader_.getDeadRunTime(lastJourney.toStopId, journey.fromStopId);
-    if (deadHeadTime < 0)
-        deadHeadTime = 0; // Assume no connection if not found
+    costLowerBound_ += newBlock.totalCost;
 
-    int earliestStart = lastJourney.arrTime + lastJourney.minLayoverTime + deadHeadTime;
-
-    return earliestStart <= journey.depTime;
-}
-
-double GreedyMDVSPSolver::calculateAppendCost(const data::VehicleBlock&   block,
-                                              const data::ServiceJourney& journey) const {
-    const auto* vehicleType = dataLoader_.getVehicleType(block.vehicleTypeId);
-    if (!vehicleType)
-        return std::numeric_limits<double>::max();
-
-    double cost = 0.0;
-
-    // Get last journey
-    int         lastJourneyIdx = block.serviceJourneyIds.back();
-    const auto& lastJourney    = dataLoader_.getServiceJourneys()[lastJourneyIdx];
+    // Add service journey costs
+    newBlock.totalCost += serviceCost(rates, position);
+    costLowerBound_ += serviceCost(rates, position);
+    newBlock.totalDistance += journeys_.distance(position);
+    newBlock.totalTime += (journeys_.arrTime(position) - journeys_.depTime(position));
 
-    // Dead head cost
-    double deadHeadDistance =
-        dataLoader_.getDeadRunDistance(lastJourney.toStopId, journey.fromStopId);
-    int deadHeadTime = dataLoader_.getDeadRunTime(lastJourney.toStopId, journey.fromStopId);
+    // The return to the depot is added by closeBlocks() once the last journey is known
 
-    if (deadHeadDistance > 0 && deadHeadTime > 0) {
-        cost += vehicleType->kmCost * deadHeadDistance / 100.0;
-        cost += vehicleType->hourCost * deadHeadTime / 3600.0;
-    }
+    state_.assign(position);
+    blockOfPosition_[position] = static_cast<int>(currentBlocks_.size());
+    currentBlocks_.push_back(newBlock);
+    blockTails_.push(journeys_.readyTime(position), journeys_.toStop(position), vehicleTypeIndex);
 
-    // Service journey cost
-    cost += vehicleType->kmCost * journey.distance / 100.0;
-    cost += vehicleType->hourCost * (journey.arrTime - journey.depTime) / 3600.0;
+    // Update depot capacity tracking
+    state_.acquire(depot->depotIndex, vehicleTypeIndex);
 
-    return cost;
+    return true;
 }
 
-void GreedyMDVSPSolver::appendJourneyToBlock(data::VehicleBlock&         block,
-                                             const data::ServiceJourney& journey) {
-    const auto* vehicleType = dataLoader_.getVehicleType(block.vehicleTypeId);
-    if (!vehicleType)
-        return;
-
-    // Get last journey for dead head calculation
-    int         lastJourneyIdx = block.serviceJourneyIds.back();
-    const auto& lastJourney    = dataLoader_.getServiceJourneys()[lastJourneyIdx];
+void GreedyMDVSPSolver::appendJourneyToBlock(int blockIdx, int position) {
+    auto&       block    = currentBlocks_[blockIdx];
+    const auto& rates    = costRates_[blockTails_.vehicleTypeIndex(blockIdx)];
+    int         fromStop = blockTails_.endStopIndex(blockIdx);
+    int         toStop   = journeys_.fromStop(position);
 
     // Add dead head costs
-    double deadHeadDistance =
-        dataLoader_.getDeadRunDistance(lastJourney.toStopId, journey.fromStopId);
-    int deadHeadTime = dataLoader_.getDeadRunTime(lastJourney.toStopId, journey.fromStopId);
+    double deadHeadDistance = dataLoader_.getDeadRunDistanceByIndex(fromStop, toStop);
+    int    deadHeadTime     = dataLoader_.getDeadRunTimeByIndex(fromStop, toStop);
 
     if (deadHeadDistance > 0 && deadHeadTime > 0) {
-        block.totalCost += vehicleType->kmCost * deadHeadDistance / 100.0;
-        block.totalCost += vehicleType->hourCost * deadHeadTime / 3600.0;
+        block.totalCost += Cost::legCost(rates, deadHeadDistance, deadHeadTime);
         block.totalDistance += deadHeadDistance;
         block.totalTime += deadHeadTime;
+        costLowerBound_ += Cost::legCost(rates, deadHeadDistance, deadHeadTime);
     }
 
     // Add service journey costs
-    block.totalCost += vehicleType->kmCost * journey.distance / 100.0;
-    block.totalCost += vehicleType->hourCost * (journey.arrTime - journey.depTime) / 3600.0;
-    block.totalDistance += journey.distance;
-    block.totalTime += (journey.arrTime - journey.depTime);
-
-    // Add journey to block
-    int journeyIdx = &journey - &dataLoader_.getServiceJourneys()[0];
-    block.serviceJourneyIds.push_back(journeyIdx);
+    block.totalCost += serviceCost(rates, position);
+    costLowerBound_ += serviceCost(rates, position);
+    block.totalDistance += journeys_.distance(position);
+    block.totalTime += (journeys_.arrTime(position) - journeys_.depTime(position));
+
+    // Add journey to block and advance its tail
+    ++block.journeyCount;
+    state_.assign(position);
+    blockOfPosition_[position] = blockIdx;
+    blockTails_.advance(blockIdx, journeys_.readyTime(position), journeys_.toStop(position));
 }
 
-int GreedyMDVSPSolver::findBestDepot(const data::ServiceJourney& journey, int vehicleTypeId) const {
-    auto depots = dataLoader_.getDepotStops();
+void GreedyMDVSPSolver::closeBlocks() {
+    for (int blockIdx = 0; blockIdx < static_cast<int>(currentBlocks_.size()); ++blockIdx) {
+        auto&       block  = currentBlocks_[blockIdx];
+        const auto& rates  = costRates_[blockTails_.vehicleTypeIndex(blockIdx)];
+        const auto& pullIn = depotRanking_.pullInLeg(dataLoader_.getDepotIndex(block.depotStopId),
+                                                     blockTails_.endStopIndex(blockIdx));
+        if (pullIn.time > 0 && pullIn.distance > 0) {
+            block.totalCost += Cost::legCost(rates, pullIn.distance, pullIn.time);
+            block.totalDistance += pullIn.distance;
+            block.totalTime += pullIn.time;
+        }
+    }
+}
 
-    double bestCost  = std::numeric_limits<double>::max();
-    int    bestDepot = -1;
+void GreedyMDVSPSolver::finishSolution(const std::vector<int>&    order,
+                                       bool                       feasible,
+                                       data::MDVSPGreedySolution& solution) {
+    closeBlocks();
 
-    const auto* vehicleType = dataLoader_.getVehicleType(vehicleTypeId);
-    if (!vehicleType)
-        return -1;
+    // Calculate solution metrics
+    solution.totalObjectiveCost = calculateTotalCost();
+    solution.totalVehiclesUsed  = currentBlocks_.size();
+    solution.isFeasible         = feasible;
+    solution.blocks             = std::move(currentBlocks_);
+    packJourneys(order, solution);
+}
 
-    for (int depotId : depots) {
-        if (!hasDepotCapacity(depotId, vehicleTypeId))
-            continue;
+void GreedyMDVSPSolver::packJourneys(const std::vector<int>&    order,
+                                     data::MDVSPGreedySolution& solution) const {
+    // Offsets from the block sizes, so the array is allocated once at its final size
+    std::vector<int> next(solution.blocks.size());
+    int              offset = 0;
+    for (size_t b = 0; b < solution.blocks.size(); ++b) {
+        solution.blocks[b].journeyOffset = offset;
+        next[b]                          = offset;
+        offset += solution.blocks[b].journeyCount;
+    }
 
-        // Calculate cost from depot to journey start
-        double distance = dataLoader_.getDeadRunDistance(depotId, journey.fromStopId);
-        int    time     = dataLoader_.getDeadRunTime(depotId, journey.fromStopId);
+    solution.journeys.assign(offset, -1);
+    for (int position : order) {
+        if (state_.isAssigned(position)) {
+            int blockIdx                        = blockOfPosition_[position];
+            solution.journeys[next[blockIdx]++] = journeys_.journeyIndex(position);
+        }
+    }
+}
 
-        if (distance >= 0 && time >= 0) {
-            double cost =
-                vehicleType->kmCost * distance / 100.0 + vehicleType->hourCost * time / 3600.0;
-            if (cost < bestCost) {
-                bestCost  = cost;
-                bestDepot = depotId;
-            }
+const DepotCandidate* GreedyMDVSPSolver::findBestDepot(int position, int vehicleTypeIndex) const {
+    if (vehicleTypeIndex < 0)
+        return nullptr;
+
+    // Candidates are sorted by pull-out cost, so the first one with capacity wins
+    auto candidates =
+        depotRanking_.pullOutCandidates(vehicleTypeIndex, journeys_.fromStop(position));
+    for (const auto& candidate : candidates) {
+        if (state_.hasCapacity(candidate.depotIndex, vehicleTypeIndex)) {
+            return &candidate;
         }
     }
 
-    return bestDepot;
+    return nullptr;
 }
 
 bool GreedyMDVSPSolver::hasDepotCapacity(int depotId, int vehicleTypeId) const {
-    int maxCapacity = dataLoader_.getVehicleCapacityAtStop(vehicleTypeId, depotId);
-
-    if (maxCapacity <= 0) {
+    int depotIndex       = dataLoader_.getDepotIndex(depotId);
+    int vehicleTypeIndex = dataLoader_.getVehicleTypeIndex(vehicleTypeId);
+    if (depotIndex < 0 || vehicleTypeIndex < 0) {
         return false;
     }
 
-    // Check current usage
-    auto depotIt = depotVehicleCount_.find(depotId);
-    if (depotIt != depotVehicleCount_.end()) {
-        auto vehTypeIt = depotIt->second.find(vehicleTypeId);
-        if (vehTypeIt != depotIt->second.end()) {
-            return vehTypeIt->second < maxCapacity;
-        }
-    }
-
-    return true;
+    return state_.hasCapacity(depotIndex, vehicleTypeIndex);
 }
 
 double GreedyMDVSPSolver::calculateTotalCost() const {
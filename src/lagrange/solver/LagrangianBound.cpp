@@ -0,0 +1,160 @@
+#include "lagrange/LagrangianBound.hpp"
+#include "core/ParallelFor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <numeric>
+
+namespace lagrange {
+
+LagrangianBoundSolver::LagrangianBoundSolver(const data::DataLoader&      dataLoader,
+                                             int                          threads,
+                                             const network::Preprocessor* preprocessor)
+  : dataLoader_(dataLoader),
+    verbose_(false) {
+    network::ConnectionNetwork::Options options;
+    options.threads      = threads;
+    options.preprocessor = preprocessor;
+    network_             = std::make_unique<network::ConnectionNetwork>(dataLoader_, options);
+
+    int numJourneys = network_->getNumJourneys();
+    coverPrice_.assign(numJourneys, std::numeric_limits<double>::infinity());
+
+    for (int d = 0; d < network_->getNumDepots(); ++d) {
+        for (int t = 0; t < network_->getNumVehicleTypes(); ++t) {
+            int capacity = network_->getCapacity(d, t);
+            if (capacity <= 0)
+                continue;
+            subproblems_.emplace_back(*network_, d, t, capacity);
+
+            for (int j = 0; j < numJourneys; ++j) {
+                if (network_->isCompatible(t, j) && network_->hasPullOut(d, j)) {
+                    double cost    = network_->evaluateBlock(d, t, data::JourneySpan(&j, 1)).cost;
+                    coverPrice_[j] = std::min(coverPrice_[j], cost);
+                }
+            }
+        }
+    }
+}
+
+BoundResult LagrangianBoundSolver::computeBound(const core::UnifiedSolution& solution,
+                                                const SolverConfig&          config,
+                                                const ProgressCallback&      progress) {
+    auto startTime = std::chrono::steady_clock::now();
+    auto deadline  = startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                    std::chrono::duration<double>(config.timeLimit));
+    verbose_ = config.verbose;
+
+    const double infinity    = std::numeric_limits<double>::infinity();
+    int          numJourneys = network_->getNumJourneys();
+
+    BoundResult result{-infinity, infinity, infinity, 0, 0.0};
+    if (solution.isFeasible() && !solution.blocks.empty()) {
+        result.upperBound = solution.objectiveValue;
+    }
+
+    // Step target: the solution objective, else the cost of single-journey blocks
+    double coverTotal = 0.0;
+    for (double price : coverPrice_) {
+        coverTotal += std::isfinite(price) ? price : 0.0;
+    }
+    double target = std::isfinite(result.upperBound) ? result.upperBound : coverTotal;
+
+    // Start with the target spread over the journeys in proportion to their single block cost
+    std::vector<double> multipliers(numJourneys, 0.0);
+    for (int j = 0; j < numJourneys; ++j) {
+        if (std::isfinite(coverPrice_[j]) && coverTotal > 0.0) {
+            multipliers[j] = coverPrice_[j] * target / coverTotal;
+        }
+    }
+    bestMultipliers_ = multipliers;
+
+    std::vector<SlotFlowResult> slots(subproblems_.size());
+    std::vector<int>            coverCount(numJourneys);
+    std::vector<double>         direction(numJourneys, 0.0);
+    double                      stepScale = 1.0;
+    int                         stall     = 0;
+
+    while (result.iterations < config.maxIterations) {
+        ++result.iterations;
+
+        core::parallelFor(static_cast<int>(subproblems_.size()), config.threads, [&](int s) {
+            slots[s] = subproblems_[s].solve(multipliers, deadline);
+        });
+
+        double value = std::accumulate(multipliers.begin(), multipliers.end(), 0.0);
+        bool   exact = true;
+        std::fill(coverCount.begin(), coverCount.end(), 0);
+        for (const auto& slot : slots) {
+            value += slot.value;
+            exact = exact && slot.exact;
+            for (int journey : slot.usedJourneys) {
+                ++coverCount[journey];
+            }
+        }
+
+        if (value > result.lowerBound) {
+            if (value > result.lowerBound + 1e-6 * std::abs(value))
+                stall = 0;
+            result.lowerBound = value;
+            bestMultipliers_  = multipliers;
+        }
+        if (++stall > config.stallIterations) {
+            stepScale *= 0.5;
+            stall = 0;
+        }
+
+        if (progress) {
+            progress(result.iterations, result.lowerBound);
+        }
+        log("Iteration " + std::to_string(result.iterations) + ": L = " + std::to_string(value) +
+            ", best = " + std::to_string(result.lowerBound));
+
+        // Deflected subgradient: keep part of the previous direction to damp zig-zagging
+        double norm       = 0.0;
+        bool   allCovered = true;
+        for (int j = 0; j < numJourneys; ++j) {
+            double gradient = 1.0 - coverCount[j];
+            allCovered      = allCovered && gradient == 0.0;
+            direction[j]    = gradient + config.deflection * direction[j];
+            norm += direction[j] * direction[j];
+        }
+
+        // Every journey covered once by optimal flows: the bound is attained
+        if (allCovered && exact)
+            break;
+        double gapLimit = config.targetGap * std::abs(result.upperBound);
+        if (std::isfinite(result.upperBound) && result.upperBound - result.lowerBound <= gapLimit)
+            break;
+        if (stepScale < config.minStepScale || std::chrono::steady_clock::now() > deadline)
+            break;
+
+        if (norm == 0.0)
+            break;
+
+        double step = stepScale * std::max(target - value, 1e-3 * (std::abs(value) + 1.0)) / norm;
+        for (int j = 0; j < numJourneys; ++j) {
+            multipliers[j] += step * direction[j];
+        }
+    }
+
+    if (std::isfinite(result.upperBound)) {
+        result.gap = (result.upperBound - result.lowerBound) / std::abs(result.upperBound);
+        if (result.lowerBound > result.upperBound + 1e-6 * std::abs(result.upperBound)) {
+            log("Solution objective is below the lower bound, the solution is likely incomplete");
+        }
+    }
+    result.solutionTime =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return result;
+}
+
+void LagrangianBoundSolver::log(const std::string& message) const {
+    if (verbose_) {
+        std::cout << "[LagrangianBoundSolver] " << message << std::endl;
+    }
+}
+
+} // namespace lagrange
@@ -0,0 +1,237 @@
+#include "lagrange/SlotFlowSubproblem.hpp"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace lagrange {
+
+namespace {
+constexpr double kInfinity  = std::numeric_limits<double>::infinity();
+constexpr double kTolerance = 1e-6;
+
+// Journey links of the current flow
+constexpr int kNone     = -2;
+constexpr int kTerminal = -1; // Depot (source for prev, sink for next)
+} // namespace
+
+SlotFlowSubproblem::SlotFlowSubproblem(const network::ConnectionNetwork& network,
+                                       int                               depotIndex,
+                                       int                               vehicleTypeIndex,
+                                       int                               capacity)
+  : network_(network),
+    depotIndex_(depotIndex),
+    vehicleTypeIndex_(vehicleTypeIndex),
+    capacity_(capacity) {
+    const auto& order    = network_.getOrder();
+    int         numNodes = network_.getNumJourneys();
+
+    startCost_.assign(numNodes, kInfinity);
+    endCost_.assign(numNodes, kInfinity);
+    serviceCost_.assign(numNodes, 0.0);
+    active_.assign(numNodes, 0);
+
+    double vehicleCost = network_.vehicleCost(vehicleTypeIndex_);
+    for (int q = 0; q < numNodes; ++q) {
+        int journeyIdx = order[q];
+        if (!network_.isCompatible(vehicleTypeIndex_, journeyIdx))
+            continue;
+
+        active_[q]      = 1;
+        serviceCost_[q] = network_.serviceCost(vehicleTypeIndex_, journeyIdx);
+        endCost_[q]     = network_.pullInCost(vehicleTypeIndex_, depotIndex_, journeyIdx);
+        if (network_.hasPullOut(depotIndex_, journeyIdx)) {
+            startCost_[q] =
+                vehicleCost + network_.pullOutCost(vehicleTypeIndex_, depotIndex_, journeyIdx);
+        }
+    }
+}
+
+SlotFlowResult SlotFlowSubproblem::solve(const std::vector<double>&            multipliers,
+                                         std::chrono::steady_clock::time_point deadline) const {
+    SlotFlowResult result{0.0, true, 0, {}};
+
+    const auto& order    = network_.getOrder();
+    int         numNodes = network_.getNumJourneys();
+    if (capacity_ <= 0 || numNodes == 0)
+        return result;
+
+    // Node ids of the split network: in(q) = 2q, out(q) = 2q + 1, then source and sink
+    const int source = 2 * numNodes;
+    const int sink   = 2 * numNodes + 1;
+
+    auto connection = [&](int p, int q) {
+        return network_.connectionCost(vehicleTypeIndex_, order[p], order[q]);
+    };
+
+    std::vector<double> nodeCost(numNodes);
+    for (int q = 0; q < numNodes; ++q) {
+        nodeCost[q] = active_[q] ? serviceCost_[q] - multipliers[order[q]] : kInfinity;
+    }
+
+    // Initial potentials: exact distances to the sink on the DAG (no flow yet)
+    std::vector<double> potential(2 * numNodes + 2, kInfinity);
+    potential[sink] = 0.0;
+    for (int q = 0; q < numNodes; ++q) {
+        if (active_[q]) {
+            potential[2 * q + 1] = endCost_[q];
+        }
+    }
+    for (int q = numNodes - 1; q >= 0; --q) {
+        if (!active_[q])
+            continue;
+        potential[2 * q] = nodeCost[q] + potential[2 * q + 1];
+        for (const int* p = network_.predecessorsBegin(q); p != network_.predecessorsEnd(q); ++p) {
+            if (active_[*p]) {
+                potential[2 * *p + 1] =
+                    std::min(potential[2 * *p + 1], connection(*p, q) + potential[2 * q]);
+            }
+        }
+    }
+    for (int q = 0; q < numNodes; ++q) {
+        if (active_[q] && startCost_[q] < kInfinity) {
+            potential[source] = std::min(potential[source], startCost_[q] + potential[2 * q]);
+        }
+    }
+    if (!(potential[source] < -kTolerance))
+        return result;
+
+    std::vector<char> used(numNodes, 0);
+    std::vector<int>  next(numNodes, kNone);
+    std::vector<int>  prev(numNodes, kNone);
+
+    std::vector<double> distance(2 * numNodes + 2);
+    std::vector<int>    hop(2 * numNodes + 2);
+    using Entry = std::pair<double, int>;
+
+    double total = 0.0;
+    while (result.flow < capacity_) {
+        // Backward Dijkstra from the sink on reduced costs, stopped once the source settles
+        std::fill(distance.begin(), distance.end(), kInfinity);
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        distance[sink] = 0.0;
+        queue.emplace(0.0, sink);
+
+        while (!queue.empty()) {
+            auto [d, v] = queue.top();
+            queue.pop();
+            if (d > distance[v])
+                continue;
+            if (v == source)
+                break;
+
+            auto relax = [&](int u, double cost) {
+                if (potential[u] == kInfinity)
+                    return;
+                double reduced = std::max(0.0, cost + potential[v] - potential[u]);
+                if (d + reduced < distance[u]) {
+                    distance[u] = d + reduced;
+                    hop[u]      = v;
+                    queue.emplace(distance[u], u);
+                }
+            };
+
+            if (v == sink) {
+                for (int q = 0; q < numNodes; ++q) {
+                    if (active_[q] && next[q] != kTerminal) {
+                        relax(2 * q + 1, endCost_[q]);
+                    }
+                }
+            }
+            else if (v & 1) {
+                int q = v / 2;
+                if (!used[q]) {
+                    relax(2 * q, nodeCost[q]);
+                }
+                if (next[q] >= 0) {
+                    relax(2 * next[q], -connection(q, next[q]));
+                }
+            }
+            else {
+                int q = v / 2;
+                if (startCost_[q] < kInfinity && prev[q] != kTerminal) {
+                    relax(source, startCost_[q]);
+                }
+                const int* end = network_.predecessorsEnd(q);
+                for (const int* p = network_.predecessorsBegin(q); p != end; ++p) {
+                    if (active_[*p] && next[*p] != q) {
+                        relax(2 * *p + 1, connection(*p, q));
+                    }
+                }
+                if (used[q]) {
+                    relax(2 * q + 1, -nodeCost[q]);
+                }
+            }
+        }
+
+        if (distance[source] == kInfinity)
+            break;
+
+        double settled = distance[source];
+        for (int u = 0; u < 2 * numNodes + 2; ++u) {
+            if (potential[u] != kInfinity) {
+                potential[u] += std::min(distance[u], settled);
+            }
+        }
+
+        double pathCost = potential[source];
+        if (pathCost >= -kTolerance)
+            break;
+
+        if (std::chrono::steady_clock::now() > deadline) {
+            // Marginal costs only grow, so the next path prices the remaining capacity
+            total += (capacity_ - result.flow) * pathCost;
+            result.exact = false;
+            break;
+        }
+
+        // Augment one unit along the path, updating the implicit residual network
+        for (int u = source; u != sink; u = hop[u]) {
+            int v = hop[u];
+            if (u == source) {
+                prev[v / 2] = kTerminal;
+            }
+            else if (v == sink) {
+                next[u / 2] = kTerminal;
+            }
+            else if (!(u & 1) && (v & 1)) {
+                int q = u / 2;
+                int p = v / 2;
+                if (p == q) {
+                    used[q] = 1;
+                }
+                else {
+                    // Cancel the connection p -> q
+                    if (next[p] == q)
+                        next[p] = kNone;
+                    if (prev[q] == p)
+                        prev[q] = kNone;
+                }
+            }
+            else {
+                int p = u / 2;
+                int q = v / 2;
+                if (p == q) {
+                    used[q] = 0;
+                }
+                else {
+                    next[p] = q;
+                    prev[q] = p;
+                }
+            }
+        }
+
+        total += pathCost;
+        ++result.flow;
+    }
+
+    result.value = total;
+    for (int q = 0; q < numNodes; ++q) {
+        if (used[q]) {
+            result.usedJourneys.push_back(order[q]);
+        }
+    }
+    return result;
+}
+
+} // namespace lagrange
@@ -0,0 +1,69 @@
+#include "service/SolverDaemon.hpp"
+#include <csignal>
+#include <iostream>
+#include <string>
+
+namespace {
+service::SolverDaemon* activeDaemon = nullptr;
+
+void handleSignal(int) {
+    if (activeDaemon) {
+        activeDaemon->requestStop();
+    }
+}
+} // namespace
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  -s, --socket <path>      Unix socket path (default: /tmp/mdvsp.sock)" << std::endl;
+    std::cout << "  -w, --workers <n>        Concurrent requests (default: all hardware threads)" << std::endl;
+    std::cout << "  --memory <MB>            Resident instance budget before eviction (default: 4096)" << std::endl;
+    std::cout << "  --no-preprocess          Skip the safe slot and arc reductions on load" << std::endl;
+    std::cout << "  -v, --verbose            Log every request" << std::endl;
+    std::cout << "  -h, --help               Show this help message" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Protocol: one JSON request per line, one JSON response per line, e.g." << std::endl;
+    std::cout << "  {\"id\":1,\"op\":\"solve\",\"instance\":\"/workspace/data/short\",\"method\":\"greedy\"}" << std::endl;
+    std::cout << "Ops: load, solve, repair, query, evict, status, ping, shutdown" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    service::SolverDaemon::Config config;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if ((arg == "-s" || arg == "--socket") && i + 1 < argc) {
+            config.socketPath = argv[++i];
+        } else if ((arg == "-w" || arg == "--workers") && i + 1 < argc) {
+            config.workers = std::stoi(argv[++i]);
+        } else if (arg == "--memory" && i + 1 < argc) {
+            config.memoryBudget = std::stoul(argv[++i]);
+        } else if (arg == "--no-preprocess") {
+            config.preprocess = false;
+        } else if (arg == "-v" || arg == "--verbose") {
+            config.verbose = true;
+        } else {
+            std::cerr << "Error: unknown or incomplete option " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    service::SolverDaemon daemon(config);
+    activeDaemon = &daemon;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    std::cout << "=== MDVSP Solver Daemon ===" << std::endl;
+    std::cout << "  Socket: " << config.socketPath << std::endl;
+    std::cout << "  Memory budget: " << config.memoryBudget << " MB" << std::endl;
+
+    int result   = daemon.run();
+    activeDaemon = nullptr;
+    return result;
+}
@@ -1,10 +1,144 @@
 #include "core/SolutionTransformer.hpp"
+#include "core/StopToken.hpp"
 #include "core/UnifiedSolutionDatabase.hpp"
 #include "data/DataLoader.hpp"
 #include "greedy/GreedyMDVSPSolver.hpp"
 #include "greedy/GreedySolutionPrinter.hpp"
+#include "greedy/OnlineDispatcher.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <utility>
+
+// Repeat the greedy solve and report candidate evaluation throughput
+int runBenchmark(const data::DataLoader& dataLoader, int runs) {
+    greedy::GreedyMDVSPSolver solver(dataLoader);
+
+    long long evaluations = 0;
+    auto      startTime   = std::chrono::high_resolution_clock::now();
+    for (int run = 0; run < runs; ++run) {
+        solver.solve();
+        evaluations += solver.getCandidateEvaluations();
+    }
+    auto   endTime = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(endTime - startTime).count();
+
+    std::cout << "=== Greedy Benchmark ===" << std::endl;
+    std::cout << "  Runs: " << runs << std::endl;
+    std::cout << "  Average solve time: " << std::fixed << std::setprecision(4)
+              << seconds / runs << " s" << std::endl;
+    std::cout << "  Candidate evaluations per run: " << evaluations / runs << std::endl;
+    std::cout << "  Candidate evaluations per second: " << std::setprecision(0)
+              << (seconds > 0 ? evaluations / seconds : 0.0) << std::endl;
+    return 0;
+}
+
+// Numeric "id" member of a JSON feed object, e.g. {"id":1042,"line":7}. Scans the members of
+// the outer object only, strings and nested values are skipped.
+bool parseJsonId(const std::string& line, size_t start, int& journeyId) {
+    int  depth    = 0;
+    bool inString = false;
+    for (size_t i = start; i < line.size(); ++i) {
+        char c = line[i];
+        if (inString) {
+            if (c == '\\')
+                ++i;
+            else if (c == '"')
+                inString = false;
+            continue;
+        }
+        if (c == '{' || c == '[') {
+            ++depth;
+        }
+        else if (c == '}' || c == ']') {
+            --depth;
+        }
+        else if (c == '"') {
+            size_t colon = line.find_first_not_of(" \t", i + 4);
+            if (depth == 1 && line.compare(i, 4, "\"id\"") == 0 && colon != std::string::npos &&
+                line[colon] == ':') {
+                const char* value = line.c_str() + colon + 1;
+                char*       end   = nullptr;
+                double      id    = std::strtod(value, &end);
+                if (end == value || !std::isfinite(id))
+                    return false;
+                journeyId = static_cast<int>(id);
+                return true;
+            }
+            inString = true;
+        }
+    }
+    return false;
+}
+
+// Journey ID of a feed line: a JSON object with "id" or a CSV row (',' or ';') starting with
+// the ID, e.g. a row of servicejourney.csv.
+// Returns false for blank lines, comments and headers.
+bool parseFeedLine(const std::string& line, int& journeyId) {
+    size_t start = line.find_first_not_of(" \t\r");
+    if (start == std::string::npos || line[start] == '#')
+        return false;
+
+    if (line[start] == '{')
+        return parseJsonId(line, start, journeyId);
+
+    char* end = nullptr;
+    long  id  = std::strtol(line.c_str() + start, &end, 10);
+    bool  separated = *end == '\0' || std::strchr(",;\r", *end) != nullptr;
+    if (end == line.c_str() + start || !separated)
+        return false;
+    journeyId = static_cast<int>(id);
+    return true;
+}
+
+// Dispatch the journeys of a feed on stdin as they arrive, one decision line per journey,
+// until the feed ends or the token stops
+int runOnline(const data::DataLoader& dataLoader,
+              double                  latencyBudgetMicros,
+              const core::StopToken&  stop) {
+    greedy::OnlineDispatcher dispatcher(dataLoader, latencyBudgetMicros);
+
+    std::cout << "journey_id,block,latency_us" << std::endl;
+    std::string line;
+    while (!stop.stopRequested() && std::getline(std::cin, line)) {
+        int journeyId = 0;
+        if (!parseFeedLine(line, journeyId))
+            continue;
+
+        auto decision = dispatcher.release(journeyId);
+        std::cout << decision.journeyId << "," << decision.blockIdx << "," << std::fixed
+                  << std::setprecision(1) << decision.latencyMicros << std::endl;
+    }
+
+    auto report = dispatcher.finish(true);
+    std::cout << std::endl;
+    std::cout << "=== Online Dispatch ===" << std::endl;
+    std::cout << "  Released journeys: " << report.released << std::endl;
+    std::cout << "  Assigned journeys: " << report.assigned << std::endl;
+    std::cout << "  Decision latency p50/p99/max: " << std::fixed << std::setprecision(1)
+              << report.p50Micros << " / " << report.p99Micros << " / " << report.maxMicros
+              << " us" << std::endl;
+    std::cout << "  Over budget (" << latencyBudgetMicros << " us): " << report.overBudget
+              << std::endl;
+    std::cout << "  Vehicles: " << report.solution.totalVehiclesUsed << " online";
+    if (report.offlineVehicles >= 0) {
+        std::cout << ", " << report.offlineVehicles << " offline greedy";
+    }
+    std::cout << std::endl;
+    std::cout << "  Cost: " << std::setprecision(2) << report.solution.totalObjectiveCost
+              << " online";
+    if (report.offlineVehicles >= 0) {
+        std::cout << ", " << report.offlineCost << " offline greedy";
+    }
+    std::cout << std::endl;
+    return report.assigned == report.released ? 0 : 1;
+}
 
 int main(int argc, char* argv[]) {
     std::cout << "=== Greedy MDVSP Solver ===" << std::endl;
@@ -14,28 +148,50 @@ int main(int argc, char* argv[]) {
     // Default data directory
     std::string dataDir = "/workspace/data/short";
 
-    // Parse command line arguments
+    // Parse command line arguments: [dataDir] [--bench <runs> | --online [budget_us]]
+    int    benchmarkRuns = 0;
+    double onlineBudget  = 0.0;
     if (argc > 1) {
         dataDir = argv[1];
     }
+    if (argc > 3 && std::string(argv[2]) == "--bench") {
+        benchmarkRuns = std::max(1, std::stoi(argv[3]));
+    }
+    if (argc > 2 && std::string(argv[2]) == "--online") {
+        onlineBudget = argc > 3 ? std::stod(argv[3]) : 1000.0;
+    }
 
     std::cout << "Loading data from: " << dataDir << std::endl;
     std::cout << std::endl;
 
+    // Ctrl-C stops loading, the construction or the save gracefully, a second one kills
+    core::StopToken interrupt;
+    core::StopToken::stopOnInterrupt(interrupt);
+
     // Load data
     data::DataLoader dataLoader(dataDir);
+    dataLoader.setStopCondition([interrupt]() { return interrupt.stopRequested(); });
     if (!dataLoader.loadAll()) {
         std::cerr << "Failed to load MDVSP data!" << std::endl;
         return 1;
     }
 
+    if (benchmarkRuns > 0) {
+        return runBenchmark(dataLoader, benchmarkRuns);
+    }
+    if (onlineBudget > 0.0) {
+        return runOnline(dataLoader, onlineBudget, interrupt);
+    }
+
     // Create and configure solver
     greedy::GreedyMDVSPSolver solver(dataLoader);
     solver.setVerbose(true);
+    solver.setStop(interrupt);
 
     // Solve the problem
     std::cout << std::endl;
-    auto solution = solver.solve();
+    auto       solution = solver.solve();
+    const bool feasible = solution.isFeasible;
     std::cout << std::endl;
 
     // Print results
@@ -62,16 +218,21 @@ int main(int argc, char* argv[]) {
     std::cout << "Converting solution to unified format..." << std::endl;
 
     try {
-        // Transform greedy solution to unified format
+        // Transform greedy solution to unified format, handing over its journey array
         core::UnifiedSolution unifiedSolution =
-            core::SolutionTransformer::transform(solution, dataLoader, dataDir);
+            core::SolutionTransformer::transform(std::move(solution), dataLoader, dataDir);
+        // Named by content like the results of mdvsp_unified, which never share these
+        // parameters: this greedy runs without preprocessing
+        unifiedSolution.instanceHash  = dataLoader.computeFingerprintText();
+        unifiedSolution.runParameters = "method=greedy_mdvsp preprocess=0";
 
         std::cout << "Saving solution to database..." << std::endl;
 
         // Initialize and save to database
         core::UnifiedSolutionDatabase database("/workspace/database/mdvsp_solutions.db", true);
         if (database.initialize()) {
-            int solutionId = database.saveSolution(unifiedSolution);
+            int solutionId = database.saveSolution(
+                unifiedSolution, core::JourneyIdMap(dataLoader.getServiceJourneys()), interrupt);
             if (solutionId > 0) {
                 std::cout << "Solution successfully saved to database with ID: " << solutionId
                           << std::endl;
@@ -88,5 +249,5 @@ int main(int argc, char* argv[]) {
         std::cerr << "Database error: " << e.what() << std::endl;
     }
 
-    return solution.isFeasible ? 0 : 1;
+    return feasible ? 0 : 1;
 }
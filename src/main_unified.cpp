@@ -1,24 +1,62 @@
+#include "core/BatchRunner.hpp"
+#include "core/DatabaseProgressSink.hpp"
+#include "core/ProgressListener.hpp"
 #include "core/Solver.hpp"
+#include "core/StopToken.hpp"
 #include <iostream>
 #include <iomanip>
+#include <memory>
 #include <string>
 
 void printUsage(const char* programName) {
     std::cout << "Usage: " << programName << " [options]" << std::endl;
     std::cout << "Options:" << std::endl;
     std::cout << "  -d, --data <path>        Data directory path (default: /workspace/data/short)" << std::endl;
-    std::cout << "  -m, --method <method>    Solution method: greedy, exact, or both (default: both)" << std::endl;
-    std::cout << "  -t, --time <seconds>     Time limit in seconds (default: 300)" << std::endl;
+    std::cout << "  -m, --method <method>    Solution method: greedy, exact, meta, colgen, portfolio, pool, or both (default: both)" << std::endl;
+    std::cout << "  -t, --time <seconds>     Wall-clock budget of load and solve (default: 300)" << std::endl;
     std::cout << "  -g, --gap <gap>          Optimality gap for exact solver (default: 0.01)" << std::endl;
+    std::cout << "  -b, --bound              Compute a Lagrangian lower bound and gap of the result" << std::endl;
+    std::cout << "  --validate               Check feasibility and costs of the result" << std::endl;
+    std::cout << "  --no-preprocess          Skip the safe slot and arc reductions" << std::endl;
+    std::cout << "  --decompose              Solve independent components in parallel" << std::endl;
+    std::cout << "  --window <minutes>       Rolling horizon window length (default: off)" << std::endl;
+    std::cout << "  --overlap <minutes>      Rolling horizon window overlap (default: 60)" << std::endl;
+    std::cout << "  --node-heuristic <n>     Exact: round the node relaxation every n nodes (default: off)" << std::endl;
+    std::cout << "  --telemetry <file>       Exact: append solver progress samples to a CSV file" << std::endl;
+    std::cout << "  --progress <file>        Append incumbents and bounds of every engine to a CSV file" << std::endl;
+    std::cout << "  --progress-db <path>     Store incumbents and bounds of the run in a solution database" << std::endl;
+    std::cout << "  --batch <manifest>       Solve every \"<data> <method> [time] [threads]\" line of a manifest" << std::endl;
+    std::cout << "  --cores <n>              Batch: total thread budget (default: all hardware threads)" << std::endl;
+    std::cout << "  --job-threads <n>        Batch: default threads of every job but greedy (default: 4)" << std::endl;
+    std::cout << "  --db <path>              Batch and pool: solution database, \"none\" to skip it" << std::endl;
+    std::cout << "  --warm-start             Start from the best stored solution of the instance in --db" << std::endl;
+    std::cout << "  --reuse                  Return the stored result of an identical run in --db" << std::endl;
     std::cout << "  -v, --verbose            Enable verbose output" << std::endl;
     std::cout << "  -h, --help               Show this help message" << std::endl;
     std::cout << std::endl;
     std::cout << "Methods:" << std::endl;
     std::cout << "  greedy                   Fast heuristic algorithm" << std::endl;
     std::cout << "  exact                    Optimal solution using Gurobi" << std::endl;
+    std::cout << "  meta                     Greedy, local search and large neighbourhood search" << std::endl;
+    std::cout << "  colgen                   Column generation seeded with the greedy solution" << std::endl;
+    std::cout << "  portfolio                Greedy variants, local search and exact racing concurrently" << std::endl;
+    std::cout << "  pool                     Recombine the blocks of many greedy and local search runs" << std::endl;
     std::cout << "  both                     Run greedy first, then exact with warm start" << std::endl;
 }
 
+// Status, algorithm, objective, time and vehicles of one method's result
+void printResults(const std::string& label, const core::UnifiedSolution& solution) {
+    std::cout << label << " Results:" << std::endl;
+    std::cout << "  Status: " << solution.status << std::endl;
+    std::cout << "  Algorithm: " << solution.algorithmType << std::endl;
+    std::cout << "  Objective: " << std::fixed << std::setprecision(2)
+              << solution.objectiveValue << std::endl;
+    std::cout << "  Time: " << std::fixed << std::setprecision(3)
+              << solution.solutionTimeSeconds << "s" << std::endl;
+    std::cout << "  Vehicles: " << solution.getNumVehicles() << std::endl;
+    std::cout << std::endl;
+}
+
 int main(int argc, char* argv[]) {
     std::cout << "=== Unified MDVSP Solver ===" << std::endl;
     std::cout << "Multi-Depot Vehicle Scheduling Problem Solver" << std::endl;
@@ -31,6 +69,18 @@ int main(int argc, char* argv[]) {
     double timeLimit = 300.0;
     double optimalityGap = 0.01;
     bool verbose = false;
+    bool computeBound = false;
+    bool validate = false;
+    bool preprocess = true;
+    bool decompose = false;
+    int windowMinutes = 0;
+    int overlapMinutes = 60;
+    int nodeHeuristicInterval = 0;
+    std::string telemetryFile;
+    std::string progressFile;
+    std::string progressDatabase;
+    std::string batchManifest;
+    core::BatchRunner::Config batchConfig;
 
     // Parse command line arguments
     for (int i = 1; i < argc; i++) {
@@ -69,6 +119,89 @@ int main(int argc, char* argv[]) {
             }
         } else if (arg == "-v" || arg == "--verbose") {
             verbose = true;
+        } else if (arg == "-b" || arg == "--bound") {
+            computeBound = true;
+        } else if (arg == "--validate") {
+            validate = true;
+        } else if (arg == "--no-preprocess") {
+            preprocess = false;
+        } else if (arg == "--decompose") {
+            decompose = true;
+        } else if (arg == "--window") {
+            if (i + 1 < argc) {
+                windowMinutes = std::stoi(argv[++i]);
+            } else {
+                std::cerr << "Error: --window requires a number of minutes" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--overlap") {
+            if (i + 1 < argc) {
+                overlapMinutes = std::stoi(argv[++i]);
+            } else {
+                std::cerr << "Error: --overlap requires a number of minutes" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--node-heuristic") {
+            if (i + 1 < argc) {
+                nodeHeuristicInterval = std::stoi(argv[++i]);
+            } else {
+                std::cerr << "Error: --node-heuristic requires a number of nodes" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--telemetry") {
+            if (i + 1 < argc) {
+                telemetryFile = argv[++i];
+            } else {
+                std::cerr << "Error: --telemetry requires a file path" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--progress") {
+            if (i + 1 < argc) {
+                progressFile = argv[++i];
+            } else {
+                std::cerr << "Error: --progress requires a file path" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--progress-db") {
+            if (i + 1 < argc) {
+                progressDatabase = argv[++i];
+            } else {
+                std::cerr << "Error: --progress-db requires a path" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--batch") {
+            if (i + 1 < argc) {
+                batchManifest = argv[++i];
+            } else {
+                std::cerr << "Error: --batch requires a manifest file" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--cores") {
+            if (i + 1 < argc) {
+                batchConfig.cores = std::stoi(argv[++i]);
+            } else {
+                std::cerr << "Error: --cores requires a number" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--job-threads") {
+            if (i + 1 < argc) {
+                batchConfig.exactThreads = std::stoi(argv[++i]);
+            } else {
+                std::cerr << "Error: --job-threads requires a number" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--warm-start") {
+            batchConfig.warmStart = true;
+        } else if (arg == "--reuse") {
+            batchConfig.reuseResults = true;
+        } else if (arg == "--db") {
+            if (i + 1 < argc) {
+                std::string path = argv[++i];
+                batchConfig.databasePath = path == "none" ? "" : path;
+            } else {
+                std::cerr << "Error: --db requires a path" << std::endl;
+                return 1;
+            }
         } else {
             // Positional arguments for backward compatibility
             if (i == 1) dataPath = arg;
@@ -77,6 +210,35 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    // Ctrl-C ends the run gracefully with the best solution so far, a second one kills it
+    core::StopToken interrupt;
+    core::StopToken::stopOnInterrupt(interrupt);
+
+    if (!batchManifest.empty()) {
+        batchConfig.stop = interrupt;
+        batchConfig.timeLimit = timeLimit;
+        batchConfig.optimalityGap = optimalityGap;
+        batchConfig.preprocess = preprocess;
+        batchConfig.verbose = verbose;
+
+        try {
+            core::BatchRunner runner(batchConfig);
+            auto results = runner.run(runner.readManifest(batchManifest));
+            for (const auto& result : results) {
+                if (result.status != "FEASIBLE" && result.status != "OPTIMAL") {
+                    return 1;
+                }
+            }
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "\nERROR: " << e.what() << std::endl;
+            return 2;
+        }
+    }
+
+    std::string warmStartDatabase = batchConfig.warmStart ? batchConfig.databasePath : "";
+    std::string reuseDatabase = batchConfig.reuseResults ? batchConfig.databasePath : "";
+
     // Extract problem name from data path
     std::string problemName = "unknown";
     size_t lastSlash = dataPath.find_last_of('/');
@@ -97,13 +259,33 @@ int main(int argc, char* argv[]) {
     std::cout << "  Verbose: " << (verbose ? "enabled" : "disabled") << std::endl;
     std::cout << std::endl;
 
+    // Anytime progress of every engine, e.g. for time-to-target curves
+    std::unique_ptr<core::ProgressListener> progress;
+    if (verbose || !progressFile.empty() || !progressDatabase.empty()) {
+        progress = std::make_unique<core::ProgressListener>();
+        if (verbose) {
+            progress->addSink(std::make_unique<core::ConsoleProgressSink>());
+        }
+        if (!progressFile.empty()) {
+            progress->addSink(
+                std::make_unique<core::CsvProgressSink>(progressFile, problemName + "/" + method));
+        }
+        if (!progressDatabase.empty()) {
+            progress->addSink(std::make_unique<core::DatabaseProgressSink>(
+                progressDatabase, problemName, method));
+        }
+    }
+
     try {
         // Initialize solver
         MDVSPSolver solver;
 
+        // One wall-clock budget for loading and every phase
+        core::StopToken budget = interrupt.child(timeLimit);
+
         // Load problem
         std::cout << "Loading problem data..." << std::endl;
-        if (!solver.loadProblem(dataPath)) {
+        if (!solver.loadProblem(dataPath, preprocess, budget)) {
             std::cerr << "ERROR: Failed to load problem from: " << dataPath << std::endl;
             return 1;
         }
@@ -112,6 +294,10 @@ int main(int argc, char* argv[]) {
 
         core::UnifiedSolution greedySolution;
         core::UnifiedSolution exactSolution;
+        core::UnifiedSolution metaSolution;
+        core::UnifiedSolution colgenSolution;
+        core::UnifiedSolution portfolioSolution;
+        core::UnifiedSolution poolSolution;
 
         // Execute based on method
         if (method == "greedy" || method == "both") {
@@ -121,7 +307,13 @@ int main(int argc, char* argv[]) {
             greedyConfig.method = "greedy";
             greedyConfig.problemName = problemName;
             greedyConfig.verbose = verbose;
-            greedyConfig.timeLimit = std::min(timeLimit, 60.0); // Greedy is fast
+            greedyConfig.decompose = decompose;
+            greedyConfig.rollingWindowSeconds = windowMinutes * 60;
+            greedyConfig.rollingOverlapSeconds = overlapMinutes * 60;
+            greedyConfig.timeLimit = timeLimit;
+            greedyConfig.stop = budget;
+            greedyConfig.progress = progress.get();
+            greedyConfig.reuseDatabase = reuseDatabase;
             
             greedySolution = solver.solve(greedyConfig);
             
@@ -147,8 +339,17 @@ int main(int argc, char* argv[]) {
                 exactConfig.method = "exact";
                 exactConfig.problemName = problemName;
                 exactConfig.verbose = verbose;
+                exactConfig.decompose = decompose;
+                exactConfig.rollingWindowSeconds = windowMinutes * 60;
+                exactConfig.rollingOverlapSeconds = overlapMinutes * 60;
                 exactConfig.timeLimit = timeLimit;
+                exactConfig.stop = budget;
+                exactConfig.progress = progress.get();
+                exactConfig.warmStartDatabase = warmStartDatabase;
+                exactConfig.reuseDatabase = reuseDatabase;
                 exactConfig.optimalityGap = optimalityGap;
+                exactConfig.nodeHeuristicInterval = nodeHeuristicInterval;
+                exactConfig.telemetryFile = telemetryFile;
                 
                 exactSolution = solver.solve(exactConfig);
             }
@@ -164,6 +365,98 @@ int main(int argc, char* argv[]) {
             std::cout << std::endl;
         }
 
+        if (method == "meta") {
+            std::cout << "=== Meta-heuristic ===" << std::endl;
+
+            MDVSPSolver::SolverConfig metaConfig;
+            metaConfig.method = "meta";
+            metaConfig.problemName = problemName;
+            metaConfig.verbose = verbose;
+            metaConfig.decompose = decompose;
+            metaConfig.rollingWindowSeconds = windowMinutes * 60;
+            metaConfig.rollingOverlapSeconds = overlapMinutes * 60;
+            metaConfig.timeLimit = timeLimit;
+            metaConfig.stop = budget;
+            metaConfig.progress = progress.get();
+            metaConfig.warmStartDatabase = warmStartDatabase;
+            metaConfig.reuseDatabase = reuseDatabase;
+
+            metaSolution = solver.solve(metaConfig);
+
+            printResults("Meta-heuristic", metaSolution);
+        }
+
+        if (method == "colgen") {
+            std::cout << "=== Column Generation ===" << std::endl;
+
+            MDVSPSolver::SolverConfig colgenConfig;
+            colgenConfig.method = "colgen";
+            colgenConfig.problemName = problemName;
+            colgenConfig.verbose = verbose;
+            colgenConfig.decompose = decompose;
+            colgenConfig.rollingWindowSeconds = windowMinutes * 60;
+            colgenConfig.rollingOverlapSeconds = overlapMinutes * 60;
+            colgenConfig.timeLimit = timeLimit;
+            colgenConfig.stop = budget;
+            colgenConfig.progress = progress.get();
+            colgenConfig.warmStartDatabase = warmStartDatabase;
+            colgenConfig.reuseDatabase = reuseDatabase;
+
+            colgenSolution = solver.solve(colgenConfig);
+
+            printResults("Column Generation", colgenSolution);
+        }
+
+        if (method == "portfolio") {
+            std::cout << "=== Portfolio ===" << std::endl;
+
+            MDVSPSolver::SolverConfig portfolioConfig;
+            portfolioConfig.method = "portfolio";
+            portfolioConfig.problemName = problemName;
+            portfolioConfig.verbose = verbose;
+            portfolioConfig.decompose = decompose;
+            portfolioConfig.rollingWindowSeconds = windowMinutes * 60;
+            portfolioConfig.rollingOverlapSeconds = overlapMinutes * 60;
+            portfolioConfig.timeLimit = timeLimit;
+            portfolioConfig.stop = budget;
+            portfolioConfig.progress = progress.get();
+            portfolioConfig.warmStartDatabase = warmStartDatabase;
+            portfolioConfig.reuseDatabase = reuseDatabase;
+            portfolioConfig.optimalityGap = optimalityGap;
+            portfolioConfig.nodeHeuristicInterval = nodeHeuristicInterval;
+
+            portfolioSolution = solver.solve(portfolioConfig);
+
+            printResults("Portfolio", portfolioSolution);
+        }
+
+        if (method == "pool") {
+            std::cout << "=== Block Pool ===" << std::endl;
+
+            MDVSPSolver::SolverConfig poolConfig;
+            poolConfig.method = "pool";
+            poolConfig.problemName = problemName;
+            poolConfig.verbose = verbose;
+            poolConfig.decompose = decompose;
+            poolConfig.rollingWindowSeconds = windowMinutes * 60;
+            poolConfig.rollingOverlapSeconds = overlapMinutes * 60;
+            poolConfig.timeLimit = timeLimit;
+            poolConfig.stop = budget;
+            poolConfig.progress = progress.get();
+            poolConfig.warmStartDatabase = warmStartDatabase;
+            poolConfig.reuseDatabase = reuseDatabase;
+            poolConfig.poolDatabase = batchConfig.databasePath;
+
+            poolSolution = solver.solve(poolConfig);
+
+            printResults("Block Pool", poolSolution);
+        }
+
+        // Flush the progress sinks before the summary
+        if (progress) {
+            progress->close();
+        }
+
         // Final summary
         std::cout << "=== Final Summary ===" << std::endl;
         
@@ -197,6 +490,14 @@ int main(int argc, char* argv[]) {
             bestSolution = &greedySolution;
         } else if (method == "exact") {
             bestSolution = &exactSolution;
+        } else if (method == "meta") {
+            bestSolution = &metaSolution;
+        } else if (method == "colgen") {
+            bestSolution = &colgenSolution;
+        } else if (method == "portfolio") {
+            bestSolution = &portfolioSolution;
+        } else if (method == "pool") {
+            bestSolution = &poolSolution;
         } else { // both
             if (exactSolution.status == "OPTIMAL" || exactSolution.status == "TIME_LIMIT") {
                 bestSolution = &exactSolution;
@@ -207,6 +508,35 @@ int main(int argc, char* argv[]) {
             }
         }
 
+        // Checks of the result get a fresh token, so the Ctrl-C that ended the solve does not
+        // skip them; another one stops them
+        core::StopToken checks;
+        core::StopToken::stopOnInterrupt(checks);
+
+        if (computeBound && bestSolution && bestSolution->isFeasible()) {
+            auto bound = solver.computeLowerBound(*bestSolution, std::min(timeLimit, 60.0), verbose);
+            std::cout << "Lower bound: " << std::fixed << std::setprecision(2) << bound.lowerBound
+                      << " (gap " << std::setprecision(2) << (bound.gap * 100) << "%, "
+                      << bound.iterations << " iterations, " << std::setprecision(3)
+                      << bound.solutionTime << "s)" << std::endl;
+        }
+
+        if (validate && bestSolution && bestSolution->isFeasible()) {
+            auto report = solver.validateSolution(*bestSolution, checks);
+            std::cout << "Validation: " << report.summary() << std::endl;
+            for (size_t v = 0; v < report.violations.size() && v < 20; ++v) {
+                std::cout << "  " << report.violations[v].describe() << std::endl;
+            }
+            if (report.stopped) {
+                std::cout << "✗ Validation interrupted" << std::endl;
+                return 1;
+            }
+            if (!report.isValid()) {
+                std::cout << "✗ Solution failed validation" << std::endl;
+                return 1;
+            }
+        }
+
         if (bestSolution && (bestSolution->status == "FEASIBLE" || bestSolution->status == "OPTIMAL" || bestSolution->status == "TIME_LIMIT")) {
             std::cout << "✓ Solution completed successfully" << std::endl;
             return 0;
@@ -0,0 +1,471 @@
+#include "meta/LargeNeighbourhoodSearch.hpp"
+#include "core/ParallelFor.hpp"
+#include "core/SolutionValidator.hpp"
+#include "meta/LocalSearch.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+
+namespace meta {
+
+namespace {
+constexpr double kEpsilon  = 1e-6;
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+/**
+ * Successive shortest paths with Johnson potentials on a small explicit graph. All arc
+ * costs must be non-negative, which holds for the block cost model.
+ */
+class MinCostFlow {
+  public:
+    explicit MinCostFlow(int numNodes) : adjacency_(numNodes) {}
+
+    int addArc(int from, int to, int capacity, double cost) {
+        int arc = static_cast<int>(arcs_.size());
+        arcs_.push_back({to, capacity, cost});
+        arcs_.push_back({from, 0, -cost});
+        adjacency_[from].push_back(arc);
+        adjacency_[to].push_back(arc + 1);
+        return arc;
+    }
+
+    int getFlow(int arc) const { return arcs_[arc + 1].capacity; }
+
+    /**
+     * Send the amount from source to sink at minimum cost
+     * @return false if the network cannot carry the amount
+     */
+    bool solve(int source, int sink, int amount) {
+        int                 numNodes = static_cast<int>(adjacency_.size());
+        std::vector<double> potential(numNodes, 0.0);
+        std::vector<double> distance(numNodes);
+        std::vector<int>    viaArc(numNodes);
+        using Entry = std::pair<double, int>;
+
+        while (amount > 0) {
+            std::fill(distance.begin(), distance.end(), kInfinity);
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+            distance[source] = 0.0;
+            queue.emplace(0.0, source);
+            while (!queue.empty()) {
+                auto [d, u] = queue.top();
+                queue.pop();
+                if (d > distance[u])
+                    continue;
+                for (int arc : adjacency_[u]) {
+                    const auto& a = arcs_[arc];
+                    if (a.capacity <= 0)
+                        continue;
+                    double reduced = std::max(0.0, a.cost + potential[u] - potential[a.to]);
+                    if (d + reduced < distance[a.to]) {
+                        distance[a.to] = d + reduced;
+                        viaArc[a.to]   = arc;
+                        queue.emplace(distance[a.to], a.to);
+                    }
+                }
+            }
+            if (distance[sink] == kInfinity)
+                return false;
+
+            for (int v = 0; v < numNodes; ++v) {
+                potential[v] += std::min(distance[v], distance[sink]);
+            }
+
+            int bottleneck = amount;
+            for (int v = sink; v != source; v = arcs_[viaArc[v] ^ 1].to) {
+                bottleneck = std::min(bottleneck, arcs_[viaArc[v]].capacity);
+            }
+            for (int v = sink; v != source; v = arcs_[viaArc[v] ^ 1].to) {
+                arcs_[viaArc[v]].capacity -= bottleneck;
+                arcs_[viaArc[v] ^ 1].capacity += bottleneck;
+            }
+            amount -= bottleneck;
+        }
+        return true;
+    }
+
+  private:
+    struct Arc {
+        int    to;
+        int    capacity;
+        double cost;
+    };
+
+    std::vector<Arc>              arcs_; // Arc 2k and its reverse 2k + 1
+    std::vector<std::vector<int>> adjacency_;
+};
+} // namespace
+
+LargeNeighbourhoodSearch::LargeNeighbourhoodSearch(const network::ConnectionNetwork& network)
+  : network_(network),
+    verbose_(false),
+    neighbourhoods_(0),
+    improvements_(0),
+    state_(network.getDataLoader()) {}
+
+core::UnifiedSolution LargeNeighbourhoodSearch::improve(const core::UnifiedSolution& start,
+                                                        const SolverConfig&          config) {
+    auto startTime = std::chrono::steady_clock::now();
+    auto timeUp    = [&]() {
+        return config.stop.stopRequested() ||
+               std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime)
+                       .count() >= config.timeLimit;
+    };
+
+    const auto& dataLoader = network_.getDataLoader();
+    LocalSearch evaluator(network_);
+
+    verbose_        = config.verbose;
+    neighbourhoods_ = 0;
+    improvements_   = 0;
+    blocks_.clear();
+    state_.reset();
+    for (const auto& block : start.blocks) {
+        Block current{dataLoader.getDepotIndex(block.depotId),
+                      dataLoader.getVehicleTypeIndex(block.vehicleTypeId),
+                      start.journeysOf(block).toVector(),
+                      0.0};
+        if (current.depotIndex < 0 || current.vehicleTypeIndex < 0) {
+            log("Block with unknown depot or vehicle type, no large neighbourhood search");
+            return evaluator.evaluate(start);
+        }
+        if (current.journeys.empty())
+            continue;
+        current.cost =
+            network_.evaluateBlock(current.depotIndex, current.vehicleTypeIndex, current.journeys)
+                .cost;
+        state_.acquire(current.depotIndex, current.vehicleTypeIndex);
+        blocks_.push_back(std::move(current));
+    }
+
+    // Debug builds check that no round breaks a valid start
+#ifndef NDEBUG
+    core::SolutionValidator validator(network_);
+    bool checkRounds = validator.validate(buildSolution(start)).isValid();
+#endif
+
+    if (config.progress) {
+        config.progress->phase("lns");
+    }
+
+    const Relation relations[] = {Relation::TimeWindow, Relation::Slot, Relation::Line};
+    std::mt19937   generator(config.seed);
+    int            perRound = core::resolveThreadCount(config.threads);
+    int            stall    = 0;
+    long long      rounds   = 0;
+    while (!blocks_.empty() && stall < config.maxStall && !timeUp()) {
+        std::vector<Neighbourhood> selected;
+        for (int i = 0; i < perRound; ++i) {
+            auto neighbourhood = select(relations[(rounds + i) % 3], generator, config);
+            if (neighbourhood.blocks.size() > 1 || neighbourhood.maxVehicles > 1) {
+                selected.push_back(std::move(neighbourhood));
+            }
+        }
+        ++rounds;
+
+        // Rebuild concurrently on the current blocks, then apply best first
+        std::vector<Rebuild> rebuilt(selected.size());
+        core::parallelFor(static_cast<int>(selected.size()), config.threads, [&](int i) {
+            rebuilt[i] = rebuild(selected[i]);
+        });
+        neighbourhoods_ += static_cast<long long>(selected.size());
+
+        std::vector<int> order(selected.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&rebuilt](int a, int b) {
+            return rebuilt[a].gain > rebuilt[b].gain;
+        });
+
+        std::vector<char> touched(blocks_.size(), 0);
+        bool              improved = false;
+        for (int i : order) {
+            if (rebuilt[i].gain <= kEpsilon)
+                break;
+            const auto& destroyed = selected[i].blocks;
+            if (std::any_of(destroyed.begin(), destroyed.end(), [&](int b) { return touched[b]; }))
+                continue;
+            if (!apply(selected[i], rebuilt[i]))
+                continue;
+
+            for (int b : destroyed) {
+                touched[b] = 1;
+            }
+            touched.resize(blocks_.size(), 1);
+            improved = true;
+            ++improvements_;
+        }
+
+        // Drop the blocks a rebuild emptied
+        blocks_.erase(std::remove_if(blocks_.begin(),
+                                     blocks_.end(),
+                                     [](const Block& block) { return block.journeys.empty(); }),
+                      blocks_.end());
+        stall = improved ? 0 : stall + 1;
+        if (improved && config.progress) {
+            double objective = 0.0;
+            for (const auto& block : blocks_) {
+                objective += block.cost;
+            }
+            config.progress->incumbent("lns", objective);
+        }
+
+#ifndef NDEBUG
+        if (improved && checkRounds) {
+            auto report = validator.validate(buildSolution(start));
+            if (!report.isValid()) {
+                throw std::logic_error("Large neighbourhood round broke the solution: " +
+                                       report.summary() + " (" +
+                                       report.violations.front().describe() + ")");
+            }
+        }
+#endif
+    }
+
+    auto result          = evaluator.evaluate(buildSolution(start));
+    result.algorithmType = "lns";
+    log("LNS: " + std::to_string(rounds) + " rounds, " + std::to_string(neighbourhoods_) +
+        " neighbourhoods, " + std::to_string(improvements_) + " improvements, objective " +
+        std::to_string(start.objectiveValue) + " -> " + std::to_string(result.objectiveValue));
+    return result;
+}
+
+LargeNeighbourhoodSearch::Neighbourhood
+LargeNeighbourhoodSearch::select(Relation            relation,
+                                 std::mt19937&       generator,
+                                 const SolverConfig& config) const {
+    const auto& journeys = network_.getDataLoader().getServiceJourneys();
+
+    std::uniform_int_distribution<int> pickBlock(0, static_cast<int>(blocks_.size()) - 1);
+    int                                seedIndex = pickBlock(generator);
+    const auto&                        seed      = blocks_[seedIndex];
+
+    std::uniform_int_distribution<size_t> pickJourney(0, seed.journeys.size() - 1);
+    int                                   seedJourney = seed.journeys[pickJourney(generator)];
+    int                                   seedTime    = journeys[seedJourney].depTime;
+    int                                   seedLine    = journeys[seedJourney].lineId;
+
+    // Related blocks of the seed's slot by distance in time, the seed first
+    std::vector<std::pair<int, int>> candidates;
+    for (int b = 0; b < static_cast<int>(blocks_.size()); ++b) {
+        const auto& block = blocks_[b];
+        if (block.depotIndex != seed.depotIndex ||
+            block.vehicleTypeIndex != seed.vehicleTypeIndex)
+            continue;
+
+        int distance = std::numeric_limits<int>::max();
+        for (int journeyIdx : block.journeys) {
+            int gap = std::abs(journeys[journeyIdx].depTime - seedTime);
+            switch (relation) {
+                case Relation::TimeWindow:
+                    if (gap <= config.windowSeconds) {
+                        distance = std::min(distance, gap);
+                    }
+                    break;
+                case Relation::Slot:
+                    distance = std::min(distance, gap);
+                    break;
+                case Relation::Line:
+                    if (journeys[journeyIdx].lineId == seedLine) {
+                        distance = std::min(distance, gap);
+                    }
+                    break;
+            }
+        }
+        if (b == seedIndex) {
+            distance = -1;
+        }
+        if (distance != std::numeric_limits<int>::max()) {
+            candidates.emplace_back(distance, b);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    Neighbourhood neighbourhood{relation, seed.depotIndex, seed.vehicleTypeIndex, 0, {}};
+    int           numJourneys = 0;
+    for (const auto& candidate : candidates) {
+        int size = static_cast<int>(blocks_[candidate.second].journeys.size());
+        if (numJourneys + size > config.maxJourneys && !neighbourhood.blocks.empty())
+            continue;
+        neighbourhood.blocks.push_back(candidate.second);
+        numJourneys += size;
+    }
+
+    int freeCapacity = state_.getCapacity(seed.depotIndex, seed.vehicleTypeIndex) -
+                       state_.getUsed(seed.depotIndex, seed.vehicleTypeIndex);
+    neighbourhood.maxVehicles = static_cast<int>(neighbourhood.blocks.size()) + freeCapacity;
+    return neighbourhood;
+}
+
+LargeNeighbourhoodSearch::Rebuild
+LargeNeighbourhoodSearch::rebuild(const Neighbourhood& neighbourhood) const {
+    Rebuild result;
+    int     depot = neighbourhood.depotIndex;
+    int     type  = neighbourhood.vehicleTypeIndex;
+
+    std::vector<int> journeys;
+    double           destroyedCost = 0.0;
+    for (int b : neighbourhood.blocks) {
+        journeys.insert(journeys.end(), blocks_[b].journeys.begin(), blocks_[b].journeys.end());
+        destroyedCost += blocks_[b].cost;
+    }
+    std::sort(journeys.begin(), journeys.end(), [this](int a, int b) {
+        return network_.getPosition(a) < network_.getPosition(b);
+    });
+
+    // Assignment network: every journey gets one predecessor (journey or pull-out) and one
+    // successor (journey or pull-in); unused vehicles go straight from depot out to depot in
+    int       numJourneys = static_cast<int>(journeys.size());
+    int       vehicles    = neighbourhood.maxVehicles;
+    const int source      = 0;
+    const int depotOut    = 1;
+    const int depotIn     = 2;
+    const int sink        = 3;
+    auto      outNode     = [](int i) { return 4 + 2 * i; };
+    auto      inNode      = [](int i) { return 5 + 2 * i; };
+
+    MinCostFlow flow(4 + 2 * numJourneys);
+    flow.addArc(source, depotOut, vehicles, 0.0);
+    flow.addArc(depotOut, depotIn, vehicles, 0.0);
+    flow.addArc(depotIn, sink, vehicles, 0.0);
+
+    std::vector<int> pullOutArc(numJourneys, -1);
+    for (int i = 0; i < numJourneys; ++i) {
+        flow.addArc(source, outNode(i), 1, 0.0);
+        flow.addArc(inNode(i), sink, 1, 0.0);
+        flow.addArc(outNode(i), depotIn, 1, network_.pullInCost(type, depot, journeys[i]));
+        if (network_.hasPullOut(depot, journeys[i])) {
+            pullOutArc[i] =
+                flow.addArc(depotOut,
+                            inNode(i),
+                            1,
+                            network_.vehicleCost(type) +
+                                network_.pullOutCost(type, depot, journeys[i]));
+        }
+    }
+
+    std::vector<std::pair<int, int>> connectionArcs; // (from, arc) per target journey
+    std::vector<int>                 connectionOffsets(numJourneys + 1, 0);
+    for (int j = 0; j < numJourneys; ++j) {
+        for (int i = 0; i < j; ++i) {
+            if (network_.canConnect(journeys[i], journeys[j])) {
+                int arc = flow.addArc(outNode(i),
+                                      inNode(j),
+                                      1,
+                                      network_.connectionCost(type, journeys[i], journeys[j]));
+                connectionArcs.emplace_back(i, arc);
+            }
+        }
+        connectionOffsets[j + 1] = static_cast<int>(connectionArcs.size());
+    }
+
+    if (!flow.solve(source, sink, numJourneys + vehicles))
+        return result;
+
+    // Blocks are the chains from pull-out arcs along the used connections
+    std::vector<int> next(numJourneys, -1);
+    for (int j = 0; j < numJourneys; ++j) {
+        for (int c = connectionOffsets[j]; c < connectionOffsets[j + 1]; ++c) {
+            if (flow.getFlow(connectionArcs[c].second) > 0) {
+                next[connectionArcs[c].first] = j;
+            }
+        }
+    }
+
+    double rebuiltCost = 0.0;
+    for (int i = 0; i < numJourneys; ++i) {
+        if (pullOutArc[i] < 0 || flow.getFlow(pullOutArc[i]) == 0)
+            continue;
+
+        Block block{depot, type, {}, 0.0};
+        for (int k = i; k >= 0; k = next[k]) {
+            block.journeys.push_back(journeys[k]);
+        }
+        auto metrics = network_.evaluateBlock(depot, type, block.journeys);
+        if (!metrics.feasible)
+            return Rebuild();
+        block.cost = metrics.cost;
+        rebuiltCost += metrics.cost;
+        result.blocks.push_back(std::move(block));
+    }
+
+    result.gain = destroyedCost - rebuiltCost;
+    return result;
+}
+
+bool LargeNeighbourhoodSearch::apply(const Neighbourhood& neighbourhood, Rebuild& rebuilt) {
+    int depot = neighbourhood.depotIndex;
+    int type  = neighbourhood.vehicleTypeIndex;
+
+    // Earlier rebuilds of the round may have taken the free capacity of the slot
+    auto checkpoint = state_.checkpoint();
+    for (size_t k = 0; k < neighbourhood.blocks.size(); ++k) {
+        state_.release(depot, type);
+    }
+    for (size_t k = 0; k < rebuilt.blocks.size(); ++k) {
+        if (!state_.hasCapacity(depot, type)) {
+            state_.rollback(checkpoint);
+            return false;
+        }
+        state_.acquire(depot, type);
+    }
+    state_.commit(checkpoint);
+
+    // Rebuilt blocks take the places of the destroyed ones, surplus places are emptied
+    size_t k = 0;
+    for (int b : neighbourhood.blocks) {
+        if (k < rebuilt.blocks.size()) {
+            blocks_[b] = std::move(rebuilt.blocks[k++]);
+        }
+        else {
+            blocks_[b].journeys.clear();
+        }
+    }
+    for (; k < rebuilt.blocks.size(); ++k) {
+        blocks_.push_back(std::move(rebuilt.blocks[k]));
+    }
+    return true;
+}
+
+core::UnifiedSolution
+LargeNeighbourhoodSearch::buildSolution(const core::UnifiedSolution& start) const {
+    const auto& dataLoader = network_.getDataLoader();
+
+    core::UnifiedSolution solution = start;
+    solution.clearBlocks();
+    solution.objectiveValue = 0.0;
+
+    size_t numJourneys = 0;
+    for (const auto& block : blocks_) {
+        numJourneys += block.journeys.size();
+    }
+    solution.blocks.reserve(blocks_.size());
+    solution.journeys.reserve(numJourneys);
+    for (const auto& block : blocks_) {
+        if (block.journeys.empty())
+            continue;
+        core::VehicleBlock unifiedBlock{};
+        unifiedBlock.blockNumber   = static_cast<int>(solution.blocks.size()) + 1;
+        unifiedBlock.depotId       = dataLoader.getDepotStops()[block.depotIndex];
+        unifiedBlock.vehicleTypeId = dataLoader.getVehicleTypes()[block.vehicleTypeIndex].id;
+        unifiedBlock.totalCost     = block.cost;
+        unifiedBlock.totalDistance = 0.0;
+        unifiedBlock.totalTime     = 0;
+        solution.addBlock(unifiedBlock, block.journeys);
+        solution.objectiveValue += block.cost;
+    }
+    return solution;
+}
+
+void LargeNeighbourhoodSearch::log(const std::string& message) const {
+    if (verbose_) {
+        std::cout << "[LargeNeighbourhoodSearch] " << message << std::endl;
+    }
+}
+
+} // namespace meta
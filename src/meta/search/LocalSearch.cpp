@@ -0,0 +1,402 @@
+#include "meta/LocalSearch.hpp"
+#include "core/SolutionValidator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace meta {
+
+namespace {
+constexpr double kEpsilon = 1e-6;
+}
+
+LocalSearch::LocalSearch(const network::ConnectionNetwork& network)
+  : network_(network), verbose_(false), moves_(0), state_(network.getDataLoader()) {}
+
+core::UnifiedSolution LocalSearch::evaluate(const core::UnifiedSolution& solution) const {
+    const auto& dataLoader = network_.getDataLoader();
+
+    core::UnifiedSolution result = solution;
+    result.objectiveValue        = 0.0;
+
+    bool             feasible = true;
+    std::vector<int> covered(network_.getNumJourneys(), 0);
+    for (auto& block : result.blocks) {
+        auto blockJourneys = result.journeysOf(block);
+        auto metrics = network_.evaluateBlock(dataLoader.getDepotIndex(block.depotId),
+                                              dataLoader.getVehicleTypeIndex(block.vehicleTypeId),
+                                              blockJourneys);
+
+        block.totalCost     = metrics.cost;
+        block.totalDistance = metrics.distance;
+        block.totalTime     = metrics.time;
+        result.objectiveValue += metrics.cost;
+        feasible = feasible && metrics.feasible;
+        for (int journeyIdx : blockJourneys) {
+            feasible = feasible && ++covered[journeyIdx] == 1;
+        }
+    }
+    for (int count : covered) {
+        feasible = feasible && count == 1;
+    }
+
+    if (!feasible) {
+        result.status = "INFEASIBLE";
+    }
+    else if (!result.isFeasible()) {
+        result.status = "FEASIBLE";
+    }
+    return result;
+}
+
+core::UnifiedSolution LocalSearch::improve(const core::UnifiedSolution& start,
+                                           const SolverConfig&          config) {
+    auto startTime = std::chrono::steady_clock::now();
+    auto timeUp    = [&]() {
+        return config.stop.stopRequested() ||
+               std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime)
+                       .count() >= config.timeLimit;
+    };
+
+    const auto& dataLoader = network_.getDataLoader();
+
+    verbose_ = config.verbose;
+    moves_   = 0;
+    blocks_.clear();
+    state_.reset();
+    for (const auto& block : start.blocks) {
+        Block current{dataLoader.getDepotIndex(block.depotId),
+                      dataLoader.getVehicleTypeIndex(block.vehicleTypeId),
+                      start.journeysOf(block).toVector(),
+                      0.0};
+        if (current.depotIndex < 0 || current.vehicleTypeIndex < 0) {
+            log("Block with unknown depot or vehicle type, no local search");
+            return evaluate(start);
+        }
+        current.cost =
+            network_.evaluateBlock(current.depotIndex, current.vehicleTypeIndex, current.journeys)
+                .cost;
+        state_.acquire(current.depotIndex, current.vehicleTypeIndex);
+        blocks_.push_back(std::move(current));
+    }
+
+    // Debug builds check that no pass breaks a valid start
+#ifndef NDEBUG
+    core::SolutionValidator validator(network_);
+    bool                    checkPasses =
+        validator.validate(buildSolution(start, blocks_)).isValid();
+#endif
+
+    if (config.progress) {
+        config.progress->phase("local_search");
+    }
+
+    // Descent until a full pass finds no improving move; moves may drop blocks
+    auto numBlocks = [this]() { return static_cast<int>(blocks_.size()); };
+    bool improved  = true;
+    while (improved && !timeUp()) {
+        improved = false;
+        for (int a = 0; a < numBlocks() && !timeUp(); ++a) {
+            for (int b = 0; b < numBlocks() && a < numBlocks(); ++b) {
+                if (a != b && tryTailExchange(a, b)) {
+                    improved = true;
+                }
+            }
+            if (a < numBlocks() && trySlotChange(a)) {
+                improved = true;
+            }
+        }
+        if (improved && config.progress) {
+            double objective = 0.0;
+            for (const auto& block : blocks_) {
+                objective += block.cost;
+            }
+            config.progress->incumbent("local_search", objective);
+        }
+
+#ifndef NDEBUG
+        if (checkPasses) {
+            auto report = validator.validate(buildSolution(start, blocks_));
+            if (!report.isValid()) {
+                throw std::logic_error("Local search pass broke the solution: " +
+                                       report.summary() + " (" +
+                                       report.violations.front().describe() + ")");
+            }
+        }
+#endif
+    }
+
+    auto result          = evaluate(buildSolution(start, blocks_));
+    result.algorithmType = "local_search";
+    log("Local search: " + std::to_string(moves_) + " moves, objective " +
+        std::to_string(start.objectiveValue) + " -> " + std::to_string(result.objectiveValue));
+    return result;
+}
+
+core::UnifiedSolution LocalSearch::repair(const core::UnifiedSolution& partial) const {
+    const auto& dataLoader = network_.getDataLoader();
+    const auto& journeys   = dataLoader.getServiceJourneys();
+    int         numTypes   = network_.getNumVehicleTypes();
+
+    // Keep the drivable part of every block within the slot capacities
+    std::vector<Block>  blocks;
+    core::ScheduleState state(dataLoader);
+    for (const auto& block : partial.blocks) {
+        Block kept{dataLoader.getDepotIndex(block.depotId),
+                   dataLoader.getVehicleTypeIndex(block.vehicleTypeId),
+                   {},
+                   0.0};
+        if (kept.depotIndex < 0 || kept.vehicleTypeIndex < 0)
+            continue;
+        if (!state.hasCapacity(kept.depotIndex, kept.vehicleTypeIndex))
+            continue;
+
+        // The vehicle is booked up front and given back if none of its journeys is kept
+        auto checkpoint = state.checkpoint();
+        state.acquire(kept.depotIndex, kept.vehicleTypeIndex);
+        for (int journeyIdx : partial.journeysOf(block)) {
+            bool drivable = kept.journeys.empty()
+                                ? network_.hasPullOut(kept.depotIndex, journeyIdx)
+                                : network_.canConnect(kept.journeys.back(), journeyIdx);
+            if (!state.isAssigned(journeyIdx) && drivable &&
+                network_.isCompatible(kept.vehicleTypeIndex, journeyIdx)) {
+                state.assign(journeyIdx);
+                kept.journeys.push_back(journeyIdx);
+            }
+        }
+        if (kept.journeys.empty()) {
+            state.rollback(checkpoint);
+            continue;
+        }
+        state.commit(checkpoint);
+        blocks.push_back(std::move(kept));
+    }
+
+    // Cheapest insertion in departure order; in a block only the position by departure fits
+    int placed = 0;
+    int failed = 0;
+    for (int journeyIdx : network_.getOrder()) {
+        if (state.isAssigned(journeyIdx))
+            continue;
+
+        Block* bestBlock    = nullptr;
+        size_t bestPosition = 0;
+        double bestDelta    = std::numeric_limits<double>::infinity();
+        for (auto& block : blocks) {
+            int type = block.vehicleTypeIndex;
+            if (!network_.isCompatible(type, journeyIdx))
+                continue;
+
+            auto after = std::upper_bound(
+                block.journeys.begin(),
+                block.journeys.end(),
+                journeys[journeyIdx].depTime,
+                [&journeys](int time, int j) { return time < journeys[j].depTime; });
+            size_t position = after - block.journeys.begin();
+            double delta    = network_.serviceCost(type, journeyIdx);
+            if (position == 0) {
+                int next = block.journeys.front();
+                if (!network_.hasPullOut(block.depotIndex, journeyIdx) ||
+                    !network_.canConnect(journeyIdx, next))
+                    continue;
+                delta += network_.pullOutCost(type, block.depotIndex, journeyIdx) +
+                         network_.connectionCost(type, journeyIdx, next) -
+                         network_.pullOutCost(type, block.depotIndex, next);
+            }
+            else if (position == block.journeys.size()) {
+                int previous = block.journeys.back();
+                if (!network_.canConnect(previous, journeyIdx))
+                    continue;
+                delta += network_.connectionCost(type, previous, journeyIdx) +
+                         network_.pullInCost(type, block.depotIndex, journeyIdx) -
+                         network_.pullInCost(type, block.depotIndex, previous);
+            }
+            else {
+                int previous = block.journeys[position - 1];
+                int next     = block.journeys[position];
+                if (!network_.canConnect(previous, journeyIdx) ||
+                    !network_.canConnect(journeyIdx, next))
+                    continue;
+                delta += network_.connectionCost(type, previous, journeyIdx) +
+                         network_.connectionCost(type, journeyIdx, next) -
+                         network_.connectionCost(type, previous, next);
+            }
+            if (delta < bestDelta) {
+                bestBlock    = &block;
+                bestPosition = position;
+                bestDelta    = delta;
+            }
+        }
+
+        // A new vehicle in the cheapest free slot
+        int bestDepot = -1;
+        int bestType  = -1;
+        for (int d = 0; d < network_.getNumDepots(); ++d) {
+            for (int t = 0; t < numTypes; ++t) {
+                if (!state.hasCapacity(d, t) ||
+                    !network_.isCompatible(t, journeyIdx) || !network_.hasPullOut(d, journeyIdx))
+                    continue;
+
+                double cost = network_.vehicleCost(t) + network_.pullOutCost(t, d, journeyIdx) +
+                              network_.serviceCost(t, journeyIdx) +
+                              network_.pullInCost(t, d, journeyIdx);
+                if (cost < bestDelta) {
+                    bestBlock = nullptr;
+                    bestDepot = d;
+                    bestType  = t;
+                    bestDelta = cost;
+                }
+            }
+        }
+
+        if (bestBlock != nullptr) {
+            bestBlock->journeys.insert(bestBlock->journeys.begin() + bestPosition, journeyIdx);
+            state.assign(journeyIdx);
+            ++placed;
+        }
+        else if (bestDepot >= 0) {
+            state.acquire(bestDepot, bestType);
+            state.assign(journeyIdx);
+            blocks.push_back({bestDepot, bestType, {journeyIdx}, 0.0});
+            ++placed;
+        }
+        else {
+            ++failed;
+        }
+    }
+
+    log("Repair: " + std::to_string(placed) + " journeys inserted, " + std::to_string(failed) +
+        " without a feasible position");
+    return evaluate(buildSolution(partial, blocks));
+}
+
+bool LocalSearch::tryTailExchange(int a, int b) {
+    const auto& blockA  = blocks_[a];
+    const auto& blockB  = blocks_[b];
+    int         lengthA = static_cast<int>(blockA.journeys.size());
+    int         lengthB = static_cast<int>(blockB.journeys.size());
+
+    // Keep a[0..i] and b[0..j] (-1 keeps nothing), then swap the tails
+    for (int i = -1; i < lengthA; ++i) {
+        for (int j = -1; j < lengthB; ++j) {
+            bool tailA = i + 1 < lengthA;
+            bool tailB = j + 1 < lengthB;
+            if ((!tailA && !tailB) || (i < 0 && j < 0))
+                continue;
+            if (i >= 0 && tailB && !network_.canConnect(blockA.journeys[i], blockB.journeys[j + 1]))
+                continue;
+            if (j >= 0 && tailA && !network_.canConnect(blockB.journeys[j], blockA.journeys[i + 1]))
+                continue;
+
+            std::vector<int> newA(blockA.journeys.begin(), blockA.journeys.begin() + i + 1);
+            std::vector<int> newB(blockB.journeys.begin(), blockB.journeys.begin() + j + 1);
+            newA.insert(newA.end(), blockB.journeys.begin() + j + 1, blockB.journeys.end());
+            newB.insert(newB.end(), blockA.journeys.begin() + i + 1, blockA.journeys.end());
+
+            // An empty block is dropped, which saves its vehicle
+            network::BlockMetrics metricsA{true, 0.0, 0.0, 0};
+            network::BlockMetrics metricsB{true, 0.0, 0.0, 0};
+            if (!newA.empty()) {
+                metricsA = network_.evaluateBlock(blockA.depotIndex, blockA.vehicleTypeIndex, newA);
+            }
+            if (!metricsA.feasible)
+                continue;
+            if (!newB.empty()) {
+                metricsB = network_.evaluateBlock(blockB.depotIndex, blockB.vehicleTypeIndex, newB);
+            }
+            if (!metricsB.feasible ||
+                metricsA.cost + metricsB.cost >= blockA.cost + blockB.cost - kEpsilon)
+                continue;
+
+            blocks_[a].journeys = std::move(newA);
+            blocks_[a].cost     = metricsA.cost;
+            blocks_[b].journeys = std::move(newB);
+            blocks_[b].cost     = metricsB.cost;
+            ++moves_;
+
+            // Drop emptied blocks, the higher index first so the other stays valid
+            for (int k : {std::max(a, b), std::min(a, b)}) {
+                if (blocks_[k].journeys.empty()) {
+                    state_.release(blocks_[k].depotIndex, blocks_[k].vehicleTypeIndex);
+                    if (k + 1 < static_cast<int>(blocks_.size())) {
+                        blocks_[k] = std::move(blocks_.back());
+                    }
+                    blocks_.pop_back();
+                }
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LocalSearch::trySlotChange(int a) {
+    auto& block    = blocks_[a];
+    int   numTypes = network_.getNumVehicleTypes();
+
+    int    bestDepot = -1;
+    int    bestType  = -1;
+    double bestCost  = block.cost - kEpsilon;
+    for (int d = 0; d < network_.getNumDepots(); ++d) {
+        for (int t = 0; t < numTypes; ++t) {
+            if ((d == block.depotIndex && t == block.vehicleTypeIndex) ||
+                !state_.hasCapacity(d, t))
+                continue;
+
+            auto metrics = network_.evaluateBlock(d, t, block.journeys);
+            if (metrics.feasible && metrics.cost < bestCost) {
+                bestDepot = d;
+                bestType  = t;
+                bestCost  = metrics.cost;
+            }
+        }
+    }
+    if (bestDepot < 0)
+        return false;
+
+    state_.release(block.depotIndex, block.vehicleTypeIndex);
+    state_.acquire(bestDepot, bestType);
+    block.depotIndex       = bestDepot;
+    block.vehicleTypeIndex = bestType;
+    block.cost             = bestCost;
+    ++moves_;
+    return true;
+}
+
+core::UnifiedSolution LocalSearch::buildSolution(const core::UnifiedSolution& start,
+                                                 const std::vector<Block>&    blocks) const {
+    const auto& dataLoader = network_.getDataLoader();
+
+    core::UnifiedSolution solution = start;
+    solution.clearBlocks();
+    solution.objectiveValue = 0.0;
+
+    size_t numJourneys = 0;
+    for (const auto& block : blocks) {
+        numJourneys += block.journeys.size();
+    }
+    solution.blocks.reserve(blocks.size());
+    solution.journeys.reserve(numJourneys);
+    for (const auto& block : blocks) {
+        core::VehicleBlock unifiedBlock{};
+        unifiedBlock.blockNumber   = static_cast<int>(solution.blocks.size()) + 1;
+        unifiedBlock.depotId       = dataLoader.getDepotStops()[block.depotIndex];
+        unifiedBlock.vehicleTypeId = dataLoader.getVehicleTypes()[block.vehicleTypeIndex].id;
+        unifiedBlock.totalCost     = block.cost;
+        unifiedBlock.totalDistance = 0.0;
+        unifiedBlock.totalTime     = 0;
+        solution.addBlock(unifiedBlock, block.journeys);
+        solution.objectiveValue += block.cost;
+    }
+    return solution;
+}
+
+void LocalSearch::log(const std::string& message) const {
+    if (verbose_) {
+        std::cout << "[LocalSearch] " << message << std::endl;
+    }
+}
+
+} // namespace meta
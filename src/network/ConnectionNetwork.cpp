@@ -0,0 +1,157 @@
+#include "network/ConnectionNetwork.hpp"
+#include "core/ParallelFor.hpp"
+#include "network/Preprocessor.hpp"
+#include <algorithm>
+
+namespace network {
+
+ConnectionNetwork::ConnectionNetwork(const data::DataLoader& dataLoader)
+  : ConnectionNetwork(dataLoader, Options()) {}
+
+ConnectionNetwork::ConnectionNetwork(const data::DataLoader& dataLoader, const Options& options)
+  : dataLoader_(dataLoader), journeys_(dataLoader) {
+    int numJourneys = journeys_.size();
+
+    for (int depotId : dataLoader_.getDepotStops()) {
+        depotStopIndex_.push_back(dataLoader_.getStopIndex(depotId));
+    }
+
+    for (const auto& vehicleType : dataLoader_.getVehicleTypes()) {
+        rates_.emplace_back(vehicleType);
+    }
+
+    // Collect predecessors per node in parallel, then pack them into CSR. Candidates are
+    // scanned in departure order, so the loop streams through the ready time and stop columns.
+    const int32_t*                readyTimes = journeys_.readyTimes();
+    const int32_t*                toStops    = journeys_.toStops();
+    std::vector<std::vector<int>> incoming(numJourneys);
+    std::vector<size_t>           pruned(numJourneys, 0);
+    core::parallelFor(numJourneys, options.threads, [&](int q) {
+        int depTime  = journeys_.depTime(q);
+        int fromStop = journeys_.fromStop(q);
+
+        for (int p = 0; p < q; ++p) {
+            if (readyTimes[p] > depTime)
+                continue;
+            int deadHeadTime = std::max(dataLoader_.getDeadRunTimeByIndex(toStops[p], fromStop), 0);
+            int idle         = depTime - readyTimes[p] - deadHeadTime;
+            if (idle < 0)
+                continue;
+            if (options.maxWaitSeconds > 0 && idle > options.maxWaitSeconds)
+                continue;
+
+            if (options.preprocessor && !options.preprocessor->keepArc(journeys_.journeyIndex(p),
+                                                                       journeys_.journeyIndex(q))) {
+                ++pruned[q];
+                continue;
+            }
+
+            incoming[q].push_back(p);
+        }
+    });
+
+    predecessorOffsets_.assign(numJourneys + 1, 0);
+    for (int q = 0; q < numJourneys; ++q) {
+        prunedArcs_ += pruned[q];
+        predecessorOffsets_[q + 1] = predecessorOffsets_[q] + static_cast<int>(incoming[q].size());
+    }
+    predecessors_.reserve(predecessorOffsets_[numJourneys]);
+    for (auto& list : incoming) {
+        predecessors_.insert(predecessors_.end(), list.begin(), list.end());
+        std::vector<int>().swap(list);
+    }
+}
+
+bool ConnectionNetwork::connects(int fromPosition, int toPosition) const {
+    int deadHeadTime = dataLoader_.getDeadRunTimeByIndex(journeys_.toStop(fromPosition),
+                                                         journeys_.fromStop(toPosition));
+    return journeys_.readyTime(fromPosition) + std::max(deadHeadTime, 0) <=
+           journeys_.depTime(toPosition);
+}
+
+double ConnectionNetwork::deadRunCost(int vehicleTypeIndex,
+                                      int fromStopIndex,
+                                      int toStopIndex) const {
+    return Cost::deadRunCost(rates_[vehicleTypeIndex],
+                             dataLoader_.getDeadRunDistanceByIndex(fromStopIndex, toStopIndex),
+                             dataLoader_.getDeadRunTimeByIndex(fromStopIndex, toStopIndex));
+}
+
+double ConnectionNetwork::pullOutCost(int vehicleTypeIndex, int depotIndex, int journeyIdx) const {
+    return deadRunCost(vehicleTypeIndex,
+                       depotStopIndex_[depotIndex],
+                       journeys_.fromStop(journeys_.position(journeyIdx)));
+}
+
+double ConnectionNetwork::pullInCost(int vehicleTypeIndex, int depotIndex, int journeyIdx) const {
+    return deadRunCost(vehicleTypeIndex,
+                       journeys_.toStop(journeys_.position(journeyIdx)),
+                       depotStopIndex_[depotIndex]);
+}
+
+double ConnectionNetwork::serviceCost(int vehicleTypeIndex, int journeyIdx) const {
+    int position = journeys_.position(journeyIdx);
+    return Cost::legCost(rates_[vehicleTypeIndex],
+                         journeys_.distance(position),
+                         journeys_.arrTime(position) - journeys_.depTime(position));
+}
+
+double ConnectionNetwork::connectionCost(int vehicleTypeIndex,
+                                         int fromJourney,
+                                         int toJourney) const {
+    return deadRunCost(vehicleTypeIndex,
+                       journeys_.toStop(journeys_.position(fromJourney)),
+                       journeys_.fromStop(journeys_.position(toJourney)));
+}
+
+int ConnectionNetwork::getCapacity(int depotIndex, int vehicleTypeIndex) const {
+    return dataLoader_.getVehicleCapacityAtStop(dataLoader_.getVehicleTypes()[vehicleTypeIndex].id,
+                                                dataLoader_.getDepotStops()[depotIndex]);
+}
+
+BlockMetrics ConnectionNetwork::evaluateBlock(int               depotIndex,
+                                              int               vehicleTypeIndex,
+                                              data::JourneySpan journeys) const {
+    BlockMetrics metrics{false, 0.0, 0.0, 0};
+    if (journeys.empty() || depotIndex < 0 || vehicleTypeIndex < 0)
+        return metrics;
+
+    int depotStop = depotStopIndex_[depotIndex];
+
+    auto addDeadRun = [&](int fromStop, int toStop) {
+        double distance = dataLoader_.getDeadRunDistanceByIndex(fromStop, toStop);
+        int    time     = dataLoader_.getDeadRunTimeByIndex(fromStop, toStop);
+        metrics.cost += Cost::deadRunCost(rates_[vehicleTypeIndex], distance, time);
+        if (distance > 0 && time > 0) {
+            metrics.distance += distance;
+            metrics.time += time;
+        }
+    };
+
+    metrics.feasible = hasPullOut(depotIndex, journeys.front());
+    metrics.cost     = rates_[vehicleTypeIndex].vehicleCost;
+    int previous = -1; // Position of the previous journey
+    for (int journeyIdx : journeys) {
+        int position = journeys_.position(journeyIdx);
+        int duration = journeys_.arrTime(position) - journeys_.depTime(position);
+        if (previous < 0) {
+            addDeadRun(depotStop, journeys_.fromStop(position));
+        } else {
+            metrics.feasible = metrics.feasible && connects(previous, position);
+            addDeadRun(journeys_.toStop(previous), journeys_.fromStop(position));
+        }
+
+        metrics.feasible = metrics.feasible && dataLoader_.isVehicleTypeIndexCompatible(
+                                                   vehicleTypeIndex, journeys_.group(position));
+        metrics.cost +=
+            Cost::legCost(rates_[vehicleTypeIndex], journeys_.distance(position), duration);
+        metrics.distance += journeys_.distance(position);
+        metrics.time += duration;
+        previous = position;
+    }
+
+    addDeadRun(journeys_.toStop(previous), depotStop);
+    return metrics;
+}
+
+} // namespace network
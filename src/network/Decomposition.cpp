@@ -0,0 +1,193 @@
+#include "network/Decomposition.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+namespace network {
+
+namespace {
+/**
+ * Union-find with path halving and union by size
+ */
+class DisjointSets {
+  public:
+    explicit DisjointSets(int count) : parent_(count), size_(count, 1) {
+        std::iota(parent_.begin(), parent_.end(), 0);
+    }
+
+    int find(int x) {
+        while (parent_[x] != x) {
+            parent_[x] = parent_[parent_[x]];
+            x          = parent_[x];
+        }
+        return x;
+    }
+
+    void unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b)
+            return;
+        if (size_[a] < size_[b])
+            std::swap(a, b);
+        parent_[b] = a;
+        size_[a] += size_[b];
+    }
+
+  private:
+    std::vector<int> parent_;
+    std::vector<int> size_;
+};
+} // namespace
+
+Decomposition::Decomposition(const data::DataLoader& dataLoader) {
+    const auto& journeys        = dataLoader.getServiceJourneys();
+    const auto& vehicleTypes    = dataLoader.getVehicleTypes();
+    const auto& depotStops      = dataLoader.getDepotStops();
+    int         numJourneys     = static_cast<int>(journeys.size());
+    int         numVehicleTypes = static_cast<int>(vehicleTypes.size());
+    int         numDepots       = static_cast<int>(depotStops.size());
+    size_t      typeWords       = (vehicleTypes.size() + 63) / 64;
+
+    std::vector<int>  capacity(numDepots * numVehicleTypes);
+    std::vector<char> hasCapacity(numVehicleTypes, 0);
+    for (int d = 0; d < numDepots; ++d) {
+        for (int t = 0; t < numVehicleTypes; ++t) {
+            int slot       = d * numVehicleTypes + t;
+            capacity[slot] = dataLoader.getVehicleCapacityAtStop(vehicleTypes[t].id, depotStops[d]);
+            hasCapacity[t] |= capacity[slot] > 0;
+        }
+    }
+
+    // Per journey: stops, ready time and the vehicle types with capacity that serve it
+    std::vector<int>      fromStop(numJourneys);
+    std::vector<int>      toStop(numJourneys);
+    std::vector<int>      readyTime(numJourneys);
+    std::vector<uint64_t> typeBits(numJourneys * typeWords, 0);
+    for (int j = 0; j < numJourneys; ++j) {
+        const auto& journey = journeys[j];
+        int         group   = dataLoader.getVehicleTypeGroupIndex(journey.vehTypeGroupId);
+        fromStop[j]         = dataLoader.getStopIndex(journey.fromStopId);
+        toStop[j]           = dataLoader.getStopIndex(journey.toStopId);
+        readyTime[j]        = journey.arrTime + journey.minLayoverTime;
+        for (int t = 0; t < numVehicleTypes && group >= 0; ++t) {
+            if (hasCapacity[t] && dataLoader.isVehicleTypeIndexCompatible(t, group)) {
+                typeBits[j * typeWords + (t >> 6)] |= uint64_t{1} << (t & 63);
+            }
+        }
+    }
+
+    // Elements: journeys first, then slots
+    DisjointSets sets(numJourneys + numDepots * numVehicleTypes);
+    for (int j = 0; j < numJourneys; ++j) {
+        for (int d = 0; d < numDepots; ++d) {
+            int depotStop = dataLoader.getStopIndex(depotStops[d]);
+            if (depotStop < 0 || fromStop[j] < 0 ||
+                dataLoader.getDeadRunTimeByIndex(depotStop, fromStop[j]) < 0 ||
+                dataLoader.getDeadRunDistanceByIndex(depotStop, fromStop[j]) < 0)
+                continue;
+            for (int t = 0; t < numVehicleTypes; ++t) {
+                int slot = d * numVehicleTypes + t;
+                if (capacity[slot] > 0 && (typeBits[j * typeWords + (t >> 6)] >> (t & 63)) & 1u) {
+                    sets.unite(j, numJourneys + slot);
+                }
+            }
+        }
+    }
+
+    // Journey ends bucketed by (end stop, vehicle type) and sorted by ready time. A journey
+    // connects to a prefix of every bucket of its types: the journeys ready before its
+    // departure minus the dead run. All of a prefix thus lands in one component, so each
+    // bucket keeps how far it is already joined and joins each journey once.
+    int               numStops = dataLoader.getNumStopIndices();
+    std::vector<int>  bucketOffsets(static_cast<size_t>(numStops) * numVehicleTypes + 1, 0);
+    std::vector<char> isEndStop(numStops, 0);
+    auto              forEachType = [&](int j, auto&& visit) {
+        for (int t = 0; t < numVehicleTypes; ++t) {
+            if ((typeBits[j * typeWords + (t >> 6)] >> (t & 63)) & 1u) {
+                visit(t);
+            }
+        }
+    };
+    for (int j = 0; j < numJourneys; ++j) {
+        if (toStop[j] < 0)
+            continue;
+        isEndStop[toStop[j]] = 1;
+        forEachType(j, [&](int t) { ++bucketOffsets[toStop[j] * numVehicleTypes + t + 1]; });
+    }
+    std::partial_sum(bucketOffsets.begin(), bucketOffsets.end(), bucketOffsets.begin());
+
+    std::vector<int> bucketJourneys(bucketOffsets.back());
+    std::vector<int> fill(bucketOffsets.begin(), bucketOffsets.end() - 1);
+    for (int j = 0; j < numJourneys; ++j) {
+        if (toStop[j] < 0)
+            continue;
+        forEachType(j, [&](int t) { bucketJourneys[fill[toStop[j] * numVehicleTypes + t]++] = j; });
+    }
+    for (size_t bucket = 0; bucket + 1 < bucketOffsets.size(); ++bucket) {
+        auto first = bucketJourneys.begin() + bucketOffsets[bucket];
+        auto last  = bucketJourneys.begin() + bucketOffsets[bucket + 1];
+        std::stable_sort(first, last, [&readyTime](int a, int b) {
+            return readyTime[a] < readyTime[b];
+        });
+    }
+    std::vector<int> bucketReady(bucketJourneys.size());
+    for (size_t i = 0; i < bucketJourneys.size(); ++i) {
+        bucketReady[i] = readyTime[bucketJourneys[i]];
+    }
+
+    std::vector<int> endStops;
+    for (int s = 0; s < numStops; ++s) {
+        if (isEndStop[s]) {
+            endStops.push_back(s);
+        }
+    }
+    std::vector<int> joined(bucketOffsets.size() - 1, 1);
+    for (int to = 0; to < numJourneys; ++to) {
+        if (fromStop[to] < 0)
+            continue;
+        for (int s : endStops) {
+            int deadHeadTime = dataLoader.getDeadRunTimeByIndex(s, fromStop[to]);
+            int latestReady  = journeys[to].depTime - std::max(deadHeadTime, 0);
+            forEachType(to, [&](int t) {
+                int        bucket = s * numVehicleTypes + t;
+                const int* first  = bucketReady.data() + bucketOffsets[bucket];
+                const int* last   = bucketReady.data() + bucketOffsets[bucket + 1];
+                auto       count  = std::upper_bound(first, last, latestReady) - first;
+                if (count == 0)
+                    return;
+                const int* members = bucketJourneys.data() + bucketOffsets[bucket];
+                for (; joined[bucket] < count; ++joined[bucket]) {
+                    sets.unite(members[0], members[joined[bucket]]);
+                }
+                sets.unite(members[0], to);
+            });
+        }
+    }
+
+    // Collect components that contain journeys
+    std::vector<int> componentOf(numJourneys + numDepots * numVehicleTypes, -1);
+    for (int j = 0; j < numJourneys; ++j) {
+        int root = sets.find(j);
+        if (componentOf[root] < 0) {
+            componentOf[root] = static_cast<int>(components_.size());
+            components_.emplace_back();
+        }
+        components_[componentOf[root]].journeys.push_back(j);
+    }
+    for (int slot = 0; slot < numDepots * numVehicleTypes; ++slot) {
+        int root = sets.find(numJourneys + slot);
+        if (capacity[slot] > 0 && componentOf[root] >= 0) {
+            components_[componentOf[root]].slots.emplace_back(slot / numVehicleTypes,
+                                                              slot % numVehicleTypes);
+        }
+    }
+
+    std::stable_sort(components_.begin(),
+                     components_.end(),
+                     [](const Component& a, const Component& b) {
+                         return a.journeys.size() > b.journeys.size();
+                     });
+}
+
+} // namespace network
@@ -0,0 +1,195 @@
+#include "network/Preprocessor.hpp"
+#include "core/ParallelFor.hpp"
+#include <chrono>
+
+namespace network {
+
+Preprocessor::Preprocessor(const data::DataLoader& dataLoader, int threads)
+  : dataLoader_(dataLoader),
+    numVehicleTypes_(static_cast<int>(dataLoader.getVehicleTypes().size())),
+    numDepots_(static_cast<int>(dataLoader.getDepotStops().size())),
+    typeWords_((dataLoader.getVehicleTypes().size() + 63) / 64) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    const auto& journeys     = dataLoader_.getServiceJourneys();
+    const auto& vehicleTypes = dataLoader_.getVehicleTypes();
+    int         numJourneys  = static_cast<int>(journeys.size());
+    int         numGroups    = dataLoader_.getNumVehicleTypeGroupIndices();
+    int         numSlots     = numDepots_ * numVehicleTypes_;
+
+    for (const auto& vehicleType : vehicleTypes) {
+        rates_.emplace_back(vehicleType);
+    }
+    for (int depotId : dataLoader_.getDepotStops()) {
+        depotStopIndex_.push_back(dataLoader_.getStopIndex(depotId));
+    }
+
+    std::vector<int> groupIndex(numJourneys);
+    for (int j = 0; j < numJourneys; ++j) {
+        groupIndex[j] = dataLoader_.getVehicleTypeGroupIndex(journeys[j].vehTypeGroupId);
+        fromStopIndex_.push_back(dataLoader_.getStopIndex(journeys[j].fromStopId));
+        toStopIndex_.push_back(dataLoader_.getStopIndex(journeys[j].toStopId));
+    }
+    auto compatible = [&](int t, int j) {
+        return groupIndex[j] >= 0 && dataLoader_.isVehicleTypeIndexCompatible(t, groupIndex[j]);
+    };
+    auto hasPullOut = [&](int d, int j) {
+        return depotStopIndex_[d] >= 0 && fromStopIndex_[j] >= 0 &&
+               dataLoader_.getDeadRunTimeByIndex(depotStopIndex_[d], fromStopIndex_[j]) >= 0 &&
+               dataLoader_.getDeadRunDistanceByIndex(depotStopIndex_[d], fromStopIndex_[j]) >= 0;
+    };
+
+    std::vector<int> compatibleJourneys(numVehicleTypes_, 0);
+    core::parallelFor(numVehicleTypes_, threads, [&](int t) {
+        for (int j = 0; j < numJourneys; ++j) {
+            compatibleJourneys[t] += compatible(t, j) ? 1 : 0;
+        }
+    });
+
+    // Slot capacities, usability and slack
+    std::vector<int>  capacity(numSlots);
+    std::vector<char> usable(numSlots, 0);
+    slack_.assign(numSlots, 0);
+    core::parallelFor(numSlots, threads, [&](int slot) {
+        int d          = slot / numVehicleTypes_;
+        int t          = slot % numVehicleTypes_;
+        capacity[slot] = dataLoader_.getVehicleCapacityAtStop(vehicleTypes[t].id,
+                                                              dataLoader_.getDepotStops()[d]);
+        if (capacity[slot] <= 0)
+            return;
+        for (int j = 0; j < numJourneys && !usable[slot]; ++j) {
+            usable[slot] = compatible(t, j) && hasPullOut(d, j);
+        }
+        slack_[slot] = capacity[slot] >= compatibleJourneys[t];
+    });
+
+    // Type dominance: groups(a) within groups(b) and no higher rate, ties go to the lower index
+    std::vector<char> dominates(numVehicleTypes_ * numVehicleTypes_, 0);
+    for (int a = 0; a < numVehicleTypes_; ++a) {
+        for (int b = 0; b < numVehicleTypes_; ++b) {
+            if (a == b)
+                continue;
+            bool subset = true;
+            bool equal  = true;
+            for (int g = 0; g < numGroups && subset; ++g) {
+                bool servesA = dataLoader_.isVehicleTypeIndexCompatible(a, g);
+                bool servesB = dataLoader_.isVehicleTypeIndexCompatible(b, g);
+                subset       = !servesA || servesB;
+                equal        = equal && servesA == servesB;
+            }
+
+            const auto& ra = rates_[a];
+            const auto& rb = rates_[b];
+
+            bool cheaper = rb.vehicleCost <= ra.vehicleCost && rb.kmCost <= ra.kmCost &&
+                           rb.hourCost <= ra.hourCost;
+            equal = equal && rb.vehicleCost == ra.vehicleCost && rb.kmCost == ra.kmCost &&
+                    rb.hourCost == ra.hourCost;
+            dominates[b * numVehicleTypes_ + a] = subset && cheaper && (!equal || b < a);
+        }
+    }
+
+    removed_.assign(numSlots, 0);
+    for (int slot = 0; slot < numSlots; ++slot) {
+        if (capacity[slot] <= 0)
+            continue;
+        int d = slot / numVehicleTypes_;
+        int a = slot % numVehicleTypes_;
+        if (!usable[slot]) {
+            removed_[slot] = 1;
+            ++stats_.unusableSlots;
+            continue;
+        }
+        for (int b = 0; b < numVehicleTypes_; ++b) {
+            int other = d * numVehicleTypes_ + b;
+            if (dominates[b * numVehicleTypes_ + a] && usable[other] && slack_[other]) {
+                removed_[slot] = 1;
+                ++stats_.dominatedSlots;
+                break;
+            }
+        }
+    }
+
+    // Vehicle types with a remaining slot, per type and per journey
+    std::vector<char> hasSlot(numVehicleTypes_, 0);
+    std::vector<char> hadSlot(numVehicleTypes_, 0);
+    active_.assign(numSlots, 0);
+    for (int slot = 0; slot < numSlots; ++slot) {
+        int t         = slot % numVehicleTypes_;
+        active_[slot] = capacity[slot] > 0 && !removed_[slot];
+        hadSlot[t] |= capacity[slot] > 0;
+        hasSlot[t] |= active_[slot];
+    }
+    for (int t = 0; t < numVehicleTypes_; ++t) {
+        stats_.removedVehicleTypes += hadSlot[t] && !hasSlot[t] ? 1 : 0;
+    }
+
+    usableTypeBits_.assign(static_cast<size_t>(numJourneys) * typeWords_, 0);
+    core::parallelFor(numJourneys, threads, [&](int j) {
+        for (int t = 0; t < numVehicleTypes_; ++t) {
+            if (hasSlot[t] && compatible(t, j)) {
+                usableTypeBits_[j * typeWords_ + (t >> 6)] |= uint64_t{1} << (t & 63);
+            }
+        }
+    });
+
+    stats_.seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void Preprocessor::apply(data::DataLoader& dataLoader) const {
+    const auto& vehicleTypes = dataLoader.getVehicleTypes();
+    const auto& depotStops   = dataLoader.getDepotStops();
+    for (int d = 0; d < numDepots_; ++d) {
+        for (int t = 0; t < numVehicleTypes_; ++t) {
+            if (isSlotRemoved(d, t)) {
+                dataLoader.setVehicleCapacityAtStop(vehicleTypes[t].id, depotStops[d], 0);
+            }
+        }
+    }
+}
+
+bool Preprocessor::keepArc(int fromJourney, int toJourney) const {
+    int fromStop = toStopIndex_[fromJourney];
+    int toStop   = fromStopIndex_[toJourney];
+    if (fromStop < 0 || toStop < 0)
+        return true;
+
+    for (size_t w = 0; w < typeWords_; ++w) {
+        uint64_t common = usableTypeBits_[fromJourney * typeWords_ + w] &
+                          usableTypeBits_[toJourney * typeWords_ + w];
+        for (; common != 0; common &= common - 1) {
+            int    t        = static_cast<int>(w * 64) + __builtin_ctzll(common);
+            double connect  = deadRunCost(t, fromStop, toStop);
+            double newBlock = rates_[t].vehicleCost;
+
+            for (int d = 0; d < numDepots_; ++d) {
+                int slot = d * numVehicleTypes_ + t;
+                if (!active_[slot])
+                    continue;
+
+                // Without slack the split may need a vehicle the depot does not have
+                int depotStop = depotStopIndex_[d];
+                if (!slack_[slot] || depotStop < 0)
+                    return true;
+                if (dataLoader_.getDeadRunTimeByIndex(depotStop, toStop) < 0 ||
+                    dataLoader_.getDeadRunDistanceByIndex(depotStop, toStop) < 0)
+                    return true;
+
+                double split = deadRunCost(t, fromStop, depotStop) + newBlock +
+                               deadRunCost(t, depotStop, toStop);
+                if (connect <= split)
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+double Preprocessor::deadRunCost(int vehicleTypeIndex, int fromStopIndex, int toStopIndex) const {
+    return Cost::deadRunCost(rates_[vehicleTypeIndex],
+                             dataLoader_.getDeadRunDistanceByIndex(fromStopIndex, toStopIndex),
+                             dataLoader_.getDeadRunTimeByIndex(fromStopIndex, toStopIndex));
+}
+
+} // namespace network
@@ -0,0 +1,259 @@
+#include "network/TimeSpaceNetwork.hpp"
+#include "core/CostPolicy.hpp"
+#include <algorithm>
+
+namespace network {
+
+namespace {
+using Cost = core::DefaultCostPolicy;
+
+// Arrivals sort before departures at equal times, so they can connect by waiting
+constexpr int kArrival   = 0;
+constexpr int kDeparture = 1;
+
+struct Event {
+    int time;
+    int kind;
+    int journeyIdx;
+
+    bool operator<(const Event& other) const {
+        if (time != other.time)
+            return time < other.time;
+        if (kind != other.kind)
+            return kind < other.kind;
+        return journeyIdx < other.journeyIdx;
+    }
+};
+} // namespace
+
+TimeSpaceSize& TimeSpaceSize::operator+=(const TimeSpaceSize& other) {
+    nodes += other.nodes;
+    serviceArcs += other.serviceArcs;
+    waitingArcs += other.waitingArcs;
+    deadheadArcs += other.deadheadArcs;
+    depotArcs += other.depotArcs;
+    return *this;
+}
+
+TimeSpaceNetwork::TimeSpaceNetwork(const data::DataLoader& dataLoader, int vehicleTypeIndex)
+  : TimeSpaceNetwork(dataLoader, vehicleTypeIndex, Options()) {}
+
+TimeSpaceNetwork::TimeSpaceNetwork(const data::DataLoader& dataLoader,
+                                   int                     vehicleTypeIndex,
+                                   const Options&          options)
+  : vehicleTypeIndex_(vehicleTypeIndex) {
+    const auto&     journeys    = dataLoader.getServiceJourneys();
+    int             numJourneys = static_cast<int>(journeys.size());
+    int             numStops    = dataLoader.getNumStopIndices();
+    core::CostRates rates(dataLoader.getVehicleTypes()[vehicleTypeIndex_]);
+
+    // Events of the compatible journeys per stop
+    std::vector<std::vector<Event>> events(numStops);
+    std::vector<char>               active(numJourneys, 0);
+    for (int j = 0; j < numJourneys; ++j) {
+        const auto& journey    = journeys[j];
+        int         groupIndex = dataLoader.getVehicleTypeGroupIndex(journey.vehTypeGroupId);
+        int         fromStop   = dataLoader.getStopIndex(journey.fromStopId);
+        int         toStop     = dataLoader.getStopIndex(journey.toStopId);
+        if (fromStop < 0 || toStop < 0 ||
+            !dataLoader.isVehicleTypeIndexCompatible(vehicleTypeIndex_, groupIndex))
+            continue;
+
+        active[j] = 1;
+        events[fromStop].push_back({journey.depTime, kDeparture, j});
+        events[toStop].push_back({journey.arrTime + journey.minLayoverTime, kArrival, j});
+    }
+
+    // Departure and arrival events per stop, both in time order
+    std::vector<std::vector<int>> departureTimes(numStops);
+    std::vector<std::vector<int>> departureJourneys(numStops);
+    std::vector<std::vector<int>> arrivalTimes(numStops);
+    std::vector<std::vector<int>> arrivalJourneys(numStops);
+    for (int s = 0; s < numStops; ++s) {
+        std::sort(events[s].begin(), events[s].end());
+        for (const auto& event : events[s]) {
+            auto& times = event.kind == kDeparture ? departureTimes[s] : arrivalTimes[s];
+            auto& owner = event.kind == kDeparture ? departureJourneys[s] : arrivalJourneys[s];
+            times.push_back(event.time);
+            owner.push_back(event.journeyIdx);
+        }
+        if (!events[s].empty()) {
+            unreducedSize_.nodes += events[s].size();
+            unreducedSize_.waitingArcs += events[s].size() - 1;
+        }
+    }
+
+    // Deadheads between events: from every arrival to the first reachable departure at each
+    // other stop. Targets are non-decreasing in the arrival time, so equal targets form runs.
+    struct EventDeadhead {
+        int    arrivalJourney;
+        int    departureJourney;
+        double cost;
+        double distance;
+        int    time;
+    };
+    std::vector<EventDeadhead> deadheads;
+    std::vector<char>          hasDeadheadOut(numJourneys, 0); // At the arrival event
+    std::vector<char>          hasDeadheadIn(numJourneys, 0);  // At the departure event
+    for (int a = 0; a < numStops; ++a) {
+        if (arrivalTimes[a].empty())
+            continue;
+        for (int b = 0; b < numStops; ++b) {
+            if (b == a || departureTimes[b].empty())
+                continue;
+
+            int    deadRunTime     = dataLoader.getDeadRunTimeByIndex(a, b);
+            double deadRunDistance = dataLoader.getDeadRunDistanceByIndex(a, b);
+            bool   driven          = deadRunDistance > 0 && deadRunTime > 0;
+            int    shift           = std::max(deadRunTime, 0);
+
+            EventDeadhead arc{-1,
+                              -1,
+                              Cost::deadRunCost(rates, deadRunDistance, deadRunTime),
+                              driven ? deadRunDistance : 0.0,
+                              driven ? deadRunTime : 0};
+
+            auto flush = [&]() {
+                if (arc.arrivalJourney < 0)
+                    return;
+                deadheads.push_back(arc);
+                hasDeadheadOut[arc.arrivalJourney]  = 1;
+                hasDeadheadIn[arc.departureJourney] = 1;
+            };
+
+            const auto& times = departureTimes[b];
+            for (size_t k = 0; k < arrivalTimes[a].size(); ++k) {
+                int  ready = arrivalTimes[a][k] + shift;
+                auto next  = std::lower_bound(times.begin(), times.end(), ready);
+                if (next == times.end())
+                    break;
+                ++unreducedSize_.deadheadArcs;
+
+                int target = departureJourneys[b][next - times.begin()];
+                if (target != arc.departureJourney || !options.pruneDominatedDeadheads) {
+                    flush();
+                    arc.departureJourney = target;
+                }
+                // A later arrival with the same target dominates the pending one
+                arc.arrivalJourney = arrivalJourneys[a][k];
+            }
+            flush();
+        }
+    }
+
+    // Nodes and waiting arcs. Entries into a stop are arrivals and incoming deadheads (at the
+    // target departure), exits are departures and outgoing deadheads (at the arrival). Events
+    // share a node as long as no entry follows an exit, so every entry reaches every exit.
+    std::vector<int> departureNode(numJourneys, -1);
+    std::vector<int> arrivalNode(numJourneys, -1);
+    std::vector<int> firstNode(numStops, -1);
+    std::vector<int> lastNode(numStops, -1);
+    for (int s = 0; s < numStops; ++s) {
+        bool hasExit = false;
+        for (const auto& event : events[s]) {
+            bool arrival = event.kind == kArrival;
+            bool entry   = arrival || hasDeadheadIn[event.journeyIdx];
+            bool exit    = !arrival || hasDeadheadOut[event.journeyIdx];
+
+            if (firstNode[s] < 0 || !options.aggregateEvents || (entry && hasExit)) {
+                int node = static_cast<int>(nodes_.size());
+                nodes_.push_back({s, event.time});
+                if (firstNode[s] < 0) {
+                    firstNode[s] = node;
+                }
+                else {
+                    arcs_.push_back(
+                        {TimeSpaceArcType::Waiting, node - 1, node, -1, -1, 0.0, 0.0, 0});
+                    ++size_.waitingArcs;
+                }
+                hasExit = false;
+            }
+            hasExit = hasExit || exit;
+
+            int node = static_cast<int>(nodes_.size()) - 1;
+            (arrival ? arrivalNode : departureNode)[event.journeyIdx] = node;
+        }
+        lastNode[s] = static_cast<int>(nodes_.size()) - 1;
+    }
+    size_.nodes = nodes_.size();
+
+    // Service arcs
+    for (int j = 0; j < numJourneys; ++j) {
+        if (!active[j])
+            continue;
+        const auto& journey = journeys[j];
+        arcs_.push_back({TimeSpaceArcType::Service,
+                         departureNode[j],
+                         arrivalNode[j],
+                         j,
+                         -1,
+                         Cost::serviceCost(rates, journey),
+                         journey.distance,
+                         journey.arrTime - journey.depTime});
+        ++size_.serviceArcs;
+    }
+    unreducedSize_.serviceArcs = size_.serviceArcs;
+
+    // Deadhead arcs between nodes; parallel arcs connect the same stops and collapse
+    std::vector<TimeSpaceArc> nodeDeadheads;
+    nodeDeadheads.reserve(deadheads.size());
+    for (const auto& deadhead : deadheads) {
+        nodeDeadheads.push_back({TimeSpaceArcType::Deadhead,
+                                 arrivalNode[deadhead.arrivalJourney],
+                                 departureNode[deadhead.departureJourney],
+                                 -1,
+                                 -1,
+                                 deadhead.cost,
+                                 deadhead.distance,
+                                 deadhead.time});
+    }
+    auto byNodes = [](const TimeSpaceArc& x, const TimeSpaceArc& y) {
+        return x.fromNode != y.fromNode ? x.fromNode < y.fromNode : x.toNode < y.toNode;
+    };
+    std::sort(nodeDeadheads.begin(), nodeDeadheads.end(), byNodes);
+    auto last = std::unique(nodeDeadheads.begin(),
+                            nodeDeadheads.end(),
+                            [](const TimeSpaceArc& x, const TimeSpaceArc& y) {
+                                return x.fromNode == y.fromNode && x.toNode == y.toNode;
+                            });
+    arcs_.insert(arcs_.end(), nodeDeadheads.begin(), last);
+    size_.deadheadArcs = last - nodeDeadheads.begin();
+
+    // Depot arcs: pull-out into the first node of a stop, pull-in from its last node
+    const auto& depotStops = dataLoader.getDepotStops();
+    for (int d = 0; d < static_cast<int>(depotStops.size()); ++d) {
+        int depotStop = dataLoader.getStopIndex(depotStops[d]);
+        if (depotStop < 0)
+            continue;
+
+        for (int s = 0; s < numStops; ++s) {
+            if (firstNode[s] < 0)
+                continue;
+
+            auto depotArc = [&](TimeSpaceArcType type, int from, int to, int fromStop, int toStop) {
+                int    time     = dataLoader.getDeadRunTimeByIndex(fromStop, toStop);
+                double distance = dataLoader.getDeadRunDistanceByIndex(fromStop, toStop);
+                bool   driven   = distance > 0 && time > 0;
+                arcs_.push_back({type,
+                                 from,
+                                 to,
+                                 -1,
+                                 d,
+                                 Cost::deadRunCost(rates, distance, time),
+                                 driven ? distance : 0.0,
+                                 driven ? time : 0});
+                ++size_.depotArcs;
+            };
+
+            // Same rule as the connection network: the pull-out dead run must exist
+            if (dataLoader.getDeadRunTimeByIndex(depotStop, s) >= 0 &&
+                dataLoader.getDeadRunDistanceByIndex(depotStop, s) >= 0) {
+                depotArc(TimeSpaceArcType::PullOut, -1, firstNode[s], depotStop, s);
+            }
+            depotArc(TimeSpaceArcType::PullIn, lastNode[s], -1, s, depotStop);
+        }
+    }
+    unreducedSize_.depotArcs = size_.depotArcs;
+}
+
+} // namespace network
@@ -0,0 +1,168 @@
+#include "service/InstanceCache.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace service {
+
+InstanceCache::InstanceCache(size_t memoryBudget, bool preprocess)
+  : memoryBudget_(memoryBudget),
+    preprocess_(preprocess),
+    clock_(0),
+    hits_(0),
+    misses_(0),
+    evictions_(0) {}
+
+std::shared_ptr<ResidentInstance> InstanceCache::acquire(const std::string& path, bool& loaded) {
+    loaded = false;
+
+    std::promise<std::shared_ptr<ResidentInstance>> promise;
+    Entry                                           entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto                        found = entries_.find(path);
+        if (found != entries_.end()) {
+            entry = found->second;
+            ++hits_;
+        }
+        else {
+            entry = promise.get_future().share();
+            entries_.emplace(path, entry);
+            loaded = true;
+            ++misses_;
+        }
+    }
+
+    // The first request loads outside the lock, later ones wait on its future
+    if (loaded) {
+        try {
+            promise.set_value(load(path));
+        }
+        catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                entries_.erase(path);
+            }
+            promise.set_exception(std::current_exception());
+        }
+    }
+
+    auto instance = entry.get(); // Rethrows a failed load
+    instance->lastUse.store(++clock_, std::memory_order_relaxed);
+    if (loaded) {
+        enforceBudget(instance.get());
+    }
+    return instance;
+}
+
+std::shared_ptr<ResidentInstance> InstanceCache::find(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto                        found = entries_.find(path);
+    if (found == entries_.end() ||
+        found->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return nullptr;
+
+    auto instance = found->second.get();
+    instance->lastUse.store(++clock_, std::memory_order_relaxed);
+    return instance;
+}
+
+bool InstanceCache::evict(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto                        found = entries_.find(path);
+    if (found == entries_.end() ||
+        found->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return false;
+
+    entries_.erase(found);
+    ++evictions_;
+    return true;
+}
+
+void InstanceCache::enforceBudget(const ResidentInstance* keep) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto   ready = readyLocked();
+    size_t total = 0;
+    for (const auto& entry : ready) {
+        total += entry.second->memoryBytes.load(std::memory_order_relaxed);
+    }
+
+    std::sort(ready.begin(), ready.end(), [](const auto& a, const auto& b) {
+        return a.second->lastUse.load(std::memory_order_relaxed) <
+               b.second->lastUse.load(std::memory_order_relaxed);
+    });
+    for (const auto& entry : ready) {
+        if (total <= memoryBudget_)
+            break;
+        if (entry.second.get() == keep)
+            continue;
+        total -= entry.second->memoryBytes.load(std::memory_order_relaxed);
+        entries_.erase(entry.first);
+        ++evictions_;
+    }
+}
+
+InstanceCache::Stats InstanceCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Stats stats;
+    for (const auto& entry : readyLocked()) {
+        ++stats.instances;
+        stats.memoryBytes += entry.second->memoryBytes.load(std::memory_order_relaxed);
+    }
+    stats.hits      = hits_;
+    stats.misses    = misses_;
+    stats.evictions = evictions_;
+    return stats;
+}
+
+std::vector<std::string> InstanceCache::getPaths() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<std::string> paths;
+    for (const auto& entry : readyLocked()) {
+        paths.push_back(entry.first);
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+std::shared_ptr<ResidentInstance> InstanceCache::load(const std::string& path) const {
+    auto startTime = std::chrono::steady_clock::now();
+
+    auto instance    = std::make_shared<ResidentInstance>();
+    instance->path   = path;
+    instance->solver = std::make_unique<MDVSPSolver>();
+    if (!instance->solver->loadProblem(path, preprocess_)) {
+        throw std::runtime_error("Failed to load problem from: " + path);
+    }
+
+    const auto& journeys = instance->solver->getDataLoader()->getServiceJourneys();
+    for (int j = 0; j < static_cast<int>(journeys.size()); ++j) {
+        instance->journeyIndex.emplace(journeys[j].id, j);
+    }
+    instance->memoryBytes = instance->solver->getDataLoader()->getMemoryUsage() +
+                            instance->journeyIndex.size() * 4 * sizeof(int);
+    instance->loadSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return instance;
+}
+
+std::vector<std::pair<std::string, std::shared_ptr<ResidentInstance>>>
+InstanceCache::readyLocked() const {
+    std::vector<std::pair<std::string, std::shared_ptr<ResidentInstance>>> ready;
+    for (const auto& entry : entries_) {
+        if (entry.second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            try {
+                ready.emplace_back(entry.first, entry.second.get());
+            }
+            catch (...) {
+                // Failed load, its entry is being removed
+            }
+        }
+    }
+    return ready;
+}
+
+} // namespace service
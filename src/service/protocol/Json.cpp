@@ -0,0 +1,342 @@
+#include "service/Json.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace service {
+
+namespace {
+
+/**
+ * Recursive descent parser over the input text
+ */
+class Parser {
+  public:
+    explicit Parser(const std::string& text) : text_(text), pos_(0) {}
+
+    JsonValue parseDocument() {
+        JsonValue value = parseValue(0);
+        skipWhitespace();
+        if (pos_ != text_.size())
+            fail("trailing characters");
+        return value;
+    }
+
+  private:
+    static constexpr int kMaxDepth = 64;
+
+    const std::string& text_;
+    size_t             pos_;
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::invalid_argument("JSON: " + message + " at offset " + std::to_string(pos_));
+    }
+
+    void skipWhitespace() {
+        while (pos_ < text_.size() &&
+               (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' ||
+                text_[pos_] == '\r')) {
+            ++pos_;
+        }
+    }
+
+    bool consume(char c) {
+        skipWhitespace();
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c) {
+        if (!consume(c))
+            fail(std::string("expected '") + c + "'");
+    }
+
+    bool consumeWord(const char* word) {
+        size_t length = std::char_traits<char>::length(word);
+        if (text_.compare(pos_, length, word) != 0)
+            return false;
+        pos_ += length;
+        return true;
+    }
+
+    JsonValue parseValue(int depth) {
+        if (depth > kMaxDepth)
+            fail("nesting too deep");
+
+        skipWhitespace();
+        if (pos_ >= text_.size())
+            fail("unexpected end");
+
+        char c = text_[pos_];
+        if (c == '{')
+            return parseObject(depth);
+        if (c == '[')
+            return parseArray(depth);
+        if (c == '"')
+            return JsonValue(parseString());
+        if (consumeWord("true"))
+            return JsonValue(true);
+        if (consumeWord("false"))
+            return JsonValue(false);
+        if (consumeWord("null"))
+            return JsonValue();
+        return JsonValue(parseNumber());
+    }
+
+    JsonValue parseObject(int depth) {
+        JsonValue object = JsonValue::object();
+        expect('{');
+        if (consume('}'))
+            return object;
+        do {
+            skipWhitespace();
+            if (pos_ >= text_.size() || text_[pos_] != '"')
+                fail("expected member name");
+            std::string key = parseString();
+            expect(':');
+            object.set(key, parseValue(depth + 1));
+        } while (consume(','));
+        expect('}');
+        return object;
+    }
+
+    JsonValue parseArray(int depth) {
+        JsonValue array = JsonValue::array();
+        expect('[');
+        if (consume(']'))
+            return array;
+        do {
+            array.push(parseValue(depth + 1));
+        } while (consume(','));
+        expect(']');
+        return array;
+    }
+
+    double parseNumber() {
+        const char* begin = text_.c_str() + pos_;
+        char*       end   = nullptr;
+        double      value = std::strtod(begin, &end);
+        if (end == begin)
+            fail("unexpected character");
+        pos_ += static_cast<size_t>(end - begin);
+        return value;
+    }
+
+    std::string parseString() {
+        std::string value;
+        ++pos_; // Opening quote
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char c = text_[pos_++];
+            if (c != '\\') {
+                value += c;
+                continue;
+            }
+            if (pos_ >= text_.size())
+                break;
+            char escape = text_[pos_++];
+            switch (escape) {
+                case 'n':
+                    value += '\n';
+                    break;
+                case 't':
+                    value += '\t';
+                    break;
+                case 'r':
+                    value += '\r';
+                    break;
+                case 'b':
+                    value += '\b';
+                    break;
+                case 'f':
+                    value += '\f';
+                    break;
+                case 'u':
+                    value += parseCodePoint();
+                    break;
+                default:
+                    value += escape;
+                    break;
+            }
+        }
+        if (pos_ >= text_.size())
+            fail("unterminated string");
+        ++pos_; // Closing quote
+        return value;
+    }
+
+    // \uXXXX as UTF-8; surrogate pairs are not combined, protocol strings are ASCII
+    std::string parseCodePoint() {
+        if (pos_ + 4 > text_.size())
+            fail("bad unicode escape");
+        unsigned code = static_cast<unsigned>(std::stoul(text_.substr(pos_, 4), nullptr, 16));
+        pos_ += 4;
+
+        std::string out;
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        }
+        else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        return out;
+    }
+};
+
+void dumpString(const std::string& value, std::string& out) {
+    out += '"';
+    for (char c : value) {
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    out += buffer;
+                }
+                else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+} // namespace
+
+JsonValue JsonValue::array() {
+    JsonValue value;
+    value.type_ = Type::Array;
+    return value;
+}
+
+JsonValue JsonValue::object() {
+    JsonValue value;
+    value.type_ = Type::Object;
+    return value;
+}
+
+JsonValue JsonValue::parse(const std::string& text) {
+    return Parser(text).parseDocument();
+}
+
+std::string JsonValue::dump() const {
+    std::string out;
+    dump(out);
+    return out;
+}
+
+void JsonValue::dump(std::string& out) const {
+    switch (type_) {
+        case Type::Null:
+            out += "null";
+            break;
+        case Type::Bool:
+            out += bool_ ? "true" : "false";
+            break;
+        case Type::Number: {
+            if (!std::isfinite(number_)) {
+                out += "null";
+                break;
+            }
+            char buffer[32];
+            if (number_ == std::floor(number_) && std::fabs(number_) < 1e15) {
+                std::snprintf(buffer, sizeof(buffer), "%.0f", number_);
+            }
+            else {
+                std::snprintf(buffer, sizeof(buffer), "%.17g", number_);
+            }
+            out += buffer;
+            break;
+        }
+        case Type::String:
+            dumpString(string_, out);
+            break;
+        case Type::Array:
+            out += '[';
+            for (size_t i = 0; i < items_.size(); ++i) {
+                if (i > 0)
+                    out += ',';
+                items_[i].dump(out);
+            }
+            out += ']';
+            break;
+        case Type::Object:
+            out += '{';
+            for (size_t i = 0; i < members_.size(); ++i) {
+                if (i > 0)
+                    out += ',';
+                dumpString(members_[i].first, out);
+                out += ':';
+                members_[i].second.dump(out);
+            }
+            out += '}';
+            break;
+    }
+}
+
+JsonValue& JsonValue::push(JsonValue value) {
+    type_ = Type::Array;
+    items_.push_back(std::move(value));
+    return *this;
+}
+
+JsonValue& JsonValue::set(const std::string& key, JsonValue value) {
+    type_ = Type::Object;
+    for (auto& member : members_) {
+        if (member.first == key) {
+            member.second = std::move(value);
+            return *this;
+        }
+    }
+    members_.emplace_back(key, std::move(value));
+    return *this;
+}
+
+const JsonValue* JsonValue::find(const std::string& key) const {
+    for (const auto& member : members_) {
+        if (member.first == key)
+            return &member.second;
+    }
+    return nullptr;
+}
+
+std::string JsonValue::getString(const std::string& key, const std::string& fallback) const {
+    const JsonValue* value = find(key);
+    return value && value->isString() ? value->string_ : fallback;
+}
+
+double JsonValue::getNumber(const std::string& key, double fallback) const {
+    const JsonValue* value = find(key);
+    return value && value->isNumber() ? value->number_ : fallback;
+}
+
+bool JsonValue::getBool(const std::string& key, bool fallback) const {
+    const JsonValue* value = find(key);
+    return value && value->type_ == Type::Bool ? value->bool_ : fallback;
+}
+
+} // namespace service
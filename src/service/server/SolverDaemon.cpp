@@ -0,0 +1,513 @@
+#include "service/SolverDaemon.hpp"
+#include "core/ParallelFor.hpp"
+#include "meta/LocalSearch.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "gurobi_c++.h"
+
+namespace service {
+
+namespace {
+constexpr size_t kMaxLineBytes = 16 * 1024 * 1024; // Longer requests drop the connection
+
+bool needsGurobi(const JsonValue& request) {
+    std::string method = request.getString("method", "greedy");
+    return request.getString("op") == "solve" && (method == "exact" || method == "portfolio");
+}
+} // namespace
+
+/**
+ * Client connection; the socket closes when the last job holding it is done
+ */
+struct SolverDaemon::Connection {
+    int         fd;
+    std::mutex  writeMutex;
+    std::string buffer; // Unterminated input, I/O thread only
+
+    explicit Connection(int socketFd) : fd(socketFd) {}
+    ~Connection() { close(fd); }
+
+    void send(const std::string& line) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        size_t                      sent = 0;
+        while (sent < line.size()) {
+            ssize_t written = ::send(fd, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+            if (written < 0 && errno == EINTR)
+                continue;
+            if (written <= 0)
+                return; // Client gone, the I/O thread drops the connection
+            sent += static_cast<size_t>(written);
+        }
+    }
+};
+
+SolverDaemon::SolverDaemon(const Config& config)
+  : config_(config),
+    cache_(config.memoryBudget * 1024 * 1024, config.preprocess),
+    numWorkers_(core::resolveThreadCount(config.workers)),
+    listenFd_(-1),
+    wakePipe_{-1, -1},
+    stopping_(false),
+    served_(0),
+    envTried_(false) {}
+
+SolverDaemon::~SolverDaemon() {
+    if (listenFd_ >= 0) {
+        close(listenFd_);
+    }
+    for (int fd : wakePipe_) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+int SolverDaemon::run() {
+    if (!openSocket())
+        return 1;
+
+    for (int w = 0; w < numWorkers_; ++w) {
+        workers_.emplace_back(&SolverDaemon::workerLoop, this);
+    }
+    log("Listening on " + config_.socketPath + " with " + std::to_string(numWorkers_) +
+        " workers");
+
+    serve();
+
+    // Running requests return their best solution early, queued ones are dropped with their
+    // connections
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        stopping_ = true;
+        queue_.clear();
+    }
+    queueReady_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+
+    close(listenFd_);
+    listenFd_ = -1;
+    unlink(config_.socketPath.c_str());
+    log("Stopped after " + std::to_string(served_.load()) + " requests");
+    return 0;
+}
+
+void SolverDaemon::requestStop() {
+    stopping_.store(true);
+    shutdown_.requestStop();
+    if (wakePipe_[1] >= 0) {
+        char byte = 1;
+        ssize_t ignored = write(wakePipe_[1], &byte, 1);
+        (void) ignored;
+    }
+}
+
+bool SolverDaemon::openSocket() {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (config_.socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "[SolverDaemon] Socket path too long: " << config_.socketPath << std::endl;
+        return false;
+    }
+    std::strncpy(address.sun_path, config_.socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    // Replace a stale socket of an earlier run, but never another kind of file
+    struct stat info;
+    if (stat(config_.socketPath.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+        unlink(config_.socketPath.c_str());
+    }
+
+    if (pipe2(wakePipe_, O_CLOEXEC | O_NONBLOCK) != 0) {
+        std::cerr << "[SolverDaemon] pipe: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    listenFd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0 ||
+        bind(listenFd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd_, 64) != 0) {
+        std::cerr << "[SolverDaemon] Cannot listen on " << config_.socketPath << ": "
+                  << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void SolverDaemon::serve() {
+    std::vector<std::shared_ptr<Connection>> connections;
+
+    while (!stopping_.load()) {
+        std::vector<pollfd> fds;
+        fds.push_back({listenFd_, POLLIN, 0});
+        fds.push_back({wakePipe_[0], POLLIN, 0});
+        for (const auto& connection : connections) {
+            fds.push_back({connection->fd, POLLIN, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            std::cerr << "[SolverDaemon] poll: " << std::strerror(errno) << std::endl;
+            return;
+        }
+        if (fds[1].revents != 0)
+            return; // requestStop()
+
+        if (fds[0].revents & POLLIN) {
+            int fd = accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd >= 0) {
+                connections.push_back(std::make_shared<Connection>(fd));
+            }
+        }
+
+        // Read the clients of this poll round, complete lines become jobs
+        std::vector<std::shared_ptr<Connection>> open;
+        for (size_t c = 0; c + 2 < fds.size(); ++c) {
+            auto& connection = connections[c];
+            if (fds[c + 2].revents == 0) {
+                open.push_back(connection);
+                continue;
+            }
+
+            char    chunk[65536];
+            ssize_t received = read(connection->fd, chunk, sizeof(chunk));
+            if (received < 0 && (errno == EINTR || errno == EAGAIN)) {
+                open.push_back(connection);
+                continue;
+            }
+            if (received <= 0)
+                continue; // Closed by the client
+
+            connection->buffer.append(chunk, static_cast<size_t>(received));
+            size_t newline;
+            while ((newline = connection->buffer.find('\n')) != std::string::npos) {
+                std::string line = connection->buffer.substr(0, newline);
+                connection->buffer.erase(0, newline + 1);
+                if (line.find_first_not_of(" \t\r") == std::string::npos)
+                    continue;
+
+                std::lock_guard<std::mutex> lock(queueMutex_);
+                queue_.push_back({connection, std::move(line)});
+                queueReady_.notify_one();
+            }
+            if (connection->buffer.size() <= kMaxLineBytes) {
+                open.push_back(connection);
+            }
+        }
+        // Connections accepted in this round have no poll entry yet
+        for (size_t c = fds.size() - 2; c < connections.size(); ++c) {
+            open.push_back(connections[c]);
+        }
+        connections = std::move(open);
+    }
+}
+
+void SolverDaemon::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueReady_.wait(lock, [this]() { return stopping_.load() || !queue_.empty(); });
+            if (stopping_.load())
+                return;
+            job = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        JsonValue response;
+        try {
+            JsonValue request = JsonValue::parse(job.line);
+            response = handle(request, needsGurobi(request) ? gurobiEnvironment() : nullptr);
+            if (const JsonValue* id = request.find("id")) {
+                response.set("id", *id);
+            }
+        }
+        catch (const std::exception& e) {
+            response = JsonValue::object().set("ok", false).set("error", e.what());
+        }
+
+        job.connection->send(response.dump() + "\n");
+        ++served_;
+    }
+}
+
+std::shared_ptr<GRBEnv> SolverDaemon::gurobiEnvironment() {
+    std::lock_guard<std::mutex> lock(envMutex_);
+    if (!envTried_) {
+        envTried_ = true;
+        try {
+            env_ = std::make_shared<GRBEnv>(true);
+            env_->set(GRB_IntParam_LogToConsole, 0);
+            env_->start();
+        }
+        catch (GRBException& e) {
+            log("Gurobi environment not available: " + e.getMessage());
+            env_.reset();
+        }
+    }
+    return env_;
+}
+
+JsonValue SolverDaemon::handle(const JsonValue& request, std::shared_ptr<GRBEnv> env) {
+    auto        startTime = std::chrono::steady_clock::now();
+    std::string op        = request.getString("op");
+
+    JsonValue response;
+    try {
+        if (!request.isObject()) {
+            throw std::invalid_argument("Request must be a JSON object");
+        }
+        else if (op == "ping") {
+            response = JsonValue::object();
+        }
+        else if (op == "load") {
+            response = handleLoad(request);
+        }
+        else if (op == "solve") {
+            response = handleSolve(request, std::move(env));
+        }
+        else if (op == "repair") {
+            response = handleRepair(request);
+        }
+        else if (op == "query") {
+            response = handleQuery(request);
+        }
+        else if (op == "evict") {
+            response = JsonValue::object().set("evicted",
+                                               cache_.evict(request.getString("instance")));
+        }
+        else if (op == "status") {
+            response = handleStatus();
+        }
+        else if (op == "shutdown") {
+            response = JsonValue::object();
+            requestStop();
+        }
+        else {
+            throw std::invalid_argument("Unknown op: \"" + op + "\"");
+        }
+        response.set("ok", true);
+    }
+    catch (const std::exception& e) {
+        response = JsonValue::object().set("ok", false).set("error", e.what());
+    }
+
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    response.set("op", op).set("seconds", seconds);
+    std::string instance = request.getString("instance");
+    log(op + (instance.empty() ? "" : " " + instance) + " in " + std::to_string(seconds) + "s");
+    return response;
+}
+
+JsonValue SolverDaemon::handleLoad(const JsonValue& request) {
+    bool loaded   = false;
+    auto instance = acquire(request, loaded);
+    return instanceInfo(*instance).set("loaded", loaded);
+}
+
+JsonValue SolverDaemon::handleSolve(const JsonValue& request, std::shared_ptr<GRBEnv> env) {
+    bool loaded   = false;
+    auto instance = acquire(request, loaded);
+
+    // Workers share the cores unless the request asks for more
+    int defaultThreads = std::max(1, core::resolveThreadCount(0) / numWorkers_);
+
+    MDVSPSolver::SolverConfig config;
+    config.method        = request.getString("method", "greedy");
+    config.timeLimit     = request.getNumber("timeLimit", 60.0);
+    config.optimalityGap = request.getNumber("gap", 0.01);
+    config.threads       = static_cast<int>(request.getNumber("threads", defaultThreads));
+    config.verbose       = config_.verbose;
+    config.problemName   = request.getString("name", instance->path);
+
+    config.nodeHeuristicInterval = static_cast<int>(request.getNumber("nodeHeuristic", 0));
+    config.stop                  = shutdown_;
+
+    core::UnifiedSolution solution;
+    {
+        std::lock_guard<std::mutex> solveLock(instance->solveMutex);
+        instance->solver->setGurobiEnvironment(std::move(env));
+        solution = instance->solver->solve(config);
+        instance->solver->setGurobiEnvironment(nullptr);
+    }
+
+    if (solution.isFeasible()) {
+        std::lock_guard<std::mutex> lock(instance->mutex);
+        instance->lastSolution = solution;
+        instance->hasSolution  = true;
+    }
+    return solutionInfo(*instance, solution, request.getBool("blocks", false))
+        .set("loaded", loaded);
+}
+
+JsonValue SolverDaemon::handleRepair(const JsonValue& request) {
+    bool loaded   = false;
+    auto instance = acquire(request, loaded);
+
+    std::lock_guard<std::mutex> solveLock(instance->solveMutex);
+    const auto&                 dataLoader = *instance->solver->getDataLoader();
+    if (!instance->network) {
+        network::ConnectionNetwork::Options options;
+        options.threads   = std::max(1, core::resolveThreadCount(0) / numWorkers_);
+        instance->network = std::make_unique<network::ConnectionNetwork>(dataLoader, options);
+        instance->memoryBytes += instance->network->getNumArcs() * sizeof(int) +
+                                 dataLoader.getServiceJourneys().size() * 8 * sizeof(int);
+        cache_.enforceBudget(instance.get());
+    }
+
+    // Blocks of the request (journey IDs), otherwise the last solution
+    core::UnifiedSolution partial("repair", 0.0, 0.0, "FEASIBLE");
+    if (const JsonValue* blocks = request.find("blocks")) {
+        for (const auto& item : blocks->getItems()) {
+            core::VehicleBlock block{};
+            block.depotId       = static_cast<int>(item.getNumber("depot", -1));
+            block.vehicleTypeId = static_cast<int>(item.getNumber("vehicleType", -1));
+            block.journeyOffset = static_cast<int>(partial.journeys.size());
+            if (const JsonValue* journeys = item.find("journeys")) {
+                for (const auto& journey : journeys->getItems()) {
+                    auto index = instance->journeyIndex.find(static_cast<int>(journey.asNumber()));
+                    if (index == instance->journeyIndex.end()) {
+                        throw std::invalid_argument("Unknown journey ID " +
+                                                    std::to_string(journey.asNumber()));
+                    }
+                    partial.journeys.push_back(index->second);
+                }
+            }
+            block.journeyCount = static_cast<int>(partial.journeys.size()) - block.journeyOffset;
+            partial.blocks.push_back(block);
+        }
+    }
+    else {
+        std::lock_guard<std::mutex> lock(instance->mutex);
+        if (instance->hasSolution) {
+            partial.blocks   = instance->lastSolution.blocks;
+            partial.journeys = instance->lastSolution.journeys;
+        }
+    }
+
+    meta::LocalSearch localSearch(*instance->network);
+    auto              solution = localSearch.repair(partial);
+    if (solution.isFeasible()) {
+        meta::LocalSearch::SolverConfig searchConfig;
+        searchConfig.timeLimit = request.getNumber("timeLimit", 1.0);
+        searchConfig.verbose   = config_.verbose;
+        searchConfig.stop      = shutdown_;
+        solution               = localSearch.improve(solution, searchConfig);
+        solution.algorithmType = "repair";
+
+        std::lock_guard<std::mutex> lock(instance->mutex);
+        instance->lastSolution = solution;
+        instance->hasSolution  = true;
+    }
+    return solutionInfo(*instance, solution, request.getBool("blocks", true)).set("loaded", loaded);
+}
+
+JsonValue SolverDaemon::handleQuery(const JsonValue& request) {
+    auto instance = cache_.find(request.getString("instance"));
+    if (!instance)
+        return JsonValue::object().set("resident", false);
+
+    JsonValue response = instanceInfo(*instance).set("resident", true);
+
+    // Copied under the state lock only, a running solve does not delay the query
+    core::UnifiedSolution solution;
+    {
+        std::lock_guard<std::mutex> lock(instance->mutex);
+        if (!instance->hasSolution)
+            return response;
+        solution = instance->lastSolution;
+    }
+    return response.set("solution", solutionInfo(*instance, solution, request.getBool("blocks")));
+}
+
+JsonValue SolverDaemon::handleStatus() const {
+    auto stats = cache_.getStats();
+
+    JsonValue instances = JsonValue::array();
+    for (const auto& path : cache_.getPaths()) {
+        instances.push(path);
+    }
+
+    size_t queued;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        queued = queue_.size();
+    }
+    return JsonValue::object()
+        .set("instances", instances)
+        .set("memoryBytes", static_cast<double>(stats.memoryBytes))
+        .set("memoryBudgetBytes", static_cast<double>(cache_.getMemoryBudget()))
+        .set("hits", static_cast<double>(stats.hits))
+        .set("misses", static_cast<double>(stats.misses))
+        .set("evictions", static_cast<double>(stats.evictions))
+        .set("workers", numWorkers_)
+        .set("queued", static_cast<double>(queued))
+        .set("served", static_cast<double>(served_.load()));
+}
+
+std::shared_ptr<ResidentInstance> SolverDaemon::acquire(const JsonValue& request, bool& loaded) {
+    std::string path = request.getString("instance");
+    if (path.empty()) {
+        throw std::invalid_argument("Missing \"instance\" (data directory)");
+    }
+    return cache_.acquire(path, loaded);
+}
+
+JsonValue SolverDaemon::instanceInfo(const ResidentInstance& instance) {
+    const auto& dataLoader = *instance.solver->getDataLoader();
+    return JsonValue::object()
+        .set("instance", instance.path)
+        .set("journeys", static_cast<int>(dataLoader.getServiceJourneys().size()))
+        .set("vehicleTypes", static_cast<int>(dataLoader.getVehicleTypes().size()))
+        .set("depots", static_cast<int>(dataLoader.getDepotStops().size()))
+        .set("memoryBytes", static_cast<double>(instance.memoryBytes.load()))
+        .set("loadSeconds", instance.loadSeconds);
+}
+
+JsonValue SolverDaemon::solutionInfo(const ResidentInstance&      instance,
+                                     const core::UnifiedSolution& solution,
+                                     bool                         withBlocks) {
+    JsonValue info = JsonValue::object()
+                         .set("status", solution.status)
+                         .set("algorithm", solution.algorithmType)
+                         .set("objective", solution.objectiveValue)
+                         .set("vehicles", solution.getNumVehicles())
+                         .set("solveSeconds", solution.solutionTimeSeconds);
+    if (!withBlocks)
+        return info;
+
+    // Journey IDs for the client, the solvers work on indices
+    const auto& journeys = instance.solver->getDataLoader()->getServiceJourneys();
+    JsonValue   blocks   = JsonValue::array();
+    for (const auto& block : solution.blocks) {
+        JsonValue journeyIds = JsonValue::array();
+        for (int journeyIdx : solution.journeysOf(block)) {
+            journeyIds.push(journeys[journeyIdx].id);
+        }
+        blocks.push(JsonValue::object()
+                        .set("depot", block.depotId)
+                        .set("vehicleType", block.vehicleTypeId)
+                        .set("cost", block.totalCost)
+                        .set("journeys", journeyIds));
+    }
+    return info.set("blocks", blocks);
+}
+
+void SolverDaemon::log(const std::string& message) const {
+    if (config_.verbose) {
+        std::cout << "[SolverDaemon] " << message << std::endl;
+    }
+}
+
+} // namespace service
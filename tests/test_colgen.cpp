@@ -0,0 +1,71 @@
+#include "colgen/ColumnGenerationSolver.hpp"
+#include "colgen/SubgradientMasterProblem.hpp"
+#include "core/SolutionValidator.hpp"
+#include "data/DataLoader.hpp"
+#include "network/ConnectionNetwork.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Column generation with the license-free subgradient master: the schedule must be valid and
+// the reported bound must lie between zero and its cost, also when the rounds stop early.
+// Each run is seeded with the previous schedule, the first one only with single-journey blocks.
+namespace {
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        ++failures;
+    }
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <dataDir>" << std::endl;
+        return 2;
+    }
+
+    data::DataLoader dataLoader(argv[1]);
+    if (!dataLoader.loadAll()) {
+        std::cerr << "Cannot load " << argv[1] << std::endl;
+        return 2;
+    }
+    network::ConnectionNetwork network(dataLoader);
+    core::SolutionValidator    validator(network);
+
+    core::UnifiedSolution initial;
+    for (int maxIterations : {1, 100, 100}) {
+        std::string run = "maxIterations=" + std::to_string(maxIterations) +
+                          (initial.isFeasible() ? " seeded" : "");
+
+        colgen::ColumnGenerationSolver::SolverConfig config;
+        config.timeLimit     = 30.0;
+        config.maxIterations = maxIterations;
+        config.threads       = 2;
+
+        colgen::ColumnGenerationSolver solver(dataLoader,
+                                              std::make_unique<colgen::SubgradientMasterProblem>());
+        auto   solution = solver.solve(initial, config);
+        auto   report   = validator.validate(solution);
+        double bound    = solver.getLowerBound();
+
+        std::cout << run << ": objective " << solution.objectiveValue << ", bound " << bound
+                  << ", " << solver.getNumColumns() << " columns" << std::endl;
+
+        check(solution.isFeasible(), run + ": schedule is feasible");
+        check(report.isValid(), run + ": schedule validates (" + report.summary() + ")");
+        check(bound >= 0.0, run + ": bound is not negative");
+        check(bound <= solution.objectiveValue * (1.0 + 1e-9),
+              run + ": bound does not exceed the primal cost");
+        check(solution.objectiveValue <= initial.objectiveValue || !initial.isFeasible(),
+              run + ": schedule is no worse than the seed");
+        if (initial.isFeasible()) {
+            check(bound > 0.0, run + ": seeded bound improves on zero");
+        }
+        initial = solution;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+#include "core/CostPolicy.hpp"
+#include "data/DataLoader.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Dense lookups of the DataLoader against the raw tables, and the shared cost policy against
+// the written-out cost formula
+namespace {
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        ++failures;
+    }
+}
+
+bool near(double expected, double actual) {
+    return std::abs(expected - actual) <= 1e-9 * std::max(1.0, std::abs(expected));
+}
+
+// (vehicle type, group) pairs of vehtypetovehtypegroup.csv, read independently of the loader
+std::set<std::pair<int, int>> readMappings(const std::string& dataDirectory) {
+    std::set<std::pair<int, int>> mappings;
+    std::ifstream                 file(dataDirectory + "/vehtypetovehtypegroup.csv");
+    std::string                   line;
+    std::getline(file, line); // Skip header
+    while (std::getline(file, line)) {
+        std::vector<std::string> fields;
+        std::stringstream        stream(line);
+        for (std::string field; std::getline(stream, field, ';');) {
+            fields.push_back(field);
+        }
+        if (fields.size() >= 3) {
+            mappings.emplace(std::stoi(fields[1]), std::stoi(fields[2]));
+        }
+    }
+    return mappings;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <dataDir>" << std::endl;
+        return 2;
+    }
+
+    data::DataLoader dataLoader(argv[1]);
+    if (!dataLoader.loadAll()) {
+        std::cerr << "Cannot load " << argv[1] << std::endl;
+        return 2;
+    }
+    const auto& vehicleTypes = dataLoader.getVehicleTypes();
+    const auto& groups       = dataLoader.getVehicleTypeGroups();
+
+    // Compatibility bitmatrix against the mapping table
+    auto mappings = readMappings(argv[1]);
+    check(!mappings.empty(), "fixture has vehicle type group mappings");
+    for (const auto& group : groups) {
+        int              groupIndex = dataLoader.getVehicleTypeGroupIndex(group.id);
+        std::vector<int> compatible = dataLoader.getCompatibleVehicleTypes(group.id);
+        std::set<int>    listed(compatible.begin(), compatible.end());
+        check(groupIndex >= 0, "group " + std::to_string(group.id) + " has a dense index");
+
+        for (const auto& vehicleType : vehicleTypes) {
+            int         typeId   = vehicleType.id;
+            int         index    = dataLoader.getVehicleTypeIndex(typeId);
+            bool        expected = mappings.count({typeId, group.id}) > 0;
+            std::string pair =
+                " (type " + std::to_string(typeId) + ", group " + std::to_string(group.id) + ")";
+
+            check(dataLoader.isVehicleTypeCompatible(typeId, group.id) == expected,
+                  "compatibility by ID" + pair);
+            check(dataLoader.isVehicleTypeIndexCompatible(index, groupIndex) == expected,
+                  "compatibility bit" + pair);
+            check((listed.count(typeId) > 0) == expected, "compatible type list" + pair);
+        }
+    }
+    check(dataLoader.getVehicleTypeGroupIndex(-1) == -1, "unknown group has no index");
+
+    // Dense dead run matrix against the lookup by stop ID
+    for (const auto& fromStop : dataLoader.getStopPoints()) {
+        for (const auto& toStop : dataLoader.getStopPoints()) {
+            int from = dataLoader.getStopIndex(fromStop.id);
+            int to   = dataLoader.getStopIndex(toStop.id);
+            if (from < 0 || to < 0)
+                continue; // Stop of no journey or depot
+            std::string pair = " " + std::to_string(fromStop.id) + "->" + std::to_string(toStop.id);
+            check(dataLoader.getDeadRunTimeByIndex(from, to) ==
+                      dataLoader.getDeadRunTime(fromStop.id, toStop.id),
+                  "dead run time" + pair);
+            check(dataLoader.getDeadRunDistanceByIndex(from, to) ==
+                      dataLoader.getDeadRunDistance(fromStop.id, toStop.id),
+                  "dead run distance" + pair);
+        }
+    }
+
+    // Cost policy against kmCost * dist / 100 + hourCost * time / 3600
+    for (const auto& vehicleType : vehicleTypes) {
+        core::CostRates rates(vehicleType);
+        std::string     type = " (type " + std::to_string(vehicleType.id) + ")";
+
+        for (const auto& journey : dataLoader.getServiceJourneys()) {
+            int    time     = journey.arrTime - journey.depTime;
+            double expected = vehicleType.kmCost * journey.distance / 100.0 +
+                              vehicleType.hourCost * time / 3600.0;
+            check(near(expected, core::DefaultCostPolicy::serviceCost(rates, journey)),
+                  "service cost of journey " + std::to_string(journey.id) + type);
+        }
+
+        check(near(vehicleType.kmCost * 12.5 + vehicleType.hourCost * 0.5,
+                   core::DefaultCostPolicy::deadRunCost(rates, 1250.0, 1800)),
+              "dead run cost" + type);
+        check(core::DefaultCostPolicy::deadRunCost(rates, -1.0, -1) == 0.0,
+              "missing dead run is free" + type);
+        check(core::DefaultCostPolicy::deadRunCost(rates, 0.0, 0) == 0.0,
+              "zero-length dead run is free" + type);
+    }
+
+    return failures == 0 ? 0 : 1;
+}